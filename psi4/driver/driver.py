@@ -1248,7 +1248,8 @@ def optimize(name, **kwargs):
 
         # Use orbitals from previous iteration as a guess
         #   set within loop so that can be influenced by fns to optimize (e.g., cbs)
-        if (n > 1) and (not core.get_option('SCF', 'GUESS_PERSIST')):
+        #   (an EXTRAPOLATE guess already builds on the orbitals of the previous steps)
+        if (n > 1) and (not core.get_option('SCF', 'GUESS_PERSIST')) and (core.get_option('SCF', 'GUESS') != 'EXTRAPOLATE'):
             core.set_local_option('SCF', 'GUESS', 'READ')
 
         # We'll currently ignore the possibility that the gradient isn't needed
@@ -1476,7 +1476,7 @@ def scf_wavefunction_factory(name, ref_wfn, reference, **kwargs):
         wfn.set_basisset("BASIS_RELATIVISTIC", decon_basis)
 
     # Set the multitude of SAD basis sets
-    if (core.get_option("SCF", "GUESS") in ["SAD", "SADNO", "HUCKEL", "MODHUCKEL"]):
+    if (core.get_option("SCF", "GUESS") in ["SAD", "SADNO", "HUCKEL", "MODHUCKEL", "EXTRAPOLATE"]):
         sad_basis_list = core.BasisSet.build(wfn.molecule(), "ORBITAL",
                                              core.get_global_option("BASIS"),
                                              puream=wfn.basisset().has_puream(),
@@ -1838,6 +1838,7 @@ def scf_helper(name, post_scf=True, **kwargs):
                 guessbasis = '3-21G'  # guess of last resort
         else:
             guessbasis = cast
+        targetbasis = core.get_global_option('BASIS')
         core.set_global_option('BASIS', guessbasis)
 
         castdf = 'DF' in core.get_global_option('SCF_TYPE')
@@ -1910,6 +1911,11 @@ def scf_helper(name, post_scf=True, **kwargs):
             core.print_out("         " + "SCF Castup computation".center(58))
         ref_wfn = scf_wavefunction_factory(name, base_wfn, core.get_option('SCF', 'REFERENCE'), **kwargs)
 
+        # An extrapolated guess comes from, and is only saved for, the target basis
+        if core.get_option('SCF', 'GUESS') == 'EXTRAPOLATE':
+            ref_wfn.set_guess_history_basis(
+                core.BasisSet.build(scf_molecule, "ORBITAL", targetbasis))
+
         # Compute additive correction: dftd3, mp2d, dftd4, etc.
         if hasattr(ref_wfn, "_disp_functor"):
             disp_energy = ref_wfn._disp_functor.compute_energy(ref_wfn.molecule())
@@ -346,6 +346,11 @@ def scf_iterate(self, e_conv=None, d_conv=None):
     # has early_screening changed from True to False?
     early_screening_disabled = False
 
+    # is the XC quadrature in single precision until the DIIS error drops below DFT_MIXED_PRECISION_SWITCH?
+    mixed_precision_xc = bool(self.V_potential()) and core.get_option('SCF', 'DFT_MIXED_PRECISION')
+    if mixed_precision_xc:
+        self.V_potential().set_mixed_precision(True)
+
     # SCF iterations!
     SCFE_old = 0.0
     Dnorm = 0.0
@@ -356,6 +361,7 @@ def scf_iterate(self, e_conv=None, d_conv=None):
         diis_performed = False
         soscf_performed = False
         self.frac_performed_ = False
+        mixed_precision_iter = mixed_precision_xc
         #self.MOM_performed_ = False  # redundant from common_init()
 
         self.save_density_and_energy()
@@ -540,6 +546,13 @@ def scf_iterate(self, e_conv=None, d_conv=None):
         self.set_variable("SCF ITERATION ENERGY", SCFE)
         core.set_variable("SCF D NORM", Dnorm)
 
+        # Finish the SCF on the double-precision XC quadrature
+        if (mixed_precision_xc and not ((self.iteration_ == 0) and self.sad_)
+                and Dnorm < core.get_option('SCF', 'DFT_MIXED_PRECISION_SWITCH')):
+            mixed_precision_xc = False
+            self.V_potential().set_mixed_precision(False)
+            status.append("XC FP64")
+
         # After we've built the new D, damp the update
         if (damping_enabled and self.iteration_ > 1 and Dnorm > core.get_option('SCF', 'DAMPING_CONVERGENCE')):
             damping_percentage = core.get_option('SCF', "DAMPING_PERCENTAGE")
@@ -580,7 +593,13 @@ def scf_iterate(self, e_conv=None, d_conv=None):
         # Call any postiteration callbacks
         if not ((self.iteration_ == 0) and self.sad_) and _converged(Ediff, Dnorm, e_conv=e_conv, d_conv=d_conv):
 
-            if early_screening:
+            if mixed_precision_iter:
+
+                # converged on the single-precision XC quadrature; the next iteration(s) use double precision
+                mixed_precision_xc = False
+                self.V_potential().set_mixed_precision(False)
+
+            elif early_screening:
 
                 # we've reached convergence with early screning enabled; disable it
                 early_screening = False
@@ -796,6 +815,10 @@ def scf_finalize_energy(self):
     for k, v in self.variables().items():
         core.set_variable(k, v)
 
+    # Keep the converged orbitals for extrapolated guesses of later computations
+    if core.get_option('SCF', 'GUESS') == 'EXTRAPOLATE':
+        self.save_guess_history()
+
     # TODO re-enable
     self.finalize()
     if self.V_potential():
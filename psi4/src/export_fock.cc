@@ -176,6 +176,8 @@ void export_fock(py::module &m) {
         .def("get_AO_core", &DFHelper::get_AO_core)
         .def("set_MO_core", &DFHelper::set_MO_core)
         .def("get_MO_core", &DFHelper::get_MO_core)
+        .def("set_mmap_io", &DFHelper::set_mmap_io)
+        .def("get_mmap_io", &DFHelper::get_mmap_io)
         .def("add_space", &DFHelper::add_space)
         .def("initialize", &DFHelper::initialize)
         .def("print_header", &DFHelper::print_header)
@@ -191,7 +193,21 @@ void export_fock(py::module &m) {
         .def("get_tensor", tensor_access3(&DFHelper::get_tensor));
 
     py::class_<MemDFJK, std::shared_ptr<MemDFJK>, JK>(m, "MemDFJK", "docstring")
-        .def("dfh", &MemDFJK::dfh, "Return the DFHelper object.");
+        .def("dfh", &MemDFJK::dfh, "Return the DFHelper object.")
+        .def("do_incfock_iter", &MemDFJK::do_incfock_iter, "Was the last Fock build incremental?")
+        .def("num_incfock_J_builds", &MemDFJK::num_incfock_J_builds,
+             "Number of J builds done from the density difference.")
+        .def("num_incfock_K_builds", &MemDFJK::num_incfock_K_builds,
+             "Number of K builds done from the density difference.")
+        .def("clear_D_prev", &MemDFJK::clear_D_prev, "Clear previous D matrices.");
+
+    py::class_<DiskDFJK, std::shared_ptr<DiskDFJK>, JK>(m, "DiskDFJK", "docstring")
+        .def("do_incfock_iter", &DiskDFJK::do_incfock_iter, "Was the last Fock build incremental?")
+        .def("num_incfock_J_builds", &DiskDFJK::num_incfock_J_builds,
+             "Number of J builds done from the density difference.")
+        .def("num_incfock_K_builds", &DiskDFJK::num_incfock_K_builds,
+             "Number of K builds done from the density difference.")
+        .def("clear_D_prev", &DiskDFJK::clear_D_prev, "Clear previous D matrices.");
 
     py::class_<DirectJK, std::shared_ptr<DirectJK>, JK>(m, "DirectJK", "docstring")
         .def("do_incfock_iter", &DirectJK::do_incfock_iter, "Was the last Fock build incremental?");
@@ -250,7 +250,8 @@ void export_functional(py::module &m) {
         .def_static("build", [](std::shared_ptr<Molecule> &mol, std::shared_ptr<BasisSet> &basis,
                                 std::map<std::string, int> int_opts, std::map<std::string, std::string> string_opts) {
             return std::make_shared<DFTGrid>(mol, basis, int_opts, string_opts, Process::environment.options);
-        });
+        })
+        .def_static("clear_cache", &GridCache::clear, "Drops the grids, extents and blocks kept for DFT_GRID_CACHE.");
 
     py::class_<VBase, std::shared_ptr<VBase>>(m, "VBase", "docstring")
         .def_static("build",
@@ -266,9 +267,14 @@ void export_functional(py::module &m) {
         .def("get_block", &VBase::get_block, "Returns the requested BlockOPoints.")
         .def("nblocks", &VBase::nblocks, "Total number of blocks.")
         .def("quadrature_values", &VBase::quadrature_values, "Returns the quadrature values.")
+        .def("nblocks_skipped", &VBase::nblocks_skipped,
+             "Number of blocks the density screening left out of the last compute_V.")
         .def("build_collocation_cache", &VBase::build_collocation_cache,
              "Constructs a collocation cache to prevent recomputation.")
         .def("clear_collocation_cache", &VBase::clear_collocation_cache, "Clears the collocation cache.")
+        .def("set_mixed_precision", &VBase::set_mixed_precision,
+             "Toggles single-precision grid GEMMs in compute_V, accumulated into double precision.")
+        .def("mixed_precision", &VBase::mixed_precision, "Are the grid GEMMs of compute_V in single precision?")
         .def("set_D", &VBase::set_D, "Sets the internal density.")
         .def("Dao", &VBase::set_D, "Returns internal AO density.")
         .def("compute_V", &VBase::compute_V, "doctsring")
@@ -74,6 +74,8 @@
 #include "psi4/libmints/overlap.h"
 #include "psi4/libmints/thc_eri.h"
 #include "psi4/libpsi4util/libpsi4util.h"
+#include "psi4/dlpno/pair_gemm.h"
+#include "psi4/dlpno/sparse.h"
 #include <string>
 
 using namespace psi;
@@ -1731,6 +1733,10 @@ void export_mints(py::module& m) {
         .def("group", &CorrelationTable::gamma, "Returns the higher order point group");
 
     m.def("test_matrix_dpd_interface", &psi::test_matrix_dpd_interface);
+    m.def("test_dlpno_pair_gemm", &psi::dlpno::test_pair_gemm,
+          "Checks the DLPNO pair products against linalg::triplet and linalg::doublet.");
+    m.def("test_dlpno_sparse_maps", &psi::dlpno::test_sparse_maps,
+          "Checks the CSR pair domains and the sparse list helpers of DLPNO.");
 
     m.def("_libint2_configuration", []() { return libint2::configuration_accessor(); },
         "Returns string with codes detailing the integral classes, angular momenta, and ordering \
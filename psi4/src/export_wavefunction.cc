@@ -54,6 +54,7 @@
 #include "psi4/libmints/molecule.h"
 
 #include "psi4/libscf_solver/hf.h"
+#include "psi4/libscf_solver/guess_history.h"
 #include "psi4/libscf_solver/rhf.h"
 #include "psi4/libscf_solver/uhf.h"
 #include "psi4/libscf_solver/rohf.h"
@@ -333,6 +334,8 @@ void export_wavefunction(py::module& m) {
         .def("form_Shalf", &scf::HF::form_Shalf, "Forms the S^1/2 matrix")
         .def("form_FDSmSDF", &scf::HF::form_FDSmSDF, "Forms the residual of SCF theory")
         .def("guess", &scf::HF::guess, "Forms the guess (guarantees C, D, and E)")
+        .def("save_guess_history", &scf::HF::save_guess_history,
+             "Saves the converged occupied orbitals for later EXTRAPOLATE guesses")
         .def("initialize_gtfock_jk", &scf::HF::initialize_gtfock_jk, "Sets up a GTFock JK object")
         .def("onel_Hx", &scf::HF::onel_Hx, "One-electron Hessian-vector products.")
         .def("twoel_Hx", &scf::HF::twoel_Hx, "Two-electron Hessian-vector products")
@@ -347,6 +350,8 @@ void export_wavefunction(py::module& m) {
         .def_property("sad_", &scf::HF::sad, &scf::HF::set_sad,
                       "Do assume a non-idempotent density matrix and no orbitals after the guess.")
         .def("set_sad_basissets", &scf::HF::set_sad_basissets, "Sets the Superposition of Atomic Densities basisset.")
+        .def("set_guess_history_basis", &scf::HF::set_guess_history_basis,
+             "Sets the basis an EXTRAPOLATE guess looks its history up in, and stops this SCF from adding to it.")
         .def("set_sad_fitting_basissets", &scf::HF::set_sad_fitting_basissets,
              "Sets the Superposition of Atomic Densities density-fitted basisset.")
         .def("Va", &scf::HF::Va, "Returns the Alpha Kohn-Sham Potential Matrix.")
@@ -401,6 +406,10 @@ void export_wavefunction(py::module& m) {
         .def("print_stability_analysis", &scf::HF::print_stability_analysis, "docstring")
         .def("openorbital_scf", &scf::HF::openorbital_scf, "Runs the SCF with OpenOrbitalOptimizer");
 
+    py::class_<scf::GuessHistory>(m, "GuessHistory", "Converged SCF orbitals kept for EXTRAPOLATE guesses")
+        .def_static("size", &scf::GuessHistory::size, "Number of saved SCF solutions")
+        .def_static("clear", &scf::GuessHistory::clear, "Drops all saved SCF solutions");
+
     /// HF Functions
     py::class_<scf::RHF, std::shared_ptr<scf::RHF>, scf::HF>(m, "RHF", "docstring")
         .def(py::init<std::shared_ptr<Wavefunction>, std::shared_ptr<SuperFunctional>>())
@@ -102,7 +102,7 @@ PsiReturnType cceom(std::shared_ptr<ccenergy::CCEnergyWavefunction> ref_wfn, Opt
         spaces.emplace_back(moinfo.avirtpi, moinfo.avir_sym);
         spaces.emplace_back(moinfo.boccpi, moinfo.bocc_sym);
         spaces.emplace_back(moinfo.bvirtpi, moinfo.bvir_sym);
-        dpd_init(0, moinfo.nirreps, params.memory, 0, cachefiles, cachelist, nullptr, spaces);
+        dpd_init(0, moinfo.nirreps, params.memory, params.cachetype, cachefiles, cachelist, nullptr, spaces);
     } else { /* RHF or ROHF */
         cachelist = cacheprep_rhf(params.cachelev, cachefiles);
         /* cachelist = init_int_matrix(12,12); */
@@ -110,7 +110,7 @@ PsiReturnType cceom(std::shared_ptr<ccenergy::CCEnergyWavefunction> ref_wfn, Opt
         std::vector<std::pair<Dimension, int *>> spaces;
         spaces.emplace_back(moinfo.occpi, moinfo.occ_sym);
         spaces.emplace_back(moinfo.virtpi, moinfo.vir_sym);
-        dpd_init(0, moinfo.nirreps, params.memory, 0, cachefiles, cachelist, nullptr, spaces);
+        dpd_init(0, moinfo.nirreps, params.memory, params.cachetype, cachefiles, cachelist, nullptr, spaces);
     }
 
     if (params.local) local_init();
@@ -97,12 +97,11 @@ void get_params(Options &options) {
     params.full_matrix = options["FULL_MATRIX"].to_integer();
     params.cachelev = options.get_int("CACHELEVEL");
 
+    /* There are no cache priorities in cceom, so LOW falls back to LRU */
     std::string cachetype = options.get_str("CACHETYPE");
-    if (cachetype == "LOW")
-        params.cachetype = 1;
-    else if (cachetype == "LRU")
-        params.cachetype = 0;
-    if (params.ref == 2) /* No LRU cacheing yet for UHF references */
+    if (cachetype == "COST")
+        params.cachetype = 2;
+    else
         params.cachetype = 0;
 
     params.nthreads = Process::environment.get_n_threads();
@@ -137,7 +136,7 @@ void get_params(Options &options) {
     outfile->Printf("\tMemory (Mbytes) =  %5.1f\n", params.memory / 1e6);
     outfile->Printf("\tABCD            =     %s\n", params.abcd.c_str());
     outfile->Printf("\tCache Level     =    %1d\n", params.cachelev);
-    outfile->Printf("\tCache Type      =    %4s\n", params.cachetype ? "LOW" : "LRU");
+    outfile->Printf("\tCache Type      =    %4s\n", params.cachetype == 2 ? "COST" : "LRU");
     if (params.wfn == "EOM_CC3") outfile->Printf("\tT3 Ws incore  =    %4s\n", params.t3_Ws_incore ? "Yes" : "No");
     outfile->Printf("\tNum. of threads =     %d\n", params.nthreads);
     outfile->Printf("\tLocal CC        =     %s\n", params.local ? "Yes" : "No");
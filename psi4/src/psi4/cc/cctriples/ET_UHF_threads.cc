@@ -0,0 +1,84 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2026 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+/*! \file
+    \ingroup CCTRIPLES
+    \brief Explicit threads for the ijk loops of the UHF (T) energies
+*/
+#include <cstdio>
+#include "psi4/libdpd/dpd.h"
+#include "MOInfo.h"
+#include "Params.h"
+#include "globals.h"
+#include "psi4/libpsi4util/PsiOutStream.h"
+
+namespace psi {
+namespace cctriples {
+
+/* Number of threads for the ijk loop of a UHF (T) spin case, reduced when the
+** nabc abc-blocks (plus an F block) that each thread holds don't fit in memory.
+** virtpi_a, virtpi_b, and virtpi_c are the virtual spaces of the three indices. */
+int ET_UHF_nthreads(int nabc, Dimension const &virtpi_a, Dimension const &virtpi_b, Dimension const &virtpi_c) {
+    int nthreads = params.nthreads;
+
+    long int mem_avail = dpd_memfree();
+    long int abc = ((long int)virtpi_a.sum()) * virtpi_b.sum() * virtpi_c.sum() / moinfo.nirreps;
+    long int thread_mem_estimate = (nabc + 1) * abc;
+
+    outfile->Printf("    Memory available in words               : %15ld\n", mem_avail);
+    outfile->Printf("    Approx. words needed per explicit thread: %15ld\n", thread_mem_estimate);
+
+    // subtract at least 1/2 for non-abc quantities (mainly the ijab's + other buffers)
+    double tval = (double)mem_avail / (double)thread_mem_estimate;
+    int possible_nthreads = tval - 0.5;
+    if (possible_nthreads < 1) possible_nthreads = 1;
+
+    if (possible_nthreads < nthreads) {
+        nthreads = possible_nthreads;
+        outfile->Printf("    Reducing threads due to memory limitations.\n");
+    }
+
+    outfile->Printf("    Number of threads for explicit ijk threading: %4d\n\n", nthreads);
+
+    return nthreads;
+}
+
+/* Start reading the F <pq|rs> rows of occupied orbital P (of irrep Gp) for
+** all irreps of q in the background, if the DPD I/O pipeline is on.  The
+** prefetched rows are then served to whichever thread reads them first. */
+void ET_UHF_prefetch(dpdbuf4 *F, int Gp, int P) {
+#pragma omp critical
+    for (int Gq = 0; Gq < F->params->nirreps; Gq++) {
+        int Gpq = Gp ^ Gq;
+        if (!F->params->qpi[Gq]) continue;
+        global_dpd_->buf4_mat_irrep_prefetch_block(F, Gpq, F->row_offset[Gpq][P], F->params->qpi[Gq]);
+    }
+}
+
+}  // namespace cctriples
+}  // namespace psi
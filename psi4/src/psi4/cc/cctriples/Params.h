@@ -44,6 +44,7 @@ struct Params {
     int semicanonical;
     int nthreads;
     int dertype;
+    int print;
 };
 
 }  // namespace cctriples
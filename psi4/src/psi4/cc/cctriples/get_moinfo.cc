@@ -91,6 +91,8 @@ void get_moinfo(std::shared_ptr<Wavefunction> wfn, Options &options) {
         params.nthreads = options.get_int("CC_NUM_THREADS");
     }
 
+    params.print = options.get_int("PRINT");
+
     params.semicanonical = 0;
     junk = options.get_str("REFERENCE");
     /* if no reference is given, assume rhf */
@@ -46,6 +46,10 @@ namespace cctriples {
 /* Global variables */
 extern struct MOInfo moinfo;
 extern struct Params params;
+
+/* Thread count and F-row prefetch helpers for the UHF (T) energies, in ET_UHF_threads.cc */
+int ET_UHF_nthreads(int nabc, Dimension const &virtpi_a, Dimension const &virtpi_b, Dimension const &virtpi_c);
+void ET_UHF_prefetch(dpdbuf4 *F, int Gp, int P);
 }
 }  // namespace psi
 #endif
@@ -27,6 +27,7 @@
  */
 
 #include "dlpno.h"
+#include "pair_gemm.h"
 #include "sparse.h"
 
 #include "psi4/lib3index/3index.h"
@@ -83,7 +84,7 @@ inline SharedMatrix DLPNOCCSD::S_PNO(const int ij, const int mn) {
         std::tie(i, j) = ij_to_i_j_[ij];
         std::tie(m, n) = ij_to_i_j_[mn];
 
-        const int m_ij = lmopair_to_lmos_dense_[ij][m], n_ij = lmopair_to_lmos_dense_[ij][n];
+        const int m_ij = lmopair_to_lmos_[ij].find(m), n_ij = lmopair_to_lmos_[ij].find(n);
         if (m_ij == -1 || n_ij == -1 || low_memory_overlap_) {
             auto S_ij_mn = submatrix_rows_and_cols(*S_pao_, lmopair_to_paos_[ij], lmopair_to_paos_[mn]);
             return linalg::triplet(X_pno_[ij], S_ij_mn, X_pno_[mn], true, false, false);
@@ -111,17 +112,12 @@ inline std::vector<SharedMatrix> DLPNOCCSD::QIA_PNO(const int ij) {
     auto &[i, j] = ij_to_i_j_[ij];
     int pair_idx = (i > j) ? ij_to_ji_[ij] : ij;
 
-    if (write_qia_pno_) {
+    if (qia_pno_on_disk_[pair_idx]) {
         int naux_ij = lmopair_to_ribfs_[ij].size();
         int nlmo_ij = lmopair_to_lmos_[ij].size();
         int npno_ij = n_pno_[ij];
 
-        std::stringstream toc_entry;
-        toc_entry << "QIA (PNO) " << pair_idx;
-
-        auto q_ov = std::make_shared<Matrix>(toc_entry.str(), naux_ij, nlmo_ij * npno_ij);
-#pragma omp critical
-        q_ov->load(psio_, PSIF_DLPNO_QIA_PNO, psi::Matrix::SubBlocks);
+        auto q_ov = qia_pno_file_->read(pair_idx);
 
         std::vector<SharedMatrix> Qma_pno(naux_ij);
         for (int q_ij = 0; q_ij < naux_ij; q_ij++) {
@@ -138,16 +134,11 @@ inline std::vector<SharedMatrix> DLPNOCCSD::QAB_PNO(const int ij) {
     auto &[i, j] = ij_to_i_j_[ij];
     int pair_idx = (i > j) ? ij_to_ji_[ij] : ij;
 
-    if (write_qab_pno_) {
+    if (qab_pno_on_disk_[pair_idx]) {
         int naux_ij = lmopair_to_ribfs_[ij].size();
         int npno_ij = n_pno_[ij];
 
-        std::stringstream toc_entry;
-        toc_entry << "QAB (PNO) " << pair_idx;
-
-        auto q_vv = std::make_shared<Matrix>(toc_entry.str(), naux_ij, npno_ij * npno_ij);
-#pragma omp critical
-        q_vv->load(psio_, PSIF_DLPNO_QAB_PNO, psi::Matrix::ThreeIndexLowerTriangle);
+        auto q_vv = qab_pno_file_->read(pair_idx);
 
         std::vector<SharedMatrix> Qab_pno(naux_ij);
         for (int q_ij = 0; q_ij < naux_ij; q_ij++) {
@@ -160,6 +151,45 @@ inline std::vector<SharedMatrix> DLPNOCCSD::QAB_PNO(const int ij) {
     }
 }
 
+std::vector<std::pair<int, int>> DLPNOCCSD::pair_batches(const std::vector<int>& pairs) {
+    std::vector<std::pair<int, int>> batches;
+
+    int start = 0;
+    size_t batch_size = 0;
+    for (int idx = 0; idx < pairs.size(); ++idx) {
+        int ij = pairs[idx];
+        auto &[i, j] = ij_to_i_j_[ij];
+        if (i > j) continue;
+
+        size_t pair_size = 0;
+        if (qia_pno_on_disk_[ij]) pair_size += qia_pno_file_->block_size(ij);
+        if (qab_pno_on_disk_[ij]) pair_size += qab_pno_file_->block_size(ij);
+
+        // Every batch holds at least one pair, however large
+        if (batch_size > 0 && batch_size + pair_size > pair_batch_memory_) {
+            batches.emplace_back(start, idx);
+            start = idx;
+            batch_size = 0;
+        }
+        batch_size += pair_size;
+    }
+    batches.emplace_back(start, pairs.size());
+
+    return batches;
+}
+
+void DLPNOCCSD::stage_pno_integrals(const std::vector<int>& pairs, int start, int stop) {
+    std::vector<int> batch(pairs.begin() + start, pairs.begin() + stop);
+    qia_pno_file_->stage(batch);
+    qab_pno_file_->stage(batch);
+}
+
+void DLPNOCCSD::prefetch_pno_integrals(const std::vector<int>& pairs, int start, int stop) {
+    std::vector<int> batch(pairs.begin() + start, pairs.begin() + stop);
+    qia_pno_file_->prefetch(batch);
+    qab_pno_file_->prefetch(batch);
+}
+
 void DLPNOCCSD::compute_pno_overlaps() {
 
     const int naocc = i_j_to_ij_.size();
@@ -244,7 +274,7 @@ void DLPNOCCSD::estimate_memory() {
                 low_overlap_memory += n_pno_[ij] * n_pno_[kj];
             }
 
-            if (i <= j && lmopair_to_lmos_dense_[ij][k] != -1) {
+            if (i <= j && lmopair_to_lmos_[ij].find(k) != -1) {
                 int kk = i_j_to_ij_[k][k];
                 pno_overlap_memory += n_pno_[ij] * n_pno_[kk];
                 low_overlap_memory += n_pno_[ij] * n_pno_[kk];
@@ -267,6 +297,7 @@ void DLPNOCCSD::estimate_memory() {
     } // end ij
 
     size_t oo = 0, ov = 0, vv = 0, vv_non_proj = 0, vvv = 0, qo = 0, qv = 0, qov = 0, qvv = 0;
+    std::vector<size_t> qov_pair(n_lmo_pairs, 0), qvv_pair(n_lmo_pairs, 0);
 
     // oo => n_lmo_pairs * (nlmo_{ij}, nlmo_{ij})-like quantities: \beta_{ij}^{kl} (1 case over strong pairs, restricted indexing)
 
@@ -316,8 +347,10 @@ void DLPNOCCSD::estimate_memory() {
                 oo += nlmo_ij * nlmo_ij; // 1 case over strong pairs, restricted indexing
                 ov += nlmo_ij * npno_ij; // 1 case over strong pairs, restricted indexing
                 vv += 2 * npno_ij * npno_ij; // 2 cases over strong pairs, restricted indexing
-                qov += naux_ij * nlmo_ij * npno_ij; // 1 case over strong pairs, restricted indexing
-                qvv += naux_ij * npno_ij * npno_ij; // 1 case over strong pairs, restricted indexing
+                qov_pair[ij] = (size_t) naux_ij * nlmo_ij * npno_ij; // 1 case over strong pairs, restricted indexing
+                qvv_pair[ij] = (size_t) naux_ij * npno_ij * npno_ij; // 1 case over strong pairs, restricted indexing
+                qov += qov_pair[ij];
+                qvv += qvv_pair[ij];
             } // end if
 
         } // end if
@@ -333,12 +366,11 @@ void DLPNOCCSD::estimate_memory() {
         const int npno_ij = n_pno_[ij];
 
         // Determine size of extended_pao_domain
-        std::vector<int> extended_pao_domain;
-        
-        extended_pao_domain = lmopair_to_paos_[ij];
+        std::vector<int> extended_pao_domain = lmopair_to_paos_[ij].to_vector(), merge_buffer;
         for (int k_ij = 0; k_ij < nlmo_ij; ++k_ij) {
             int k = lmopair_to_lmos_[ij][k_ij];
-            extended_pao_domain = merge_lists(extended_pao_domain, lmo_to_paos_[k]);
+            merge_lists(extended_pao_domain, lmo_to_paos_[k], merge_buffer);
+            extended_pao_domain.swap(merge_buffer);
         }
         const int npao_ext_ij = extended_pao_domain.size();
 
@@ -354,9 +386,11 @@ void DLPNOCCSD::estimate_memory() {
     if (low_memory_overlap_) pno_overlap_memory = low_overlap_memory;
 
     write_qia_pno_ = options_.get_bool("WRITE_QIA_PNO");
+    qia_pno_on_disk_.assign(n_lmo_pairs, write_qia_pno_);
     if (write_qia_pno_) qov = 0;
 
     write_qab_pno_ = options_.get_bool("WRITE_QAB_PNO");
+    qab_pno_on_disk_.assign(n_lmo_pairs, write_qab_pno_);
     if (write_qab_pno_) qvv = 0;
 
 // Thread and OMP Parallel info
@@ -418,27 +452,63 @@ void DLPNOCCSD::estimate_memory() {
         outfile->Printf("    Required Memory Reduced to %.3f [GB]\n\n", std::max(memory_ccsd, memory_integrals) * DOUBLES_TO_GB);
     }
 
-    if (toggle_memory_ && !write_qia_pno_ && std::max(memory_ccsd, memory_integrals) * sizeof(double) > 0.9 * memory_) {
+    // (Q_{ij}|m_{ij} a_{ij}) and (Q_{ij}|a_{ij} b_{ij}) pair blocks beyond DF_PNO_CORE_MEMORY, or beyond what
+    // the total memory allows, go to disk, largest first. During the LCCSD iterations they come back in
+    // batches of pair_batch_memory_ doubles, the next one read while the current one is worked on, so two
+    // batches must fit next to everything else.
+    const size_t max_memory = 0.9 * memory_ / sizeof(double);
+    const size_t df_pno_core_memory = options_.get_double("DF_PNO_CORE_MEMORY") / DOUBLES_TO_GB;
+    pair_batch_memory_ = 0.05 * memory_ / sizeof(double);
+
+    size_t spill_target = 0;
+    if (df_pno_core_memory > 0 && qov + qvv > df_pno_core_memory) spill_target = qov + qvv - df_pno_core_memory;
+
+    if (toggle_memory_ && std::max(memory_ccsd, memory_integrals) > max_memory) {
         outfile->Printf("  Total Required Memory is (still) more than 90%% of Available Memory!\n");
-        outfile->Printf("    Attempting to switch to disk IO for (Q_{ij}|m_{ij} a_{ij}) integrals...\n");
+        outfile->Printf("    Attempting to move (Q_{ij}|m_{ij} a_{ij}) and (Q_{ij}|a_{ij} b_{ij}) pair blocks to disk...\n");
+        spill_target = std::max(spill_target,
+                                std::max(memory_ccsd, memory_integrals) + 2 * pair_batch_memory_ - max_memory);
+    }
 
-        memory_ccsd -= qov;
-        memory_integrals -= qov;
-        write_qia_pno_ = true;
+    if (spill_target > 0) {
         memory_changed = true;
-        qov = 0L;
-        outfile->Printf("    Required Memory Reduced to %.3f [GB]\n\n", std::max(memory_ccsd, memory_integrals) * DOUBLES_TO_GB);
+
+        // (pair size, pair, is qvv) of every block still in core
+        std::vector<std::tuple<size_t, int, bool>> blocks;
+        for (int ij = 0; ij < n_lmo_pairs; ++ij) {
+            if (qov_pair[ij] > 0 && !qia_pno_on_disk_[ij]) blocks.emplace_back(qov_pair[ij], ij, false);
+            if (qvv_pair[ij] > 0 && !qab_pno_on_disk_[ij]) blocks.emplace_back(qvv_pair[ij], ij, true);
+        }
+        std::sort(blocks.rbegin(), blocks.rend());
+
+        size_t spilled = 0;
+        for (const auto &[size, ij, is_qvv] : blocks) {
+            if (spilled >= spill_target) break;
+            if (is_qvv) {
+                qab_pno_on_disk_[ij] = true;
+                qvv -= size;
+            } else {
+                qia_pno_on_disk_[ij] = true;
+                qov -= size;
+            }
+            memory_ccsd -= size;
+            memory_integrals -= size;
+            spilled += size;
+        }
     }
 
-    if (toggle_memory_ && !write_qab_pno_ && std::max(memory_ccsd, memory_integrals) * sizeof(double) > 0.9 * memory_) {
-        outfile->Printf("  Total Required Memory is (still) more than 90%% of Available Memory!\n");
-        outfile->Printf("    Attempting to switch to disk IO for (Q_{ij}|a_{ij} b_{ij}) integrals...\n");
+    // Room to stage the largest disk-resident pair, if nothing else
+    size_t max_disk_pair = 0;
+    for (int ij = 0; ij < n_lmo_pairs; ++ij) {
+        size_t disk_pair = (qia_pno_on_disk_[ij] ? qov_pair[ij] : 0) + (qab_pno_on_disk_[ij] ? qvv_pair[ij] : 0);
+        max_disk_pair = std::max(max_disk_pair, disk_pair);
+    }
+    if (max_disk_pair > 0) {
+        pair_batch_memory_ = std::max(pair_batch_memory_, max_disk_pair);
+        memory_ccsd += 2 * pair_batch_memory_;
+    }
 
-        memory_ccsd -= qvv;
-        memory_integrals -= qvv;
-        write_qab_pno_ = true;
-        memory_changed = true;
-        qvv = 0L;
+    if (spill_target > 0) {
         outfile->Printf("    Required Memory Reduced to %.3f [GB]\n\n", std::max(memory_ccsd, memory_integrals) * DOUBLES_TO_GB);
     }
 
@@ -488,17 +558,31 @@ void DLPNOCCSD::estimate_memory() {
         outfile->Printf("    Using high memory PNO overlap algorithm... \n\n");
     }
 
-    if (write_qia_pno_) {
-        outfile->Printf("    Writing (Q_{ij}|m_{ij} a_{ij}) integrals to disk...\n\n");
-    } else {
-        outfile->Printf("    Storing (Q_{ij}|m_{ij} a_{ij}) integrals in RAM... \n\n");
-    }
+    // How many pair blocks of each kind ended up on disk
+    auto print_disk_pairs = [&](const std::vector<size_t>& pair_size, const std::vector<bool>& on_disk, const char* name) {
+        int npairs = 0, ndisk = 0;
+        size_t disk_size = 0;
+        for (int ij = 0; ij < n_lmo_pairs; ++ij) {
+            if (pair_size[ij] == 0) continue;
+            npairs++;
+            if (on_disk[ij]) {
+                ndisk++;
+                disk_size += pair_size[ij];
+            }
+        }
 
-    if (write_qab_pno_) {
-        outfile->Printf("    Writing (Q_{ij}|a_{ij} b_{ij}) integrals to disk...\n\n");
-    } else {
-        outfile->Printf("    Storing (Q_{ij}|a_{ij} b_{ij}) integrals in RAM... \n\n");
-    }
+        if (ndisk == 0) {
+            outfile->Printf("    Storing %s integrals in RAM... \n\n", name);
+        } else if (ndisk == npairs) {
+            outfile->Printf("    Writing %s integrals to disk...\n\n", name);
+        } else {
+            outfile->Printf("    Writing %d of %d %s pair blocks (%.3f [GB]) to disk...\n\n", ndisk, npairs, name,
+                            disk_size * DOUBLES_TO_GB);
+        }
+    };
+
+    print_disk_pairs(qov_pair, qia_pno_on_disk_, "(Q_{ij}|m_{ij} a_{ij})");
+    print_disk_pairs(qvv_pair, qab_pno_on_disk_, "(Q_{ij}|a_{ij} b_{ij})");
 }
 
 template<bool crude> std::vector<double> DLPNOCCSD::compute_pair_energies() {
@@ -867,7 +951,13 @@ std::vector<double> DLPNOCCSD::pno_lmp2_iterations() {
     outfile->Printf("    R_CONVERGENCE = %.2e\n\n", 0.01 * options_.get_double("R_CONVERGENCE"));
     outfile->Printf("                         Corr. Energy    Delta E     Max R     Time (s)\n");
 
+    // residuals are rebuilt in place every iteration, and the coupling products go through per-thread scratch
     std::vector<SharedMatrix> R_iajb(n_lmo_pairs);
+    for (int ij = 0; ij < n_lmo_pairs; ++ij) {
+        R_iajb[ij] = std::make_shared<Matrix>("Residual", n_pno_[ij], n_pno_[ij]);
+    }
+    PairArena arena;
+    const std::vector<int> pair_order = pairs_by_pno_size(n_pno_);
 
     int iteration = 1, max_iteration = options_.get_int("DLPNO_MAXITER");
     double e_curr = 0.0, e_prev = 0.0, r_curr = 0.0;
@@ -880,24 +970,28 @@ std::vector<double> DLPNOCCSD::pno_lmp2_iterations() {
 
         std::time_t time_start = std::time(nullptr);
 
-        // Calculate residuals from current amplitudes
+        // Calculate residuals from current amplitudes, largest PNO spaces first
 #pragma omp parallel for schedule(dynamic, 1)
-        for (int ij = 0; ij < n_lmo_pairs; ++ij) {
+        for (int ij_idx = 0; ij_idx < n_lmo_pairs; ++ij_idx) {
+            const int ij = pair_order[ij_idx];
             int i, j;
             std::tie(i, j) = ij_to_i_j_[ij];
 
             if (i > j) continue;
 
-            R_iajb[ij] = std::make_shared<Matrix>("Residual", n_pno_[ij], n_pno_[ij]);
+            const int npno = n_pno_[ij];
+            if (npno == 0) continue;
 
-            if (n_pno_[ij] == 0) continue;
+            double *Rp = R_iajb[ij]->get_pointer();
+            const double *Kp = K_iajb_[ij]->get_pointer();
+            const double *Tp = T_iajb_[ij]->get_pointer();
+            const double *ep = e_pno_[ij]->pointer();
+            const double f_ij = F_lmo_->get(i, i) + F_lmo_->get(j, j);
 
-            for (int a = 0; a < n_pno_[ij]; ++a) {
-                for (int b = 0; b < n_pno_[ij]; ++b) {
-                    R_iajb[ij]->set(a, b,
-                                    K_iajb_[ij]->get(a, b) +
-                                        (e_pno_[ij]->get(a) + e_pno_[ij]->get(b) - F_lmo_->get(i, i) - F_lmo_->get(j, j)) *
-                                            T_iajb_[ij]->get(a, b));
+            for (int a = 0; a < npno; ++a) {
+                for (int b = 0; b < npno; ++b) {
+                    const size_t ab = (size_t)a * npno + b;
+                    Rp[ab] = Kp[ab] + (ep[a] + ep[b] - f_ij) * Tp[ab];
                 }
             }
 
@@ -905,17 +999,15 @@ std::vector<double> DLPNOCCSD::pno_lmp2_iterations() {
                 int kj = i_j_to_ij_[k][j];
                 int ik = i_j_to_ij_[i][k];
 
-                if (kj != -1 && i != k && fabs(F_lmo_->get(i, k)) > options_.get_double("F_CUT") && n_pno_[kj] > 0) {
-                    auto S_ij_kj = S_pno_ij_kj[ij][k];
-                    auto temp = linalg::triplet(S_ij_kj, T_iajb_[kj], S_ij_kj, false, false, true);
-                    temp->scale(-1.0 * F_lmo_->get(i, k));
-                    R_iajb[ij]->add(temp);
+                if (kj != -1 && i != k && fabs(F_lmo_->get(i, k)) > F_CUT_MP2 && n_pno_[kj] > 0) {
+                    const Matrix &S_ij_kj = *S_pno_ij_kj[ij][k];
+                    triplet_add(-F_lmo_->get(i, k), S_ij_kj, false, *T_iajb_[kj], false, S_ij_kj, true, *R_iajb[ij],
+                                arena);
                 }
-                if (ik != -1 && j != k && fabs(F_lmo_->get(k, j)) > options_.get_double("F_CUT") && n_pno_[ik] > 0) {
-                    auto S_ij_ik = S_pno_ij_ik[ij][k];
-                    auto temp = linalg::triplet(S_ij_ik, T_iajb_[ik], S_ij_ik, false, false, true);
-                    temp->scale(-1.0 * F_lmo_->get(k, j));
-                    R_iajb[ij]->add(temp);
+                if (ik != -1 && j != k && fabs(F_lmo_->get(k, j)) > F_CUT_MP2 && n_pno_[ik] > 0) {
+                    const Matrix &S_ij_ik = *S_pno_ij_ik[ij][k];
+                    triplet_add(-F_lmo_->get(k, j), S_ij_ik, false, *T_iajb_[ik], false, S_ij_ik, true, *R_iajb[ij],
+                                arena);
                 }
             }
 
@@ -923,7 +1015,12 @@ std::vector<double> DLPNOCCSD::pno_lmp2_iterations() {
 
             if (i < j) {
                 int ji = ij_to_ji_[ij];
-                R_iajb[ji] = R_iajb[ij]->transpose();
+                double *Rtp = R_iajb[ji]->get_pointer();
+                for (int a = 0; a < npno; ++a) {
+                    for (int b = 0; b < npno; ++b) {
+                        Rtp[(size_t)b * npno + a] = Rp[(size_t)a * npno + b];
+                    }
+                }
                 R_iajb_rms[ji] = R_iajb_rms[ij];
             }
         }
@@ -1333,19 +1430,17 @@ void DLPNOCCSD::compute_pno_integrals() {
     // 3 virtual
     K_ivvv_.resize(n_lmo_pairs);
 
-    // DF integrals (only allocate if writing to RAM)
-    if (!write_qia_pno_) {
-        Qma_ij_.resize(n_lmo_pairs);
-    }
-    if (!write_qab_pno_) {
-        Qab_ij_.resize(n_lmo_pairs);
-    }
+    // DF integrals (pairs that go to disk are left empty)
+    Qma_ij_.resize(n_lmo_pairs);
+    Qab_ij_.resize(n_lmo_pairs);
 
     i_Qa_ij_.resize(n_lmo_pairs);
     i_Qk_ij_.resize(n_lmo_pairs);
 
     psio_->open(PSIF_DLPNO_QIA_PNO, PSIO_OPEN_NEW);
     psio_->open(PSIF_DLPNO_QAB_PNO, PSIO_OPEN_NEW);
+    qia_pno_file_ = std::make_unique<PairBlockFile>(psio_, PSIF_DLPNO_QIA_PNO, "QIA (PNO)", n_lmo_pairs, false);
+    qab_pno_file_ = std::make_unique<PairBlockFile>(psio_, PSIF_DLPNO_QAB_PNO, "QAB (PNO)", n_lmo_pairs, true);
 
     std::time_t time_start = std::time(nullptr);
     std::time_t time_lap = std::time(nullptr);
@@ -1373,11 +1468,12 @@ void DLPNOCCSD::compute_pno_integrals() {
             // For strong pairs, there are the non-projected integrals
             if (i_j_to_ij_strong_[i][j] != -1) {
 
-                std::vector<int> extended_pao_domain = lmopair_to_paos_[ij];
+                std::vector<int> extended_pao_domain = lmopair_to_paos_[ij].to_vector(), merge_buffer;
 
                 for (int k_ij = 0; k_ij < nlmo_ij; ++k_ij) {
                     int k = lmopair_to_lmos_[ij][k_ij];
-                    extended_pao_domain = merge_lists(extended_pao_domain, lmo_to_paos_[k]);
+                    merge_lists(extended_pao_domain, lmo_to_paos_[k], merge_buffer);
+                    extended_pao_domain.swap(merge_buffer);
                 }
 
                 const int npao_ext_ij = extended_pao_domain.size();
@@ -1443,51 +1539,56 @@ void DLPNOCCSD::compute_pno_integrals() {
 
         // Extended PAO domain of ij is formed from the union of PAOs
         // from all interacting k_ij (LMOs k such that ik AND kj form a valid pair)
-        std::vector<int> extended_pao_domain;
-        int npao_ext_ij;
-        
-        extended_pao_domain = lmopair_to_paos_[ij];
+        std::vector<int> extended_pao_domain = lmopair_to_paos_[ij].to_vector(), merge_buffer;
         for (int k_ij = 0; k_ij < nlmo_ij; ++k_ij) {
             int k = lmopair_to_lmos_[ij][k_ij];
-            extended_pao_domain = merge_lists(extended_pao_domain, lmo_to_paos_[k]);
+            merge_lists(extended_pao_domain, lmo_to_paos_[k], merge_buffer);
+            extended_pao_domain.swap(merge_buffer);
         }
-        npao_ext_ij = extended_pao_domain.size();
+        const int npao_ext_ij = extended_pao_domain.size();
 
         if (thread == 0) timer_on("DLPNO-CCSD: Setup Integrals");
 
+        // Gather buffers, reused for every auxiliary function of the pair
+        std::vector<int> i_slice(1), j_slice(1), sparse_lmo_list, sparse_pao_list;
+        auto q_o_row = std::make_shared<Matrix>(1, nlmo_ij);
+        auto q_v_row = std::make_shared<Matrix>(1, npao_ij);
+        auto q_ov_pao = std::make_shared<Matrix>(nlmo_ij, npao_ij);
+        auto q_vv_tmp = std::make_shared<Matrix>(npao_ij, npao_ij);
+
         for (int q_ij = 0; q_ij < naux_ij; q_ij++) {
             const int q = lmopair_to_ribfs_[ij][q_ij];
             const int centerq = ribasis_->function_to_center(q);
 
             const int i_sparse = riatom_to_lmos_ext_dense_[centerq][i];
             const int j_sparse = riatom_to_lmos_ext_dense_[centerq][j];
-            const std::vector<int> i_slice(1, i_sparse);
-            const std::vector<int> j_slice(1, j_sparse);
+            i_slice[0] = i_sparse;
+            j_slice[0] = j_sparse;
 
-            const auto sparse_lmo_list = index_list(riatom_to_lmos_ext_[centerq], lmopair_to_lmos_[ij]);
-            const auto sparse_pao_list = index_list(riatom_to_paos_ext_[centerq], lmopair_to_paos_[ij]);
+            index_list(riatom_to_lmos_ext_[centerq], lmopair_to_lmos_[ij], sparse_lmo_list);
+            index_list(riatom_to_paos_ext_[centerq], lmopair_to_paos_[ij], sparse_pao_list);
 
             q_pair->set(q_ij, 0, (*qij_[q])(i_sparse, j_sparse));
             
-            auto q_io_tmp = submatrix_rows_and_cols(*qij_[q], i_slice, sparse_lmo_list);
-            ::memcpy(&(*q_io)(q_ij, 0), &(*q_io_tmp)(0,0), nlmo_ij * sizeof(double));
+            submatrix_rows_and_cols(*qij_[q], i_slice, sparse_lmo_list, *q_o_row);
+            ::memcpy(&(*q_io)(q_ij, 0), &(*q_o_row)(0,0), nlmo_ij * sizeof(double));
 
-            auto q_jo_tmp = submatrix_rows_and_cols(*qij_[q], j_slice, sparse_lmo_list);
-            ::memcpy(&(*q_jo)(q_ij, 0), &(*q_jo_tmp)(0,0), nlmo_ij * sizeof(double));
+            submatrix_rows_and_cols(*qij_[q], j_slice, sparse_lmo_list, *q_o_row);
+            ::memcpy(&(*q_jo)(q_ij, 0), &(*q_o_row)(0,0), nlmo_ij * sizeof(double));
 
-            auto q_iv_tmp = submatrix_rows_and_cols(*qia_[q], i_slice, sparse_pao_list);
-            q_iv_tmp = linalg::doublet(q_iv_tmp, X_pno_[ij], false, false);
+            submatrix_rows_and_cols(*qia_[q], i_slice, sparse_pao_list, *q_v_row);
+            auto q_iv_tmp = linalg::doublet(q_v_row, X_pno_[ij], false, false);
             ::memcpy(&(*q_iv)(q_ij, 0), &(*q_iv_tmp)(0,0), npno_ij * sizeof(double));
 
-            auto q_jv_tmp = submatrix_rows_and_cols(*qia_[q], j_slice, sparse_pao_list);
-            q_jv_tmp = linalg::doublet(q_jv_tmp, X_pno_[ij], false, false);
+            submatrix_rows_and_cols(*qia_[q], j_slice, sparse_pao_list, *q_v_row);
+            auto q_jv_tmp = linalg::doublet(q_v_row, X_pno_[ij], false, false);
             ::memcpy(&(*q_jv)(q_ij, 0), &(*q_jv_tmp)(0,0), npno_ij * sizeof(double));
 
-            auto q_ov_tmp = submatrix_rows_and_cols(*qia_[q], sparse_lmo_list, sparse_pao_list);
-            q_ov_tmp = linalg::doublet(q_ov_tmp, X_pno_[ij], false, false);
+            submatrix_rows_and_cols(*qia_[q], sparse_lmo_list, sparse_pao_list, *q_ov_pao);
+            auto q_ov_tmp = linalg::doublet(q_ov_pao, X_pno_[ij], false, false);
             ::memcpy(&(*q_ov)(q_ij, 0), &(*q_ov_tmp)(0,0), nlmo_ij * npno_ij * sizeof(double));
 
-            SharedMatrix q_vv_tmp = std::make_shared<Matrix>(npao_ij, npao_ij);
+            q_vv_tmp->zero();
             
             for (int u_ij = 0; u_ij < npao_ij; ++u_ij) {
                 int u = lmopair_to_paos_[ij][u_ij];
@@ -1499,8 +1600,8 @@ void DLPNOCCSD::compute_pno_integrals() {
                 }
             }
             
-            q_vv_tmp = linalg::triplet(X_pno_[ij], q_vv_tmp, X_pno_[ij], true, false, false);
-            ::memcpy(&(*q_vv)(q_ij, 0), &(*q_vv_tmp)(0,0), npno_ij * npno_ij * sizeof(double));
+            auto q_vv_pno = linalg::triplet(X_pno_[ij], q_vv_tmp, X_pno_[ij], true, false, false);
+            ::memcpy(&(*q_vv)(q_ij, 0), &(*q_vv_pno)(0,0), npno_ij * npno_ij * sizeof(double));
         }
 
         auto A_solve = submatrix_rows_and_cols(*full_metric_, lmopair_to_ribfs_[ij], lmopair_to_ribfs_[ij]);
@@ -1547,11 +1648,11 @@ void DLPNOCCSD::compute_pno_integrals() {
             SharedMatrix q_vv_partial = std::make_shared<Matrix>("q_vv_partial", naux_ij, npno_ij * npao_ext_ij);
 
             // Compute (i k_{ij} | a_{ij} b_{kj}) integrals through density-fitting
+            auto q_cd_temp = std::make_shared<Matrix>(npao_ij, npao_ext_ij);
             for (int q_ij = 0; q_ij < naux_ij; q_ij++) {
                 const int q = lmopair_to_ribfs_[ij][q_ij];
                 const int centerq = ribasis_->function_to_center(q);
                 
-                auto q_cd_temp = std::make_shared<Matrix>(npao_ij, npao_ext_ij);
                 q_cd_temp->zero();
                 for (int u_ij = 0; u_ij < npao_ij; ++u_ij) {
                     int u = lmopair_to_paos_[ij][u_ij];
@@ -1562,8 +1663,8 @@ void DLPNOCCSD::compute_pno_integrals() {
                         q_cd_temp->set(u_ij, v_ij, qab_[q]->get(uv_idx, 0));
                     }
                 }
-                q_cd_temp = linalg::doublet(X_pno_[ij], q_cd_temp, true, false);
-                ::memcpy(&(*q_vv_partial)(q_ij, 0), q_cd_temp->get_pointer(), npno_ij * npao_ext_ij * sizeof(double));
+                auto q_cd_pno = linalg::doublet(X_pno_[ij], q_cd_temp, true, false);
+                ::memcpy(&(*q_vv_partial)(q_ij, 0), q_cd_pno->get_pointer(), npno_ij * npao_ext_ij * sizeof(double));
             }
 
             SharedMatrix K_iovv_partial = linalg::doublet(q_io_clone, q_vv_partial, true, false);
@@ -1598,15 +1699,16 @@ void DLPNOCCSD::compute_pno_integrals() {
             SharedMatrix q_ov_ext = std::make_shared<Matrix>("q_ov_ext", naux_ij, nlmo_ij * npao_ext_ij);
 
             // Compute (i k_{ij} | a_{ij} b_{kj}) integrals through density-fitting
+            auto q_ov_ext_tmp = std::make_shared<Matrix>(nlmo_ij, npao_ext_ij);
 
             for (int q_ij = 0; q_ij < naux_ij; q_ij++) {
                 const int q = lmopair_to_ribfs_[ij][q_ij];
                 const int centerq = ribasis_->function_to_center(q);
 
-                const auto sparse_lmo_list = index_list(riatom_to_lmos_ext_[centerq], lmopair_to_lmos_[ij]);
-                const auto sparse_pao_list = index_list(riatom_to_paos_ext_[centerq], extended_pao_domain);
+                index_list(riatom_to_lmos_ext_[centerq], lmopair_to_lmos_[ij], sparse_lmo_list);
+                index_list(riatom_to_paos_ext_[centerq], extended_pao_domain, sparse_pao_list);
 
-                auto q_ov_ext_tmp = submatrix_rows_and_cols(*qia_[q], sparse_lmo_list, sparse_pao_list);
+                submatrix_rows_and_cols(*qia_[q], sparse_lmo_list, sparse_pao_list, *q_ov_ext_tmp);
                 ::memcpy(&(*q_ov_ext)(q_ij, 0), q_ov_ext_tmp->get_pointer(), nlmo_ij * npao_ext_ij * sizeof(double));
             }
 
@@ -1676,7 +1778,7 @@ void DLPNOCCSD::compute_pno_integrals() {
         }
         
         if (is_strong_pair) {
-            if (!write_qia_pno_) {
+            if (!qia_pno_on_disk_[ij]) {
                 Qma_ij_[ij].resize(naux_ij);
                 for (int q_ij = 0; q_ij < naux_ij; ++q_ij) {
                     // Save transformed (Q_ij | m_ij a_ij) integrals
@@ -1684,16 +1786,12 @@ void DLPNOCCSD::compute_pno_integrals() {
                     ::memcpy(&(*Qma_ij_[ij][q_ij])(0, 0), &(*q_ov)(q_ij,0), nlmo_ij * npno_ij * sizeof(double));
                 }
             } else {
-                std::stringstream toc_entry;
-                toc_entry << "QIA (PNO) " << ij;
-                q_ov->set_name(toc_entry.str());
-    #pragma omp critical
-                q_ov->save(psio_, PSIF_DLPNO_QIA_PNO, psi::Matrix::SubBlocks);
+                qia_pno_file_->write(ij, *q_ov);
             }
         }
 
         if (is_strong_pair) {
-            if (!write_qab_pno_) {
+            if (!qab_pno_on_disk_[ij]) {
                 Qab_ij_[ij].resize(naux_ij);
                 for (int q_ij = 0; q_ij < naux_ij; ++q_ij) {
                     // Save transformed (Q_ij | a_ij b_ij) integrals
@@ -1701,11 +1799,7 @@ void DLPNOCCSD::compute_pno_integrals() {
                     ::memcpy(&(*Qab_ij_[ij][q_ij])(0, 0), &(*q_vv)(q_ij,0), npno_ij * npno_ij * sizeof(double));
                 }
             } else {
-                std::stringstream toc_entry;
-                toc_entry << "QAB (PNO) " << ij;
-                q_vv->set_name(toc_entry.str());
-    #pragma omp critical
-                q_vv->save(psio_, PSIF_DLPNO_QAB_PNO, psi::Matrix::ThreeIndexLowerTriangle);
+                qab_pno_file_->write(ij, *q_vv);
             }
         }
 
@@ -1751,7 +1845,7 @@ void DLPNOCCSD::t1_ints() {
         int naux_ij = lmopair_to_ribfs_[ij].size();
         int npno_ij = n_pno_[ij];
         int pair_idx = (i > j) ? ij_to_ji_[ij] : ij;
-        int i_ij = lmopair_to_lmos_dense_[ij][i], j_ij = lmopair_to_lmos_dense_[ij][j];
+        auto [i_ij, j_ij] = lmopair_to_i_j_pos_[ij];
 
         // These are only needed to be computed over strong pairs
         if (i_j_to_ij_strong_[i][j] == -1) continue;
@@ -1899,7 +1993,7 @@ void DLPNOCCSD::t1_fock() {
 #pragma omp parallel for schedule(dynamic, 1)
     for (int ij = 0; ij < n_lmo_pairs; ++ij) {
         auto &[i, j] = ij_to_i_j_[ij];
-        int i_ij = lmopair_to_lmos_dense_[ij][i], j_ij = lmopair_to_lmos_dense_[ij][j];
+        auto [i_ij, j_ij] = lmopair_to_i_j_pos_[ij];
         int ji = ij_to_ji_[ij], jj = i_j_to_ij_[j][j];
         int pair_idx = (i > j) ? ji : ij;
 
@@ -1909,7 +2003,7 @@ void DLPNOCCSD::t1_fock() {
 
         // Fully dress Fkj matrices (Jiang Eq. 94)
         // \widetilde{F}_{ij} = \overline{F}_{ij} (initialized earlier) + \overline{F}_{ic} T_{j}^{c}
-        int i_jj = lmopair_to_lmos_dense_[jj][i];
+        int i_jj = lmopair_to_lmos_[jj].find(i);
         for (int a_jj = 0; a_jj < n_pno_[jj]; ++a_jj) {
             (*Fkj_)(i, j) += (*Fkc_bar[jj])(i_jj, a_jj) * (*T_ia_[j])(a_jj, 0);
         }
@@ -1980,7 +2074,7 @@ std::vector<SharedMatrix> DLPNOCCSD::compute_beta() {
         int naux_ij = lmopair_to_ribfs_[ij].size();
         int nlmo_ij = lmopair_to_lmos_[ij].size();
         int pair_idx = (i > j) ? ji : ij;
-        int i_ij = lmopair_to_lmos_dense_[ij][i], j_ij = lmopair_to_lmos_dense_[ij][j];
+        auto [i_ij, j_ij] = lmopair_to_i_j_pos_[ij];
 
         // Jiang Eq. 82a
         beta[ij] = linalg::doublet(i_Qk_t1_[ij], i_Qk_t1_[ji], true, false); // (Q, k) (Q, l) -> (k, l)
@@ -2016,7 +2110,7 @@ std::vector<SharedMatrix> DLPNOCCSD::compute_gamma() {
         int naux_ki = lmopair_to_ribfs_[ki].size();
         int nlmo_ki = lmopair_to_lmos_[ki].size();
         int npno_ki = n_pno_[ki];
-        int k_ki = lmopair_to_lmos_dense_[ki][k], i_ki = lmopair_to_lmos_dense_[ki][i];
+        auto [k_ki, i_ki] = lmopair_to_i_j_pos_[ki];
         int pair_idx = (k > i) ? ij_to_ji_[ki] : ki;
 
         gamma[ki] = std::make_shared<Matrix>(npno_ki, npno_ki);
@@ -2087,7 +2181,7 @@ std::vector<SharedMatrix> DLPNOCCSD::compute_delta() {
         int naux_ik = lmopair_to_ribfs_[ik].size();
         int nlmo_ik = lmopair_to_lmos_[ik].size();
         int npno_ik = n_pno_[ik];
-        int i_ik = lmopair_to_lmos_dense_[ik][i], k_ik = lmopair_to_lmos_dense_[ik][k];
+        auto [i_ik, k_ik] = lmopair_to_i_j_pos_[ik];
         int pair_idx = (i > k) ? ki : ik;
 
         delta[ik] = std::make_shared<Matrix>(npno_ik, npno_ik);
@@ -2225,7 +2319,7 @@ void DLPNOCCSD::compute_R_ia(std::vector<SharedMatrix>& R_ia, std::vector<std::v
     for (int ik = 0; ik < n_lmo_pairs; ++ik) {
         auto &[i, k] = ij_to_i_j_[ik];
         int ki = ij_to_ji_[ik];
-        int k_ki = lmopair_to_lmos_dense_[ki][k]; // Grabs the index of k within domain ki
+        int k_ki = lmopair_to_i_j_pos_[ki].first; // Grabs the index of k within domain ki
         int pair_idx = (i > k) ? ki : ik;
 
         int nlmo_ik = lmopair_to_lmos_[ik].size();
@@ -2237,7 +2331,7 @@ void DLPNOCCSD::compute_R_ia(std::vector<SharedMatrix>& R_ia, std::vector<std::v
         thread = omp_get_thread_num();
 #endif
 
-        int i_ik = lmopair_to_lmos_dense_[ik][i], k_ik = lmopair_to_lmos_dense_[ik][k];
+        auto [i_ik, k_ik] = lmopair_to_i_j_pos_[ik];
         std::vector<int> k_ik_slice = std::vector<int>(1, k_ik);
         int ii = i_j_to_ij_[i][i];
         
@@ -2281,7 +2375,7 @@ void DLPNOCCSD::compute_R_ia(std::vector<SharedMatrix>& R_ia, std::vector<std::v
         int nlmo_kl = lmopair_to_lmos_[kl].size();
         int npno_kl = n_pno_[kl];
         int pair_idx = (k > l) ? ij_to_ji_[kl] : kl;
-        int k_kl = lmopair_to_lmos_dense_[kl][k], l_kl = lmopair_to_lmos_dense_[kl][l];
+        auto [k_kl, l_kl] = lmopair_to_i_j_pos_[kl];
 
         int thread = 0;
 #ifdef _OPENMP
@@ -2394,172 +2488,189 @@ void DLPNOCCSD::compute_R_iajb(std::vector<SharedMatrix>& R_iajb, std::vector<Sh
         ij_sorted_by_cost[ij_idx] = ij_cost_tuple[ij_idx].first;
     }
 
-    // Compute residual for doubles amplitude
+    // Products of the pair blocks go through per-thread scratch rather than temporary matrices
+    PairArena arena;
+
+    // Compute residual for doubles amplitude, streaming disk-resident DF integrals in batches of pairs
+    const auto batches = pair_batches(ij_sorted_by_cost);
+    for (int batch = 0; batch < batches.size(); ++batch) {
+        const int batch_start = batches[batch].first, batch_stop = batches[batch].second;
+        stage_pno_integrals(ij_sorted_by_cost, batch_start, batch_stop);
+        // The next batch is read while this one is worked on
+        if (batch + 1 < batches.size()) {
+            prefetch_pno_integrals(ij_sorted_by_cost, batches[batch + 1].first, batches[batch + 1].second);
+        }
+
 #pragma omp parallel for schedule(dynamic, 1)
-    for (int ij_idx = 0; ij_idx < n_lmo_pairs; ++ij_idx) {
-        int ij = ij_sorted_by_cost[ij_idx];
+        for (int ij_idx = batch_start; ij_idx < batch_stop; ++ij_idx) {
+            int ij = ij_sorted_by_cost[ij_idx];
 
-        auto &[i, j] = ij_to_i_j_[ij];
-        bool is_weak_pair = (i_j_to_ij_strong_[i][j] == -1);
-        int ji = ij_to_ji_[ij];
+            auto &[i, j] = ij_to_i_j_[ij];
+            bool is_weak_pair = (i_j_to_ij_strong_[i][j] == -1);
+            int ji = ij_to_ji_[ij];
 
-        int nlmo_ij = lmopair_to_lmos_[ij].size();
-        int naux_ij = lmopair_to_ribfs_[ij].size();
-        int npno_ij = n_pno_[ij];
+            int nlmo_ij = lmopair_to_lmos_[ij].size();
+            int naux_ij = lmopair_to_ribfs_[ij].size();
+            int npno_ij = n_pno_[ij];
 
-        // Skip if this pair is a "weak pair"
-        if (is_weak_pair) continue;
+            // Skip if this pair is a "weak pair"
+            if (is_weak_pair) continue;
 
-        int pair_idx = (i > j) ? ji : ij;
+            int pair_idx = (i > j) ? ji : ij;
+
+            if (i <= j) {
+                // R_{ij}^{ab} += \widetilde{B}^{Q}_{ai} \widetilde{B}^{Q}_{bj} (Jiang Eq. 75)
+                auto K_ij = linalg::doublet(i_Qa_t1_[ij], i_Qa_t1_[ji], true, false); // (Q, a) (Q, b) -> (a, b)
+                R_iajb[ij]->add(K_ij);
+                if (i != j) R_iajb[ji]->add(K_ij->transpose());
 
-        if (i <= j) {
-            // R_{ij}^{ab} += \widetilde{B}^{Q}_{ai} \widetilde{B}^{Q}_{bj} (Jiang Eq. 75)
-            auto K_ij = linalg::doublet(i_Qa_t1_[ij], i_Qa_t1_[ji], true, false); // (Q, a) (Q, b) -> (a, b)
-            R_iajb[ij]->add(K_ij);
-            if (i != j) R_iajb[ji]->add(K_ij->transpose());
-
-            // A_{ij}^{ab} = \widetilde{B}^{Q}_{ac} * t_{ij}^{cd} * \widetilde{B}^{Q}_{bd} (Jiang Eq. 76)
-            auto A_ij = std::make_shared<Matrix>(npno_ij, npno_ij);
-            A_ij->zero();
-
-            auto qma_ij = QIA_PNO(ij); // naux_ij * (nlmo_ij, npno_ij)
-            auto qab_ij = QAB_PNO(ij); // naux_ij * (npno_ij, npno_ij)
-            for (int q_ij = 0; q_ij < naux_ij; ++q_ij) {
-                // This performs the T1-dressing of Qab on the fly, as this intermeidate is only used once
-                // \widetilde{B}^{Q}_{ab} = B^{Q}_{ab} - t_{k}^{a} B^{Q}_{kb} (Jiang Eq. 93)
-                auto Qab_t1 = qab_ij[q_ij]->clone(); // (a, b)
-                Qab_t1->subtract(linalg::doublet(T_n_ij_[ij], qma_ij[q_ij], true, false)); // (k, a) (k, b) -> (a, b)
-                
                 // A_{ij}^{ab} = \widetilde{B}^{Q}_{ac} * t_{ij}^{cd} * \widetilde{B}^{Q}_{bd} (Jiang Eq. 76)
-                A_ij->add(linalg::triplet(Qab_t1, T_iajb_[ij], Qab_t1, false, false, true)); // (a, c) (c, d) (b, d)
-            } // end q_ij
-            R_iajb[ij]->add(A_ij);
-            if (i != j) R_iajb[ji]->add(A_ij->transpose());
-
-            // This intermediate is computed if the "semi-direct" algorithm is used for the PNO overlap matrices
-            // The rows of this intermediate contains an extended PAO domain of ij, while the columns are transformed
-            // to the PNO space of ij
-            SharedMatrix S_ij;
-            std::vector<int> pair_ext_domain;
-            if (low_memory_overlap_) {
+                auto A_ij = std::make_shared<Matrix>(npno_ij, npno_ij);
+                A_ij->zero();
+
+                auto qma_ij = QIA_PNO(ij); // naux_ij * (nlmo_ij, npno_ij)
+                auto qab_ij = QAB_PNO(ij); // naux_ij * (npno_ij, npno_ij)
+                auto Qab_t1 = std::make_shared<Matrix>(npno_ij, npno_ij);
+                for (int q_ij = 0; q_ij < naux_ij; ++q_ij) {
+                    // This performs the T1-dressing of Qab on the fly, as this intermeidate is only used once
+                    // \widetilde{B}^{Q}_{ab} = B^{Q}_{ab} - t_{k}^{a} B^{Q}_{kb} (Jiang Eq. 93)
+                    Qab_t1->copy(qab_ij[q_ij]); // (a, b)
+                    doublet_add(-1.0, *T_n_ij_[ij], true, *qma_ij[q_ij], false, *Qab_t1); // (k, a) (k, b) -> (a, b)
+                
+                    // A_{ij}^{ab} = \widetilde{B}^{Q}_{ac} * t_{ij}^{cd} * \widetilde{B}^{Q}_{bd} (Jiang Eq. 76)
+                    // (a, c) (c, d) (b, d)
+                    triplet_add(1.0, *Qab_t1, false, *T_iajb_[ij], false, *Qab_t1, true, *A_ij, arena);
+                } // end q_ij
+                R_iajb[ij]->add(A_ij);
+                if (i != j) R_iajb[ji]->add(A_ij->transpose());
+
+                // This intermediate is computed if the "semi-direct" algorithm is used for the PNO overlap matrices
+                // The rows of this intermediate contains an extended PAO domain of ij, while the columns are transformed
+                // to the PNO space of ij
+                SharedMatrix S_ij;
+                std::vector<int> pair_ext_domain, merge_buffer;
+                if (low_memory_overlap_) {
+                    for (int k_ij = 0; k_ij < nlmo_ij; ++k_ij) {
+                        int k = lmopair_to_lmos_[ij][k_ij];
+                        for (int l_ij = 0; l_ij < nlmo_ij; ++l_ij) {
+                            int l = lmopair_to_lmos_[ij][l_ij];
+                            int kl = i_j_to_ij_[k][l];
+                            if (kl == -1 || n_pno_[kl] == 0) continue;
+                            merge_lists(pair_ext_domain, lmopair_to_paos_[kl], merge_buffer);
+                            pair_ext_domain.swap(merge_buffer);
+                        } // end k
+                    } // end l
+                    S_ij = submatrix_rows_and_cols(*S_pao_, pair_ext_domain, lmopair_to_paos_[ij]);
+                    S_ij = linalg::doublet(S_ij, X_pno_[ij], false, false);
+                } // end if
+
+                // => These two intermediates involve the expensive S(a_{kl}, a_{ij}) PNO projection matrices
+
+                // B_{ij}^{ab} = t_{kl}^{ab} * \beta_{ij}^{kl} (Jiang Eq. 77)
+                auto B_ij = std::make_shared<Matrix>(npno_ij, npno_ij);
+                B_ij->zero();
+            
+                // F_{bc}'' = F_{bc}' - u_{kl}^{bd} K_{kl}^{cd} (Jiang Eq. 85)
+                auto F_bc_double_tilde = Fab_[ij]->clone();
+
                 for (int k_ij = 0; k_ij < nlmo_ij; ++k_ij) {
                     int k = lmopair_to_lmos_[ij][k_ij];
                     for (int l_ij = 0; l_ij < nlmo_ij; ++l_ij) {
                         int l = lmopair_to_lmos_[ij][l_ij];
                         int kl = i_j_to_ij_[k][l];
                         if (kl == -1 || n_pno_[kl] == 0) continue;
-                        pair_ext_domain = merge_lists(pair_ext_domain, lmopair_to_paos_[kl]);
-                    } // end k
-                } // end l
-                S_ij = submatrix_rows_and_cols(*S_pao_, pair_ext_domain, lmopair_to_paos_[ij]);
-                S_ij = linalg::doublet(S_ij, X_pno_[ij], false, false);
-            } // end if
-
-            // => These two intermediates involve the expensive S(a_{kl}, a_{ij}) PNO projection matrices
 
-            // B_{ij}^{ab} = t_{kl}^{ab} * \beta_{ij}^{kl} (Jiang Eq. 77)
-            auto B_ij = std::make_shared<Matrix>(npno_ij, npno_ij);
-            B_ij->zero();
-            
-            // F_{bc}'' = F_{bc}' - u_{kl}^{bd} K_{kl}^{cd} (Jiang Eq. 85)
-            auto F_bc_double_tilde = Fab_[ij]->clone();
+                        SharedMatrix S_kl_ij = (low_memory_overlap_) ? 
+                                linalg::doublet(X_pno_[kl], submatrix_rows(*S_ij, index_list(pair_ext_domain, lmopair_to_paos_[kl])), true, false) : S_PNO(kl, ij);
+
+                        // B contributions
+                        // \beta_{ij}^{kl} T_{kl}^{ab}, (a_{kl}, b_{kl}) -> (a_{ij}, b_{ij})
+                        triplet_add((*beta[ij])(k_ij, l_ij), *S_kl_ij, true, *T_iajb_[kl], false, *S_kl_ij, false, *B_ij,
+                                    arena);
+
+                        // F_double_tilde contributions
+                        auto E_temp = linalg::doublet(Tt_iajb_[kl], K_iajb_[kl], false, true); // (b, d) (c, d) -> (b, c)
+
+                        // (b_{kl}, c_{kl}) -> (b_{ij}, c_{ij})
+                        triplet_add(-1.0, *S_kl_ij, true, *E_temp, false, *S_kl_ij, false, *F_bc_double_tilde, arena);
+                    } // end l_ij
+                } // end k_ij
+                R_iajb[ij]->add(B_ij);
+                if (i != j) R_iajb[ji]->add(B_ij->transpose());
+
+                // E_{ij}^{ab} = t_{ij}^{ac} F_{bc}'' (Jiang Eq. 80)
+                // For the residual contribution, this needs to be symmetrized
+                // P_{ij}^{ab} t_{ij}^{ac} F_{bc}'' => t_{ij}^{ac} F_{bc}'' + F_{ac}'' t_{ij}^{cb}
+                auto E_ij = std::make_shared<Matrix>(npno_ij, npno_ij);
+                doublet_add(1.0, *T_iajb_[ij], false, *F_bc_double_tilde, true, *E_ij);
+                doublet_add(1.0, *F_bc_double_tilde, false, *T_iajb_[ij], false, *E_ij);
+
+                R_iajb[ij]->add(E_ij);
+                if (i != j) R_iajb[ji]->add(E_ij->transpose());
+            } // end if
+        
+            // C_{ij}^{ab} = [-\gamma_{ki}^{ac} - (i k | a_{ij} c_{kj})] t_{kj}^{bc} (Jiang Eq. 78)
+            auto C_ij = std::make_shared<Matrix>(npno_ij, npno_ij);
+            C_ij->zero();
 
             for (int k_ij = 0; k_ij < nlmo_ij; ++k_ij) {
                 int k = lmopair_to_lmos_[ij][k_ij];
-                for (int l_ij = 0; l_ij < nlmo_ij; ++l_ij) {
-                    int l = lmopair_to_lmos_[ij][l_ij];
-                    int kl = i_j_to_ij_[k][l];
-                    if (kl == -1 || n_pno_[kl] == 0) continue;
-
-                    SharedMatrix S_kl_ij = (low_memory_overlap_) ? 
-                            linalg::doublet(X_pno_[kl], submatrix_rows(*S_ij, index_list(pair_ext_domain, lmopair_to_paos_[kl])), true, false) : S_PNO(kl, ij);
-
-                    // B contributions
-                    // (a_{kl}, b_{kl}) -> (a_{ij}, b_{ij})
-                    auto T_kl = linalg::triplet(S_kl_ij, T_iajb_[kl], S_kl_ij, true, false, false);
-                    // \beta_{ij}^{kl} T_{kl}^{ab}
-                    T_kl->scale((*beta[ij])(k_ij, l_ij));
-                    B_ij->add(T_kl);
-
-                    // F_double_tilde contributions
-                    auto E_temp = linalg::doublet(Tt_iajb_[kl], K_iajb_[kl], false, true); // (b, d) (c, d) -> (b, c)
-
-                    // (b_{kl}, c_{kl}) -> (b_{ij}, c_{ij})
-                    F_bc_double_tilde->subtract(linalg::triplet(S_kl_ij, E_temp, S_kl_ij, true, false, false));
-                } // end l_ij
-            } // end k_ij
-            R_iajb[ij]->add(B_ij);
-            if (i != j) R_iajb[ji]->add(B_ij->transpose());
-
-            // E_{ij}^{ab} = t_{ij}^{ac} F_{bc}'' (Jiang Eq. 80)
-            // For the residual contribution, this needs to be symmetrized
-            // P_{ij}^{ab} t_{ij}^{ac} F_{bc}'' => t_{ij}^{ac} F_{bc}'' + F_{ac}'' t_{ij}^{cb}
-            auto E_ij = linalg::doublet(T_iajb_[ij], F_bc_double_tilde, false, true);
-            E_ij->add(linalg::doublet(F_bc_double_tilde, T_iajb_[ij], false, false));
-
-            R_iajb[ij]->add(E_ij);
-            if (i != j) R_iajb[ji]->add(E_ij->transpose());
-        } // end if
-        
-        // C_{ij}^{ab} = [-\gamma_{ki}^{ac} - (i k | a_{ij} c_{kj})] t_{kj}^{bc} (Jiang Eq. 78)
-        auto C_ij = std::make_shared<Matrix>(npno_ij, npno_ij);
-        C_ij->zero();
-
-        for (int k_ij = 0; k_ij < nlmo_ij; ++k_ij) {
-            int k = lmopair_to_lmos_[ij][k_ij];
-            int ki = i_j_to_ij_[k][i], kj = i_j_to_ij_[k][j];
+                int ki = i_j_to_ij_[k][i], kj = i_j_to_ij_[k][j];
             
-            auto gamma_total = J_ikac_non_proj_[ij][k_ij]->clone(); // (i k | a_{ij} c_{kj})
-            gamma_total->add(linalg::triplet(S_PNO(ij, ki), gamma[ki], S_PNO(ki, kj))); // (a_{ki}, c_{ki}) -> (a_{ij}, c_{kj})
+                auto gamma_total = J_ikac_non_proj_[ij][k_ij]->clone(); // (i k | a_{ij} c_{kj})
+                // (a_{ki}, c_{ki}) -> (a_{ij}, c_{kj})
+                triplet_add(1.0, *S_PNO(ij, ki), false, *gamma[ki], false, *S_PNO(ki, kj), false, *gamma_total, arena);
 
-            // (a_{ij}, c_{kj}) (b_{kj}, c_{kj}) (b_{kj}, b_{ij}) -> (a_{ij}, b_{ij})
-            C_ij->subtract(linalg::triplet(gamma_total, T_iajb_[kj], S_PNO(kj, ij), false, true, false));
-        }
-        // Add all the C terms to the non-symmetrized R buffer
-        // P_{ij}^{ab} [0.5 C_{ij}^{ab} + C_{ij}^{ba}] (Jiang Eq. 19)
-        auto C_ij_total = C_ij->clone();
-        C_ij_total->scale(0.5);
-        C_ij_total->add(C_ij->transpose());
-        Rn_iajb[ij]->add(C_ij_total);
+                // (a_{ij}, c_{kj}) (b_{kj}, c_{kj}) (b_{kj}, b_{ij}) -> (a_{ij}, b_{ij})
+                triplet_add(-1.0, *gamma_total, false, *T_iajb_[kj], true, *S_PNO(kj, ij), false, *C_ij, arena);
+            }
+            // Add all the C terms to the non-symmetrized R buffer
+            // P_{ij}^{ab} [0.5 C_{ij}^{ab} + C_{ij}^{ba}] (Jiang Eq. 19)
+            auto C_ij_total = C_ij->clone();
+            C_ij_total->scale(0.5);
+            C_ij_total->add(C_ij->transpose());
+            Rn_iajb[ij]->add(C_ij_total);
 
-        // D_{ij}^{ab} = 0.5 [\delta_{ik}^{ac} + 2 (i a_{ij} | k c_{jk}) - (i k | a_{ij} c_{jk})] u_{jk}^{bc}  (Jiang Eq. 79)
-        auto D_ij = std::make_shared<Matrix>(npno_ij, npno_ij);
-        D_ij->zero();
+            // D_{ij}^{ab} = 0.5 [\delta_{ik}^{ac} + 2 (i a_{ij} | k c_{jk}) - (i k | a_{ij} c_{jk})] u_{jk}^{bc}  (Jiang Eq. 79)
+            auto D_ij = std::make_shared<Matrix>(npno_ij, npno_ij);
+            D_ij->zero();
 
-        for (int k_ij = 0; k_ij < nlmo_ij; ++k_ij) {
-            int k = lmopair_to_lmos_[ij][k_ij];
-            int ik = i_j_to_ij_[i][k], jk = i_j_to_ij_[j][k];
-            int j_ik = lmopair_to_lmos_dense_[ik][j];
+            for (int k_ij = 0; k_ij < nlmo_ij; ++k_ij) {
+                int k = lmopair_to_lmos_[ij][k_ij];
+                int ik = i_j_to_ij_[i][k], jk = i_j_to_ij_[j][k];
 
-            // 2 (i a_{ij} | k c_{jk}) - (i k | a_{ij} c_{jk})
-            auto delta_total = K_iakc_non_proj_[ij][k_ij]->clone();
-            delta_total->scale(2.0);
-            delta_total->subtract(J_ikac_non_proj_[ij][k_ij]);
+                // 2 (i a_{ij} | k c_{jk}) - (i k | a_{ij} c_{jk})
+                auto delta_total = K_iakc_non_proj_[ij][k_ij]->clone();
+                delta_total->scale(2.0);
+                delta_total->subtract(J_ikac_non_proj_[ij][k_ij]);
 
-            // (a_{ik}, c_{ik}) -> (a_{ij}, c_{jk})
-            delta_total->add(linalg::triplet(S_PNO(ij, ik), delta[ik], S_PNO(ik, jk)));
+                // (a_{ik}, c_{ik}) -> (a_{ij}, c_{jk})
+                triplet_add(1.0, *S_PNO(ij, ik), false, *delta[ik], false, *S_PNO(ik, jk), false, *delta_total, arena);
             
-            // (a_{ij}, c_{jk}) (b_{jk} c_{jk}) (b_{jk}, b_{ij}) -> (a_{ij}, b_{ij})
-            D_ij->add(linalg::triplet(delta_total, Tt_iajb_[jk], S_PNO(jk, ij), false, true, false));
-        }
-        D_ij->scale(0.5);
-        Rn_iajb[ij]->add(D_ij);
+                // (a_{ij}, c_{jk}) (b_{jk} c_{jk}) (b_{jk}, b_{ij}) -> (a_{ij}, b_{ij})
+                triplet_add(1.0, *delta_total, false, *Tt_iajb_[jk], true, *S_PNO(jk, ij), false, *D_ij, arena);
+            }
+            D_ij->scale(0.5);
+            Rn_iajb[ij]->add(D_ij);
 
-        // G_{ij}^{ab} = -t_{ik}^{ab} F_{kj}'' (Jiang Eq. 81)
-        auto G_ij = std::make_shared<Matrix>(npno_ij, npno_ij);
-        G_ij->zero();
+            // G_{ij}^{ab} = -t_{ik}^{ab} F_{kj}'' (Jiang Eq. 81)
+            auto G_ij = std::make_shared<Matrix>(npno_ij, npno_ij);
+            G_ij->zero();
 
-        for (int k = 0; k < naocc; ++k) {
-            int ik = i_j_to_ij_[i][k];
-            if (ik == -1) continue;
+            for (int k = 0; k < naocc; ++k) {
+                int ik = i_j_to_ij_[i][k];
+                if (ik == -1) continue;
 
-            // (a_{ik}, b_{ik}) -> (a_{ij}, b_{ij})
-            auto T_ik = linalg::triplet(S_PNO(ij, ik), T_iajb_[ik], S_PNO(ik, ij), false, false, false);
-            T_ik->scale((*Fkj_double_tilde)(k, j));
-            G_ij->subtract(T_ik);
-        }
-        Rn_iajb[ij]->add(G_ij);
-    } // end ij
+                // (a_{ik}, b_{ik}) -> (a_{ij}, b_{ij})
+                triplet_add(-(*Fkj_double_tilde)(k, j), *S_PNO(ij, ik), false, *T_iajb_[ik], false, *S_PNO(ik, ij), false,
+                            *G_ij, arena);
+            }
+            Rn_iajb[ij]->add(G_ij);
+        } // end ij
+    } // end batch
+
+    qia_pno_file_->release();
+    qab_pno_file_->release();
 
     // Add the contributions from projection corrections
 #pragma omp parallel for schedule(dynamic, 1)
@@ -2918,6 +3029,8 @@ double DLPNOCCSD::compute_energy() {
     timer_off("LCCSD");
 
     // Bye bye (Q_ij | m_ij a_ij) integrals. You won't be missed
+    qia_pno_file_.reset();
+    qab_pno_file_.reset();
     psio_->close(PSIF_DLPNO_QIA_PNO, 0);
     // Bye bye (Q_ij | a_ij b_ij) integrals. You won't be missed
     psio_->close(PSIF_DLPNO_QAB_PNO, 0);
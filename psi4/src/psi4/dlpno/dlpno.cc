@@ -556,9 +556,10 @@ void DLPNO::compute_dipole_ints() {
         SharedVector e_pao_i;
         std::tie(X_pao_i, e_pao_i) = orthocanonicalizer(S_pao_i, F_pao_i);
 
-        auto lmo_pao_dipx_i = submatrix_rows_and_cols(*lmo_pao_dipx, {(int)i}, pao_inds);
-        auto lmo_pao_dipy_i = submatrix_rows_and_cols(*lmo_pao_dipy, {(int)i}, pao_inds);
-        auto lmo_pao_dipz_i = submatrix_rows_and_cols(*lmo_pao_dipz, {(int)i}, pao_inds);
+        const std::vector<int> i_slice(1, i);
+        auto lmo_pao_dipx_i = submatrix_rows_and_cols(*lmo_pao_dipx, i_slice, pao_inds);
+        auto lmo_pao_dipy_i = submatrix_rows_and_cols(*lmo_pao_dipy, i_slice, pao_inds);
+        auto lmo_pao_dipz_i = submatrix_rows_and_cols(*lmo_pao_dipz, i_slice, pao_inds);
 
         lmo_pao_dipx_i = linalg::doublet(lmo_pao_dipx_i, X_pao_i);
         lmo_pao_dipy_i = linalg::doublet(lmo_pao_dipy_i, X_pao_i);
@@ -752,48 +753,56 @@ void DLPNO::prep_sparsity(bool initial, bool final) {
 
     int n_lmo_pairs = ij_to_i_j_.size();
 
-    lmopair_to_paos_.resize(n_lmo_pairs);
-    lmopair_to_paoatoms_.resize(n_lmo_pairs);
-    lmopair_to_ribfs_.resize(n_lmo_pairs);
-    lmopair_to_riatoms_.resize(n_lmo_pairs);
+    SparseMap lmopair_to_paos(n_lmo_pairs);
+    SparseMap lmopair_to_paoatoms(n_lmo_pairs);
+    SparseMap lmopair_to_ribfs(n_lmo_pairs);
+    SparseMap lmopair_to_riatoms(n_lmo_pairs);
 
 #pragma omp parallel for
     for (size_t ij = 0; ij < n_lmo_pairs; ++ij) {
         size_t i, j;
         std::tie(i, j) = ij_to_i_j_[ij];
 
-        lmopair_to_paos_[ij] = merge_lists(lmo_to_paos_[i], lmo_to_paos_[j]);
-        lmopair_to_paoatoms_[ij] = merge_lists(lmo_to_paoatoms_[i], lmo_to_paoatoms_[j]);
+        merge_lists(lmo_to_paos_[i], lmo_to_paos_[j], lmopair_to_paos[ij]);
+        merge_lists(lmo_to_paoatoms_[i], lmo_to_paoatoms_[j], lmopair_to_paoatoms[ij]);
 
-        lmopair_to_ribfs_[ij] = merge_lists(lmo_to_ribfs_[i], lmo_to_ribfs_[j]);
-        lmopair_to_riatoms_[ij] = merge_lists(lmo_to_riatoms_[i], lmo_to_riatoms_[j]);
+        merge_lists(lmo_to_ribfs_[i], lmo_to_ribfs_[j], lmopair_to_ribfs[ij]);
+        merge_lists(lmo_to_riatoms_[i], lmo_to_riatoms_[j], lmopair_to_riatoms[ij]);
     }
 
+    lmopair_to_paos_ = CSRMap(lmopair_to_paos);
+    lmopair_to_paoatoms_ = CSRMap(lmopair_to_paoatoms);
+    lmopair_to_ribfs_ = CSRMap(lmopair_to_ribfs);
+    lmopair_to_riatoms_ = CSRMap(lmopair_to_riatoms);
+
     // Create a list of lmos that "interact" with a lmo_pair
     // This is defined by all LMOs m such that im and jm form valid pairs
-    lmopair_to_lmos_.clear();
-    lmopair_to_lmos_.resize(n_lmo_pairs);
-    lmopair_to_lmos_dense_.resize(n_lmo_pairs);
+    SparseMap lmopair_to_lmos(n_lmo_pairs);
 
 #pragma omp parallel for
     for (int ij = 0; ij < n_lmo_pairs; ++ij) {
         int i, j;
         std::tie(i, j) = ij_to_i_j_[ij];
-        lmopair_to_lmos_dense_[ij] = std::vector<int>(naocc, -1);
 
-        int m_ij = 0;
         for (int m = 0; m < naocc; ++m) {
             int im = i_j_to_ij_[i][m];
             int jm = i_j_to_ij_[j][m];
 
             if (im != -1 && jm != -1) {
-                lmopair_to_lmos_[ij].push_back(m);
-                lmopair_to_lmos_dense_[ij][m] = m_ij;
-                m_ij++;
+                lmopair_to_lmos[ij].push_back(m);
             }
         }
     } // end ij
 
+    lmopair_to_lmos_ = CSRMap(lmopair_to_lmos);
+
+    // i and j always interact with pair ij; their positions are needed for every pair in every CCSD iteration
+    lmopair_to_i_j_pos_.resize(n_lmo_pairs);
+    for (int ij = 0; ij < n_lmo_pairs; ++ij) {
+        auto &[i, j] = ij_to_i_j_[ij];
+        lmopair_to_i_j_pos_[ij] = std::make_pair(lmopair_to_lmos_[ij].find(i), lmopair_to_lmos_[ij].find(j));
+    }
+
     print_aux_pair_domains();
     print_lmo_pair_domains();
     print_pao_pair_domains();
@@ -29,6 +29,7 @@
 #ifndef PSI4_SRC_DLPNO_H_
 #define PSI4_SRC_DLPNO_H_
 
+#include "pair_store.h"
 #include "sparse.h"
 
 #include "psi4/libmints/wavefunction.h"
@@ -39,6 +40,7 @@
 #include "psi4/psifiles.h"
 
 #include <map>
+#include <memory>
 #include <tuple>
 #include <string>
 #include <unordered_map>
@@ -173,12 +175,13 @@ class DLPNO : public Wavefunction {
     std::vector<std::pair<int,int>> ij_to_i_j_; ///< LMO pair index (ij) to both LMO indices (i, j)
     std::vector<int> ij_to_ji_; ///< LMO pair index (ij) to LMO pair index (ji)
 
-    // LMO Pair Domains
-    SparseMap lmopair_to_ribfs_; ///< which aux BFs are needed for density-fitting a pair of LMOs?
-    SparseMap lmopair_to_riatoms_; ///< aux BFs on which atoms are needed for density-fitting a pair of LMOs?
-    SparseMap lmopair_to_paos_; ///< which PAOs span the virtual space of a pair of LMOs?
-    SparseMap lmopair_to_paoatoms_; ///< PAOs on which atoms span the virtual space of a pair of LMOs?
-    SparseMap lmopair_to_lmos_; ///< Which LMOs "interact" with an LMO pair (determined by DOI integrals)
+    // LMO Pair Domains (one row per pair, so these are stored in CSR form)
+    CSRMap lmopair_to_ribfs_; ///< which aux BFs are needed for density-fitting a pair of LMOs?
+    CSRMap lmopair_to_riatoms_; ///< aux BFs on which atoms are needed for density-fitting a pair of LMOs?
+    CSRMap lmopair_to_paos_; ///< which PAOs span the virtual space of a pair of LMOs?
+    CSRMap lmopair_to_paoatoms_; ///< PAOs on which atoms span the virtual space of a pair of LMOs?
+    CSRMap lmopair_to_lmos_; ///< Which LMOs "interact" with an LMO pair (lmopair_to_lmos_[ij].find(m) is m's index)
+    std::vector<std::pair<int,int>> lmopair_to_i_j_pos_; ///< positions of i and j themselves in lmopair_to_lmos_[ij]
 
     // Extended LMO Domains 
     SparseMap lmo_to_riatoms_ext_; ///< aux BFs on which atoms are needed for density-fitting a LMO and all connected LMOs
@@ -203,11 +206,7 @@ class DLPNO : public Wavefunction {
     std::vector<std::vector<int>> riatom_to_paos_ext_dense_;
     std::vector<std::vector<bool>> riatom_to_atoms1_dense_;
     std::vector<std::vector<bool>> riatom_to_atoms2_dense_;
-    std::vector<std::vector<int>> lmopair_to_lmos_dense_;
 
-    /// Useful for generating DF integrals (TODO: Replace this with "index_list" function)
-    std::vector<std::vector<std::vector<int>>> lmopair_lmo_to_riatom_lmo_;
-    std::vector<std::vector<std::vector<int>>> lmopair_pao_to_riatom_pao_;
     std::vector<std::vector<std::pair<int,int>>> riatom_to_pao_pairs_; ///< Which (u,v) pao pairs belong to an riatom
     std::vector<std::vector<std::vector<int>>> riatom_to_pao_pairs_dense_; ///< For each riatom, returns the index of the element in qab tensor
 
@@ -310,6 +309,14 @@ class PSI_API DLPNOCCSD : public DLPNO {
     bool write_qia_pno_;
     /// Write (Q_ij | a_ij b_ij) integrals to disk?
     bool write_qab_pno_;
+    /// Which pairs keep their (Q_ij | m_ij a_ij) and (Q_ij | a_ij b_ij) integrals on disk
+    std::vector<bool> qia_pno_on_disk_;
+    std::vector<bool> qab_pno_on_disk_;
+    /// The disk-resident (Q_ij | m_ij a_ij) and (Q_ij | a_ij b_ij) pair blocks
+    std::unique_ptr<PairBlockFile> qia_pno_file_;
+    std::unique_ptr<PairBlockFile> qab_pno_file_;
+    /// Doubles of disk-resident pair blocks staged in core at once during the iterations
+    size_t pair_batch_memory_;
 
     /// PNO overlap integrals
     std::vector<std::vector<SharedMatrix>> S_pno_ij_kj_; ///< pno overlaps
@@ -377,6 +384,12 @@ class PSI_API DLPNOCCSD : public DLPNO {
     inline std::vector<SharedMatrix> QIA_PNO(const int ij);
     /// Encapsulates the reading in of (Q_{ij}|a_{ij} b_{ij}) integrals (regardless of core or disk)
     inline std::vector<SharedMatrix> QAB_PNO(const int ij);
+    /// Splits pairs, in the given order, into batches whose disk-resident integrals fit in pair_batch_memory_
+    std::vector<std::pair<int, int>> pair_batches(const std::vector<int>& pairs);
+    /// Stages the disk-resident integrals of pairs[start, stop) in core
+    void stage_pno_integrals(const std::vector<int>& pairs, int start, int stop);
+    /// Starts reading the disk-resident integrals of pairs[start, stop), to be staged next
+    void prefetch_pno_integrals(const std::vector<int>& pairs, int start, int stop);
 
     /// These functions split up pairs that survive the initial dipole screening
     // The "crude" pre-screening step splits up semi-canonical MP2 pairs from the rest,
@@ -27,6 +27,7 @@
  */
 
 #include "dlpno.h"
+#include "pair_gemm.h"
 #include "sparse.h"
 
 #include "psi4/lib3index/3index.h"
@@ -107,7 +108,14 @@ void DLPNOMP2::lmp2_iterations() {
     outfile->Printf("    R_CONVERGENCE = %.2e\n\n", options_.get_double("R_CONVERGENCE"));
     outfile->Printf("                     Corr. Energy    Delta E     Max R\n");
 
+    // residuals are rebuilt in place every iteration, and the coupling products go through per-thread scratch
     std::vector<SharedMatrix> R_iajb(n_lmo_pairs);
+    for (int ij = 0; ij < n_lmo_pairs; ++ij) {
+        R_iajb[ij] = std::make_shared<Matrix>("Residual", n_pno_[ij], n_pno_[ij]);
+    }
+    PairArena arena;
+    const std::vector<int> pair_order = pairs_by_pno_size(n_pno_);
+    const double f_cut = options_.get_double("F_CUT");
 
     int iteration = 0, max_iteration = options_.get_int("DLPNO_MAXITER");
     double e_curr = 0.0, e_prev = 0.0, r_curr = 0.0;
@@ -118,22 +126,26 @@ void DLPNOMP2::lmp2_iterations() {
         // RMS of residual per LMO pair, for assessing convergence
         std::vector<double> R_iajb_rms(n_lmo_pairs, 0.0);
 
-        // Calculate residuals from current amplitudes
-#pragma omp parallel for schedule(static, 1)
-        for (int ij = 0; ij < n_lmo_pairs; ++ij) {
+        // Calculate residuals from current amplitudes, largest PNO spaces first
+#pragma omp parallel for schedule(dynamic, 1)
+        for (int ij_idx = 0; ij_idx < n_lmo_pairs; ++ij_idx) {
+            const int ij = pair_order[ij_idx];
             int i, j;
             std::tie(i, j) = ij_to_i_j_[ij];
 
-            R_iajb[ij] = std::make_shared<Matrix>("Residual", n_pno_[ij], n_pno_[ij]);
+            const int npno = n_pno_[ij];
+            if (npno == 0) continue;
 
-            if (n_pno_[ij] == 0) continue;
+            double *Rp = R_iajb[ij]->get_pointer();
+            const double *Kp = K_iajb_[ij]->get_pointer();
+            const double *Tp = T_iajb_[ij]->get_pointer();
+            const double *ep = e_pno_[ij]->pointer();
+            const double f_ij = F_lmo_->get(i, i) + F_lmo_->get(j, j);
 
-            for (int a = 0; a < n_pno_[ij]; ++a) {
-                for (int b = 0; b < n_pno_[ij]; ++b) {
-                    R_iajb[ij]->set(a, b,
-                                    K_iajb_[ij]->get(a, b) +
-                                        (e_pno_[ij]->get(a) + e_pno_[ij]->get(b) - F_lmo_->get(i, i) - F_lmo_->get(j, j)) *
-                                            T_iajb_[ij]->get(a, b));
+            for (int a = 0; a < npno; ++a) {
+                for (int b = 0; b < npno; ++b) {
+                    const size_t ab = (size_t)a * npno + b;
+                    Rp[ab] = Kp[ab] + (ep[a] + ep[b] - f_ij) * Tp[ab];
                 }
             }
 
@@ -141,17 +153,13 @@ void DLPNOMP2::lmp2_iterations() {
                 int kj = i_j_to_ij_[k][j];
                 int ik = i_j_to_ij_[i][k];
 
-                if (kj != -1 && i != k && fabs(F_lmo_->get(i, k)) > options_.get_double("F_CUT") && n_pno_[kj] > 0) {
-                    auto temp =
-                        linalg::triplet(S_pno_ij_kj_[ij][k], T_iajb_[kj], S_pno_ij_kj_[ij][k], false, false, true);
-                    temp->scale(-1.0 * F_lmo_->get(i, k));
-                    R_iajb[ij]->add(temp);
+                if (kj != -1 && i != k && fabs(F_lmo_->get(i, k)) > f_cut && n_pno_[kj] > 0) {
+                    const Matrix &S = *S_pno_ij_kj_[ij][k];
+                    triplet_add(-F_lmo_->get(i, k), S, false, *T_iajb_[kj], false, S, true, *R_iajb[ij], arena);
                 }
-                if (ik != -1 && j != k && fabs(F_lmo_->get(k, j)) > options_.get_double("F_CUT") && n_pno_[ik] > 0) {
-                    auto temp =
-                        linalg::triplet(S_pno_ij_ik_[ij][k], T_iajb_[ik], S_pno_ij_ik_[ij][k], false, false, true);
-                    temp->scale(-1.0 * F_lmo_->get(k, j));
-                    R_iajb[ij]->add(temp);
+                if (ik != -1 && j != k && fabs(F_lmo_->get(k, j)) > f_cut && n_pno_[ik] > 0) {
+                    const Matrix &S = *S_pno_ij_ik_[ij][k];
+                    triplet_add(-F_lmo_->get(k, j), S, false, *T_iajb_[ik], false, S, true, *R_iajb[ij], arena);
                 }
             }
 
@@ -0,0 +1,142 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2026 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#include "pair_gemm.h"
+
+#include "psi4/libqt/qt.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace psi {
+namespace dlpno {
+
+PairArena::PairArena() {
+    int nthreads = 1;
+#ifdef _OPENMP
+    nthreads = omp_get_max_threads();
+#endif
+    buffers_.resize(nthreads);
+}
+
+double *PairArena::scratch(size_t size) {
+    int thread = 0;
+#ifdef _OPENMP
+    thread = omp_get_thread_num();
+#endif
+    auto &buffer = buffers_[thread];
+    if (buffer.size() < size) buffer.resize(size);
+    return buffer.data();
+}
+
+void triplet_add(double alpha, const Matrix &A, bool transA, const Matrix &B, bool transB, const Matrix &C, bool transC,
+                 Matrix &R, PairArena &arena) {
+    const int m = transA ? A.coldim() : A.rowdim();
+    const int k = transA ? A.rowdim() : A.coldim();
+    const int l = transB ? B.rowdim() : B.coldim();
+    const int n = transC ? C.rowdim() : C.coldim();
+
+    if (m == 0 || n == 0 || k == 0 || l == 0) return;
+
+    // AB = op(A) op(B), (m, l)
+    double *AB = arena.scratch((size_t)m * l);
+    C_DGEMM(transA ? 'T' : 'N', transB ? 'T' : 'N', m, l, k, 1.0, A.get_pointer(), A.coldim(), B.get_pointer(),
+            B.coldim(), 0.0, AB, l);
+    C_DGEMM('N', transC ? 'T' : 'N', m, n, l, alpha, AB, l, C.get_pointer(), C.coldim(), 1.0, R.get_pointer(),
+            R.coldim());
+}
+
+void doublet_add(double alpha, const Matrix &A, bool transA, const Matrix &B, bool transB, Matrix &R) {
+    const int m = transA ? A.coldim() : A.rowdim();
+    const int k = transA ? A.rowdim() : A.coldim();
+    const int n = transB ? B.rowdim() : B.coldim();
+
+    if (m == 0 || n == 0 || k == 0) return;
+
+    C_DGEMM(transA ? 'T' : 'N', transB ? 'T' : 'N', m, n, k, alpha, A.get_pointer(), A.coldim(), B.get_pointer(),
+            B.coldim(), 1.0, R.get_pointer(), R.coldim());
+}
+
+std::vector<int> pairs_by_pno_size(const std::vector<int> &n_pno) {
+    std::vector<int> pairs(n_pno.size());
+    std::iota(pairs.begin(), pairs.end(), 0);
+    std::stable_sort(pairs.begin(), pairs.end(), [&](int ij, int kl) { return n_pno[ij] > n_pno[kl]; });
+    return pairs;
+}
+
+bool test_pair_gemm() {
+    // Distinct, non-square dimensions, so that a swapped dimension or leading dimension shows up
+    const int m = 3, k = 4, l = 5, n = 6;
+    auto operand = [](int nrow, int ncol, bool trans, int seed) {
+        auto M = std::make_shared<Matrix>(trans ? ncol : nrow, trans ? nrow : ncol);
+        for (int p = 0; p < M->rowdim(); ++p) {
+            for (int q = 0; q < M->coldim(); ++q) M->set(p, q, std::sin(seed + 0.7 * p + 1.3 * q));
+        }
+        return M;
+    };
+    auto close = [](const Matrix &X, const Matrix &Y) {
+        auto diff = X.clone();
+        diff->subtract(Y);
+        return diff->absmax() < 1.0e-12;
+    };
+
+    PairArena arena;
+    bool passed = true;
+    for (int ops = 0; ops < 8; ++ops) {
+        const bool transA = ops & 1, transB = ops & 2, transC = ops & 4;
+        auto A = operand(m, k, transA, 1);
+        auto B = operand(k, l, transB, 2);
+        auto C = operand(l, n, transC, 3);
+
+        // R starts out nonzero, as both only ever add to it
+        auto R = operand(m, n, false, 4);
+        auto ref = R->clone();
+        auto ABC = linalg::triplet(A, B, C, transA, transB, transC);
+        ABC->scale(-0.5);
+        ref->add(ABC);
+        triplet_add(-0.5, *A, transA, *B, transB, *C, transC, *R, arena);
+        passed = passed && close(*R, *ref);
+
+        auto S = operand(m, l, false, 5);
+        ref = S->clone();
+        auto AB = linalg::doublet(A, B, transA, transB);
+        AB->scale(2.0);
+        ref->add(AB);
+        doublet_add(2.0, *A, transA, *B, transB, *S);
+        passed = passed && close(*S, *ref);
+    }
+    return passed;
+}
+
+}  // namespace dlpno
+}  // namespace psi
@@ -0,0 +1,68 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2026 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#ifndef PSI4_SRC_DLPNO_PAIR_GEMM_H_
+#define PSI4_SRC_DLPNO_PAIR_GEMM_H_
+
+#include "psi4/libmints/matrix.h"
+
+#include <vector>
+
+namespace psi {
+namespace dlpno {
+
+/* Scratch space for the small dense products of the DLPNO pair loops, one buffer per thread.
+ * Buffers only grow, so once a thread has handled its largest pair its products stop allocating.
+ */
+class PairArena {
+   public:
+    PairArena();
+
+    /// Scratch of at least size doubles for the calling thread, valid until its next call
+    double *scratch(size_t size);
+
+   private:
+    std::vector<std::vector<double>> buffers_;
+};
+
+/// R += alpha * op(A) op(B) op(C), with the intermediate op(A) op(B) in the arena instead of a new Matrix
+void triplet_add(double alpha, const Matrix &A, bool transA, const Matrix &B, bool transB, const Matrix &C, bool transC,
+                 Matrix &R, PairArena &arena);
+/// R += alpha * op(A) op(B), straight into R
+void doublet_add(double alpha, const Matrix &A, bool transA, const Matrix &B, bool transB, Matrix &R);
+
+/// Pair indices ordered by decreasing PNO count, so pairs of similar size run back to back
+std::vector<int> pairs_by_pno_size(const std::vector<int> &n_pno);
+
+/// Checks triplet_add and doublet_add against linalg::triplet and linalg::doublet for every op combination
+bool test_pair_gemm();
+
+}  // namespace dlpno
+}  // namespace psi
+
+#endif  // PSI4_SRC_DLPNO_PAIR_GEMM_H_
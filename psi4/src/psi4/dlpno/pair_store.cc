@@ -0,0 +1,192 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2026 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#include "pair_store.h"
+
+#include "psi4/libpsi4util/exception.h"
+#include "psi4/libpsio/psio.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace psi {
+namespace dlpno {
+
+PairBlockFile::PairBlockFile(std::shared_ptr<PSIO> psio, size_t unit, const std::string &label, int npairs,
+                             bool lower_triangle)
+    : psio_(psio),
+      unit_(unit),
+      label_(label),
+      lower_triangle_(lower_triangle),
+      offset_(npairs, -1),
+      nrow_(npairs, 0),
+      ncol_(npairs, 0),
+      size_(0) {}
+
+PairBlockFile::~PairBlockFile() { release(); }
+
+size_t PairBlockFile::packed_size(int ij) const {
+    if (!lower_triangle_) return block_size(ij);
+    size_t np = std::lround(std::sqrt((double)ncol_[ij]));
+    return (size_t)nrow_[ij] * np * (np + 1) / 2;
+}
+
+void PairBlockFile::write(int ij, const Matrix &block) {
+    const int nrow = block.rowdim(), ncol = block.coldim();
+    const double *data = (nrow * ncol > 0) ? block.get_pointer() : nullptr;
+
+    std::vector<double> packed;
+    if (lower_triangle_) {
+        int np = std::lround(std::sqrt((double)ncol));
+        if (np * np != ncol) throw PSIEXCEPTION("PairBlockFile: lower triangle blocks need square pair columns.");
+        packed.resize((size_t)nrow * np * (np + 1) / 2);
+        size_t count = 0;
+        for (int q = 0; q < nrow; ++q) {
+            for (int a = 0; a < np; ++a) {
+                for (int b = 0; b <= a; ++b) packed[count++] = data[(size_t)q * ncol + a * np + b];
+            }
+        }
+        data = packed.data();
+    }
+
+    std::lock_guard<std::mutex> lock(io_mutex_);
+    nrow_[ij] = nrow;
+    ncol_[ij] = ncol;
+    offset_[ij] = size_;
+    size_t nwrite = packed_size(ij);
+    if (nwrite > 0) {
+        psio_address end;
+        psio_->write(unit_, label_.c_str(), (char *)data, nwrite * sizeof(double),
+                     psio_get_address(PSIO_ZERO, size_ * sizeof(double)), &end);
+    }
+    size_ += nwrite;
+}
+
+void PairBlockFile::unpack(int ij, const std::vector<double> &packed, Matrix &block) const {
+    const int nrow = nrow_[ij], np = std::lround(std::sqrt((double)ncol_[ij]));
+    double **bp = block.pointer();
+    size_t count = 0;
+    for (int q = 0; q < nrow; ++q) {
+        for (int a = 0; a < np; ++a) {
+            for (int b = 0; b <= a; ++b, ++count) {
+                bp[q][a * np + b] = packed[count];
+                bp[q][b * np + a] = packed[count];
+            }
+        }
+    }
+}
+
+SharedMatrix PairBlockFile::read_from_disk(int ij) {
+    auto block = std::make_shared<Matrix>(nrow_[ij], ncol_[ij]);
+    size_t nread = packed_size(ij);
+    if (nread == 0) return block;
+
+    std::vector<double> packed(lower_triangle_ ? nread : 0);
+    double *buffer = lower_triangle_ ? packed.data() : block->get_pointer();
+
+    psio_address end;
+    psio_->read(unit_, label_.c_str(), (char *)buffer, nread * sizeof(double),
+                psio_get_address(PSIO_ZERO, offset_[ij] * sizeof(double)), &end);
+
+    if (lower_triangle_) unpack(ij, packed, *block);
+    return block;
+}
+
+SharedMatrix PairBlockFile::read(int ij) {
+    auto staged = staged_.find(ij);
+    if (staged != staged_.end()) return staged->second;
+
+    std::lock_guard<std::mutex> lock(io_mutex_);
+    return read_from_disk(ij);
+}
+
+std::vector<int> PairBlockFile::file_order(const std::vector<int> &pairs) const {
+    std::vector<int> order;
+    for (int ij : pairs) {
+        if (contains(ij)) order.push_back(ij);
+    }
+    std::sort(order.begin(), order.end(), [&](int a, int b) { return offset_[a] < offset_[b]; });
+    order.erase(std::unique(order.begin(), order.end()), order.end());
+    return order;
+}
+
+void PairBlockFile::stage(const std::vector<int> &pairs) {
+    staged_.clear();
+
+    std::lock_guard<std::mutex> lock(io_mutex_);
+    for (int ij : file_order(pairs)) {
+        auto pending = prefetched_.find(ij);
+        if (pending == prefetched_.end()) {
+            staged_[ij] = read_from_disk(ij);
+            continue;
+        }
+
+        auto &[block, packed, end, job] = pending->second;
+        if (job) aio_->wait_for_job(job);
+        if (lower_triangle_ && packed_size(ij) > 0) unpack(ij, packed, *block);
+        staged_[ij] = block;
+        prefetched_.erase(pending);
+    }
+
+    // Whatever was prefetched for pairs outside this batch is of no use
+    drop_prefetched();
+}
+
+void PairBlockFile::prefetch(const std::vector<int> &pairs) {
+    drop_prefetched();
+    if (!aio_) aio_ = std::make_unique<AIOHandler>(psio_);
+
+    for (int ij : file_order(pairs)) {
+        auto &[block, packed, end, job] = prefetched_[ij];
+        block = std::make_shared<Matrix>(nrow_[ij], ncol_[ij]);
+        job = 0;
+
+        size_t nread = packed_size(ij);
+        if (nread == 0) continue;
+        if (lower_triangle_) packed.resize(nread);
+        double *buffer = lower_triangle_ ? packed.data() : block->get_pointer();
+
+        job = aio_->read(unit_, label_.c_str(), (char *)buffer, nread * sizeof(double),
+                         psio_get_address(PSIO_ZERO, offset_[ij] * sizeof(double)), &end);
+    }
+}
+
+void PairBlockFile::drop_prefetched() {
+    for (auto &[ij, pending] : prefetched_) {
+        if (pending.job) aio_->wait_for_job(pending.job);
+    }
+    prefetched_.clear();
+}
+
+void PairBlockFile::release() {
+    staged_.clear();
+    drop_prefetched();
+}
+
+}  // namespace dlpno
+}  // namespace psi
@@ -0,0 +1,120 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2026 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#ifndef PSI4_SRC_DLPNO_PAIR_STORE_H_
+#define PSI4_SRC_DLPNO_PAIR_STORE_H_
+
+#include "psi4/libmints/matrix.h"
+#include "psi4/libpsio/aiohandler.h"
+#include "psi4/libpsio/psio.hpp"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace psi {
+namespace dlpno {
+
+/* Per-pair blocks (Q_{ij}, p_{ij} q_{ij}) of a three-index quantity, kept on a single PSIO entry.
+ * Blocks are appended as the pairs are computed, in any order, and found again through a per-pair
+ * offset, so the TOC holds one entry however many pairs go to disk. Blocks whose columns are a
+ * symmetric pair of the same PNO space are stored as lower triangles.
+ *
+ * stage() reads the blocks of a batch of pairs with one ordered pass over the file; read() serves
+ * staged blocks from core and anything else straight from disk. prefetch() submits the reads of the
+ * next batch to an AIOHandler, so that they run while the staged batch is worked on, and the next
+ * stage() only waits for what has not arrived yet. At most two batches are in core at any time.
+ * write() and read() may be called from threads, stage(), prefetch() and release() may not.
+ */
+class PairBlockFile {
+   public:
+    PairBlockFile(std::shared_ptr<PSIO> psio, size_t unit, const std::string &label, int npairs, bool lower_triangle);
+    ~PairBlockFile();
+
+    /// Append the block of pair ij
+    void write(int ij, const Matrix &block);
+    /// The block of pair ij (shared with the staged batch, do not modify)
+    SharedMatrix read(int ij);
+
+    /// Bring the blocks of these pairs into core, in file order, dropping the previous batch
+    void stage(const std::vector<int> &pairs);
+    /// Start reading the blocks of the batch that will be staged next, without waiting for them
+    void prefetch(const std::vector<int> &pairs);
+    /// Drop the staged batch, and the prefetched one
+    void release();
+
+    /// Is the block of pair ij in this file?
+    bool contains(int ij) const { return offset_[ij] != -1; }
+    /// Doubles the block of pair ij takes in core
+    size_t block_size(int ij) const { return (size_t)nrow_[ij] * ncol_[ij]; }
+    /// Doubles written so far
+    size_t size() const { return size_; }
+
+   private:
+    std::shared_ptr<PSIO> psio_;
+    size_t unit_;
+    std::string label_;
+    bool lower_triangle_;
+
+    std::vector<long int> offset_;  ///< position of each block in the entry [doubles], -1 if absent
+    std::vector<int> nrow_;
+    std::vector<int> ncol_;
+    size_t size_;
+
+    std::unordered_map<int, SharedMatrix> staged_;
+    std::mutex io_mutex_;
+
+    /// A block on its way in: the matrix, the packed buffer if any, and the AIO job filling them
+    struct Prefetch {
+        SharedMatrix block;
+        std::vector<double> packed;
+        psio_address end;
+        size_t job;
+    };
+    /// Blocks of the next batch, by pair; the map keeps their buffers in place while the reads run
+    std::unordered_map<int, Prefetch> prefetched_;
+    std::unique_ptr<AIOHandler> aio_;
+
+    /// Doubles the block of pair ij takes on disk
+    size_t packed_size(int ij) const;
+    /// Blocks of these pairs in the file, in file order
+    std::vector<int> file_order(const std::vector<int> &pairs) const;
+    /// Fill the block of pair ij from its lower triangle
+    void unpack(int ij, const std::vector<double> &packed, Matrix &block) const;
+    /// Read the block of pair ij from disk; the caller holds io_mutex_
+    SharedMatrix read_from_disk(int ij);
+    /// Wait for every prefetched block and drop them
+    void drop_prefetched();
+};
+
+}  // namespace dlpno
+}  // namespace psi
+
+#endif  // PSI4_SRC_DLPNO_PAIR_STORE_H_
@@ -35,9 +35,39 @@
 
 namespace psi {
 
-std::vector<int> merge_lists(const std::vector<int> &l1, const std::vector<int> &l2) {
+int SparseRow::find(int value) const {
+    const int *pos = std::lower_bound(begin(), end(), value);
+    if (pos == end() || *pos != value) return -1;
+    return pos - begin();
+}
+
+CSRMap::CSRMap(const SparseMap &map) : offsets_(map.size() + 1, 0) {
+    for (size_t row = 0; row < map.size(); ++row) {
+        offsets_[row + 1] = offsets_[row] + map[row].size();
+    }
+    values_.reserve(offsets_.back());
+    for (const auto &list : map) {
+        values_.insert(values_.end(), list.begin(), list.end());
+    }
+}
+
+SparseMap CSRMap::to_sparse_map() const {
+    SparseMap map(size());
+    for (size_t row = 0; row < size(); ++row) {
+        map[row] = (*this)[row].to_vector();
+    }
+    return map;
+}
 
+std::vector<int> merge_lists(SparseRow l1, SparseRow l2) {
     std::vector<int> l12;
+    merge_lists(l1, l2, l12);
+    return l12;
+}
+
+void merge_lists(SparseRow l1, SparseRow l2, std::vector<int> &l12) {
+
+    l12.clear();
 
     int i1 = 0, i2 = 0;
     while(i1 < l1.size() || i2 < l2.size()) {
@@ -60,16 +90,20 @@ std::vector<int> merge_lists(const std::vector<int> &l1, const std::vector<int>
         }
     }
 
-    return l12;
+}
 
+std::vector<int> index_list(SparseRow l1, SparseRow l2) {
+    std::vector<int> lsub;
+    index_list(l1, l2, lsub);
+    return lsub;
 }
 
-std::vector<int> index_list(const std::vector<int> &l1, const std::vector<int> &l2) {
+void index_list(SparseRow l1, SparseRow l2, std::vector<int> &lsub) {
     /* This function takes two sorted lists, such that l2 is a subset of l1, 
      * and finds the indices of the elements of l1 that correspond to the elements of l2.
      */
 
-    std::vector<int> lsub;
+    lsub.clear();
 
     int i1 = 0, i2 = 0;
     while (i2 < l2.size() && i1 < l1.size()) {
@@ -85,15 +119,19 @@ std::vector<int> index_list(const std::vector<int> &l1, const std::vector<int> &
     if (lsub.size() != l2.size()) {
         throw PSIEXCEPTION("Index List error! Check that l2 is a subset of l1, and both lists are sorted!");
     }
+}
 
-    return lsub;
+std::vector<int> contract_lists(SparseRow y, const std::vector<std::vector<int>> &A_to_y) {
+    std::vector<int> yA;
+    contract_lists(y, A_to_y, yA);
+    return yA;
 }
 
-std::vector<int> contract_lists(const std::vector<int> &y, const std::vector<std::vector<int>> &A_to_y) {
+void contract_lists(SparseRow y, const std::vector<std::vector<int>> &A_to_y, std::vector<int> &yA) {
 
     // TODO: runtime is proportional to A_to_y size (system size, O(N))
     // could maybe reduce to &y size (domain size, O(1)), probably doesn't matter
-    std::vector<int> yA;
+    yA.clear();
 
     for(int a = 0, y_ind = 0; a < A_to_y.size(); ++a) {
 
@@ -113,13 +151,17 @@ std::vector<int> contract_lists(const std::vector<int> &y, const std::vector<std
 
     }
 
-    return yA;
+}
 
+std::vector<int> block_list(SparseRow x_list, const std::vector<int> &x_to_y_map) {
+    std::vector<int> y_list;
+    block_list(x_list, x_to_y_map, y_list);
+    return y_list;
 }
 
-std::vector<int> block_list(const std::vector<int> &x_list, const std::vector<int> &x_to_y_map) {
+void block_list(SparseRow x_list, const std::vector<int> &x_to_y_map, std::vector<int> &y_list) {
 
-    std::vector<int> y_list;
+    y_list.clear();
 
     for(int x_val : x_list) {
         int y_val = x_to_y_map[x_val];
@@ -130,8 +172,6 @@ std::vector<int> block_list(const std::vector<int> &x_list, const std::vector<in
         }
     }
 
-    return y_list;
-
 }
 
 std::vector<std::vector<int>> invert_map(const std::vector<std::vector<int>> &x_to_y, int ny) {
@@ -183,7 +223,7 @@ std::vector<std::vector<int>> extend_maps(const std::vector<std::vector<int>> &x
 
 }
 
-SharedMatrix submatrix_rows(const Matrix &mat, const std::vector<int> &row_inds) {
+SharedMatrix submatrix_rows(const Matrix &mat, SparseRow row_inds) {
 
     SharedMatrix mat_new = std::make_shared<Matrix>(mat.name(), row_inds.size(), mat.colspi(0));
     double** mat_newp = mat_new->pointer();
@@ -195,7 +235,7 @@ SharedMatrix submatrix_rows(const Matrix &mat, const std::vector<int> &row_inds)
     return mat_new;
 }
 
-SharedMatrix submatrix_cols(const Matrix &mat, const std::vector<int> &col_inds) {
+SharedMatrix submatrix_cols(const Matrix &mat, SparseRow col_inds) {
 
     SharedMatrix mat_new = std::make_shared<Matrix>(mat.name(), mat.rowspi(0), col_inds.size());
     double** mat_newp = mat_new->pointer();
@@ -207,21 +247,85 @@ SharedMatrix submatrix_cols(const Matrix &mat, const std::vector<int> &col_inds)
     return mat_new;
 }
 
-SharedMatrix submatrix_rows_and_cols(const Matrix &mat, const std::vector<int> &row_inds, const std::vector<int> &col_inds) {
+SharedMatrix submatrix_rows_and_cols(const Matrix &mat, SparseRow row_inds, SparseRow col_inds) {
 
     SharedMatrix mat_new = std::make_shared<Matrix>(mat.name(), row_inds.size(), col_inds.size());
-    double** mat_newp = mat_new->pointer();
+    submatrix_rows_and_cols(mat, row_inds, col_inds, *mat_new);
+    return mat_new;
+}
+
+void submatrix_rows_and_cols(const Matrix &mat, SparseRow row_inds, SparseRow col_inds, Matrix &sub) {
+
+    if (sub.rowspi(0) != row_inds.size() || sub.colspi(0) != col_inds.size()) {
+        throw PSIEXCEPTION("submatrix_rows_and_cols: the target matrix does not match the requested rows and columns!");
+    }
+
+    double** subp = sub.pointer();
     double** matp = mat.pointer();
 
     for(int r_new = 0; r_new < row_inds.size(); r_new++) {
-        int r_old = row_inds[r_new];
+        const double* mat_row = matp[row_inds[r_new]];
+        double* sub_row = subp[r_new];
         for(int c_new = 0; c_new < col_inds.size(); c_new++) {
-            int c_old = col_inds[c_new];
-            mat_newp[r_new][c_new] = matp[r_old][c_old];
+            sub_row[c_new] = mat_row[col_inds[c_new]];
         }
     }
-    return mat_new;
 }
 
+namespace dlpno {
+
+bool test_sparse_maps() {
+    bool passed = true;
+
+    // CSRMap, with an empty row in the middle
+    const SparseMap map = {{1, 3, 5}, {}, {2}};
+    CSRMap csr(map);
+    passed = passed && csr.size() == 3 && csr.nnz() == 4 && csr.to_sparse_map() == map;
+    passed = passed && csr[0].to_vector() == map[0] && csr[1].empty() && csr[2].to_vector() == map[2];
+    passed = passed && CSRMap().size() == 0 && CSRMap().nnz() == 0;
+
+    // SparseRow::find: present, absent before, between and after the values, and in an empty row
+    passed = passed && csr[0].find(1) == 0 && csr[0].find(5) == 2 && csr[2].find(2) == 0;
+    passed = passed && csr[0].find(0) == -1 && csr[0].find(4) == -1 && csr[0].find(6) == -1;
+    passed = passed && csr[1].find(1) == -1 && SparseRow().find(0) == -1;
+
+    // The buffer overloads start from a buffer holding stale values and keep its capacity
+    const std::vector<int> l1 = {2, 4, 6, 8, 10, 12}, l2 = {2, 8, 12}, l3 = {1, 4, 9};
+    std::vector<int> buffer(16, -7);
+    const size_t capacity = buffer.capacity();
+
+    merge_lists(l1, l3, buffer);
+    passed = passed && buffer == std::vector<int>({1, 2, 4, 6, 8, 9, 10, 12}) && buffer == merge_lists(l1, l3);
+    passed = passed && buffer.capacity() == capacity;
+    merge_lists(SparseRow(), l2, buffer);
+    passed = passed && buffer == l2;
+
+    index_list(l1, l2, buffer);
+    passed = passed && buffer == std::vector<int>({0, 3, 5}) && buffer == index_list(l1, l2);
+    passed = passed && buffer.capacity() == capacity;
+
+    // submatrix_rows_and_cols into a reused matrix, element by element against the source
+    Matrix mat(4, 5);
+    for (int p = 0; p < 4; ++p) {
+        for (int q = 0; q < 5; ++q) mat.set(p, q, 10.0 * p + q);
+    }
+    Matrix sub(2, 3);
+    for (const auto &inds : {std::make_pair(std::vector<int>{1, 3}, std::vector<int>{0, 2, 4}),
+                             std::make_pair(std::vector<int>{0, 2}, std::vector<int>{1, 3, 4})}) {
+        submatrix_rows_and_cols(mat, inds.first, inds.second, sub);
+        auto ref = submatrix_rows_and_cols(mat, inds.first, inds.second);
+        for (int r = 0; r < 2; ++r) {
+            for (int c = 0; c < 3; ++c) {
+                passed = passed && sub.get(r, c) == mat.get(inds.first[r], inds.second[c]);
+                passed = passed && ref->get(r, c) == sub.get(r, c);
+            }
+        }
+    }
+
+    return passed;
+}
+
+}  // namespace dlpno
+
 } // namespace psi
 
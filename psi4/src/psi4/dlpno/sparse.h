@@ -37,29 +37,90 @@ typedef std::vector<std::vector<int>> SparseMap;
 
 namespace psi{
 
+/* A read-only view of a sorted list of indices, either a std::vector<int> or one row of a CSRMap.
+ * The view does not own its data, so it must not outlive the list it was taken from.
+ */
+class SparseRow {
+   public:
+    SparseRow() : data_(nullptr), size_(0) {}
+    SparseRow(const int *data, size_t size) : data_(data), size_(size) {}
+    SparseRow(const std::vector<int> &list) : data_(list.data()), size_(list.size()) {}
+
+    const int *begin() const { return data_; }
+    const int *end() const { return data_ + size_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    int operator[](size_t ind) const { return data_[ind]; }
+
+    /// Position of value in the list, (-1) if the list does not contain it
+    int find(int value) const;
+    /// An owning copy of the list
+    std::vector<int> to_vector() const { return std::vector<int>(begin(), end()); }
+
+   private:
+    const int *data_;
+    size_t size_;
+};
+
+/* A SparseMap stored in compressed sparse row (CSR) form.
+ * Every row lives back to back in a single array, so a map with many short rows (e.g. one per LMO pair)
+ * costs one allocation instead of one per row, and walking consecutive rows stays in cache.
+ * Rows are views (see SparseRow) and are expected to be sorted, as every other map here is.
+ */
+class CSRMap {
+   public:
+    CSRMap() : offsets_(1, 0) {}
+    explicit CSRMap(const SparseMap &map);
+
+    /// Number of rows
+    size_t size() const { return offsets_.size() - 1; }
+    /// Number of stored indices, over all rows
+    size_t nnz() const { return values_.size(); }
+    SparseRow operator[](size_t row) const {
+        return SparseRow(values_.data() + offsets_[row], offsets_[row + 1] - offsets_[row]);
+    }
+
+    /// The same map, one std::vector<int> per row
+    SparseMap to_sparse_map() const;
+
+   private:
+    std::vector<size_t> offsets_;
+    std::vector<int> values_;
+};
+
 /* Args: sorted lists l1 and l2
  * Returns: sorted union of l1 and l2
  */
-std::vector<int> merge_lists(const std::vector<int> &l1, const std::vector<int> &l2);
+std::vector<int> merge_lists(SparseRow l1, SparseRow l2);
+/* Same as above, but overwrites l12 (which must not be l1 or l2) and keeps its capacity
+ * Accumulating a union: merge_lists(l1, l2, buffer); l1.swap(buffer);
+ */
+void merge_lists(SparseRow l1, SparseRow l2, std::vector<int> &l12);
 
 /* Args: two lists of values l1 and l2 (where l2 is a subset of l1)
  * WARNING: This assumes that each list is sorted and has unique elements!
  * Returns: the position in l1 where each element of l2 is
  * Example: l1 = [2, 4, 6, 8, 10, 12], l2 = [2, 8, 12], return = [0, 3, 5] since those are the indices of [8, 10, 12] in l1
  */
-std::vector<int> PSI_API index_list(const std::vector<int> &l1, const std::vector<int> &l2);
+std::vector<int> PSI_API index_list(SparseRow l1, SparseRow l2);
+/* Same as above, but overwrites lsub and keeps its capacity */
+void index_list(SparseRow l1, SparseRow l2, std::vector<int> &lsub);
 
 /* Args: sorted list of y, sparse map from A to another list of y (assume sorted, each possible value of y appears exactly once in entire map)
  * Returns: the union of lists in A_to_y where at least one element is in y
  */
-std::vector<int> contract_lists(const std::vector<int> &y, const std::vector<std::vector<int>> &A_to_y);
+std::vector<int> contract_lists(SparseRow y, const std::vector<std::vector<int>> &A_to_y);
+/* Same as above, but overwrites yA and keeps its capacity */
+void contract_lists(SparseRow y, const std::vector<std::vector<int>> &A_to_y, std::vector<int> &yA);
 
 /* Args: x is a list of values (sorted), y is a map from values of x to values of y
  * Returns: a list of y values
  *
  * Multiple values in x may map to the same value in y (i.e. x is a list of bf, y is atoms)
  */
-std::vector<int> block_list(const std::vector<int> &x_list, const std::vector<int> &x_to_y_map);
+std::vector<int> block_list(SparseRow x_list, const std::vector<int> &x_to_y_map);
+/* Same as above, but overwrites y_list and keeps its capacity */
+void block_list(SparseRow x_list, const std::vector<int> &x_to_y_map, std::vector<int> &y_list);
 
 /* Args: SparseMap from x to y, maximum possible y value
  * Returns: SparseMap from y to x
@@ -77,13 +138,23 @@ SparseMap chain_maps(const SparseMap &x_to_y, const SparseMap &y_to_z);
 SparseMap extend_maps(const SparseMap &i_to_y, const std::vector<std::pair<int,int>> &ij_to_i_j);
 
 /* Args: Matrix, list of row indices */
-SharedMatrix submatrix_rows(const Matrix &mat, const std::vector<int> &row_inds);
+SharedMatrix submatrix_rows(const Matrix &mat, SparseRow row_inds);
 
 /* Args: Matrix, list of column indices */
-SharedMatrix submatrix_cols(const Matrix &mat, const std::vector<int> &col_inds);
+SharedMatrix submatrix_cols(const Matrix &mat, SparseRow col_inds);
 
 /* Args: Matrix, list of row and column indices */
-SharedMatrix submatrix_rows_and_cols(const Matrix &mat, const std::vector<int> &row_inds, const std::vector<int> &col_inds);
+SharedMatrix submatrix_rows_and_cols(const Matrix &mat, SparseRow row_inds, SparseRow col_inds);
+
+/* Args: Matrix, list of row and column indices, and a preallocated Matrix of shape (row_inds, col_inds)
+ * Gathers the submatrix into sub, so that a buffer can be reused across many gathers of the same shape
+ */
+void submatrix_rows_and_cols(const Matrix &mat, SparseRow row_inds, SparseRow col_inds, Matrix &sub);
+
+namespace dlpno {
+/* Checks CSRMap, SparseRow::find and the buffer-reusing overloads against hand-made references */
+bool test_sparse_maps();
+}  // namespace dlpno
 
 } // namespace psi
 
@@ -29,11 +29,16 @@
 #include "dfhelper.h"
 
 #include <algorithm>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #ifdef _MSC_VER
 #include <process.h>
 #define SYSTEM_GETPID ::_getpid
 #else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
 #define SYSTEM_GETPID ::getpid
 #endif
@@ -62,6 +67,50 @@
 
 namespace psi {
 
+namespace {
+
+// Bump whenever the layout or the contents of a cached AO tensor change
+const uint64_t AO_cache_version = 1;
+const char AO_cache_magic[8] = {'P', 'S', 'I', 'D', 'F', 'H', 'A', 'O'};
+
+struct AOCacheHeader {
+    char magic[8];
+    uint64_t version;
+    uint64_t key;
+    uint64_t mask_key;
+    uint64_t nelem;
+    uint64_t sample_key;
+};
+
+// 64-bit FNV-1a
+class FNVHash {
+    uint64_t hash_ = 14695981039346656037ULL;
+
+   public:
+    void add(const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash_ ^= bytes[i];
+            hash_ *= 1099511628211ULL;
+        }
+    }
+    template <typename T>
+    void add(const T& value) {
+        add(&value, sizeof(T));
+    }
+    uint64_t value() const { return hash_; }
+};
+
+// Hash of one element per page of the tensor, to catch truncated or damaged entries
+uint64_t AO_cache_sample_key(const double* data, size_t nelem) {
+    FNVHash hash;
+    for (size_t i = 0; i < nelem; i += 512) hash.add(data[i]);
+    if (nelem) hash.add(data[nelem - 1]);
+    return hash.value();
+}
+
+}  // namespace
+
 DFHelper::DFHelper(std::shared_ptr<BasisSet> primary, std::shared_ptr<BasisSet> aux)
     : primary_(primary), aux_(aux) {
     if(Process::environment.options["SCF_SUBTYPE"].has_changed()) {
@@ -73,7 +122,9 @@ DFHelper::DFHelper(std::shared_ptr<BasisSet> primary, std::shared_ptr<BasisSet>
         // Needed b/c the enough_mem ? mem : disk memory logic is slightly different from the DFHelper memory logic, so one can hit MemDF+Disk_algorithm by accident.
         subalgo_ = "INCORE";
     }
-    
+    mmap_io_ = (Process::environment.options.get_str("DF_IO_BACKEND") == "MMAP");
+    ints_cache_dir_ = Process::environment.options.get_str("DF_INTS_CACHE_DIR");
+
     nbf_ = primary_->nbf();
     naux_ = aux_->nbf();
     prepare_blocking();
@@ -172,8 +223,18 @@ void DFHelper::initialize() {
         throw PSIEXCEPTION(error.str().c_str());
     }
 
-    // if metric power is not zero, prepare it
-    if (!(std::fabs(mpower_ - 0.0) < 1e-13)) (hold_met_ ? prepare_metric_core() : prepare_metric());
+    // prepare sparsity masks
+    prepare_sparsity();
+
+    // figure out AO_core
+    AO_core(true);
+
+    // in-core STORE AOs may be in the persistent cache from an earlier run
+    bool AO_cache = AO_core_ && !do_wK_ && !direct_ && !direct_iaQ_ && !ints_cache_dir_.empty();
+    bool AO_cached = AO_cache && load_AO_cache();
+
+    // if metric power is not zero, prepare it (the cached AOs are already contracted)
+    if (!AO_cached && !(std::fabs(mpower_ - 0.0) < 1e-13)) (hold_met_ ? prepare_metric_core() : prepare_metric());
 
     // if metric power for omega integrals is not zero, prepare its metric
     if (do_wK_) {
@@ -181,20 +242,15 @@ void DFHelper::initialize() {
             (hold_met_ ? prepare_metric_core() : prepare_metric());
     }
 
-    // prepare sparsity masks
-    prepare_sparsity();
-
-    // figure out AO_core
-    AO_core(true);
-
     // prepare AOs for STORE method
     if (AO_core_) {
         if (do_wK_) {
             prepare_AO_wK_core();
-        } else {  // It is possible to reformulate the expression for the
+        } else if (!AO_cached) {  // It is possible to reformulate the expression for the
             //   coulomb matrix to save memory in case do_wK_ is
             //   is true, but do_K_ is false. This code isn't written
             prepare_AO_core();
+            if (AO_cache) store_AO_cache();
         }
     } else if (!direct_ && !direct_iaQ_) {
         prepare_AO();
@@ -289,6 +345,8 @@ void DFHelper::print_header() {
     outfile->Printf("    Algorithm:               %11s\n", method_.c_str());
     outfile->Printf("    AO Core:                 %11s\n", (AO_core_ ? "True" : "False"));
     outfile->Printf("    MO Core:                 %11s\n", (MO_core_ ? "True" : "False"));
+    outfile->Printf("    Disk I/O:                %11s\n", (mmap_io_ ? "MMAP" : "STDIO"));
+    outfile->Printf("    AO Cache:                %11s\n", (ints_cache_dir_.empty() ? "None" : ints_cache_dir_.c_str()));
     outfile->Printf("    Hold Metric:             %11s\n", (hold_met_ ? "True" : "False"));
     outfile->Printf("    Metric Power:            %11.3f\n", mpower_);
     outfile->Printf("    Fitting Condition:       %11.0E\n", condition_);
@@ -586,6 +644,129 @@ void DFHelper::prepare_AO_core() {
     }
     // outfile->Printf("\n    ==> End AO Blocked Construction <==");
 }
+uint64_t DFHelper::AO_cache_key() {
+    FNVHash hash;
+    hash.add(AO_cache_version);
+    hash.add(cutoff_);
+    hash.add(mpower_);
+    hash.add(condition_);
+
+    // the shell centers carry the geometry
+    for (const auto& basis : {primary_, aux_}) {
+        hash.add(basis->nbf());
+        hash.add(basis->nshell());
+        for (int s = 0; s < basis->nshell(); s++) {
+            const GaussianShell& shell = basis->shell(s);
+            hash.add(shell.am());
+            hash.add(shell.is_pure());
+            hash.add(shell.nprimitive());
+            for (int p = 0; p < shell.nprimitive(); p++) {
+                hash.add(shell.exp(p));
+                hash.add(shell.coef(p));
+            }
+            hash.add(shell.center(), 3 * sizeof(double));
+        }
+    }
+    return hash.value();
+}
+uint64_t DFHelper::AO_cache_mask_key() {
+    FNVHash hash;
+    hash.add(schwarz_fun_index_.data(), schwarz_fun_index_.size() * sizeof(size_t));
+    hash.add(small_skips_.data(), small_skips_.size() * sizeof(size_t));
+    hash.add(big_skips_.data(), big_skips_.size() * sizeof(size_t));
+    return hash.value();
+}
+std::string DFHelper::AO_cache_filename() {
+    char key[17];
+    std::snprintf(key, sizeof(key), "%016llx", (unsigned long long)AO_cache_key());
+    return ints_cache_dir_ + "/dfh.AO." + key + ".dat";
+}
+bool DFHelper::load_AO_cache() {
+#ifdef _MSC_VER
+    return false;
+#else
+    std::string filename = AO_cache_filename();
+    size_t nelem = big_skips_[nbf_];
+    size_t size = sizeof(AOCacheHeader) + nelem * sizeof(double);
+
+    // a missing or wrongly sized entry is a miss
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) || (size_t)st.st_size != size) {
+        close(fd);
+        return false;
+    }
+    void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return false;
+#ifdef MADV_SEQUENTIAL
+    madvise(data, size, MADV_SEQUENTIAL);
+#endif
+
+    // check the header before touching the tensor
+    const AOCacheHeader* header = static_cast<const AOCacheHeader*>(data);
+    const double* tensor = reinterpret_cast<const double*>(static_cast<const char*>(data) + sizeof(AOCacheHeader));
+    bool valid = !std::memcmp(header->magic, AO_cache_magic, sizeof(AO_cache_magic)) &&
+                 header->version == AO_cache_version && header->nelem == nelem && header->key == AO_cache_key() &&
+                 header->mask_key == AO_cache_mask_key() && header->sample_key == AO_cache_sample_key(tensor, nelem);
+
+    if (valid) {
+        timer_on("DFH: AO Cache Read");
+        Ppq_ = std::unique_ptr<double[]>(new double[nelem]);
+        double* ppq = Ppq_.get();
+        const size_t chunk = 1L << 20;
+#pragma omp parallel for num_threads(nthreads_) schedule(static)
+        for (size_t start = 0; start < nelem; start += chunk) {
+            std::memcpy(ppq + start, tensor + start, std::min(chunk, nelem - start) * sizeof(double));
+        }
+        timer_off("DFH: AO Cache Read");
+    }
+    munmap(data, size);
+
+    if (print_lvl_ > 0) {
+        if (valid) {
+            outfile->Printf("  DFHelper: read metric-contracted AOs from the cache (%s).\n\n", filename.c_str());
+        } else {
+            outfile->Printf("  DFHelper: ignoring stale AO cache entry %s.\n\n", filename.c_str());
+        }
+    }
+    return valid;
+#endif
+}
+void DFHelper::store_AO_cache() {
+    std::string filename = AO_cache_filename();
+    std::string tmpname = filename + "." + std::to_string(SYSTEM_GETPID()) + ".tmp";
+    size_t nelem = big_skips_[nbf_];
+
+    AOCacheHeader header;
+    std::memcpy(header.magic, AO_cache_magic, sizeof(AO_cache_magic));
+    header.version = AO_cache_version;
+    header.key = AO_cache_key();
+    header.mask_key = AO_cache_mask_key();
+    header.nelem = nelem;
+    header.sample_key = AO_cache_sample_key(Ppq_.get(), nelem);
+
+    // write under a private name and rename, so no run ever sees a partial entry
+    timer_on("DFH: AO Cache Write");
+    FILE* fp = std::fopen(tmpname.c_str(), "wb");
+    bool written = (fp != nullptr);
+    if (written) {
+        written = (std::fwrite(&header, sizeof(AOCacheHeader), 1, fp) == 1) &&
+                  (std::fwrite(Ppq_.get(), sizeof(double), nelem, fp) == nelem);
+        written = !std::fclose(fp) && written;
+    }
+    if (written) written = !std::rename(tmpname.c_str(), filename.c_str());
+    timer_off("DFH: AO Cache Write");
+
+    // the cache is an optimization, failing to fill it is not an error
+    if (!written) {
+        std::remove(tmpname.c_str());
+        outfile->Printf("  DFHelper: unable to write AO cache entry %s, continuing without it.\n\n", filename.c_str());
+    } else if (print_lvl_ > 0) {
+        outfile->Printf("  DFHelper: wrote metric-contracted AOs to the cache (%s).\n\n", filename.c_str());
+    }
+}
 void DFHelper::prepare_AO_wK_core() {
     // get each thread an eri object
     std::shared_ptr<BasisSet> zero = BasisSet::zero_ao_basis_set();
@@ -842,6 +1023,8 @@ std::tuple<size_t, size_t> DFHelper::Qshell_blocks_for_JK_build(std::vector<std:
         // compute total memory used by aggregate block
         size_t constraint = total_AO_buffer + T1 * tmpbs + T3;
         constraint += (lr_symmetric ? T2 : T2 * tmpbs);
+        // per-thread orbital block, orbital K and K accumulator of the domain contraction
+        if (lr_symmetric && K_domain_cutoff_ > 0.0) constraint += nthreads_ * (2 * nbf_ * nbf_ + nbf_ * tmpbs);
 
         if (constraint > memory_ || i == Qshells_ - 1) {
             if (count == 1 && i != Qshells_ - 1) {
@@ -919,6 +1102,114 @@ void DFHelper::StreamStruct::close_stream() {
     fclose(fp_);
 }
 
+DFHelper::MappedFile* DFHelper::mapped_check(std::string filename) {
+    if (mapped_files_.count(filename) == 0) {
+        mapped_files_[filename] = std::make_shared<MappedFile>(filename);
+    }
+
+    return mapped_files_[filename].get();
+}
+
+DFHelper::MappedFileStruct::MappedFileStruct(std::string filename) : filename_(filename) {
+#ifdef _MSC_VER
+    throw PSIEXCEPTION("DFHelper: memory-mapped disk I/O is not available on this platform");
+#else
+    fd_ = open(filename_.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd_ < 0) {
+        std::stringstream error;
+        error << "DFHelper:MappedFile: unable to open " << filename_;
+        throw PSIEXCEPTION(error.str().c_str());
+    }
+
+    // pick up whatever is already in the file
+    struct stat st;
+    if (!fstat(fd_, &st) && st.st_size > 0) {
+        void* data = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (data == MAP_FAILED) {
+            std::stringstream error;
+            error << "DFHelper:MappedFile: unable to map " << filename_;
+            throw PSIEXCEPTION(error.str().c_str());
+        }
+        data_ = static_cast<char*>(data);
+        mapped_ = st.st_size;
+    }
+#endif
+}
+
+DFHelper::MappedFileStruct::~MappedFileStruct() {
+#ifndef _MSC_VER
+    if (data_) munmap(data_, mapped_);
+    if (fd_ >= 0) close(fd_);
+#endif
+    std::remove(filename_.c_str());
+}
+
+char* DFHelper::MappedFileStruct::reserve(size_t size, bool write) {
+    if (size <= mapped_) return data_;
+    if (!write) {
+        std::stringstream error;
+        error << "DFHelper:MappedFile: read past the end of " << filename_;
+        throw PSIEXCEPTION(error.str().c_str());
+    }
+#ifndef _MSC_VER
+    // grow geometrically, in multiples of the 2 MiB huge page size
+    const size_t align = 2L * 1024L * 1024L;
+    size_t length = std::max(size, 2 * mapped_);
+    length = ((length + align - 1) / align) * align;
+
+    if (data_) munmap(data_, mapped_);
+    data_ = nullptr;
+    mapped_ = 0;
+
+    if (ftruncate(fd_, length)) {
+        std::stringstream error;
+        error << "DFHelper:MappedFile: unable to resize " << filename_;
+        throw PSIEXCEPTION(error.str().c_str());
+    }
+    void* data = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (data == MAP_FAILED) {
+        std::stringstream error;
+        error << "DFHelper:MappedFile: unable to map " << filename_;
+        throw PSIEXCEPTION(error.str().c_str());
+    }
+#ifdef MADV_HUGEPAGE
+    madvise(data, length, MADV_HUGEPAGE);
+#endif
+    data_ = static_cast<char*>(data);
+    mapped_ = length;
+#endif
+    return data_;
+}
+
+void DFHelper::MappedFileStruct::prefetch(size_t offset, size_t size) {
+#ifndef _MSC_VER
+    if (offset >= mapped_ || size == 0) return;
+    size = std::min(size, mapped_ - offset);
+
+    // madvise wants a page-aligned start
+    size_t page = sysconf(_SC_PAGESIZE);
+    size_t begin = (offset / page) * page;
+    madvise(data_ + begin, offset + size - begin, MADV_WILLNEED);
+#endif
+}
+
+void DFHelper::prefetch_AO(const size_t start, const size_t stop) {
+    if (!mmap_io_ || AO_core_ || direct_ || direct_iaQ_) return;
+    if (mapped_files_.count(AO_names_[1]) == 0) return;
+
+    size_t begin = Qshell_aggs_[start];
+    size_t end = Qshell_aggs_[stop + 1] - 1;
+    size_t block_size = end - begin + 1;
+    auto mf = mapped_files_[AO_names_[1]];
+
+    // same access pattern as grab_AO
+    for (size_t i = 0; i < nbf_; i++) {
+        size_t size = block_size * small_skips_[i];
+        size_t jump = begin * small_skips_[i];
+        mf->prefetch((big_skips_[i] + jump) * sizeof(double), size * sizeof(double));
+    }
+}
+
 void DFHelper::put_tensor(std::string file, double* b, std::pair<size_t, size_t> i0, std::pair<size_t, size_t> i1,
                           std::pair<size_t, size_t> i2, std::string op) {
     // collapse to 2D, assume file has form (i1 | i2 i3)
@@ -955,6 +1246,17 @@ void DFHelper::put_tensor(std::string file, double* Mp, const size_t start1, con
     size_t A1 = std::get<1>(sizes_[file]) * std::get<2>(sizes_[file]);
     size_t st = A1 - a1;
 
+    if (mmap_io_) {
+        // the positions are fixed, so op does not matter here
+        size_t offset = start1 * A1 + start2;
+        double* fp = reinterpret_cast<double*>(
+            mapped_check(file)->reserve((offset + (a0 - 1) * A1 + a1) * sizeof(double), true));
+        for (size_t i = 0; i < a0; i++) {
+            std::memcpy(&fp[offset + i * A1], &Mp[i * a1], a1 * sizeof(double));
+        }
+        return;
+    }
+
     // begin stream
     FILE* fp = stream_check(file, op);
 
@@ -991,6 +1293,12 @@ void DFHelper::put_tensor(std::string file, double* Mp, const size_t start1, con
     }
 }
 void DFHelper::put_tensor_AO(std::string file, double* Mp, size_t size, size_t start, std::string op) {
+    if (mmap_io_) {
+        double* fp = reinterpret_cast<double*>(mapped_check(file)->reserve((start + size) * sizeof(double), true));
+        std::memcpy(&fp[start], &Mp[0], size * sizeof(double));
+        return;
+    }
+
     // begin stream
     FILE* fp = stream_check(file, op);
 
@@ -1006,6 +1314,12 @@ void DFHelper::put_tensor_AO(std::string file, double* Mp, size_t size, size_t s
     }
 }
 void DFHelper::get_tensor_AO(std::string file, double* Mp, size_t size, size_t start) {
+    if (mmap_io_) {
+        double* fp = reinterpret_cast<double*>(mapped_check(file)->reserve((start + size) * sizeof(double), false));
+        std::memcpy(&Mp[0], &fp[start], size * sizeof(double));
+        return;
+    }
+
     // begin stream
     FILE* fp = stream_check(file, "rb");
 
@@ -1065,6 +1379,16 @@ void DFHelper::get_tensor_(std::string file, double* b, const size_t start1, con
     size_t A1 = std::get<1>(sizes) * std::get<2>(sizes);
     size_t st = A1 - a1;
 
+    if (mmap_io_) {
+        size_t offset = start1 * A1 + start2;
+        double* fp = reinterpret_cast<double*>(
+            mapped_check(file)->reserve((offset + (a0 - 1) * A1 + a1) * sizeof(double), false));
+        for (size_t i = 0; i < a0; i++) {
+            std::memcpy(&b[i * a1], &fp[offset + i * A1], a1 * sizeof(double));
+        }
+        return;
+    }
+
     // check stream
     FILE* fp = stream_check(file, "rb");
 
@@ -1774,6 +2098,7 @@ void DFHelper::clear_transformations() {
 void DFHelper::clear_all() {
     // invokes destructors, eliminating all files.
     file_streams_.clear();
+    mapped_files_.clear();
 
     // clears all info
     clear_spaces();
@@ -1871,7 +2196,7 @@ void DFHelper::transform() {
     size_t wfinal = std::get<1>(info_);
 
     // prep AO file stream if STORE + !AO_core_
-    if (!direct_iaQ_ && !direct_ && !AO_core_) stream_check(AO_names_[1], "rb");
+    if (!direct_iaQ_ && !direct_ && !AO_core_ && !mmap_io_) stream_check(AO_names_[1], "rb");
 
     // get Q blocking scheme
     std::vector<std::pair<size_t, size_t>> Qsteps;
@@ -1958,6 +2283,7 @@ void DFHelper::transform() {
             } else {
                 timer_on("DFH: Grabbing AOs");
                 grab_AO(start, stop, Mp);
+                if (j + 1 < Qsteps.size()) prefetch_AO(std::get<0>(Qsteps[j + 1]), std::get<1>(Qsteps[j + 1]));
                 timer_off("DFH: Grabbing AOs");
             }
 
@@ -2977,11 +3303,21 @@ void DFHelper::transpose_disk(std::string name, std::tuple<size_t, size_t, size_
         }
     }
     // better be careful
-    remove(filename.c_str());
-    rename(new_filename.c_str(), filename.c_str());
-    file_streams_[filename] = file_streams_[new_filename];
-    stream_check(filename, "rb");
-    file_streams_.erase(new_filename);
+    if (mmap_io_) {
+        // drop (and delete) the old mapping before the new file takes its name
+        mapped_files_.erase(filename);
+        remove(filename.c_str());
+        rename(new_filename.c_str(), filename.c_str());
+        mapped_files_[filename] = mapped_files_[new_filename];
+        mapped_files_[filename]->filename_ = filename;
+        mapped_files_.erase(new_filename);
+    } else {
+        remove(filename.c_str());
+        rename(new_filename.c_str(), filename.c_str());
+        file_streams_[filename] = file_streams_[new_filename];
+        stream_check(filename, "rb");
+        file_streams_.erase(new_filename);
+    }
 
     // keep tsizes_ separate and do not ovwrt sizes_ in case of STORE directive
     files_.erase(new_file);
@@ -3066,7 +3402,7 @@ void DFHelper::compute_JK(std::vector<SharedMatrix> Cleft, std::vector<SharedMat
     size_t totsb = std::get<1>(info);
 
     // prep stream, blocking
-    if (!direct_ && !AO_core_) stream_check(AO_names_[1], "rb");
+    if (!direct_ && !AO_core_ && !mmap_io_) stream_check(AO_names_[1], "rb");
 
     std::vector<std::vector<double>> C_buffers(nthreads_);
 
@@ -3119,12 +3455,25 @@ void DFHelper::compute_JK(std::vector<SharedMatrix> Cleft, std::vector<SharedMat
         M1p = m1Ppq_.get();
     }
 
+    // orbital domains and per-thread buffers for the sparse K contraction
+    bool K_domains = do_K && lr_symmetric && K_domain_cutoff_ > 0.0;
+    std::vector<KDomains> domains;
+    std::vector<std::vector<double>> U_buffers, Ki_buffers, K_buffers;
+    if (K_domains) {
+        timer_on("DFH: K domains");
+        for (size_t i = 0; i < Cleft.size(); i++) domains.push_back(build_K_domains(Cleft[i]));
+        timer_off("DFH: K domains");
+        U_buffers.assign(nthreads_, std::vector<double>(nbf_ * totsb));
+        Ki_buffers.assign(nthreads_, std::vector<double>(nbf_ * nbf_));
+        K_buffers.assign(nthreads_, std::vector<double>(nbf_ * nbf_));
+    }
+
     // Transform a single batch of integrals
     size_t bcount = 0;
-    for (const auto& Qstep :Qsteps) {
+    for (size_t qind = 0; qind < Qsteps.size(); qind++) {
         // Qshell step info
-        auto start = std::get<0>(Qstep);
-        auto stop = std::get<1>(Qstep);
+        auto start = std::get<0>(Qsteps[qind]);
+        auto stop = std::get<1>(Qsteps[qind]);
         auto begin = Qshell_aggs_[start];
         auto end = Qshell_aggs_[stop + 1] - 1;
         auto block_size = end - begin + 1;
@@ -3133,6 +3482,7 @@ void DFHelper::compute_JK(std::vector<SharedMatrix> Cleft, std::vector<SharedMat
         timer_on("DFH: Grabbing AOs");
         if (!AO_core_) {
             grab_AO(start, stop, Mp);
+            if (qind + 1 < Qsteps.size()) prefetch_AO(std::get<0>(Qsteps[qind + 1]), std::get<1>(Qsteps[qind + 1]));
         }
         timer_off("DFH: Grabbing AOs");
         if (do_J) {
@@ -3151,7 +3501,12 @@ void DFHelper::compute_JK(std::vector<SharedMatrix> Cleft, std::vector<SharedMat
 
         if (do_K) {
             timer_on("DFH: compute_K");
-            compute_K(Cleft, Cright, K, T1p, T2p, Mp, bcount, block_size, C_buffers, lr_symmetric);
+            if (K_domains) {
+                compute_K_domains(Cleft, domains, K, T1p, Mp, bcount, block_size, C_buffers, U_buffers, Ki_buffers,
+                                  K_buffers);
+            } else {
+                compute_K(Cleft, Cright, K, T1p, T2p, Mp, bcount, block_size, C_buffers, lr_symmetric);
+            }
             timer_off("DFH: compute_K");
         }
 
@@ -3375,6 +3730,134 @@ void DFHelper::compute_K(std::vector<SharedMatrix> Cleft, std::vector<SharedMatr
                 nbf_);
     }
 }
+DFHelper::KDomains DFHelper::build_K_domains(SharedMatrix C) {
+    size_t nocc = C->colspi()[0];
+    double* Cp = C->pointer()[0];
+
+    KDomains dom;
+    dom.orbitals.resize(nbf_);
+    dom.offsets.assign(nbf_ + 1, 0);
+    dom.functions.resize(nocc);
+    if (!nocc) return dom;
+
+    // orbitals with a significant coefficient on each basis function
+    std::vector<std::vector<size_t>> significant(nbf_);
+#pragma omp parallel for schedule(static) num_threads(nthreads_)
+    for (size_t m = 0; m < nbf_; m++) {
+        for (size_t i = 0; i < nocc; i++) {
+            if (std::fabs(Cp[m * nocc + i]) > K_domain_cutoff_) significant[m].push_back(i);
+        }
+    }
+
+    // (p|Qi) = (pq|Q) C_qi can only be significant if some Schwarz partner q of p is significant in i
+    std::vector<std::vector<char>> marks(nthreads_, std::vector<char>(nocc, 0));
+#pragma omp parallel for schedule(guided) num_threads(nthreads_)
+    for (size_t k = 0; k < nbf_; k++) {
+        int rank = 0;
+#ifdef _OPENMP
+        rank = omp_get_thread_num();
+#endif
+        auto& mark = marks[rank];
+        auto& orbitals = dom.orbitals[k];
+        for (size_t m = 0; m < nbf_; m++) {
+            if (!schwarz_fun_index_[k * nbf_ + m]) continue;
+            for (size_t i : significant[m]) {
+                if (!mark[i]) {
+                    mark[i] = 1;
+                    orbitals.push_back(i);
+                }
+            }
+        }
+        for (size_t i : orbitals) mark[i] = 0;
+        std::sort(orbitals.begin(), orbitals.end());
+    }
+
+    for (size_t k = 0; k < nbf_; k++) {
+        dom.offsets[k + 1] = dom.offsets[k] + dom.orbitals[k].size();
+        for (size_t pos = 0; pos < dom.orbitals[k].size(); pos++) {
+            dom.functions[dom.orbitals[k][pos]].emplace_back(k, pos);
+        }
+    }
+
+    return dom;
+}
+void DFHelper::compute_K_domains(std::vector<SharedMatrix> C, const std::vector<KDomains>& domains,
+                                 std::vector<SharedMatrix> K, double* Tp, double* Mp, size_t bcount,
+                                 size_t block_size, std::vector<std::vector<double>>& C_buffers,
+                                 std::vector<std::vector<double>>& U_buffers,
+                                 std::vector<std::vector<double>>& Ki_buffers,
+                                 std::vector<std::vector<double>>& K_buffers) {
+    for (size_t i = 0; i < K.size(); i++) {
+        size_t nocc = C[i]->colspi()[0];
+        if (!nocc) {
+            continue;
+        }
+
+        const auto& dom = domains[i];
+        double* Cp = C[i]->pointer()[0];
+        double* Kp = K[i]->pointer()[0];
+
+// (Qm)(mi)->(Qi) over the orbitals in the domain of each p, packed p by p
+#pragma omp parallel for schedule(guided) num_threads(nthreads_)
+        for (size_t k = 0; k < nbf_; k++) {
+            const auto& orbitals = dom.orbitals[k];
+            size_t ndom = orbitals.size();
+            if (!ndom) continue;
+
+            size_t sp_size = small_skips_[k];
+            size_t jump = (AO_core_ ? big_skips_[k] + bcount * sp_size : (big_skips_[k] * block_size) / naux_);
+
+            int rank = 0;
+#ifdef _OPENMP
+            rank = omp_get_thread_num();
+#endif
+            double* Cbp = C_buffers[rank].data();
+            for (size_t m = 0, sp_count = 0; m < nbf_; m++) {
+                if (schwarz_fun_index_[k * nbf_ + m]) {
+                    for (size_t j = 0; j < ndom; j++) Cbp[sp_count * ndom + j] = Cp[m * nocc + orbitals[j]];
+                    sp_count++;
+                }
+            }
+
+            C_DGEMM('N', 'N', block_size, ndom, sp_size, 1.0, &Mp[jump], sp_size, Cbp, ndom, 0.0,
+                    &Tp[block_size * dom.offsets[k]], ndom);
+        }
+
+        for (size_t t = 0; t < nthreads_; t++) std::fill(K_buffers[t].begin(), K_buffers[t].end(), 0.0);
+
+// K_pq += (p|Qi)(q|Qi), one orbital at a time over the p in its domain
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads_)
+        for (size_t o = 0; o < nocc; o++) {
+            const auto& functions = dom.functions[o];
+            size_t nfun = functions.size();
+            if (!nfun) continue;
+
+            int rank = 0;
+#ifdef _OPENMP
+            rank = omp_get_thread_num();
+#endif
+            double* Up = U_buffers[rank].data();
+            double* Kip = Ki_buffers[rank].data();
+            double* Ktp = K_buffers[rank].data();
+
+            for (size_t a = 0; a < nfun; a++) {
+                size_t k = functions[a].first;
+                size_t ndom = dom.orbitals[k].size();
+                const double* Tkp = &Tp[block_size * dom.offsets[k] + functions[a].second];
+                for (size_t Q = 0; Q < block_size; Q++) Up[a * block_size + Q] = Tkp[Q * ndom];
+            }
+
+            C_DGEMM('N', 'T', nfun, nfun, block_size, 1.0, Up, block_size, Up, block_size, 0.0, Kip, nfun);
+
+            for (size_t a = 0; a < nfun; a++) {
+                double* Krowp = &Ktp[functions[a].first * nbf_];
+                for (size_t b = 0; b < nfun; b++) Krowp[functions[b].first] += Kip[a * nfun + b];
+            }
+        }
+
+        for (size_t t = 0; t < nthreads_; t++) C_DAXPY(nbf_ * nbf_, 1.0, K_buffers[t].data(), 1, Kp, 1);
+    }
+}
 void DFHelper::compute_wK(std::vector<SharedMatrix> Cleft, std::vector<SharedMatrix> Cright,
                           std::vector<SharedMatrix> wK, size_t max_nocc, bool do_J, bool do_K, bool do_wK) {
     std::vector<std::pair<size_t, size_t>> Qsteps;
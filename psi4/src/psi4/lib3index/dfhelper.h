@@ -33,6 +33,7 @@
 #include <psi4/libmints/typedefs.h>
 #include "psi4/libpsi4util/exception.h"
 
+#include <cstdint>
 #include <map>
 #include <list>
 #include <vector>
@@ -126,6 +127,27 @@ class PSI_API DFHelper {
     void set_MO_core(bool core) { MO_core_ = core; }
     bool get_MO_core() { return MO_core_; }
 
+    ///
+    /// Memory-map the on-disk tensors instead of using stdio streams.
+    /// (Defaults to TRUE if DF_IO_BACKEND is MMAP)
+    /// @param mmap True to read and write the scratch files through mmap
+    /// Slices are copied straight out of / into the page cache, and the
+    /// AO blocks of transform() and the JK builds are prefetched ahead of use.
+    ///
+    void set_mmap_io(bool mmap) { mmap_io_ = mmap; }
+    bool get_mmap_io() { return mmap_io_; }
+
+    ///
+    /// Directory of the persistent cache of metric-contracted AO integrals.
+    /// (Defaults to DF_INTS_CACHE_DIR, empty disables the cache)
+    /// @param dir directory to look up and store the in-core STORE tensors in
+    /// Entries are keyed by a hash of both basis sets, the geometry, and the
+    /// screening and fitting settings, so a later run on the same system
+    /// reads the tensor back instead of recomputing it.
+    ///
+    void set_ints_cache_dir(std::string dir) { ints_cache_dir_ = dir; }
+    std::string get_ints_cache_dir() { return ints_cache_dir_; }
+
     /// schwarz screening cutoff (defaults to 1e-12)
     void set_schwarz_cutoff(double cutoff) { cutoff_ = cutoff; }
     double get_schwarz_cutoff() { return cutoff_; }
@@ -176,6 +198,18 @@ class PSI_API DFHelper {
     void set_do_wK(bool do_wK) { do_wK_ = do_wK; }
     size_t get_do_wK() { return do_wK_; }
 
+    ///
+    /// Contract K over orbital domains instead of the full occupied block.
+    /// Each orbital is only half-transformed for the basis functions p whose
+    /// Schwarz-significant partners q carry a coefficient above the cutoff,
+    /// and K is accumulated orbital by orbital over those p. Pays off for
+    /// localized (e.g. Cholesky) orbitals. Used only when Cleft == Cright.
+    /// @param cutoff coefficient magnitude below which an orbital drops out of a domain,
+    /// 0.0 (default) keeps the dense contraction
+    ///
+    void set_K_domain_cutoff(double cutoff) { K_domain_cutoff_ = cutoff; }
+    double get_K_domain_cutoff() { return K_domain_cutoff_; }
+
     ///
     /// sets the parameter for the other type of integrals
     /// @param omega double indicating parameter for other type
@@ -350,6 +384,10 @@ class PSI_API DFHelper {
     bool AO_core_ = true;
     bool MO_core_ = false;
     bool release_core_AO_before_metric_ = false;
+    // Use the memory-mapped backend for on-disk tensors?
+    bool mmap_io_ = false;
+    // Directory of the persistent AO integral cache, empty if disabled
+    std::string ints_cache_dir_;
     size_t nthreads_ = 1;
     double cutoff_ = 1e-12;
     double condition_ = 1e-12;
@@ -362,6 +400,7 @@ class PSI_API DFHelper {
     bool ordered_ = false;
     bool do_wK_ = false;
     bool wcombine_ = false;
+    double K_domain_cutoff_ = 0.0;
     double omega_;
     double omega_alpha_;
     double omega_beta_;
@@ -388,6 +427,17 @@ class PSI_API DFHelper {
     // => AO building machinery <=
     void prepare_AO();
     void prepare_AO_core();
+
+    // => persistent AO cache <=
+    // Hash of everything the metric-contracted AOs depend on
+    uint64_t AO_cache_key();
+    // Hash of the sparsity masks, must match between the writing and the reading run
+    uint64_t AO_cache_mask_key();
+    std::string AO_cache_filename();
+    // Fill Ppq_ from the cache; false if there is no valid entry
+    bool load_AO_cache();
+    // Write Ppq_ to the cache, replacing the entry atomically
+    void store_AO_cache();
     void compute_dense_Qpq_blocking_Q(const size_t start, const size_t stop, double* Mp,
                                       std::vector<std::shared_ptr<TwoBodyAOInt>> eri);
     void compute_sparse_pQq_blocking_Q(const size_t start, const size_t stop, double* Mp,
@@ -520,6 +570,31 @@ class PSI_API DFHelper {
     std::map<std::string, std::shared_ptr<Stream>> file_streams_;
     FILE* stream_check(std::string filename, std::string op);
 
+    // Memory-mapped alternative to Stream, used if mmap_io_ is set.
+    // The mapping grows with the file in 2 MiB steps, so it stays huge-page friendly.
+    typedef struct MappedFileStruct {
+        MappedFileStruct(std::string filename);
+        ~MappedFileStruct();
+
+        // Returns the start of the mapping, with at least size bytes mapped.
+        // If write, the file is grown as needed; otherwise reading past the end throws.
+        char* reserve(size_t size, bool write);
+        // Ask the kernel to start reading [offset, offset + size) into the page cache
+        void prefetch(size_t offset, size_t size);
+
+        int fd_ = -1;
+        char* data_ = nullptr;
+        // length of the mapping and of the file, in bytes
+        size_t mapped_ = 0;
+        std::string filename_;
+
+    } MappedFile;
+
+    std::map<std::string, std::shared_ptr<MappedFile>> mapped_files_;
+    MappedFile* mapped_check(std::string filename);
+    // Prefetch the AO integrals for Q shells [start, stop] if they are memory-mapped
+    void prefetch_AO(const size_t start, const size_t stop);
+
     // => FILE IO machinery <=
     void put_tensor(std::string file, double* b, std::pair<size_t, size_t> a1, std::pair<size_t, size_t> a2,
                     std::pair<size_t, size_t> a3, std::string op);
@@ -584,6 +659,20 @@ class PSI_API DFHelper {
     void compute_K(std::vector<SharedMatrix> Cleft, std::vector<SharedMatrix> Cright, std::vector<SharedMatrix> K,
                    double* Tp, double* Jtmp, double* Mp, size_t bcount, size_t block_size,
                    std::vector<std::vector<double>>& C_buffers, bool lr_symmetric);
+    // => Orbital domains for the sparse K contraction <=
+    struct KDomains {
+        // orbitals significant for each basis function p, ascending
+        std::vector<std::vector<size_t>> orbitals;
+        // running total of the domain sizes, the offset of p in the (p|Qi) buffer
+        std::vector<size_t> offsets;
+        // (p, position of the orbital in the domain of p) for each orbital
+        std::vector<std::vector<std::pair<size_t, size_t>>> functions;
+    };
+    KDomains build_K_domains(SharedMatrix C);
+    void compute_K_domains(std::vector<SharedMatrix> C, const std::vector<KDomains>& domains,
+                           std::vector<SharedMatrix> K, double* Tp, double* Mp, size_t bcount, size_t block_size,
+                           std::vector<std::vector<double>>& C_buffers, std::vector<std::vector<double>>& U_buffers,
+                           std::vector<std::vector<double>>& Ki_buffers, std::vector<std::vector<double>>& K_buffers);
     // returns tuple(largest AO buffer size, largest Q block size)
     std::tuple<size_t, size_t> Qshell_blocks_for_JK_build(std::vector<std::pair<size_t, size_t>>& b, size_t max_nocc,
                                                           bool lr_symmetric);
@@ -45,7 +45,7 @@
 ** dpd_main.memfree to make sure the malloc() request will not
 ** overrun the user-specified memory limits.  If there is insufficient
 ** memory available, entries are deleted from the dpd_file4_cache (in
-** LRU order) until the memory limits are satisfied.  If, after
+** LRU, priority or cost order, depending on the cachetype) until the memory limits are satisfied.  If, after
 ** deletion of the entire dpd_file4_cache (or at least until no other
 ** zero-priority entries remain), there is still insufficient memory
 ** available to satisfy the request, a nullptr pointer is returned to the
@@ -87,6 +87,12 @@ double **DPD::dpd_block_matrix(size_t n, size_t m) {
 
     //    while((dpd_main.memory - dpd_main.memused - size) < 0) {
     while ((dpd_main.memory - dpd_main.memused) < size) {
+        /* Staging buffers of the I/O pipeline go first */
+        if (!dpd_main.file4_io_requests.empty()) {
+            file4_io_sync_all();
+            continue;
+        }
+
         /* Delete cache entries until there's enough memory or no more cache */
 
         /* Priority-based cache */
@@ -107,6 +113,15 @@ double **DPD::dpd_block_matrix(size_t n, size_t m) {
             }
         }
 
+        /* Size- and cost-weighted cache */
+        else if (dpd_main.cachetype == 2) {
+            if (file4_cache_del_cost()) {
+                file4_cache_print("outfile");
+                outfile->Printf("dpd_block_matrix: n = %zd  m = %zd\n", n, m);
+                dpd_error("dpd_block_matrix: No memory left.", "outfile");
+            }
+        }
+
         else
             dpd_error("LIBDPD Error: invalid cachetype.", "outfile");
     }
@@ -152,6 +167,15 @@ double **DPD::dpd_block_matrix(size_t n, size_t m) {
                 dpd_error("dpd_block_matrix: No memory left.", "outfile");
             }
         }
+
+        /* Size- and cost-weighted cache */
+        else if (dpd_main.cachetype == 2) {
+            if (file4_cache_del_cost()) {
+                file4_cache_print("outfile");
+                outfile->Printf("dpd_block_matrix: n = %zd  m = %zd\n", n, m);
+                dpd_error("dpd_block_matrix: No memory left.", "outfile");
+            }
+        }
     }
 
     /*  memset((void *) B, 0, m*n*sizeof(double)); */
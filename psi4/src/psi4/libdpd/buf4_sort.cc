@@ -113,7 +113,13 @@ namespace psi {
 ** sqrp: IC     ** sqpr: none
 ** srqp: IC     ** srpq: IC
 ** spqr: IC     ** sprq: IC
-** -RAK, Nov. 2005*/
+** -RAK, Nov. 2005
+**
+** With DPD_KERNEL_THREADS (the default) all in-core sorts, sqpr included,
+** go through the threaded, tiled kernel in buf4_sort_incore(); the
+** per-ordering loops below remain for the out-of-core cases and as the
+** serial fallback.
+*/
 
 int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum, int rsnum, const std::string& label) {
     int h, nirreps, row, col, my_irrep, r_irrep;
@@ -212,6 +218,21 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum
         }
     }
 
+    /* Every in-core ordering goes through the threaded, tiled kernel */
+    if (incore && index != pqrs && dpd_main.kernel_threads) {
+        buf4_sort_incore(InBuf, &OutBuf, index, 1.0, 0.0);
+        for (h = 0; h < nirreps; h++) {
+            buf4_mat_irrep_wrt(&OutBuf, h);
+            buf4_mat_irrep_close(&OutBuf, h);
+            buf4_mat_irrep_close(InBuf, h);
+        }
+        buf4_close(&OutBuf);
+#ifdef DPD_TIMER
+        timer_off("buf4_sort");
+#endif
+        return 0;
+    }
+
     switch (index) {
         case pqrs:
             outfile->Printf("\nDPD sort error: invalid index ordering.\n");
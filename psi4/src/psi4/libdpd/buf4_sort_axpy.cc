@@ -158,6 +158,21 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index, int
     if (index == rspq) timer_off("axpy:alloc");
 #endif
 
+    /* Every in-core ordering goes through the threaded, tiled kernel */
+    if (incore && index != pqrs && dpd_main.kernel_threads) {
+        buf4_sort_incore(InBuf, &OutBuf, index, alpha, 1.0);
+        for (h = 0; h < nirreps; h++) {
+            buf4_mat_irrep_wrt(&OutBuf, h);
+            buf4_mat_irrep_close(&OutBuf, h);
+            buf4_mat_irrep_close(InBuf, h);
+        }
+        buf4_close(&OutBuf);
+#ifdef DPD_TIMER
+        timer_off("buf4_sort");
+#endif
+        return 0;
+    }
+
     switch (index) {
         case pqrs:
             outfile->Printf("\nDPD sort error: invalid index ordering.\n");
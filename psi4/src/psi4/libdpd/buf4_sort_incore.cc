@@ -0,0 +1,132 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2026 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+/*! \file
+    \ingroup DPD
+    \brief Threaded, cache-tiled in-core permutation of four-index buffers
+*/
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include "dpd.h"
+#include "psi4/libpsi4util/process.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace psi {
+
+/* Output tiles are this many rows by this many columns */
+#define DPD_SORT_TILE_ROWS 32
+#define DPD_SORT_TILE_COLS 512
+
+/* Below this many elements the sort stays on one thread */
+#define DPD_SORT_MIN_THREADED (1L << 16)
+
+/* The orderings of enum indices, spelled out */
+static const char *const sort_orders[] = {"pqrs", "pqsr", "prqs", "prsq", "psqr", "psrq", "qprs", "qpsr",
+                                          "qrps", "qrsp", "qspr", "qsrp", "rqps", "rqsp", "rpqs", "rpsq",
+                                          "rsqp", "rspq", "sqrp", "sqpr", "srqp", "srpq", "spqr", "sprq"};
+
+/* buf4_sort_incore(): Forms OutBuf = alpha * sort(InBuf) + beta * OutBuf
+** for any ordering of the indices, with all irrep blocks of both buffers
+** already in core.  This is the in-core path of buf4_sort() and
+** buf4_sort_axpy().  Each output element is located in the input through
+** the pair lookup arrays, so one loop covers all orderings.  The output is
+** split into tiles of rows and columns so that the scattered reads from the
+** input stay in cache, and the tiles are shared among the threads.
+**
+** Arguments:
+**   dpdbuf4 *InBuf: A pointer to the input buffer, in core.
+**   dpdbuf4 *OutBuf: A pointer to the output buffer, in core.
+**   enum indices index: The ordering of the input indices in the output.
+**   double alpha: A prefactor for the sorted input.
+**   double beta: A prefactor for the output.  With beta = 0 the output is
+**                not read.
+*/
+
+void DPD::buf4_sort_incore(dpdbuf4 *InBuf, dpdbuf4 *OutBuf, enum indices index, double alpha, double beta) {
+    dpdparams4 *In = InBuf->params;
+    dpdparams4 *Out = OutBuf->params;
+    int nirreps = Out->nirreps;
+    int my_irrep = OutBuf->file.my_irrep;
+
+    /* Position in the output pqrs of each input index */
+    const char *order = sort_orders[index];
+    int src[4];
+    for (int i = 0; i < 4; i++) src[i] = std::strchr(order, "pqrs"[i]) - order;
+
+    std::vector<std::array<int, 3>> tiles;
+    long int total = 0;
+    for (int h = 0; h < nirreps; h++) {
+        int rowtot = Out->rowtot[h];
+        int coltot = Out->coltot[h ^ my_irrep];
+        total += (long)rowtot * coltot;
+        for (int row = 0; row < rowtot; row += DPD_SORT_TILE_ROWS)
+            for (int col = 0; col < coltot; col += DPD_SORT_TILE_COLS) tiles.push_back({h, row, col});
+    }
+
+    int nthreads = 1;
+    if (dpd_main.kernel_threads && total >= DPD_SORT_MIN_THREADED)
+        nthreads = std::min(Process::environment.get_n_threads(), (int)tiles.size());
+    if (nthreads > 1) dpd_main.kernel_threaded_sorts++;
+
+#pragma omp parallel for schedule(dynamic, 1) num_threads(nthreads)
+    for (size_t t = 0; t < tiles.size(); t++) {
+        int h = tiles[t][0];
+        int Hcol = h ^ my_irrep;
+        int row_end = std::min(tiles[t][1] + DPD_SORT_TILE_ROWS, Out->rowtot[h]);
+        int col_end = std::min(tiles[t][2] + DPD_SORT_TILE_COLS, Out->coltot[Hcol]);
+        int orb[4];
+
+        for (int pq = tiles[t][1]; pq < row_end; pq++) {
+            orb[0] = Out->roworb[h][pq][0];
+            orb[1] = Out->roworb[h][pq][1];
+            double *Z = OutBuf->matrix[h][pq];
+
+            for (int rs = tiles[t][2]; rs < col_end; rs++) {
+                orb[2] = Out->colorb[Hcol][rs][0];
+                orb[3] = Out->colorb[Hcol][rs][1];
+
+                int p = orb[src[0]];
+                int q = orb[src[1]];
+                int r = orb[src[2]];
+                int s = orb[src[3]];
+                double value = InBuf->matrix[In->psym[p] ^ In->qsym[q]][In->rowidx[p][q]][In->colidx[r][s]];
+
+                if (beta == 0.0)
+                    Z[rs] = alpha * value;
+                else
+                    Z[rs] = alpha * value + beta * Z[rs];
+            }
+        }
+    }
+}
+
+}  // namespace psi
@@ -43,6 +43,8 @@ DPD::~DPD() {
     file2_cache_close();
     /*  dpd_file4_cache_print(stdout);*/
     file4_cache_close();
+    file4_io_sync_all();
+    dpd_main.io_handler.reset();
 
     if (params4)
         for (i = 0; i < num_pairs; i++)
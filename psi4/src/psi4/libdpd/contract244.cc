@@ -274,83 +274,60 @@ int DPD::contract244(dpdfile2 *X, dpdbuf4 *Y, dpdbuf4 *Z, int sum_X, int sum_Y,
 #endif
             }
 
-            if (rking)
-                for (Hz = 0; Hz < nirreps; Hz++) {
-                    if (!Xtrans && !Ytrans) {
-                        Hx = Hz;
-                        Hy = Hz ^ GX;
-                    } else if (!Xtrans && Ytrans) {
-                        Hx = Hz;
-                        Hy = Hz ^ GX ^ GY;
-                    } else if (Xtrans && !Ytrans) {
-                        Hx = Hz ^ GX;
-                        Hy = Hz ^ GX;
-                    } else if (Xtrans && Ytrans) {
-                        Hx = Hz ^ GX;
-                        Hy = Hz ^ GX ^ GY;
-                    }
-#ifdef DPD_DEBUG
-                    if ((xrow[Hz] != zrow[Hz]) || (ycol[Hz] != zcol[Hz]) || (xcol[Hz] != yrow[Hz])) {
-                        outfile->Printf("** Alignment error in contract244 **\n");
-                        outfile->Printf("** Irrep: %d; Subirrep: %d **\n", hzbuf, Hz);
-                        dpd_error("dpd_contract244", "outfile");
-                    }
-#endif
-                    newmm_rking(X->matrix[Hx], Xtrans, Ymat[Hy], Ytrans, Zmat[Hz], numrows[Hz], numlinks[Hx ^ symlink],
-                                numcols[Hz], alpha, 1.0);
+            /* The sub-irrep blocks of Z are disjoint, so their products may run concurrently */
+            auto subirrep_irreps = [&](int Hz, int &Hx, int &Hy) {
+                if (!Xtrans && !Ytrans) {
+                    Hx = Hz;
+                    Hy = Hz ^ GX;
+                } else if (!Xtrans && Ytrans) {
+                    Hx = Hz;
+                    Hy = Hz ^ GX ^ GY;
+                } else if (Xtrans && !Ytrans) {
+                    Hx = Hz ^ GX;
+                    Hy = Hz ^ GX;
+                } else {
+                    Hx = Hz ^ GX;
+                    Hy = Hz ^ GX ^ GY;
                 }
-            else
-                for (Hz = 0; Hz < nirreps; Hz++) {
-                    if (!Xtrans && !Ytrans) {
-                        Hx = Hz;
-                        Hy = Hz ^ GX;
-                    } else if (!Xtrans && Ytrans) {
-                        Hx = Hz;
-                        Hy = Hz ^ GX ^ GY;
-                    } else if (Xtrans && !Ytrans) {
-                        Hx = Hz ^ GX;
-                        Hy = Hz ^ GX;
-                    } else if (Xtrans && Ytrans) {
-                        Hx = Hz ^ GX;
-                        Hy = Hz ^ GX ^ GY;
-                    }
+            };
 
+            std::vector<long int> subirrep_cost(nirreps);
+            for (Hz = 0; Hz < nirreps; Hz++) {
+                subirrep_irreps(Hz, Hx, Hy);
 #ifdef DPD_DEBUG
-                    if ((xrow[Hz] != zrow[Hz]) || (ycol[Hz] != zcol[Hz]) || (xcol[Hz] != yrow[Hz])) {
-                        outfile->Printf("** Alignment error in contract244 **\n");
-                        outfile->Printf("** Irrep: %d; Subirrep: %d **\n", hzbuf, Hz);
-                        dpd_error("dpd_contract244", "outfile");
-                    }
+                if ((xrow[Hz] != zrow[Hz]) || (ycol[Hz] != zcol[Hz]) || (xcol[Hz] != yrow[Hz])) {
+                    outfile->Printf("** Alignment error in contract244 **\n");
+                    outfile->Printf("** Irrep: %d; Subirrep: %d **\n", hzbuf, Hz);
+                    dpd_error("dpd_contract244", "outfile");
+                }
 #endif
-                    /* outfile->Printf("Hz %d, Hx %d, Hy %d, numrows %d, numlinks %d, numcols %d\n",
-         Hz, Hx, Hy, numrows[Hz],numlinks[Hx],numcols[Hz]); */
-
-                    if (numrows[Hz] && numcols[Hz] && numlinks[Hx ^ symlink]) {
-                        if (!Xtrans && !Ytrans) {
-                            C_DGEMM('n', 'n', numrows[Hz], numcols[Hz], numlinks[Hx ^ symlink], alpha,
-                                    &(X->matrix[Hx][0][0]), numlinks[Hz ^ symlink], &(Ymat[Hy][0][0]), numcols[Hz], 1.0,
-                                    &(Zmat[Hz][0][0]), numcols[Hz]);
-                        } else if (Xtrans && !Ytrans) {
-                            C_DGEMM('t', 'n', numrows[Hz], numcols[Hz], numlinks[Hx ^ symlink], alpha,
-                                    &(X->matrix[Hx][0][0]), numrows[Hz], &(Ymat[Hy][0][0]), numcols[Hz], 1.0,
-                                    &(Zmat[Hz][0][0]), numcols[Hz]);
-                        } else if (!Xtrans && Ytrans) {
-                            C_DGEMM('n', 't', numrows[Hz], numcols[Hz], numlinks[Hx ^ symlink], alpha,
-                                    &(X->matrix[Hx][0][0]), numlinks[Hx ^ symlink], &(Ymat[Hy][0][0]),
-                                    numlinks[Hx ^ symlink], 1.0, &(Zmat[Hz][0][0]), numcols[Hz]);
-                        } else {
-                            C_DGEMM('t', 't', numrows[Hz], numcols[Hz], numlinks[Hx ^ symlink], alpha,
-                                    &(X->matrix[Hx][0][0]), numrows[Hz], &(Ymat[Hy][0][0]), numlinks[Hx ^ symlink], 1.0,
-                                    &(Zmat[Hz][0][0]), numcols[Hz]);
-                        }
-                    }
+                subirrep_cost[Hz] = (long int)numrows[Hz] * numcols[Hz] * numlinks[Hx ^ symlink];
+            }
 
-                    /*
-        newmm(X->matrix[Hx], Xtrans, Ymat[Hy], Ytrans,
-        Zmat[Hz], numrows[Hz], numlinks[Hx^symlink],
-        numcols[Hz], alpha, 1.0);
-      */
+            irrep_schedule(subirrep_cost, [&](int Hz) {
+                int Hx, Hy;
+                subirrep_irreps(Hz, Hx, Hy);
+                if (rking) {
+                    newmm_rking(X->matrix[Hx], Xtrans, Ymat[Hy], Ytrans, Zmat[Hz], numrows[Hz], numlinks[Hx ^ symlink],
+                                numcols[Hz], alpha, 1.0);
+                } else if (!Xtrans && !Ytrans) {
+                    C_DGEMM('n', 'n', numrows[Hz], numcols[Hz], numlinks[Hx ^ symlink], alpha,
+                            &(X->matrix[Hx][0][0]), numlinks[Hz ^ symlink], &(Ymat[Hy][0][0]), numcols[Hz], 1.0,
+                            &(Zmat[Hz][0][0]), numcols[Hz]);
+                } else if (Xtrans && !Ytrans) {
+                    C_DGEMM('t', 'n', numrows[Hz], numcols[Hz], numlinks[Hx ^ symlink], alpha,
+                            &(X->matrix[Hx][0][0]), numrows[Hz], &(Ymat[Hy][0][0]), numcols[Hz], 1.0,
+                            &(Zmat[Hz][0][0]), numcols[Hz]);
+                } else if (!Xtrans && Ytrans) {
+                    C_DGEMM('n', 't', numrows[Hz], numcols[Hz], numlinks[Hx ^ symlink], alpha,
+                            &(X->matrix[Hx][0][0]), numlinks[Hx ^ symlink], &(Ymat[Hy][0][0]),
+                            numlinks[Hx ^ symlink], 1.0, &(Zmat[Hz][0][0]), numcols[Hz]);
+                } else {
+                    C_DGEMM('t', 't', numrows[Hz], numcols[Hz], numlinks[Hx ^ symlink], alpha,
+                            &(X->matrix[Hx][0][0]), numrows[Hz], &(Ymat[Hy][0][0]), numlinks[Hx ^ symlink], 1.0,
+                            &(Zmat[Hz][0][0]), numcols[Hz]);
                 }
+            });
 
             if (sum_Y == 0)
                 buf4_mat_irrep_close(Y, hybuf);
@@ -258,75 +258,60 @@ int DPD::contract424(dpdbuf4 *X, dpdfile2 *Y, dpdbuf4 *Z, int sum_X, int sum_Y,
 #endif
             }
 
-            if (rking)
-                for (Hz = 0; Hz < nirreps; Hz++) {
-                    if (!Xtrans && !Ytrans) {
-                        Hx = Hz;
-                        Hy = Hz ^ GX;
-                    } else if (!Xtrans && Ytrans) {
-                        Hx = Hz;
-                        Hy = Hz ^ GX ^ GY;
-                    } else if (Xtrans && !Ytrans) {
-                        Hx = Hz ^ GX;
-                        Hy = Hz ^ GX;
-                    } else if (Xtrans && Ytrans) {
-                        Hx = Hz ^ GX;
-                        Hy = Hz ^ GX ^ GY;
-                    }
+            /* The sub-irrep blocks of Z are disjoint, so their products may run concurrently */
+            auto subirrep_irreps = [&](int Hz, int &Hx, int &Hy) {
+                if (!Xtrans && !Ytrans) {
+                    Hx = Hz;
+                    Hy = Hz ^ GX;
+                } else if (!Xtrans && Ytrans) {
+                    Hx = Hz;
+                    Hy = Hz ^ GX ^ GY;
+                } else if (Xtrans && !Ytrans) {
+                    Hx = Hz ^ GX;
+                    Hy = Hz ^ GX;
+                } else {
+                    Hx = Hz ^ GX;
+                    Hy = Hz ^ GX ^ GY;
+                }
+            };
+
+            std::vector<long int> subirrep_cost(nirreps);
+            for (Hz = 0; Hz < nirreps; Hz++) {
+                subirrep_irreps(Hz, Hx, Hy);
 #ifdef DPD_DEBUG
-                    if ((xrow[Hz] != zrow[Hz]) || (ycol[Hz] != zcol[Hz]) || (xcol[Hz] != yrow[Hz])) {
-                        outfile->Printf("** Alignment error in contract424 **\n");
-                        outfile->Printf("** Irrep: %d; Subirrep: %d **\n", hxbuf, Hz);
-                        dpd_error("dpd_contract424", "outfile");
-                    }
+                if ((xrow[Hz] != zrow[Hz]) || (ycol[Hz] != zcol[Hz]) || (xcol[Hz] != yrow[Hz])) {
+                    outfile->Printf("** Alignment error in contract424 **\n");
+                    outfile->Printf("** Irrep: %d; Subirrep: %d **\n", hxbuf, Hz);
+                    dpd_error("dpd_contract424", "outfile");
+                }
 #endif
-                    /* outfile->Printf("Hx %d Hy %d Hz %d\n",Hx,Hy,Hz);
-         outfile->Printf("numrows %d numlinks %d numcols %d\n",numrows[Hz],numlinks[Hy],numcols[Hz]); */
+                subirrep_cost[Hz] = (long int)numrows[Hz] * numcols[Hz] * numlinks[Hy ^ symlink];
+            }
+
+            irrep_schedule(subirrep_cost, [&](int Hz) {
+                int Hx, Hy;
+                subirrep_irreps(Hz, Hx, Hy);
+                if (rking) {
                     newmm_rking(Xmat[Hx], Xtrans, Y->matrix[Hy], Ytrans, Zmat[Hz], numrows[Hz], numlinks[Hy ^ symlink],
                                 numcols[Hz], alpha, 1.0);
+                } else if (!Xtrans && !Ytrans) {
+                    C_DGEMM('n', 'n', numrows[Hz], numcols[Hz], numlinks[Hy ^ symlink], alpha,
+                            &(Xmat[Hz][0][0]), numlinks[Hy ^ symlink], &(Y->matrix[Hy][0][0]), numcols[Hz], 1.0,
+                            &(Zmat[Hz][0][0]), numcols[Hz]);
+                } else if (Xtrans && !Ytrans) {
+                    C_DGEMM('t', 'n', numrows[Hz], numcols[Hz], numlinks[Hy ^ symlink], alpha,
+                            &(Xmat[Hz][0][0]), numrows[Hz], &(Y->matrix[Hy][0][0]), numcols[Hz], 1.0,
+                            &(Zmat[Hz][0][0]), numcols[Hz]);
+                } else if (!Xtrans && Ytrans) {
+                    C_DGEMM('n', 't', numrows[Hz], numcols[Hz], numlinks[Hy ^ symlink], alpha,
+                            &(Xmat[Hz][0][0]), numlinks[Hy ^ symlink], &(Y->matrix[Hy][0][0]),
+                            numlinks[Hy ^ symlink], 1.0, &(Zmat[Hz][0][0]), numcols[Hz]);
+                } else {
+                    C_DGEMM('t', 't', numrows[Hz], numcols[Hz], numlinks[Hy ^ symlink], alpha,
+                            &(Xmat[Hz][0][0]), numrows[Hz], &(Y->matrix[Hy][0][0]), numlinks[Hy ^ symlink], 1.0,
+                            &(Zmat[Hz][0][0]), numcols[Hz]);
                 }
-            else
-                for (Hz = 0; Hz < nirreps; Hz++) {
-                    if (!Xtrans && !Ytrans) {
-                        Hx = Hz;
-                        Hy = Hz ^ GX;
-                    } else if (!Xtrans && Ytrans) {
-                        Hx = Hz;
-                        Hy = Hz ^ GX ^ GY;
-                    } else if (Xtrans && !Ytrans) {
-                        Hx = Hz ^ GX;
-                        Hy = Hz ^ GX;
-                    } else if (Xtrans && Ytrans) {
-                        Hx = Hz ^ GX;
-                        Hy = Hz ^ GX ^ GY;
-                    }
-#ifdef DPD_DEBUG
-                    if ((xrow[Hz] != zrow[Hz]) || (ycol[Hz] != zcol[Hz]) || (xcol[Hz] != yrow[Hz])) {
-                        outfile->Printf("** Alignment error in contract424 **\n");
-                        outfile->Printf("** Irrep: %d; Subirrep: %d **\n", hxbuf, Hz);
-                        dpd_error("dpd_contract424", "outfile");
-                    }
-#endif
-                    if (numrows[Hz] && numcols[Hz] && numlinks[Hy ^ symlink]) {
-                        if (!Xtrans && !Ytrans) {
-                            C_DGEMM('n', 'n', numrows[Hz], numcols[Hz], numlinks[Hy ^ symlink], alpha,
-                                    &(Xmat[Hz][0][0]), numlinks[Hy ^ symlink], &(Y->matrix[Hy][0][0]), numcols[Hz], 1.0,
-                                    &(Zmat[Hz][0][0]), numcols[Hz]);
-                        } else if (Xtrans && !Ytrans) {
-                            C_DGEMM('t', 'n', numrows[Hz], numcols[Hz], numlinks[Hy ^ symlink], alpha,
-                                    &(Xmat[Hz][0][0]), numrows[Hz], &(Y->matrix[Hy][0][0]), numcols[Hz], 1.0,
-                                    &(Zmat[Hz][0][0]), numcols[Hz]);
-                        } else if (!Xtrans && Ytrans) {
-                            C_DGEMM('n', 't', numrows[Hz], numcols[Hz], numlinks[Hy ^ symlink], alpha,
-                                    &(Xmat[Hz][0][0]), numlinks[Hy ^ symlink], &(Y->matrix[Hy][0][0]),
-                                    numlinks[Hy ^ symlink], 1.0, &(Zmat[Hz][0][0]), numcols[Hz]);
-                        } else {
-                            C_DGEMM('t', 't', numrows[Hz], numcols[Hz], numlinks[Hy ^ symlink], alpha,
-                                    &(Xmat[Hz][0][0]), numrows[Hz], &(Y->matrix[Hy][0][0]), numlinks[Hy ^ symlink], 1.0,
-                                    &(Zmat[Hz][0][0]), numcols[Hz]);
-                        }
-                    }
-                }
+            });
 
             if (sum_X == 0)
                 buf4_mat_irrep_close(X, hxbuf);
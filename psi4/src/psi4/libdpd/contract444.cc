@@ -32,13 +32,21 @@
 */
 #include <cstdio>
 #include <cmath>
+#include <cstring>
 #include "psi4/libqt/qt.h"
 #include "psi4/libpsio/psio.h"
 #include "dpd.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/libpsi4util/process.h"
 
 namespace psi {
 
+/* Do two buffers hold the same DPD file? */
+static bool contract444_shares_file(dpdbuf4 *A, dpdbuf4 *B) {
+    return A->file.filenum == B->file.filenum && A->file.dpdnum == B->file.dpdnum &&
+           !strcmp(A->file.label, B->file.label);
+}
+
 /* dpd_contract444(): Contracts a pair of four-index quantities to
 ** give a product four-index quantity.
 **
@@ -116,7 +124,8 @@ int DPD::contract444(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z, int target_X, int targe
     }
 #endif
 
-    for (Hx = 0; Hx < nirreps; Hx++) {
+    /* Irreps of the Y and Z blocks that go with irrep Hx of X */
+    auto partner_irreps = [&](int Hx, int &Hy, int &Hz) {
         if ((!Xtrans) && (!Ytrans)) {
             Hy = Hx ^ GX;
             Hz = Hx;
@@ -130,6 +139,55 @@ int DPD::contract444(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z, int target_X, int targe
             Hy = Hx ^ GY;
             Hz = Hx ^ GX;
         }
+    };
+
+    /* With every block in core at once, read them all and contract the irreps concurrently */
+    if (dpd_main.kernel_threads && nirreps > 1 && Process::environment.get_n_threads() > 1 && X != Y &&
+        !contract444_shares_file(X, Z) && !contract444_shares_file(Y, Z)) {
+        long int core_total = 0;
+        std::vector<long int> cost(nirreps);
+        for (Hx = 0; Hx < nirreps; Hx++) {
+            partner_irreps(Hx, Hy, Hz);
+            core_total += ((long)X->params->rowtot[Hx]) * ((long)X->params->coltot[Hx ^ GX]);
+            core_total += ((long)Y->params->rowtot[Hy]) * ((long)Y->params->coltot[Hy ^ GY]);
+            core_total += ((long)Z->params->rowtot[Hz]) * ((long)Z->params->coltot[Hz ^ GZ]);
+            cost[Hx] = ((long)Z->params->rowtot[Hz]) * ((long)Z->params->coltot[Hz ^ GZ]) * numlinks[Hx ^ symlink];
+        }
+
+        if (core_total < dpd_memfree()) {
+            for (Hx = 0; Hx < nirreps; Hx++) {
+                partner_irreps(Hx, Hy, Hz);
+                buf4_mat_irrep_init(X, Hx);
+                buf4_mat_irrep_rd(X, Hx);
+                buf4_mat_irrep_init(Y, Hy);
+                buf4_mat_irrep_rd(Y, Hy);
+                buf4_mat_irrep_init(Z, Hz);
+                if (std::fabs(beta) > 0.0) buf4_mat_irrep_rd(Z, Hz);
+            }
+
+            irrep_schedule(cost, [&](int Hx) {
+                int Hy, Hz;
+                partner_irreps(Hx, Hy, Hz);
+                C_DGEMM(Xtrans ? 't' : 'n', Ytrans ? 't' : 'n', Z->params->rowtot[Hz], Z->params->coltot[Hz ^ GZ],
+                        numlinks[Hx ^ symlink], alpha, &(X->matrix[Hx][0][0]), X->params->coltot[Hx ^ GX],
+                        &(Y->matrix[Hy][0][0]), Y->params->coltot[Hy ^ GY], beta, &(Z->matrix[Hz][0][0]),
+                        Z->params->coltot[Hz ^ GZ]);
+            });
+
+            for (Hx = 0; Hx < nirreps; Hx++) {
+                partner_irreps(Hx, Hy, Hz);
+                buf4_mat_irrep_close(X, Hx);
+                buf4_mat_irrep_wrt(Z, Hz);
+                buf4_mat_irrep_close(Y, Hy);
+                buf4_mat_irrep_close(Z, Hz);
+            }
+
+            return 0;
+        }
+    }
+
+    for (Hx = 0; Hx < nirreps; Hx++) {
+        partner_irreps(Hx, Hy, Hz);
 
         size_Y = ((long)Y->params->rowtot[Hy]) * ((long)Y->params->coltot[Hy ^ GY]);
         size_Z = ((long)Z->params->rowtot[Hz]) * ((long)Z->params->coltot[Hz ^ GZ]);
@@ -145,11 +203,15 @@ int DPD::contract444(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z, int target_X, int targe
 
             if (rows_per_bucket > X->params->rowtot[Hx]) rows_per_bucket = X->params->rowtot[Hx];
 
+            /* Out of core, leave room to prefetch the next bucket while working on this one */
+            if (dpd_main.io_pipeline && rows_per_bucket < X->params->rowtot[Hx]) rows_per_bucket /= 2;
+
             if (!rows_per_bucket) dpd_error("contract444: Not enough memory for one row", "outfile");
 
             nbuckets = (int)ceil((double)X->params->rowtot[Hx] / (double)rows_per_bucket);
 
-            rows_left = X->params->rowtot[Hx] % rows_per_bucket;
+            /* The last bucket may be full, too */
+            rows_left = X->params->rowtot[Hx] - (nbuckets - 1) * rows_per_bucket;
 
             incore = true;
             if (nbuckets > 1) incore = false;
@@ -191,6 +253,15 @@ int DPD::contract444(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z, int target_X, int targe
             buf4_mat_irrep_init(Z, Hz);
             if (std::fabs(beta) > 0.0) buf4_mat_irrep_rd(Z, Hz);
 
+            /* Start reading the blocks of the next irrep while this one is contracted */
+            if (dpd_main.io_pipeline && Hx + 1 < nirreps) {
+                int Hy_next, Hz_next;
+                partner_irreps(Hx + 1, Hy_next, Hz_next);
+                buf4_mat_irrep_prefetch(X, Hx + 1);
+                buf4_mat_irrep_prefetch(Y, Hy_next);
+                if (std::fabs(beta) > 0.0) buf4_mat_irrep_prefetch(Z, Hz_next);
+            }
+
             if (Z->params->rowtot[Hz] && Z->params->coltot[Hz ^ GZ] && numlinks[Hx ^ symlink]) {
                 C_DGEMM(Xtrans ? 't' : 'n', Ytrans ? 't' : 'n', Z->params->rowtot[Hz], Z->params->coltot[Hz ^ GZ],
                         numlinks[Hx ^ symlink], alpha, &(X->matrix[Hx][0][0]), X->params->coltot[Hx ^ GX],
@@ -223,6 +294,11 @@ int DPD::contract444(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z, int target_X, int targe
                 else
                     buf4_mat_irrep_rd_block(X, Hx, n * rows_per_bucket, rows_left);
 
+                /* Start reading the next bucket while this one is contracted */
+                if (n + 1 < nbuckets)
+                    buf4_mat_irrep_prefetch_block(X, Hx, (n + 1) * rows_per_bucket,
+                                                  (n + 1 < nbuckets - 1) ? rows_per_bucket : rows_left);
+
                 if (!Xtrans && Ytrans) {
                     nrows = n < (nbuckets - 1) ? rows_per_bucket : rows_left;
                     ncols = Z->params->coltot[Hz ^ GZ];
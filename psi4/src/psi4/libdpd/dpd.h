@@ -34,6 +34,9 @@
 #define _psi_src_lib_libdpd_dpd_h
 
 #include <cstdio>
+#include <functional>
+#include <list>
+#include <map>
 #include <string>
 #include "psi4/psifiles.h"
 #include "psi4/libpsio/config.h"
@@ -48,6 +51,7 @@
 namespace psi {
 
 class Matrix;
+class AIOHandler;
 
 #define T3_TIMER_ON (0)
 
@@ -173,6 +177,7 @@ struct dpd_file4_cache_entry {
     size_t access;               /* access time */
     size_t usage;                /* number of accesses */
     size_t priority;             /* priority level */
+    double frequency;            /* access count, decayed with the access clock (COST cache) */
     bool lock;                    /* auto-deletion allowed? */
     bool clean;                   /* has this file4 changed? */
     dpd_file4_cache_entry *next; /* pointer to next cache entry */
@@ -195,6 +200,33 @@ struct dpd_file2_cache_entry {
     dpd_file2_cache_entry *last; /* pointer to previous cache entry */
 };
 
+/* DPD File4 asynchronous I/O requests (prefetches and write-behinds of irrep blocks) */
+struct dpd_file4_io_request {
+    int filenum;             /* libpsio unit number */
+    char label[PSIO_KEYLEN]; /* libpsio TOC keyword */
+    int irrep;               /* irrep block */
+    int start_pq;            /* first row of the block */
+    int num_pq;              /* number of rows */
+    int coltot;              /* length of a row */
+    bool write;              /* write-behind (or prefetch)? */
+    size_t jobid;            /* AIOHandler job ID */
+    double **buffer;         /* staging buffer from dpd_block_matrix() */
+    psio_address end;        /* end address filled in by the AIOHandler */
+};
+
+/* DPD File4 I/O statistics, per libpsio unit */
+struct dpd_file4_io_stats {
+    size_t hits = 0;           /* irrep block reads served from the file4 cache */
+    size_t prefetch_hits = 0;  /* irrep block reads served from a prefetch staging buffer */
+    size_t misses = 0;         /* irrep block reads that went to disk */
+    size_t bytes_read = 0;     /* bytes read from disk, prefetches included */
+    size_t bytes_written = 0;  /* bytes written to disk */
+    size_t evictions = 0;      /* cache entries released to make room */
+    int row_irrep = -1;        /* irrep, next row and label of the last row read, so that */
+    int row_next = -1;         /* rows streamed one after the other count as one block read */
+    char row_label[PSIO_KEYLEN] = "";
+};
+
 /* DPD global parameter set */
 struct dpd_data {
     int nirreps;
@@ -249,6 +281,7 @@ struct dpd_gbl {
     long int memused;   /* Total memory used (cache + other) */
     long int memcache;  /* Total memory in cache (locked and unlocked) */
     long int memlocked; /* Total memory locked in the cache */
+    long int memstaged; /* Total memory in staging buffers of the I/O pipeline (reclaimable) */
 
     // The default C'tor will zero everything out properly
     dpd_gbl()
@@ -257,17 +290,30 @@ struct dpd_gbl {
           file4_cache_most_recent(0),
           file4_cache_least_recent(1),
           file4_cache_lru_del(0),
-          file4_cache_low_del(0) {}
+          file4_cache_low_del(0),
+          file4_cache_cost_del(0),
+          io_pipeline(false),
+          kernel_threads(false),
+          kernel_concurrent(0),
+          kernel_threaded_sorts(0) {}
     dpd_file2_cache_entry *file2_cache;
     dpd_file4_cache_entry *file4_cache;
     size_t file4_cache_most_recent;
     size_t file4_cache_least_recent;
     size_t file4_cache_lru_del;
     size_t file4_cache_low_del;
-    int cachetype;
+    size_t file4_cache_cost_del;
+    int cachetype; /* 0 = LRU, 1 = LOW (priority), 2 = COST (size/cost/frequency) */
     int *cachefiles;
     int **cachelist;
     dpd_file4_cache_entry *file4_cache_priority;
+    bool io_pipeline;                                  /* Prefetch and write-behind file4 blocks? */
+    bool kernel_threads;                               /* Threaded in-core sorts and concurrent irrep blocks? */
+    size_t kernel_concurrent;                          /* Kernels whose irrep blocks ran concurrently */
+    size_t kernel_threaded_sorts;                      /* In-core sorts that ran on several threads */
+    std::shared_ptr<AIOHandler> io_handler;            /* Created on first use */
+    std::list<dpd_file4_io_request> file4_io_requests; /* Outstanding requests, in submission order */
+    std::map<int, dpd_file4_io_stats> file4_io_stats;  /* Reported and reset when the last DPD closes */
 };
 
 /* Useful for the generalized 4-index sorting function */
@@ -306,6 +352,8 @@ class PSI_API DPD {
     // Removes the file from cache and writes it to disk instead, returning the next entry in cache.
     // Assumes the entry and the File and the main dpd object all match. Caller must guarantee that..
     dpd_file4_cache_entry* file4_cache_del_raw(dpd_file4_cache_entry *entry, dpdfile4& File);
+    // Wait for an I/O request, free its staging buffer and remove it, returning the next request.
+    std::list<dpd_file4_io_request>::iterator file4_io_retire(std::list<dpd_file4_io_request>::iterator request);
 
    public:
     // These used to live in the dpd_data struct
@@ -352,6 +400,7 @@ class PSI_API DPD {
     int contract424(dpdbuf4 *X, dpdfile2 *Y, dpdbuf4 *Z, int sum_X, int sum_Y, int trans_Z, double alpha, double beta);
     int contract444(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z, int target_X, int target_Y, double alpha, double beta);
     int contract444_df(dpdbuf4 *B, dpdbuf4 *tau_in, dpdbuf4 *tau_out, double alpha, double beta);
+    void irrep_schedule(const std::vector<long int> &cost, const std::function<void(int)> &task);
 
     /* Need to consolidate these routines into one general function */
     int dot23(dpdfile2 *T, dpdbuf4 *I, dpdfile2 *Z, int transt, int transz, double alpha, double beta);
@@ -411,6 +460,7 @@ class PSI_API DPD {
     int buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum, int rsnum, const std::string& label);
     int buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index, std::string pq, std::string rs,
                   const std::string& label);
+    void buf4_sort_incore(dpdbuf4 *InBuf, dpdbuf4 *OutBuf, enum indices index, double alpha, double beta);
     int buf4_sort_ooc(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum, int rsnum, const char *label);
     int buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index, int pqnum, int rsnum, const char *label,
                        double alpha);
@@ -483,6 +533,12 @@ class PSI_API DPD {
     void file4_cache_del_filenum(size_t filenum);
     dpd_file4_cache_entry *file4_cache_find_lru();
     int file4_cache_del_lru();
+    // Return the unlocked entry that is cheapest to lose: lowest decayed access frequency times re-read
+    // cost per byte of memory it holds. Returns nullptr if there is no cache or everything is locked.
+    dpd_file4_cache_entry *file4_cache_find_cost();
+    // Delete the entry found by file4_cache_find_cost().
+    // Returns 1 if no candidates to delete were found, 0 on success.
+    int file4_cache_del_cost();
     // Sets the file's clean flag to false.
     // Errors if the file isn't supposed to be in cache, or the file isn't found.
     void file4_cache_dirty(dpdfile4 *File);
@@ -491,6 +547,26 @@ class PSI_API DPD {
     // Mark the file as unlocked and update dpd_main.memlocked.
     void file4_cache_unlock(dpdfile4 *File);
 
+    // Start reading an irrep (or rows [start_pq, start_pq + num_pq) of it) into a staging buffer in the background,
+    // if the I/O pipeline is on and there is free memory. A later read of the same rows is served from the buffer.
+    int file4_mat_irrep_prefetch(dpdfile4 *File, int irrep);
+    int file4_mat_irrep_prefetch_block(dpdfile4 *File, int irrep, int start_pq, int num_pq);
+    // Same for a buffer that is read straight from its file4 (no sorting or antisymmetrization); a no-op otherwise.
+    int buf4_mat_irrep_prefetch(dpdbuf4 *Buf, int irrep);
+    int buf4_mat_irrep_prefetch_block(dpdbuf4 *Buf, int irrep, int start_pq, int num_pq);
+    // Read rows of an irrep into File->matrix[irrep] from a finished prefetch. Returns false if there is none, after
+    // waiting for the write-behinds to those rows.
+    bool file4_io_fetch(dpdfile4 *File, int irrep, int start_pq, int num_pq);
+    // Queue a write-behind of rows of an irrep from File->matrix[irrep]. Returns false if the caller has to write
+    // them itself, after waiting for all outstanding I/O on those rows.
+    bool file4_io_write(dpdfile4 *File, int irrep, int start_pq, int num_pq);
+    // Wait for all outstanding I/O on rows of an irrep, releasing the staging buffers.
+    void file4_io_sync_rows(dpdfile4 *File, int irrep, int start_pq, int num_pq);
+    // Wait for all outstanding I/O on a file4, on a libpsio unit, or anywhere, releasing the staging buffers.
+    void file4_io_sync(dpdfile4 *File);
+    void file4_io_sync_filenum(size_t filenum);
+    void file4_io_sync_all();
+
     void sort_3d(double ***Win, double ***Wout, int nirreps, int h, int *rowtot, int **rowidx, int ***roworb, int *asym,
                  int *bsym, int *aoff, int *boff, Dimension const& cpi, int *coff, int **rowidx_out, enum pattern index, int sum);
 
@@ -562,6 +638,7 @@ extern int dpd_init(int dpd_num, int nirreps, long int memory, int cachetype, in
 extern int dpd_close(int dpd_num);
 extern long int PSI_API dpd_memfree();
 extern void dpd_memset(long int memory);
+extern void dpd_file4_io_stats_print(std::string out_fname = "outfile");
 
 }  // Namespace psi
 
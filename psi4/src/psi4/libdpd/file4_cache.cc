@@ -30,6 +30,8 @@
     \ingroup DPD
     \brief Enter brief description of file here
 */
+#include <algorithm>
+#include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -38,12 +40,28 @@
 #include "psi4/libpsi4util/PsiOutStream.h"
 namespace psi {
 
+namespace {
+
+/* Access counts of the COST cache lose half their weight every this many cache accesses */
+constexpr double file4_cache_halflife = 256.0;
+/* Re-read cost model of the COST cache: one seek per irrep block plus the transfer */
+constexpr double file4_cache_seek_time = 1.0e-4; /* s */
+constexpr double file4_cache_bandwidth = 5.0e8;  /* bytes/s */
+
+/* Access count of an entry as seen at access time now */
+double file4_cache_decayed_frequency(const dpd_file4_cache_entry *entry, size_t now) {
+    return entry->frequency * std::exp2(-static_cast<double>(now - entry->access) / file4_cache_halflife);
+}
+
+}  // namespace
+
 void DPD::file4_cache_init() {
     dpd_main.file4_cache = nullptr;
     dpd_main.file4_cache_most_recent = 0;
     dpd_main.file4_cache_least_recent = 1;
     dpd_main.file4_cache_lru_del = 0;
     dpd_main.file4_cache_low_del = 0;
+    dpd_main.file4_cache_cost_del = 0;
 }
 
 void DPD::file4_cache_close() {
@@ -93,6 +111,8 @@ dpd_file4_cache_entry *DPD::file4_cache_scan(int filenum, int irrep, int pqnum,
 #endif
             /* increment the access timers */
             dpd_main.file4_cache_most_recent++;
+            this_entry->frequency =
+                file4_cache_decayed_frequency(this_entry, dpd_main.file4_cache_most_recent) + 1.0;
             this_entry->access = dpd_main.file4_cache_most_recent;
 
             /* increment the usage counter */
@@ -175,6 +195,7 @@ void DPD::file4_cache_add(dpdfile4 *File, size_t priority) {
 
         /* initialize the usage counter */
         this_entry->usage = 1;
+        this_entry->frequency = 1.0;
 
         /* Set the clean flag */
         this_entry->clean = true;
@@ -279,8 +300,8 @@ void DPD::file4_cache_print(std::string out) {
     printer->Printf("--------------------------------------------------------------------------------\n");
     printer->Printf("Total cached: %8.1f kB; MRU = %6zu; LRU = %6zu\n", (total_size * sizeof(double)) / 1e3,
                     dpd_main.file4_cache_most_recent, dpd_main.file4_cache_least_recent);
-    printer->Printf("#LRU deletions = %6zu; #Low-priority deletions = %6zu\n", dpd_main.file4_cache_lru_del,
-                    dpd_main.file4_cache_low_del);
+    printer->Printf("#LRU deletions = %6zu; #Low-priority deletions = %6zu; #Cost deletions = %6zu\n",
+                    dpd_main.file4_cache_lru_del, dpd_main.file4_cache_low_del, dpd_main.file4_cache_cost_del);
     printer->Printf("Core max size:  %9.1f kB\n", (dpd_main.memory) * sizeof(double) / 1e3);
     printer->Printf("Core used:      %9.1f kB\n", (dpd_main.memused) * sizeof(double) / 1e3);
     printer->Printf("Core available: %9.1f kB\n", dpd_memfree() * sizeof(double) / 1e3);
@@ -347,6 +368,7 @@ int DPD::file4_cache_del_lru() {
 
         /* increment the global LRU deletion counter */
         dpd_main.file4_cache_lru_del++;
+        dpd_main.file4_io_stats[this_entry->filenum].evictions++;
 
         /* Save the current dpd_default */
         dpdnum = dpd_default;
@@ -451,6 +473,7 @@ int DPD::file4_cache_del_low() {
 
         /* increment the global LOW deletion counter */
         dpd_main.file4_cache_low_del++;
+        dpd_main.file4_io_stats[this_entry->filenum].evictions++;
 
         /* save the current dpd default value */
         dpdnum = dpd_default;
@@ -473,6 +496,73 @@ int DPD::file4_cache_del_low() {
     }
 }
 
+dpd_file4_cache_entry *DPD::file4_cache_find_cost() {
+    dpd_file4_cache_entry *this_entry, *cost_entry = nullptr;
+    double cost_value = 0.0;
+
+    for (this_entry = dpd_main.file4_cache; this_entry != nullptr; this_entry = this_entry->next) {
+        if (this_entry->lock) continue;
+
+        /* Time to bring the entry back in, plus writing it out first if it has changed */
+        double bytes = static_cast<double>(this_entry->size) * sizeof(double);
+        int nirreps = dpd_list[this_entry->dpdnum]->params4[this_entry->pqnum][this_entry->rsnum].nirreps;
+        double cost = nirreps * file4_cache_seek_time + bytes / file4_cache_bandwidth;
+        if (!this_entry->clean) cost += bytes / file4_cache_bandwidth;
+
+        /* Expected re-read time saved per byte of memory the entry holds */
+        double value = file4_cache_decayed_frequency(this_entry, dpd_main.file4_cache_most_recent) * cost /
+                       std::max(bytes, static_cast<double>(sizeof(double)));
+
+        if (cost_entry == nullptr || value < cost_value) {
+            cost_entry = this_entry;
+            cost_value = value;
+        }
+    }
+
+    return cost_entry;
+}
+
+int DPD::file4_cache_del_cost() {
+    int dpdnum;
+    dpdfile4 File;
+    dpd_file4_cache_entry *this_entry;
+
+#ifdef DPD_TIMER
+    timer_on("cache_cost");
+#endif
+
+    this_entry = file4_cache_find_cost();
+
+    if (this_entry == nullptr) {
+#ifdef DPD_TIMER
+        timer_off("cache_cost");
+#endif
+        return 1; /* there is no cache or everything is locked */
+    }
+
+    /* increment the global COST deletion counter */
+    dpd_main.file4_cache_cost_del++;
+    dpd_main.file4_io_stats[this_entry->filenum].evictions++;
+
+    /* save the current dpd default value */
+    dpdnum = dpd_default;
+    dpd_set_default(this_entry->dpdnum);
+
+    file4_init(&File, this_entry->filenum, this_entry->irrep, this_entry->pqnum, this_entry->rsnum,
+               this_entry->label);
+    file4_cache_del(&File);
+    file4_close(&File);
+
+    /* return the default dpd to its original value */
+    dpd_set_default(dpdnum);
+
+#ifdef DPD_TIMER
+    timer_off("cache_cost");
+#endif
+
+    return 0;
+}
+
 void DPD::file4_cache_lock(dpdfile4 *File) {
     int h;
     dpd_file4_cache_entry *this_entry;
@@ -507,4 +597,33 @@ void DPD::file4_cache_unlock(dpdfile4 *File) {
     }
 }
 
+void dpd_file4_io_stats_print(std::string out) {
+    if (dpd_main.file4_io_stats.empty()) return;
+
+    std::shared_ptr<psi::PsiOutStream> printer = (out == "outfile" ? outfile : std::make_shared<PsiOutStream>(out));
+    dpd_file4_io_stats total;
+
+    printer->Printf("\n\tDPD File4 I/O Statistics:\n\n");
+    printer->Printf("\tUnit      Hits  Prefetched    Misses  Hit rate   Read (MB)  Written (MB)  Evictions\n");
+    printer->Printf("\t-------------------------------------------------------------------------------------\n");
+    for (const auto &unit : dpd_main.file4_io_stats) {
+        const auto &stats = unit.second;
+        size_t reads = stats.hits + stats.prefetch_hits + stats.misses;
+        printer->Printf("\t%4d  %8zu  %10zu  %8zu  %7.1f%%  %10.1f  %12.1f  %9zu\n", unit.first, stats.hits,
+                        stats.prefetch_hits, stats.misses, reads ? 100.0 * stats.hits / reads : 0.0,
+                        stats.bytes_read / 1e6, stats.bytes_written / 1e6, stats.evictions);
+        total.hits += stats.hits;
+        total.prefetch_hits += stats.prefetch_hits;
+        total.misses += stats.misses;
+        total.bytes_read += stats.bytes_read;
+        total.bytes_written += stats.bytes_written;
+        total.evictions += stats.evictions;
+    }
+    size_t reads = total.hits + total.prefetch_hits + total.misses;
+    printer->Printf("\t-------------------------------------------------------------------------------------\n");
+    printer->Printf("\tTotal %8zu  %10zu  %8zu  %7.1f%%  %10.1f  %12.1f  %9zu\n", total.hits, total.prefetch_hits,
+                    total.misses, reads ? 100.0 * total.hits / reads : 0.0, total.bytes_read / 1e6,
+                    total.bytes_written / 1e6, total.evictions);
+}
+
 }  // namespace psi
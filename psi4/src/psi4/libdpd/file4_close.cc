@@ -45,6 +45,9 @@ namespace psi {
 int DPD::file4_close(dpdfile4 *File) {
     file4_cache_unlock(File);
 
+    /* Finish the background I/O on this file, so others can use it */
+    file4_io_sync(File);
+
     free(File->lfiles);
 
     if (!File->incore)
@@ -0,0 +1,281 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2026 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+/*! \file
+    \ingroup DPD
+    \brief Asynchronous prefetch and write-behind of file4 irrep blocks
+*/
+
+/*
+** The DPD I/O pipeline (option DPD_IO_PIPELINE) overlaps the disk time
+** of the out-of-core contraction drivers with their arithmetic. A
+** driver announces the block it will read next with
+** buf4_mat_irrep_prefetch(); the block is read into a staging buffer by
+** an AIOHandler while the current block is worked on, and the next
+** file4_mat_irrep_rd() (or _rd_block()) of those rows copies it from
+** there. Writes of whole blocks are copied into a staging buffer and
+** written in the background.
+**
+** Staging buffers come from dpd_block_matrix(), but only out of memory
+** that is neither in use nor held by the cache, and they are handed
+** back whenever dpd_block_matrix() runs short. The outstanding requests
+** on a set of rows are waited for before any synchronous I/O touches
+** them, when a file4 is closed, and when its libpsio unit is closed, so
+** the data on disk is always what a synchronous code would see. TOC
+** entries are created or extended by the calling thread, so that only
+** the data itself moves in the background.
+*/
+
+#include <cstring>
+#include <exception>
+#include "psi4/libpsio/psio.h"
+#include "psi4/libpsio/psio.hpp"
+#include "psi4/libpsio/aiohandler.h"
+#include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/libpsi4util/exception.h"
+#include "dpd.h"
+
+namespace psi {
+
+namespace {
+
+/// The AIOHandler shared by all DPD objects, created on first use
+AIOHandler &io_handler() {
+    if (!dpd_main.io_handler) dpd_main.io_handler = std::make_shared<AIOHandler>(PSIO::shared_object());
+    return *dpd_main.io_handler;
+}
+
+/// Entry-relative address of row pq of an irrep block; careful about overflows, as in file4_mat_irrep_rd_block()
+psio_address row_address(dpdfile4 *File, int irrep, int pq) {
+    psio_address row_ptr = File->lfiles[irrep];
+    int coltot = File->params->coltot[irrep ^ File->my_irrep];
+
+    if (coltot) {
+        int seek_block = DPD_BIGNUM / (coltot * sizeof(double)); /* no. of rows for which we can compute the address */
+        if (seek_block < 1) {
+            outfile->Printf("\nLIBDPD Error: each row of %s is too long to compute an address.\n", File->label);
+            throw PSIEXCEPTION("LIBDPD Error: a row of " + std::string(File->label) + " is too long for an address.");
+        }
+        for (; pq > seek_block; pq -= seek_block)
+            row_ptr = psio_get_address(row_ptr, sizeof(double) * seek_block * coltot);
+        row_ptr = psio_get_address(row_ptr, sizeof(double) * pq * coltot);
+    }
+
+    return row_ptr;
+}
+
+/// Does the request touch rows [start_pq, start_pq + num_pq) of this irrep of File?
+bool overlaps(const dpd_file4_io_request &request, dpdfile4 *File, int irrep, int start_pq, int num_pq) {
+    return request.filenum == File->filenum && request.irrep == irrep && !strcmp(request.label, File->label) &&
+           request.start_pq < start_pq + num_pq && start_pq < request.start_pq + request.num_pq;
+}
+
+/// Byte position of a global PSIO address
+size_t global_byte(psio_address address) { return address.page * PSIO_PAGELEN + address.offset; }
+
+}  // namespace
+
+std::list<dpd_file4_io_request>::iterator DPD::file4_io_retire(std::list<dpd_file4_io_request>::iterator request) {
+    std::exception_ptr error;
+    try {
+        io_handler().wait_for_job(request->jobid);
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    free_dpd_block(request->buffer, request->num_pq, request->coltot);
+    dpd_main.memstaged -= ((long)request->num_pq) * ((long)request->coltot);
+    auto next = dpd_main.file4_io_requests.erase(request);
+
+    if (error) std::rethrow_exception(error);
+    return next;
+}
+
+int DPD::file4_mat_irrep_prefetch(dpdfile4 *File, int irrep) {
+    return file4_mat_irrep_prefetch_block(File, irrep, 0, File->params->rowtot[irrep]);
+}
+
+int DPD::file4_mat_irrep_prefetch_block(dpdfile4 *File, int irrep, int start_pq, int num_pq) {
+    if (!dpd_main.io_pipeline || File->incore) return 0;
+
+    int coltot = File->params->coltot[irrep ^ File->my_irrep];
+    long int size = ((long)num_pq) * ((long)coltot);
+
+    /* Only use memory that nobody else needs */
+    if (!size || (dpd_main.memory - dpd_main.memused) < size) return 0;
+
+    /* Already on its way? */
+    for (const auto &request : dpd_main.file4_io_requests) {
+        if (!request.write && overlaps(request, File, irrep, start_pq, num_pq) && request.start_pq <= start_pq &&
+            start_pq + num_pq <= request.start_pq + request.num_pq)
+            return 0;
+    }
+
+    /* Only prefetch rows that are on disk already */
+    if (!psio_open_check(File->filenum)) return 0;
+    psio_tocentry *entry = psio_tocscan(File->filenum, File->label);
+    if (entry == nullptr) return 0;
+    psio_address start = row_address(File, irrep, start_pq);
+    size_t tocentry_size = sizeof(psio_tocentry) - 2 * sizeof(psio_tocentry *);
+    if (global_byte(entry->sadd) + tocentry_size + global_byte(start) + size * sizeof(double) > global_byte(entry->eadd))
+        return 0;
+
+    dpd_main.file4_io_requests.emplace_back();
+    dpd_file4_io_request &request = dpd_main.file4_io_requests.back();
+    request.filenum = File->filenum;
+    strcpy(request.label, File->label);
+    request.irrep = irrep;
+    request.start_pq = start_pq;
+    request.num_pq = num_pq;
+    request.coltot = coltot;
+    request.write = false;
+    request.buffer = dpd_block_matrix(num_pq, coltot);
+    dpd_main.memstaged += size;
+    dpd_main.file4_io_stats[File->filenum].bytes_read += size * sizeof(double);
+    request.jobid = io_handler().read(File->filenum, File->label, (char *)request.buffer[0], size * sizeof(double),
+                                      start, &request.end);
+
+    return 0;
+}
+
+int DPD::buf4_mat_irrep_prefetch(dpdbuf4 *Buf, int irrep) {
+    return buf4_mat_irrep_prefetch_block(Buf, irrep, 0, Buf->params->rowtot[irrep]);
+}
+
+int DPD::buf4_mat_irrep_prefetch_block(dpdbuf4 *Buf, int irrep, int start_pq, int num_pq) {
+    /* Only buffers that are read straight from the file (method 12 of buf4_mat_irrep_rd) */
+    if (Buf->anti || Buf->params->pqnum != Buf->file.params->pqnum || Buf->params->rsnum != Buf->file.params->rsnum)
+        return 0;
+
+    return file4_mat_irrep_prefetch_block(&(Buf->file), irrep, start_pq, num_pq);
+}
+
+bool DPD::file4_io_fetch(dpdfile4 *File, int irrep, int start_pq, int num_pq) {
+    if (dpd_main.file4_io_requests.empty()) return false;
+
+    int coltot = File->params->coltot[irrep ^ File->my_irrep];
+
+    for (auto it = dpd_main.file4_io_requests.begin(); it != dpd_main.file4_io_requests.end(); ++it) {
+        if (it->write || !overlaps(*it, File, irrep, start_pq, num_pq)) continue;
+        if (it->coltot != coltot || start_pq < it->start_pq || start_pq + num_pq > it->start_pq + it->num_pq) continue;
+
+        io_handler().wait_for_job(it->jobid);
+        memcpy((void *)File->matrix[irrep][0], (const void *)it->buffer[start_pq - it->start_pq],
+               sizeof(double) * num_pq * coltot);
+
+        /* Keep the rest of a larger prefetch for the reads of the next rows */
+        if (start_pq + num_pq == it->start_pq + it->num_pq) file4_io_retire(it);
+        return true;
+    }
+
+    /* Not prefetched: the rows on disk have to be up to date */
+    for (auto it = dpd_main.file4_io_requests.begin(); it != dpd_main.file4_io_requests.end();) {
+        if (it->write && overlaps(*it, File, irrep, start_pq, num_pq))
+            it = file4_io_retire(it);
+        else
+            ++it;
+    }
+
+    return false;
+}
+
+bool DPD::file4_io_write(dpdfile4 *File, int irrep, int start_pq, int num_pq) {
+    int coltot = File->params->coltot[irrep ^ File->my_irrep];
+    long int size = ((long)num_pq) * ((long)coltot);
+
+    /* Prefetches of these rows are stale now; earlier writes are kept in order by the AIOHandler */
+    for (auto it = dpd_main.file4_io_requests.begin(); it != dpd_main.file4_io_requests.end();) {
+        if (!it->write && overlaps(*it, File, irrep, start_pq, num_pq))
+            it = file4_io_retire(it);
+        else
+            ++it;
+    }
+
+    if (!dpd_main.io_pipeline || !size || (dpd_main.memory - dpd_main.memused) < size ||
+        !psio_open_check(File->filenum)) {
+        file4_io_sync_rows(File, irrep, start_pq, num_pq);
+        return false;
+    }
+
+    /* Create or extend the TOC entry here, so the AIOHandler thread only finds it */
+    psio_address start = row_address(File, irrep, start_pq);
+    psio_address end;
+    PSIO::shared_object()->write_address(File->filenum, File->label, size * sizeof(double), start, &end);
+
+    dpd_main.file4_io_requests.emplace_back();
+    dpd_file4_io_request &request = dpd_main.file4_io_requests.back();
+    request.filenum = File->filenum;
+    strcpy(request.label, File->label);
+    request.irrep = irrep;
+    request.start_pq = start_pq;
+    request.num_pq = num_pq;
+    request.coltot = coltot;
+    request.write = true;
+    request.buffer = dpd_block_matrix(num_pq, coltot);
+    dpd_main.memstaged += size;
+    memcpy((void *)request.buffer[0], (const void *)File->matrix[irrep][0], sizeof(double) * size);
+    request.jobid = io_handler().write(File->filenum, File->label, (char *)request.buffer[0], size * sizeof(double),
+                                       start, &request.end);
+
+    return true;
+}
+
+void DPD::file4_io_sync_rows(dpdfile4 *File, int irrep, int start_pq, int num_pq) {
+    for (auto it = dpd_main.file4_io_requests.begin(); it != dpd_main.file4_io_requests.end();) {
+        if (overlaps(*it, File, irrep, start_pq, num_pq))
+            it = file4_io_retire(it);
+        else
+            ++it;
+    }
+}
+
+void DPD::file4_io_sync(dpdfile4 *File) {
+    for (auto it = dpd_main.file4_io_requests.begin(); it != dpd_main.file4_io_requests.end();) {
+        if (it->filenum == File->filenum && !strcmp(it->label, File->label))
+            it = file4_io_retire(it);
+        else
+            ++it;
+    }
+}
+
+void DPD::file4_io_sync_filenum(size_t filenum) {
+    for (auto it = dpd_main.file4_io_requests.begin(); it != dpd_main.file4_io_requests.end();) {
+        if (it->filenum == filenum)
+            it = file4_io_retire(it);
+        else
+            ++it;
+    }
+}
+
+void DPD::file4_io_sync_all() {
+    for (auto it = dpd_main.file4_io_requests.begin(); it != dpd_main.file4_io_requests.end();) {
+        it = file4_io_retire(it);
+    }
+}
+
+}  // namespace psi
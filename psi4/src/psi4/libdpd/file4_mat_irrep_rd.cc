@@ -42,7 +42,10 @@ int DPD::file4_mat_irrep_rd(dpdfile4 *File, int irrep) {
     psio_address irrep_ptr, next_address;
     long int size;
 
-    if (File->incore) return 0; /* We already have this data in core */
+    if (File->incore) { /* We already have this data in core */
+        dpd_main.file4_io_stats[File->filenum].hits++;
+        return 0;
+    }
 
     /* If the data doesn't actually exist on disk, we just leave */
     if (psio_tocscan(File->filenum, File->label) == nullptr) return 1;
@@ -57,9 +60,17 @@ int DPD::file4_mat_irrep_rd(dpdfile4 *File, int irrep) {
     coltot = File->params->coltot[irrep ^ my_irrep];
     size = ((long)rowtot) * ((long)coltot);
 
-    if (rowtot && coltot)
-        psio_read(File->filenum, File->label, (char *)File->matrix[irrep][0], size * ((long)sizeof(double)), irrep_ptr,
-                  &next_address);
+    if (rowtot && coltot) {
+        dpd_file4_io_stats &stats = dpd_main.file4_io_stats[File->filenum];
+        if (file4_io_fetch(File, irrep, 0, rowtot)) {
+            stats.prefetch_hits++;
+        } else {
+            stats.misses++;
+            stats.bytes_read += size * sizeof(double);
+            psio_read(File->filenum, File->label, (char *)File->matrix[irrep][0], size * ((long)sizeof(double)),
+                      irrep_ptr, &next_address);
+        }
+    }
 
 #ifdef DPD_TIMER
     timer_off("file4_rd");
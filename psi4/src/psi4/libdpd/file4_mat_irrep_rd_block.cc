@@ -44,7 +44,10 @@ int DPD::file4_mat_irrep_rd_block(dpdfile4 *File, int irrep, int start_pq, int n
     long int size;
 
     my_irrep = File->my_irrep;
-    if (File->incore) return 0; /* We already have this data in core */
+    if (File->incore) { /* We already have this data in core */
+        dpd_main.file4_io_stats[File->filenum].hits++;
+        return 0;
+    }
 
     irrep_ptr = File->lfiles[irrep];
     rowtot = num_pq;
@@ -52,6 +55,11 @@ int DPD::file4_mat_irrep_rd_block(dpdfile4 *File, int irrep, int start_pq, int n
 
     size = ((long)rowtot) * ((long)coltot);
 
+    if (rowtot && coltot && file4_io_fetch(File, irrep, start_pq, num_pq)) {
+        dpd_main.file4_io_stats[File->filenum].prefetch_hits++;
+        return 0;
+    }
+
     /* Advance file pointer to current row --- careful about overflows! */
     if (coltot) {
         seek_block = DPD_BIGNUM / (coltot * sizeof(double)); /* no. of rows for which we can compute the address */
@@ -64,9 +72,12 @@ int DPD::file4_mat_irrep_rd_block(dpdfile4 *File, int irrep, int start_pq, int n
         irrep_ptr = psio_get_address(irrep_ptr, sizeof(double) * start_pq * coltot);
     }
 
-    if (rowtot && coltot)
+    if (rowtot && coltot) {
+        dpd_main.file4_io_stats[File->filenum].misses++;
+        dpd_main.file4_io_stats[File->filenum].bytes_read += size * sizeof(double);
         psio_read(File->filenum, File->label, (char *)File->matrix[irrep][0], size * ((long)sizeof(double)), irrep_ptr,
                   &next_address);
+    }
 
     return 0;
 }
@@ -31,6 +31,7 @@
     \brief Enter brief description of file here
 */
 #include <cstdio>
+#include <cstring>
 #include "psi4/libpsio/psio.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
 #include "psi4/libqt/qt.h"
@@ -42,7 +43,17 @@ int DPD::file4_mat_irrep_row_rd(dpdfile4 *File, int irrep, int row) {
     int coltot, my_irrep, seek_block;
     psio_address row_ptr, next_address;
 
-    if (File->incore) return 0; /* We already have this data in core */
+    /* Rows streamed one after the other count as one block read */
+    dpd_file4_io_stats &stats = dpd_main.file4_io_stats[File->filenum];
+    bool new_block = stats.row_irrep != irrep || stats.row_next != row || strcmp(stats.row_label, File->label);
+    stats.row_irrep = irrep;
+    stats.row_next = row + 1;
+    strcpy(stats.row_label, File->label);
+
+    if (File->incore) { /* We already have this data in core */
+        if (new_block) stats.hits++;
+        return 0;
+    }
 
 #ifdef DPD_TIMER
     timer_on("f4_rowrd");
@@ -53,6 +64,16 @@ int DPD::file4_mat_irrep_row_rd(dpdfile4 *File, int irrep, int row) {
     row_ptr = File->lfiles[irrep];
     coltot = File->params->coltot[irrep ^ my_irrep];
 
+    /* The row may be in a prefetched block */
+    bool fetched = coltot && file4_io_fetch(File, irrep, row, 1);
+
+    if (coltot && fetched) {
+        if (new_block) stats.prefetch_hits++;
+    } else if (coltot) {
+        if (new_block) stats.misses++;
+        stats.bytes_read += coltot * sizeof(double);
+    }
+
     /* Advance file pointer to current row --- careful about overflows! */
     if (coltot) {
         seek_block = DPD_BIGNUM / (coltot * sizeof(double)); /* no. of rows for which we can compute the address */
@@ -65,7 +86,7 @@ int DPD::file4_mat_irrep_row_rd(dpdfile4 *File, int irrep, int row) {
         row_ptr = psio_get_address(row_ptr, sizeof(double) * row * coltot);
     }
 
-    if (coltot)
+    if (coltot && !fetched)
         psio_read(File->filenum, File->label, (char *)File->matrix[irrep][0], coltot * sizeof(double), row_ptr,
                   &next_address);
 
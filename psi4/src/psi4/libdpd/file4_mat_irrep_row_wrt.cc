@@ -51,6 +51,11 @@ int DPD::file4_mat_irrep_row_wrt(dpdfile4 *File, int irrep, int row) {
     row_ptr = File->lfiles[irrep];
     coltot = File->params->coltot[irrep ^ my_irrep];
 
+    if (coltot) {
+        file4_io_sync_rows(File, irrep, row, 1);
+        dpd_main.file4_io_stats[File->filenum].bytes_written += coltot * sizeof(double);
+    }
+
     /* Advance file pointer to current row --- careful about overflows! */
     if (coltot) {
         seek_block = DPD_BIGNUM / (coltot * sizeof(double)); /* no. of rows for which we can compute the address */
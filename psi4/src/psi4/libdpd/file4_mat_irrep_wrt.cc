@@ -51,7 +51,9 @@ int DPD::file4_mat_irrep_wrt(dpdfile4 *File, int irrep) {
     coltot = File->params->coltot[irrep ^ my_irrep];
     size = ((long)rowtot) * ((long)coltot);
 
-    if (rowtot && coltot)
+    if (rowtot && coltot) dpd_main.file4_io_stats[File->filenum].bytes_written += size * sizeof(double);
+
+    if (rowtot && coltot && !file4_io_write(File, irrep, 0, rowtot))
         psio_write(File->filenum, File->label, (char *)File->matrix[irrep][0], size * ((long)sizeof(double)), irrep_ptr,
                    &next_address);
 
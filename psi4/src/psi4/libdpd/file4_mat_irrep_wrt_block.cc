@@ -55,6 +55,10 @@ int DPD::file4_mat_irrep_wrt_block(dpdfile4 *File, int irrep, int start_pq, int
     coltot = File->params->coltot[irrep ^ my_irrep];
     size = ((long)rowtot) * ((long)coltot);
 
+    if (rowtot && coltot) dpd_main.file4_io_stats[File->filenum].bytes_written += size * sizeof(double);
+
+    if (rowtot && coltot && file4_io_write(File, irrep, start_pq, num_pq)) return 0;
+
     /* Advance file pointer to current row */
     if (coltot) {
         seek_block = DPD_BIGNUM / (coltot * sizeof(double)); /* no. of rows for which we can compute the address */
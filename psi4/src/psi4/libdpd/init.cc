@@ -37,6 +37,7 @@
 #include "psi4/libciomr/libciomr.h"
 #include "dpd.h"
 #include "psi4/libpsi4util/exception.h"
+#include "psi4/libpsi4util/process.h"
 
 namespace psi {
 
@@ -90,11 +91,25 @@ extern int dpd_close(int dpd_num) {
     delete dpd_list[dpd_num];
     dpd_list[dpd_num] = nullptr;
 
+    /* Report the file4 traffic of the module once its last DPD instance is gone (at PRINT > 1) */
+    if (dpd_list[0] == nullptr && dpd_list[1] == nullptr) {
+        if (Process::environment.options.get_int("PRINT") > 1) {
+            dpd_file4_io_stats_print();
+            if (dpd_main.kernel_threads)
+                outfile->Printf("\n\tDPD kernels with concurrent irrep blocks: %zu, threaded sorts: %zu\n",
+                                dpd_main.kernel_concurrent, dpd_main.kernel_threaded_sorts);
+        }
+        dpd_main.file4_io_stats.clear();
+        dpd_main.kernel_concurrent = 0;
+        dpd_main.kernel_threaded_sorts = 0;
+    }
+
     return 0;
 }
 
 extern long int dpd_memfree() {
-    return dpd_main.memory - (dpd_main.memused - dpd_main.memcache + dpd_main.memlocked);
+    /* Cache entries and staging buffers of the I/O pipeline are given back by dpd_block_matrix() on demand */
+    return dpd_main.memory - (dpd_main.memused - dpd_main.memcache - dpd_main.memstaged + dpd_main.memlocked);
 }
 
 extern void dpd_memset(long int memory) { dpd_main.memory = memory; }
@@ -173,10 +188,16 @@ int DPD::init(int dpd_num_in, int nirreps_in, long int memory_in, int cachetype_
     nirreps = nirreps_in;
     num_subspaces = num_subspaces_in;
 
+    /* Staging buffers count against the memory being reset below */
+    file4_io_sync_all();
+    dpd_main.io_pipeline = Process::environment.options.get_bool("DPD_IO_PIPELINE");
+    dpd_main.kernel_threads = Process::environment.options.get_bool("DPD_KERNEL_THREADS");
+
     dpd_main.memory = memory_in / sizeof(double); /* Available memory in doubles */
     dpd_main.memused = 0;                         /* At first... */
     dpd_main.memcache = 0;                        /* At first... */
     dpd_main.memlocked = 0;                       /* At first... */
+    dpd_main.memstaged = 0;                       /* At first... */
 
     dpd_main.cachetype = cachetype_in;
     dpd_main.cachelist = cachelist_in;
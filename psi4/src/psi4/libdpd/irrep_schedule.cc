@@ -0,0 +1,128 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2026 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+/*! \file
+    \ingroup DPD
+    \brief Runs the independent irrep blocks of a DPD kernel concurrently
+*/
+#include <algorithm>
+#include "dpd.h"
+#include "psi4/libpsi4util/process.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef USING_LAPACK_MKL
+#include <mkl.h>
+#elif defined(__ELF__)
+/* OpenBLAS thread control, resolved at load time; null with any other BLAS */
+extern "C" {
+void openblas_set_num_threads(int) __attribute__((weak));
+int openblas_get_num_threads(void) __attribute__((weak));
+}
+#endif
+
+namespace psi {
+
+/* Below this many flops in total the thread start-up costs more than it saves */
+#define DPD_SCHEDULE_MIN_COST (1L << 18)
+
+namespace {
+
+/* Lowers the BLAS to one thread, returning the previous count in old_threads.
+** Returns false, changing nothing, if this BLAS offers no way to do so. */
+bool blas_single_thread(int &old_threads) {
+#ifdef USING_LAPACK_MKL
+    old_threads = mkl_get_max_threads();
+    mkl_set_num_threads(1);
+    return true;
+#elif defined(__ELF__)
+    if (!openblas_set_num_threads || !openblas_get_num_threads) return false;
+    old_threads = openblas_get_num_threads();
+    openblas_set_num_threads(1);
+    return true;
+#else
+    return false;
+#endif
+}
+
+/* Gives the BLAS back the thread count blas_single_thread() returned */
+void blas_restore_threads(int old_threads) {
+#ifdef USING_LAPACK_MKL
+    mkl_set_num_threads(old_threads);
+#elif defined(__ELF__)
+    openblas_set_num_threads(old_threads);
+#endif
+}
+
+}  // namespace
+
+/* irrep_schedule(): Runs task(h) for every irrep h with a non-zero cost.
+** The tasks must write disjoint blocks.  With DPD_KERNEL_THREADS on and
+** the work spread over at least two irreps, none of which carries more than
+** half of it, the tasks run concurrently, the most expensive first, each
+** with a single-threaded BLAS.  Otherwise, or if the BLAS thread count
+** cannot be lowered (only MKL and OpenBLAS are handled), they run in irrep
+** order and the BLAS keeps all the threads.
+**
+** Arguments:
+**   const std::vector<long int> &cost: The (flop) cost of each irrep block.
+**   const std::function<void(int)> &task: The work for one irrep block.
+*/
+
+void DPD::irrep_schedule(const std::vector<long int> &cost, const std::function<void(int)> &task) {
+    std::vector<int> order;
+    long int total = 0, largest = 0;
+    for (int h = 0; h < (int)cost.size(); h++) {
+        if (cost[h] <= 0) continue;
+        order.push_back(h);
+        total += cost[h];
+        largest = std::max(largest, cost[h]);
+    }
+
+    int nthreads = std::min(Process::environment.get_n_threads(), (int)order.size());
+    bool concurrent = dpd_main.kernel_threads && nthreads > 1 && total >= DPD_SCHEDULE_MIN_COST && 2 * largest <= total;
+
+    // Concurrent blocks each calling a fully threaded BLAS would oversubscribe the cores
+    int old_threads = 0;
+    if (!concurrent || !blas_single_thread(old_threads)) {
+        for (int h : order) task(h);
+        return;
+    }
+
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return cost[a] > cost[b]; });
+    dpd_main.kernel_concurrent++;
+
+#pragma omp parallel for schedule(dynamic, 1) num_threads(nthreads)
+    for (int n = 0; n < (int)order.size(); n++) task(order[n]);
+
+    blas_restore_threads(old_threads);
+}
+
+}  // namespace psi
@@ -28,6 +28,7 @@
 
 #include "jk.h"
 #include "SplitJK.h"
+#include "task_scheduler.h"
 #include "psi4/libqt/qt.h"
 #include "psi4/libfock/cubature.h"
 #include "psi4/libfock/points.h"
@@ -44,6 +45,7 @@
 #include <algorithm>
 #include <limits>
 #include <map>
+#include <numeric>
 #include <unordered_set>
 #include <vector>
 #ifdef _OPENMP
@@ -391,21 +393,36 @@ void COSK::build_G_component(std::vector<std::shared_ptr<Matrix>>& D, std::vecto
 
     // => Integral Computation <= //
 
+    // estimated cost of each grid block: points times the shell pairs (within the block's
+    // shells and their overlapping neighbours) for which ESP integrals may be needed
+    std::vector<double> block_cost(grid->blocks().size(), 0.0);
+    for (size_t bi = 0; bi < grid->blocks().size(); bi++) {
+        const auto& block = grid->blocks()[bi];
+        double pair_cost = 0.0;
+        for (int KAPPA : block->shells_local_to_global()) {
+            for (int NU : shell_extent_map[KAPPA]) {
+                pair_cost += TaskScheduler::shell_pair_cost(primary_->shell(KAPPA), primary_->shell(NU));
+            }
+        }
+        block_cost[bi] = block->npoints() * pair_cost;
+    }
+
+    TaskScheduler scheduler(nthreads_);
+    scheduler.schedule(block_cost);
+
     // benchmarking statistics
     num_computed_shells_ = 0L;
-    size_t int_shells_total = 0;
-    size_t int_shells_computed = 0;
+    std::vector<size_t> int_shells_total(nthreads_, 0);
+    std::vector<size_t> int_shells_computed(nthreads_, 0);
 
     timer_on("Grid Loop");
 
     // The primary COSK loop over blocks of grid points
-#pragma omp parallel for schedule(dynamic) num_threads(nthreads_) reduction(+ : int_shells_total, int_shells_computed)
-    for (size_t bi = 0; bi < grid->blocks().size(); bi++) {
+    scheduler.run([&](size_t bi, int rank) {
 
-        int rank = 0;
-#ifdef _OPENMP
-        rank = omp_get_thread_num();
-#endif
+        // benchmarking
+        size_t int_shells_total_block = 0;
+        size_t int_shells_computed_block = 0;
 
         // grid points in this block
         auto block = grid->blocks()[bi];
@@ -648,7 +665,7 @@ void COSK::build_G_component(std::vector<std::shared_ptr<Matrix>>& D, std::vecto
                 if (symm && TAU > NU) continue;
 
                 // benchmarking
-                int_shells_total += npoints_block;
+                int_shells_total_block += npoints_block;
 
                 // can we screen the whole block over K_uv = (X_ug (A_vtg (F_tg)) upper bound?
                 double k_bound = X_block_max * esp_boundp[NU][TAU] * F_block_gmaxp[TAU];
@@ -674,7 +691,7 @@ void COSK::build_G_component(std::vector<std::shared_ptr<Matrix>>& D, std::vecto
                     int_computers[rank]->compute_shell(NU, TAU);
 
                     // benchmarking
-                    int_shells_computed++;
+                    int_shells_computed_block++;
 
                     // contract A_nu_tau with F_tau to get contribution to G_nu
                     // symmetry permitting, also contract A_nu_tau with F_nu to get contribution to G_tau
@@ -716,10 +733,16 @@ void COSK::build_G_component(std::vector<std::shared_ptr<Matrix>>& D, std::vecto
             }
         }
 
-    }
+        int_shells_total[rank] += int_shells_total_block;
+        int_shells_computed[rank] += int_shells_computed_block;
+    });
 
     timer_off("Grid Loop");
 
+    if (bench_) {
+        scheduler.print_statistics("COSX");
+    }
+
     // Reduce per-thread contributions
     for(size_t jki = 0; jki < njk; jki++) {
         for (size_t thread = 0; thread < nthreads_; thread++) {
@@ -730,7 +753,7 @@ void COSK::build_G_component(std::vector<std::shared_ptr<Matrix>>& D, std::vecto
         }
     }
 
-    num_computed_shells_ = int_shells_computed;
+    num_computed_shells_ = std::accumulate(int_shells_computed.begin(), int_shells_computed.end(), size_t(0));
 }
 
 }  // namespace psi
@@ -195,7 +195,15 @@ size_t CompositeJK::num_computed_shells() {
 }
 
 size_t CompositeJK::memory_estimate() {
-    return 0;  // Memory is O(N^2), which psi4 counts as effectively 0
+    // Memory is O(N^2), which psi4 counts as effectively 0, except for thread-private copies
+    if (!do_K_ || !k_algo_) return 0;
+    size_t ndensity = std::max(C_left_.size(), D_.size());
+    if (ndensity == 0) {
+        bool restricted = !options_.exists("REFERENCE") || options_.get_str("REFERENCE") == "RHF" ||
+                          options_.get_str("REFERENCE") == "RKS";
+        ndensity = restricted ? 1 : 2;
+    }
+    return k_algo_->memory_estimate(ndensity);
 }
 
 void CompositeJK::print_header() const {
@@ -34,11 +34,15 @@
 #include "psi4/lib3index/dftensor.h"
 #include "jk.h"
 #include "SplitJK.h"
+#include "task_scheduler.h"
 
 #include <unordered_set>
 #include <vector>
 #include <map>
 #include <algorithm>
+#include <functional>
+#include <limits>
+#include <numeric>
 #ifdef _OPENMP
 #include <omp.h>
 #endif
@@ -101,8 +105,7 @@ void DirectDFJ::build_G_component(std::vector<std::shared_ptr<Matrix>>& D, std::
 
     // benchmarking
     size_t nshellpair = eri_computers[0]->shell_pairs().size();
-    size_t nshelltriplet = nshell_aux * nshellpair;
-    size_t computed_triplets1 = 0, computed_triplets2 = 0;
+    std::vector<size_t> computed_triplets1(nthreads_, 0), computed_triplets2(nthreads_, 0);
 
     // screening threshold
     double thresh2 = cutoff_ * cutoff_;
@@ -157,6 +160,43 @@ void DirectDFJ::build_G_component(std::vector<std::shared_ptr<Matrix>>& D, std::
         }
     }
 
+    // => Task Costs <= //
+
+    // Each task is one auxiliary shell P against all primary shell pairs MN.
+    // The cost of a task is the summed cost of the (P|MN) triplets that survive screening.
+    // Shell pairs are sorted by their screening value, so that cost is a bisection
+    // into a prefix sum over the sorted pairs.
+    std::vector<double> pair_cost(nshellpair);
+    for (size_t MN = 0; MN < nshellpair; MN++) {
+        auto bra = eri_computers[0]->shell_pairs()[MN];
+        pair_cost[MN] = TaskScheduler::shell_pair_cost(primary_->shell(bra.first), primary_->shell(bra.second));
+    }
+
+    // (sorted screening values, prefix sums of pair cost in that order)
+    using CostTable = std::pair<std::vector<double>, std::vector<double>>;
+    auto build_cost_table = [&](const std::vector<double>& pair_value) {
+        std::vector<size_t> order(nshellpair);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return pair_value[a] > pair_value[b]; });
+        CostTable table;
+        table.second.push_back(0.0);
+        for (size_t MN : order) {
+            table.first.push_back(pair_value[MN]);
+            table.second.push_back(table.second.back() + pair_cost[MN]);
+        }
+        return table;
+    };
+    auto surviving_cost = [](const CostTable& table, double bound) {
+        size_t nsurvive = std::upper_bound(table.first.begin(), table.first.end(), bound, std::greater<double>()) -
+                          table.first.begin();
+        return table.second[nsurvive];
+    };
+    auto aux_shell_cost = [&](size_t P) {
+        return (double)auxiliary_->shell(P).nfunction() * auxiliary_->shell(P).nprimitive();
+    };
+
+    TaskScheduler scheduler(nthreads_);
+
     timer_off("Setup");
 
     //  => First Contraction <= //
@@ -166,51 +206,69 @@ void DirectDFJ::build_G_component(std::vector<std::shared_ptr<Matrix>>& D, std::
     // G_{p} correlates to gamma_P in Figure 1 of Weigend's paper
 
     timer_on("ERI1");
-#pragma omp parallel for schedule(guided) num_threads(nthreads_) reduction(+ : computed_triplets1)
-    for (size_t MNP = 0; MNP < nshelltriplet; MNP++) {
 
-        size_t MN = MNP % nshellpair;
-        size_t P = MNP / nshellpair;
-        int rank = 0;
-#ifdef _OPENMP
-        rank = omp_get_thread_num();
-#endif
-        auto bra = eri_computers[rank]->shell_pairs()[MN];
-        size_t M = bra.first;
-        size_t N = bra.second;
-        if(Dshellp[M][N] * Dshellp[M][N] * J_metric_shell_diag[P] * eri_computers[rank]->shell_pair_value(M,N) < thresh2) {
-            continue;
+    {
+        std::vector<double> pair_value(nshellpair);
+        for (size_t MN = 0; MN < nshellpair; MN++) {
+            auto bra = eri_computers[0]->shell_pairs()[MN];
+            pair_value[MN] = Dshellp[bra.first][bra.second] * Dshellp[bra.first][bra.second] *
+                             eri_computers[0]->shell_pair_value(bra.first, bra.second);
         }
-        computed_triplets1++;
-        int np = auxiliary_->shell(P).nfunction();
-        int pstart = auxiliary_->shell(P).function_index();
-        int nm = primary_->shell(M).nfunction();
-        int mstart = primary_->shell(M).function_index();
-        int nn = primary_->shell(N).nfunction();
-        int nstart = primary_->shell(N).function_index();
-        eri_computers[rank]->compute_shell(P, 0, M, N);
-        const auto & buffer = eri_computers[rank]->buffers()[0];
+        auto table = build_cost_table(pair_value);
+
+        // every task keeps a nonzero cost so that none is dropped on a rounding difference
+        std::vector<double> task_cost(nshell_aux);
+        for (size_t P = 0; P < nshell_aux; P++) {
+            task_cost[P] = aux_shell_cost(P) * (1.0 + surviving_cost(table, thresh2 / J_metric_shell_diag[P]));
+        }
+        scheduler.schedule(task_cost);
+    }
 
-        for(size_t jki = 0; jki < njk; jki++) {
+    scheduler.run([&](size_t P, int rank) {
+        size_t computed_triplets = 0;
+        for (size_t MN = 0; MN < nshellpair; MN++) {
+            auto bra = eri_computers[rank]->shell_pairs()[MN];
+            size_t M = bra.first;
+            size_t N = bra.second;
+            if(Dshellp[M][N] * Dshellp[M][N] * J_metric_shell_diag[P] * eri_computers[rank]->shell_pair_value(M,N) < thresh2) {
+                continue;
+            }
+            computed_triplets++;
+            int np = auxiliary_->shell(P).nfunction();
+            int pstart = auxiliary_->shell(P).function_index();
+            int nm = primary_->shell(M).nfunction();
+            int mstart = primary_->shell(M).function_index();
+            int nn = primary_->shell(N).nfunction();
+            int nstart = primary_->shell(N).function_index();
+            eri_computers[rank]->compute_shell(P, 0, M, N);
+            const auto & buffer = eri_computers[rank]->buffers()[0];
 
-            auto GTp = GT[jki][rank]->pointer();
-            auto Dp = D[jki]->pointer();
+            for(size_t jki = 0; jki < njk; jki++) {
+
+                auto GTp = GT[jki][rank]->pointer();
+                auto Dp = D[jki]->pointer();
 
-            for (int p = pstart, index = 0; p < pstart + np; p++) {
-                for (int m = mstart; m < mstart + nm; m++) {
-                    for (int n = nstart; n < nstart + nn; n++, index++) {
-                        GTp[p] += buffer[index] * Dp[m][n];
-                        if (N != M) GTp[p] += buffer[index] * Dp[n][m];
+                for (int p = pstart, index = 0; p < pstart + np; p++) {
+                    for (int m = mstart; m < mstart + nm; m++) {
+                        for (int n = nstart; n < nstart + nn; n++, index++) {
+                            GTp[p] += buffer[index] * Dp[m][n];
+                            if (N != M) GTp[p] += buffer[index] * Dp[n][m];
+                        }
                     }
                 }
+
             }
 
         }
-
-    }
+        computed_triplets1[rank] += computed_triplets;
+    });
 
     timer_off("ERI1");
 
+    if (bench_) {
+        scheduler.print_statistics("DF-DirJ (ERI1)");
+    }
+
     //  => Second Contraction <= //
 
     //  linear solve for H:
@@ -264,53 +322,71 @@ void DirectDFJ::build_G_component(std::vector<std::shared_ptr<Matrix>>& D, std::
 
     timer_on("ERI2");
 
-#pragma omp parallel for schedule(guided) num_threads(nthreads_) reduction(+ : computed_triplets2)
-    for (size_t MNP = 0; MNP < nshelltriplet; MNP++) {
+    {
+        std::vector<double> pair_value(nshellpair);
+        for (size_t MN = 0; MN < nshellpair; MN++) {
+            auto bra = eri_computers[0]->shell_pairs()[MN];
+            pair_value[MN] = eri_computers[0]->shell_pair_value(bra.first, bra.second);
+        }
+        auto table = build_cost_table(pair_value);
 
-        size_t MN = MNP % nshellpair;
-        size_t P = MNP / nshellpair;
-        int rank = 0;
-#ifdef _OPENMP
-        rank = omp_get_thread_num();
-#endif
-        auto bra = eri_computers[rank]->shell_pairs()[MN];
-        size_t M = bra.first;
-        size_t N = bra.second;
-        if(H_shell_maxp[P] * H_shell_maxp[P] * J_metric_shell_diag[P] * eri_computers[rank]->shell_pair_value(M,N) < thresh2) {
-            continue;
+        std::vector<double> task_cost(nshell_aux);
+        for (size_t P = 0; P < nshell_aux; P++) {
+            double scale = H_shell_maxp[P] * H_shell_maxp[P] * J_metric_shell_diag[P];
+            double bound = (scale > 0.0) ? thresh2 / scale : std::numeric_limits<double>::infinity();
+            task_cost[P] = aux_shell_cost(P) * (1.0 + surviving_cost(table, bound));
         }
-        computed_triplets2++;
-        int np = auxiliary_->shell(P).nfunction();
-        int pstart = auxiliary_->shell(P).function_index();
-        int nm = primary_->shell(M).nfunction();
-        int mstart = primary_->shell(M).function_index();
-        int nn = primary_->shell(N).nfunction();
-        int nstart = primary_->shell(N).function_index();
+        scheduler.schedule(task_cost);
+    }
 
-        eri_computers[rank]->compute_shell(P, 0, M, N);
-        const auto & buffer = eri_computers[rank]->buffers()[0];
+    scheduler.run([&](size_t P, int rank) {
+        size_t computed_triplets = 0;
+        for (size_t MN = 0; MN < nshellpair; MN++) {
+            auto bra = eri_computers[rank]->shell_pairs()[MN];
+            size_t M = bra.first;
+            size_t N = bra.second;
+            if(H_shell_maxp[P] * H_shell_maxp[P] * J_metric_shell_diag[P] * eri_computers[rank]->shell_pair_value(M,N) < thresh2) {
+                continue;
+            }
+            computed_triplets++;
+            int np = auxiliary_->shell(P).nfunction();
+            int pstart = auxiliary_->shell(P).function_index();
+            int nm = primary_->shell(M).nfunction();
+            int mstart = primary_->shell(M).function_index();
+            int nn = primary_->shell(N).nfunction();
+            int nstart = primary_->shell(N).function_index();
 
-        for(size_t jki = 0; jki < njk; jki++) {
+            eri_computers[rank]->compute_shell(P, 0, M, N);
+            const auto & buffer = eri_computers[rank]->buffers()[0];
+
+            for(size_t jki = 0; jki < njk; jki++) {
 
-            auto JTp = JT[jki][rank]->pointer();
-            auto Hp = H[jki]->pointer();
+                auto JTp = JT[jki][rank]->pointer();
+                auto Hp = H[jki]->pointer();
 
-            for (int p = pstart, index = 0; p < pstart + np; p++) {
-                for (int m = mstart; m < mstart + nm; m++) {
-                    for (int n = nstart; n < nstart + nn; n++, index++) {
-                        JTp[m][n] += buffer[index] * Hp[p];
-                        if (N != M) JTp[n][m] += buffer[index] * Hp[p];
+                for (int p = pstart, index = 0; p < pstart + np; p++) {
+                    for (int m = mstart; m < mstart + nm; m++) {
+                        for (int n = nstart; n < nstart + nn; n++, index++) {
+                            JTp[m][n] += buffer[index] * Hp[p];
+                            if (N != M) JTp[n][m] += buffer[index] * Hp[p];
+                        }
                     }
                 }
+
             }
 
         }
-
-    }
+        computed_triplets2[rank] += computed_triplets;
+    });
 
     timer_off("ERI2");
 
-    num_computed_shells_ = computed_triplets1 + computed_triplets2;
+    if (bench_) {
+        scheduler.print_statistics("DF-DirJ (ERI2)");
+    }
+
+    num_computed_shells_ = std::accumulate(computed_triplets1.begin(), computed_triplets1.end(), size_t(0)) +
+                           std::accumulate(computed_triplets2.begin(), computed_triplets2.end(), size_t(0));
 
     for(size_t jki = 0; jki < njk; jki++) {
         for (size_t thread = 0; thread < nthreads_; thread++) {
@@ -35,6 +35,8 @@
 #include "psi4/psifiles.h"
 #include "psi4/libiwl/iwl.hpp"
 #include "jk.h"
+#include "task_scheduler.h"
+#include "thread_reduction.h"
 #include "psi4/libmints/matrix.h"
 #include "psi4/libmints/basisset.h"
 #include "psi4/libmints/molecule.h"
@@ -42,10 +44,13 @@
 #include "psi4/libmints/integral.h"
 #include "psi4/lib3index/cholesky.h"
 #include "psi4/libpsi4util/process.h"
+#include "psi4/libpsi4util/libpsi4util.h"
 #include "psi4/liboptions/liboptions.h"
 
 #include <algorithm>
+#include <array>
 #include <limits>
+#include <numeric>
 #include <sstream>
 #include <unordered_set>
 #include "psi4/libpsi4util/PsiOutStream.h"
@@ -95,6 +100,7 @@ void DirectJK::common_init() {
     // other options
     auto screening_type = options_.get_str("SCREENING");
     density_screening_ = screening_type == "DENSITY";
+    accumulate_per_thread_ = options_.get_str("JK_ACCUMULATION") == "THREAD";
     computed_shells_per_iter_["Quartets"] = {};
 }
 
@@ -103,6 +109,19 @@ size_t DirectJK::num_computed_shells() {
 }
 
 size_t DirectJK::memory_estimate() {
+    if (accumulate_per_thread_) {
+        // One private J and K copy per thread and density. The estimate is usually requested before the
+        // densities are set, in which case their number follows from the reference.
+        size_t ndensity = std::max(C_left_.size(), D_.size());
+        if (ndensity == 0) {
+            bool restricted = !options_.exists("REFERENCE") || options_.get_str("REFERENCE") == "RHF" ||
+                              options_.get_str("REFERENCE") == "RKS";
+            ndensity = restricted ? 1 : 2;
+        }
+        size_t nbf = primary_->nbf();
+        size_t nmat = (do_J_ ? 1L : 0L) + (do_K_ ? 1L : 0L);
+        return nmat * ndensity * df_ints_num_threads_ * nbf * nbf;
+    }
     return 0;  // Effectively
 }
 
@@ -120,6 +139,7 @@ void DirectJK::print_header() const {
         outfile->Printf("    Screening Type:    %11s\n", screen_type.c_str());
         outfile->Printf("    Screening Cutoff:  %11.0E\n", cutoff_);
         outfile->Printf("    Incremental Fock:  %11s\n", incfock_ ? "Yes" : "No");
+        outfile->Printf("    Accumulation:      %11s\n", accumulate_per_thread_ ? "THREAD" : "ATOMIC");
         outfile->Printf("\n");
     }
 }
@@ -498,7 +518,6 @@ void DirectJK::build_JK_matrices(std::vector<std::shared_ptr<TwoBodyAOInt>>& int
         }
     }
     size_t ntask_pair = task_pairs.size();
-    size_t ntask_pair2 = ntask_pair * ntask_pair;
 
     // => Intermediate Buffers <= //
 
@@ -528,418 +547,521 @@ void DirectJK::build_JK_matrices(std::vector<std::shared_ptr<TwoBodyAOInt>>& int
         }
     }
     
-    // => Benchmarks <= //
-
-    num_computed_shells_ = 0L;
-    size_t computed_shells = 0L;
-
-// ==> Master Task Loop <== //
-
-#pragma omp parallel for num_threads(nthread) schedule(dynamic) reduction(+ : computed_shells)
-    for (size_t task = 0L; task < ntask_pair2; task++) {
-        size_t task1 = task / ntask_pair;
-        size_t task2 = task % ntask_pair;
-
-        int Ptask = task_pairs[task1].first;
-        int Qtask = task_pairs[task1].second;
-        int Rtask = task_pairs[task2].first;
-        int Stask = task_pairs[task2].second;
-
-        // GOTCHA! Thought this should be RStask > PQtask, but
-        // H2/3-21G: Task (10|11) gives valid quartets (30|22) and (31|22)
-        // This is an artifact that multiple shells on each task allow
-        // for for the Ptask's index to possibly trump any RStask pair,
-        // regardless of Qtask's index
-        if (Rtask > Ptask) continue;
-
-        // printf("Task: %2d %2d %2d %2d\n", Ptask, Qtask, Rtask, Stask);
-
-        int nPtask = task_starts[Ptask + 1] - task_starts[Ptask];
-        int nQtask = task_starts[Qtask + 1] - task_starts[Qtask];
-        int nRtask = task_starts[Rtask + 1] - task_starts[Rtask];
-        int nStask = task_starts[Stask + 1] - task_starts[Stask];
-
-        int P2start = task_starts[Ptask];
-        int Q2start = task_starts[Qtask];
-        int R2start = task_starts[Rtask];
-        int S2start = task_starts[Stask];
-
-        int dPsize = task_offsets[P2start + nPtask] - task_offsets[P2start];
-        int dQsize = task_offsets[Q2start + nQtask] - task_offsets[Q2start];
-        int dRsize = task_offsets[R2start + nRtask] - task_offsets[R2start];
-        int dSsize = task_offsets[S2start + nStask] - task_offsets[S2start];
-
-        int thread = 0;
-#ifdef _OPENMP
-        thread = omp_get_thread_num();
-#endif
-
-        // => Master shell quartet loops <= //
+    // => Accumulation Buffers <= //
+
+    // With per-thread accumulation, each thread stripes its task blocks into a
+    // private copy of J/K, and the copies are tree-reduced after the task loop
+    std::vector<std::vector<SharedMatrix>> J_thread;
+    std::vector<std::vector<SharedMatrix>> K_thread;
+    if (accumulate_per_thread_) {
+        if (build_J) J_thread = thread_private_copies(J, nthread);
+        if (build_K) K_thread = thread_private_copies(K, nthread);
+    }
 
-        bool touched = false;
-        for (int P2 = P2start; P2 < P2start + nPtask; P2++) {
-            for (int Q2 = Q2start; Q2 < Q2start + nQtask; Q2++) {
+    // => Task Costs <= //
+
+    // Each task is one bra task pair (PQ| against a contiguous chunk of ket task pairs |RS).
+    // The ket range of each bra task pair is split into chunks so there are enough tasks to balance over the threads.
+    size_t nchunk = std::min(ntask_pair, std::max<size_t>(1L, (16L * nthread + ntask_pair - 1) / ntask_pair));
+    size_t ntask_total = ntask_pair * nchunk;
+    auto chunk_start = [&](size_t chunk) { return (chunk * ntask_pair) / nchunk; };
+
+    // Estimated cost of each task pair: sum over its significant shell pairs
+    std::vector<double> task_pair_cost(ntask_pair, 0.0);
+    for (size_t task_pair = 0; task_pair < ntask_pair; task_pair++) {
+        int Ptask = task_pairs[task_pair].first;
+        int Qtask = task_pairs[task_pair].second;
+        for (int P2 = task_starts[Ptask]; P2 < task_starts[Ptask + 1]; P2++) {
+            for (int Q2 = task_starts[Qtask]; Q2 < task_starts[Qtask + 1]; Q2++) {
                 if (Q2 > P2) continue;
                 int P = task_shells[P2];
                 int Q = task_shells[Q2];
                 if (!ints[0]->shell_pair_significant(P, Q)) continue;
-                for (int R2 = R2start; R2 < R2start + nRtask; R2++) {
-                    for (int S2 = S2start; S2 < S2start + nStask; S2++) {
-                        if (S2 > R2) continue;
-                        int R = task_shells[R2];
-                        int S = task_shells[S2];
-                        if (R2 * nshell + S2 > P2 * nshell + Q2) continue;
-                        if (!ints[0]->shell_pair_significant(R, S)) continue;
-                        if (!ints[0]->shell_significant(P, Q, R, S)) continue;
-
-                        // printf("Quartet: %2d %2d %2d %2d\n", P, Q, R, S);
-                        // if (thread == 0) timer_on("JK: Ints");
-                        if (ints[thread]->compute_shell(P, Q, R, S) == 0)
-                            continue;  // No integrals in this shell quartet
-                        computed_shells++;
-                        // if (thread == 0) timer_off("JK: Ints");
-
-                        const double* buffer = ints[thread]->buffer();
-
-                        int Psize = primary_->shell(P).nfunction();
-                        int Qsize = primary_->shell(Q).nfunction();
-                        int Rsize = primary_->shell(R).nfunction();
-                        int Ssize = primary_->shell(S).nfunction();
-
-                        int Poff = primary_->shell(P).function_index();
-                        int Qoff = primary_->shell(Q).function_index();
-                        int Roff = primary_->shell(R).function_index();
-                        int Soff = primary_->shell(S).function_index();
-
-                        int Poff2 = task_offsets[P2] - task_offsets[P2start];
-                        int Qoff2 = task_offsets[Q2] - task_offsets[Q2start];
-                        int Roff2 = task_offsets[R2] - task_offsets[R2start];
-                        int Soff2 = task_offsets[S2] - task_offsets[S2start];
-
-                        // if (thread == 0) timer_on("JK: GEMV");
-                        for (size_t ind = 0; ind < D.size(); ind++) {
-                            double** Dp = D[ind]->pointer();
-                            double** JTp; 
-                            if (build_J) JTp = JT[thread][ind]->pointer();
-                            double** KTp;
-                            if (build_K) KTp = KT[thread][ind]->pointer();
-                            const double* buffer2 = buffer;
-
-                            if (!touched) {
-                                if (build_J) {
-                                    ::memset((void*)JTp[0L * max_task], '\0', dPsize * dQsize * sizeof(double));
-                                    ::memset((void*)JTp[1L * max_task], '\0', dRsize * dSsize * sizeof(double));
-                                }
+                task_pair_cost[task_pair] += TaskScheduler::shell_pair_cost(primary_->shell(P), primary_->shell(Q));
+            }
+        }
+    }
 
-                                if (build_K) {
-                                    ::memset((void*)KTp[0L * max_task], '\0', dPsize * dRsize * sizeof(double));
-                                    ::memset((void*)KTp[1L * max_task], '\0', dPsize * dSsize * sizeof(double));
-                                    ::memset((void*)KTp[2L * max_task], '\0', dQsize * dRsize * sizeof(double));
-                                    ::memset((void*)KTp[3L * max_task], '\0', dQsize * dSsize * sizeof(double));
-                                    if (!lr_symmetric_) {
-                                        ::memset((void*)KTp[4L * max_task], '\0', dRsize * dPsize * sizeof(double));
-                                        ::memset((void*)KTp[5L * max_task], '\0', dSsize * dPsize * sizeof(double));
-                                        ::memset((void*)KTp[6L * max_task], '\0', dRsize * dQsize * sizeof(double));
-                                        ::memset((void*)KTp[7L * max_task], '\0', dSsize * dQsize * sizeof(double));
-                                    }
-                                }
-                            }
+    std::vector<double> task_cost(ntask_total, 0.0);
+    for (size_t task1 = 0; task1 < ntask_pair; task1++) {
+        for (size_t chunk = 0; chunk < nchunk; chunk++) {
+            double ket_cost = 0.0;
+            for (size_t task2 = chunk_start(chunk); task2 < chunk_start(chunk + 1); task2++) {
+                if (task_pairs[task2].first > task_pairs[task1].first) continue;
+                ket_cost += task_pair_cost[task2];
+            }
+            task_cost[task1 * nchunk + chunk] = task_pair_cost[task1] * ket_cost;
+        }
+    }
+
+    TaskScheduler scheduler(nthread);
+    scheduler.schedule(task_cost);
 
-                            // Intermediate Contraction Pointers
-                            double* J1p;
-                            double* J2p;
-                            double* K1p;
-                            double* K2p;
-                            double* K3p;
-                            double* K4p;
-                            double* K5p;
-                            double* K6p;
-                            double* K7p;
-                            double* K8p;
+    // => Benchmarks <= //
 
+    num_computed_shells_ = 0L;
+    std::vector<size_t> computed_shells(nthread, 0L);
+
+    // Per-thread shell quartet batches: shell indices and their positions in task_shells
+    std::vector<std::vector<ShellQuartet>> batch_quartets(nthread);
+    std::vector<std::vector<std::array<int, 4>>> batch_task_shells(nthread);
+
+// ==> Master Task Loop <== //
+
+    scheduler.run([&](size_t task, int thread) {
+        size_t task1 = task / nchunk;
+        size_t chunk = task % nchunk;
+        size_t computed_shells_task = 0L;
+
+        for (size_t task2 = chunk_start(chunk); task2 < chunk_start(chunk + 1); task2++) {
+            int Ptask = task_pairs[task1].first;
+            int Qtask = task_pairs[task1].second;
+            int Rtask = task_pairs[task2].first;
+            int Stask = task_pairs[task2].second;
+
+            // GOTCHA! Thought this should be RStask > PQtask, but
+            // H2/3-21G: Task (10|11) gives valid quartets (30|22) and (31|22)
+            // This is an artifact that multiple shells on each task allow
+            // for for the Ptask's index to possibly trump any RStask pair,
+            // regardless of Qtask's index
+            if (Rtask > Ptask) continue;
+
+            // printf("Task: %2d %2d %2d %2d\n", Ptask, Qtask, Rtask, Stask);
+
+            int nPtask = task_starts[Ptask + 1] - task_starts[Ptask];
+            int nQtask = task_starts[Qtask + 1] - task_starts[Qtask];
+            int nRtask = task_starts[Rtask + 1] - task_starts[Rtask];
+            int nStask = task_starts[Stask + 1] - task_starts[Stask];
+
+            int P2start = task_starts[Ptask];
+            int Q2start = task_starts[Qtask];
+            int R2start = task_starts[Rtask];
+            int S2start = task_starts[Stask];
+
+            int dPsize = task_offsets[P2start + nPtask] - task_offsets[P2start];
+            int dQsize = task_offsets[Q2start + nQtask] - task_offsets[Q2start];
+            int dRsize = task_offsets[R2start + nRtask] - task_offsets[R2start];
+            int dSsize = task_offsets[S2start + nStask] - task_offsets[S2start];
+
+            // => Master shell quartet loops <= //
+
+            // Screened quartets are gathered into batches of about batch_target_size integrals,
+            // which the engine computes in one call before they are contracted one by one
+            auto& batch = batch_quartets[thread];
+            auto& batch_tasks = batch_task_shells[thread];
+            size_t batch_size = 0;
+            bool touched = false;
+
+            auto contract_batch = [&]() {
+                if (batch.empty()) return;
+                // if (thread == 0) timer_on("JK: Ints");
+                ints[thread]->compute_shell_batch(batch);
+                // if (thread == 0) timer_off("JK: Ints");
+                const double* batch_buffer = ints[thread]->batch_buffer();
+                const auto& batch_offsets = ints[thread]->batch_offsets();
+                const auto& batch_sizes = ints[thread]->batch_sizes();
+
+                for (size_t quartet = 0; quartet < batch.size(); quartet++) {
+                    if (batch_sizes[quartet] == 0) continue;  // No integrals in this shell quartet
+                    computed_shells_task++;
+
+                    int P = batch[quartet][0];
+                    int Q = batch[quartet][1];
+                    int R = batch[quartet][2];
+                    int S = batch[quartet][3];
+                    int P2 = batch_tasks[quartet][0];
+                    int Q2 = batch_tasks[quartet][1];
+                    int R2 = batch_tasks[quartet][2];
+                    int S2 = batch_tasks[quartet][3];
+
+                    const double* buffer = batch_buffer + batch_offsets[quartet];
+
+                    int Psize = primary_->shell(P).nfunction();
+                    int Qsize = primary_->shell(Q).nfunction();
+                    int Rsize = primary_->shell(R).nfunction();
+                    int Ssize = primary_->shell(S).nfunction();
+
+                    int Poff = primary_->shell(P).function_index();
+                    int Qoff = primary_->shell(Q).function_index();
+                    int Roff = primary_->shell(R).function_index();
+                    int Soff = primary_->shell(S).function_index();
+
+                    int Poff2 = task_offsets[P2] - task_offsets[P2start];
+                    int Qoff2 = task_offsets[Q2] - task_offsets[Q2start];
+                    int Roff2 = task_offsets[R2] - task_offsets[R2start];
+                    int Soff2 = task_offsets[S2] - task_offsets[S2start];
+
+                    // if (thread == 0) timer_on("JK: GEMV");
+                    for (size_t ind = 0; ind < D.size(); ind++) {
+                        double** Dp = D[ind]->pointer();
+                        double** JTp; 
+                        if (build_J) JTp = JT[thread][ind]->pointer();
+                        double** KTp;
+                        if (build_K) KTp = KT[thread][ind]->pointer();
+                        const double* buffer2 = buffer;
+
+                        if (!touched) {
                             if (build_J) {
-                                J1p = JTp[0L * max_task];
-                                J2p = JTp[1L * max_task];
+                                ::memset((void*)JTp[0L * max_task], '\0', dPsize * dQsize * sizeof(double));
+                                ::memset((void*)JTp[1L * max_task], '\0', dRsize * dSsize * sizeof(double));
                             }
 
                             if (build_K) {
-                                K1p = KTp[0L * max_task];
-                                K2p = KTp[1L * max_task];
-                                K3p = KTp[2L * max_task];
-                                K4p = KTp[3L * max_task];
+                                ::memset((void*)KTp[0L * max_task], '\0', dPsize * dRsize * sizeof(double));
+                                ::memset((void*)KTp[1L * max_task], '\0', dPsize * dSsize * sizeof(double));
+                                ::memset((void*)KTp[2L * max_task], '\0', dQsize * dRsize * sizeof(double));
+                                ::memset((void*)KTp[3L * max_task], '\0', dQsize * dSsize * sizeof(double));
                                 if (!lr_symmetric_) {
-                                    K5p = KTp[4L * max_task];
-                                    K6p = KTp[5L * max_task];
-                                    K7p = KTp[6L * max_task];
-                                    K8p = KTp[7L * max_task];
+                                    ::memset((void*)KTp[4L * max_task], '\0', dRsize * dPsize * sizeof(double));
+                                    ::memset((void*)KTp[5L * max_task], '\0', dSsize * dPsize * sizeof(double));
+                                    ::memset((void*)KTp[6L * max_task], '\0', dRsize * dQsize * sizeof(double));
+                                    ::memset((void*)KTp[7L * max_task], '\0', dSsize * dQsize * sizeof(double));
                                 }
                             }
+                        }
 
-                            double prefactor = 1.0;
-                            if (P == Q) prefactor *= 0.5;
-                            if (R == S) prefactor *= 0.5;
-                            if (P == R && Q == S) prefactor *= 0.5;
+                        // Intermediate Contraction Pointers
+                        double* J1p;
+                        double* J2p;
+                        double* K1p;
+                        double* K2p;
+                        double* K3p;
+                        double* K4p;
+                        double* K5p;
+                        double* K6p;
+                        double* K7p;
+                        double* K8p;
+
+                        if (build_J) {
+                            J1p = JTp[0L * max_task];
+                            J2p = JTp[1L * max_task];
+                        }
 
-                            for (int p = 0; p < Psize; p++) {
-                                for (int q = 0; q < Qsize; q++) {
-                                    for (int r = 0; r < Rsize; r++) {
-                                        for (int s = 0; s < Ssize; s++) {
-                                            if (build_J) {
-                                                J1p[(p + Poff2) * dQsize + q + Qoff2] +=
-                                                    prefactor * (Dp[r + Roff][s + Soff] + Dp[s + Soff][r + Roff]) *
-                                                    (*buffer2);
-                                                J2p[(r + Roff2) * dSsize + s + Soff2] +=
-                                                    prefactor * (Dp[p + Poff][q + Qoff] + Dp[q + Qoff][p + Poff]) *
-                                                    (*buffer2);
-                                            }
+                        if (build_K) {
+                            K1p = KTp[0L * max_task];
+                            K2p = KTp[1L * max_task];
+                            K3p = KTp[2L * max_task];
+                            K4p = KTp[3L * max_task];
+                            if (!lr_symmetric_) {
+                                K5p = KTp[4L * max_task];
+                                K6p = KTp[5L * max_task];
+                                K7p = KTp[6L * max_task];
+                                K8p = KTp[7L * max_task];
+                            }
+                        }
+
+                        double prefactor = 1.0;
+                        if (P == Q) prefactor *= 0.5;
+                        if (R == S) prefactor *= 0.5;
+                        if (P == R && Q == S) prefactor *= 0.5;
+
+                        for (int p = 0; p < Psize; p++) {
+                            for (int q = 0; q < Qsize; q++) {
+                                for (int r = 0; r < Rsize; r++) {
+                                    for (int s = 0; s < Ssize; s++) {
+                                        if (build_J) {
+                                            J1p[(p + Poff2) * dQsize + q + Qoff2] +=
+                                                prefactor * (Dp[r + Roff][s + Soff] + Dp[s + Soff][r + Roff]) *
+                                                (*buffer2);
+                                            J2p[(r + Roff2) * dSsize + s + Soff2] +=
+                                                prefactor * (Dp[p + Poff][q + Qoff] + Dp[q + Qoff][p + Poff]) *
+                                                (*buffer2);
+                                        }
                                             
-                                            if (build_K) {
-                                                K1p[(p + Poff2) * dRsize + r + Roff2] +=
-                                                    prefactor * (Dp[q + Qoff][s + Soff]) * (*buffer2);
-                                                K2p[(p + Poff2) * dSsize + s + Soff2] +=
-                                                    prefactor * (Dp[q + Qoff][r + Roff]) * (*buffer2);
-                                                K3p[(q + Qoff2) * dRsize + r + Roff2] +=
-                                                    prefactor * (Dp[p + Poff][s + Soff]) * (*buffer2);
-                                                K4p[(q + Qoff2) * dSsize + s + Soff2] +=
-                                                    prefactor * (Dp[p + Poff][r + Roff]) * (*buffer2);
-                                                if (!lr_symmetric_) {
-                                                    K5p[(r + Roff2) * dPsize + p + Poff2] +=
-                                                        prefactor * (Dp[s + Soff][q + Qoff]) * (*buffer2);
-                                                    K6p[(s + Soff2) * dPsize + p + Poff2] +=
-                                                        prefactor * (Dp[r + Roff][q + Qoff]) * (*buffer2);
-                                                    K7p[(r + Roff2) * dQsize + q + Qoff2] +=
-                                                        prefactor * (Dp[s + Soff][p + Poff]) * (*buffer2);
-                                                    K8p[(s + Soff2) * dQsize + q + Qoff2] +=
-                                                        prefactor * (Dp[r + Roff][p + Poff]) * (*buffer2);
-                                                }
+                                        if (build_K) {
+                                            K1p[(p + Poff2) * dRsize + r + Roff2] +=
+                                                prefactor * (Dp[q + Qoff][s + Soff]) * (*buffer2);
+                                            K2p[(p + Poff2) * dSsize + s + Soff2] +=
+                                                prefactor * (Dp[q + Qoff][r + Roff]) * (*buffer2);
+                                            K3p[(q + Qoff2) * dRsize + r + Roff2] +=
+                                                prefactor * (Dp[p + Poff][s + Soff]) * (*buffer2);
+                                            K4p[(q + Qoff2) * dSsize + s + Soff2] +=
+                                                prefactor * (Dp[p + Poff][r + Roff]) * (*buffer2);
+                                            if (!lr_symmetric_) {
+                                                K5p[(r + Roff2) * dPsize + p + Poff2] +=
+                                                    prefactor * (Dp[s + Soff][q + Qoff]) * (*buffer2);
+                                                K6p[(s + Soff2) * dPsize + p + Poff2] +=
+                                                    prefactor * (Dp[r + Roff][q + Qoff]) * (*buffer2);
+                                                K7p[(r + Roff2) * dQsize + q + Qoff2] +=
+                                                    prefactor * (Dp[s + Soff][p + Poff]) * (*buffer2);
+                                                K8p[(s + Soff2) * dQsize + q + Qoff2] +=
+                                                    prefactor * (Dp[r + Roff][p + Poff]) * (*buffer2);
                                             }
-                                            
-                                            buffer2++;
                                         }
+                                            
+                                        buffer2++;
                                     }
                                 }
                             }
                         }
-                        touched = true;
-                        // if (thread == 0) timer_off("JK: GEMV");
                     }
+                    touched = true;
+                    // if (thread == 0) timer_off("JK: GEMV");
                 }
-            }
-        }  // End Shell Quartets
 
-        if (!touched) continue;
+                batch.clear();
+                batch_tasks.clear();
+                batch_size = 0;
+            };
 
-        // => Stripe out <= //
-        if (build_J) {
-	    for (auto& JTmat : JT[thread]) {
-                JTmat->scale(2.0);
-	    }
-        }
-        
-        if (build_K && lr_symmetric_) {
-	    for (auto& KTmat : KT[thread]) {
-                KTmat->scale(2.0);
-	    }
-        }
+            for (int P2 = P2start; P2 < P2start + nPtask; P2++) {
+                for (int Q2 = Q2start; Q2 < Q2start + nQtask; Q2++) {
+                    if (Q2 > P2) continue;
+                    int P = task_shells[P2];
+                    int Q = task_shells[Q2];
+                    if (!ints[0]->shell_pair_significant(P, Q)) continue;
+                    for (int R2 = R2start; R2 < R2start + nRtask; R2++) {
+                        for (int S2 = S2start; S2 < S2start + nStask; S2++) {
+                            if (S2 > R2) continue;
+                            int R = task_shells[R2];
+                            int S = task_shells[S2];
+                            if (R2 * nshell + S2 > P2 * nshell + Q2) continue;
+                            if (!ints[0]->shell_pair_significant(R, S)) continue;
+                            if (!ints[0]->shell_significant(P, Q, R, S)) continue;
+
+                            // printf("Quartet: %2d %2d %2d %2d\n", P, Q, R, S);
+                            batch.push_back({P, Q, R, S});
+                            batch_tasks.push_back({P2, Q2, R2, S2});
+                            batch_size += static_cast<size_t>(primary_->shell(P).nfunction()) *
+                                          primary_->shell(Q).nfunction() * primary_->shell(R).nfunction() *
+                                          primary_->shell(S).nfunction();
+                            if (batch_size >= TwoBodyAOInt::batch_target_size) contract_batch();
+                        }
+                    }
+                }
+            }
+            contract_batch();  // End Shell Quartets
 
-        // if (thread == 0) timer_on("JK: Atomic");
-        for (size_t ind = 0; ind < D.size(); ind++) {
-            double** JTp;
-            double** KTp;
-            double** Jp;
-            double** Kp;
+            if (!touched) continue;
 
+            // => Stripe out <= //
             if (build_J) {
-                JTp = JT[thread][ind]->pointer();
-                Jp = J[ind]->pointer();
+    	    for (auto& JTmat : JT[thread]) {
+                    JTmat->scale(2.0);
+    	    }
             }
-            
-            if (build_K) {
-                KTp = KT[thread][ind]->pointer();
-                Kp = K[ind]->pointer();
+        
+            if (build_K && lr_symmetric_) {
+    	    for (auto& KTmat : KT[thread]) {
+                    KTmat->scale(2.0);
+    	    }
             }
 
-            double* J1p;
-            double* J2p;
-            double* K1p;
-            double* K2p;
-            double* K3p;
-            double* K4p;
-            double* K5p;
-            double* K6p;
-            double* K7p;
-            double* K8p;
-
-            if (build_J) {
-                J1p = JTp[0L * max_task];
-                J2p = JTp[1L * max_task];
-            }
+            // if (thread == 0) timer_on("JK: Atomic");
+            // Stripe out once with atomic updates into the shared matrices, or without into the thread's copy
+            auto stripe_out = [&](auto atomic) {
+                constexpr bool atomic_update = decltype(atomic)::value;
+                for (size_t ind = 0; ind < D.size(); ind++) {
+                    double** JTp;
+                    double** KTp;
+                    double** Jp;
+                    double** Kp;
+
+                    if (build_J) {
+                        JTp = JT[thread][ind]->pointer();
+                        Jp = (atomic_update ? J[ind] : J_thread[thread][ind])->pointer();
+                    }
+            
+                    if (build_K) {
+                        KTp = KT[thread][ind]->pointer();
+                        Kp = (atomic_update ? K[ind] : K_thread[thread][ind])->pointer();
+                    }
 
-            if (build_K) {
-                K1p = KTp[0L * max_task];
-                K2p = KTp[1L * max_task];
-                K3p = KTp[2L * max_task];
-                K4p = KTp[3L * max_task];
-                if (!lr_symmetric_) {
-                    K5p = KTp[4L * max_task];
-                    K6p = KTp[5L * max_task];
-                    K7p = KTp[6L * max_task];
-                    K8p = KTp[7L * max_task];
-                }
-            }
+                    double* J1p;
+                    double* J2p;
+                    double* K1p;
+                    double* K2p;
+                    double* K3p;
+                    double* K4p;
+                    double* K5p;
+                    double* K6p;
+                    double* K7p;
+                    double* K8p;
+
+                    if (build_J) {
+                        J1p = JTp[0L * max_task];
+                        J2p = JTp[1L * max_task];
+                    }
 
-            if (build_J) {
+                    if (build_K) {
+                        K1p = KTp[0L * max_task];
+                        K2p = KTp[1L * max_task];
+                        K3p = KTp[2L * max_task];
+                        K4p = KTp[3L * max_task];
+                        if (!lr_symmetric_) {
+                            K5p = KTp[4L * max_task];
+                            K6p = KTp[5L * max_task];
+                            K7p = KTp[6L * max_task];
+                            K8p = KTp[7L * max_task];
+                        }
+                    }
 
-                // > J_PQ < //
-
-                for (int P2 = 0; P2 < nPtask; P2++) {
-                    for (int Q2 = 0; Q2 < nQtask; Q2++) {
-                        int P = task_shells[P2start + P2];
-                        int Q = task_shells[Q2start + Q2];
-                        int Psize = primary_->shell(P).nfunction();
-                        int Qsize = primary_->shell(Q).nfunction();
-                        int Poff = primary_->shell(P).function_index();
-                        int Qoff = primary_->shell(Q).function_index();
-                        int Poff2 = task_offsets[P2 + P2start] - task_offsets[P2start];
-                        int Qoff2 = task_offsets[Q2 + Q2start] - task_offsets[Q2start];
-                        for (int p = 0; p < Psize; p++) {
-                            for (int q = 0; q < Qsize; q++) {
-#pragma omp atomic
-                                Jp[p + Poff][q + Qoff] += J1p[(p + Poff2) * dQsize + q + Qoff2];
+                    if (build_J) {
+
+                        // > J_PQ < //
+
+                        for (int P2 = 0; P2 < nPtask; P2++) {
+                            for (int Q2 = 0; Q2 < nQtask; Q2++) {
+                                int P = task_shells[P2start + P2];
+                                int Q = task_shells[Q2start + Q2];
+                                int Psize = primary_->shell(P).nfunction();
+                                int Qsize = primary_->shell(Q).nfunction();
+                                int Poff = primary_->shell(P).function_index();
+                                int Qoff = primary_->shell(Q).function_index();
+                                int Poff2 = task_offsets[P2 + P2start] - task_offsets[P2start];
+                                int Qoff2 = task_offsets[Q2 + Q2start] - task_offsets[Q2start];
+                                for (int p = 0; p < Psize; p++) {
+                                    for (int q = 0; q < Qsize; q++) {
+                                        stripe_add<atomic_update>(Jp[p + Poff][q + Qoff], J1p[(p + Poff2) * dQsize + q + Qoff2]);
+                                    }
+                                }
                             }
                         }
-                    }
-                }
 
-                // > J_RS < //
-
-                for (int R2 = 0; R2 < nRtask; R2++) {
-                    for (int S2 = 0; S2 < nStask; S2++) {
-                        int R = task_shells[R2start + R2];
-                        int S = task_shells[S2start + S2];
-                        int Rsize = primary_->shell(R).nfunction();
-                        int Ssize = primary_->shell(S).nfunction();
-                        int Roff = primary_->shell(R).function_index();
-                        int Soff = primary_->shell(S).function_index();
-                        int Roff2 = task_offsets[R2 + R2start] - task_offsets[R2start];
-                        int Soff2 = task_offsets[S2 + S2start] - task_offsets[S2start];
-                        for (int r = 0; r < Rsize; r++) {
-                            for (int s = 0; s < Ssize; s++) {
-#pragma omp atomic
-                                Jp[r + Roff][s + Soff] += J2p[(r + Roff2) * dSsize + s + Soff2];
+                        // > J_RS < //
+
+                        for (int R2 = 0; R2 < nRtask; R2++) {
+                            for (int S2 = 0; S2 < nStask; S2++) {
+                                int R = task_shells[R2start + R2];
+                                int S = task_shells[S2start + S2];
+                                int Rsize = primary_->shell(R).nfunction();
+                                int Ssize = primary_->shell(S).nfunction();
+                                int Roff = primary_->shell(R).function_index();
+                                int Soff = primary_->shell(S).function_index();
+                                int Roff2 = task_offsets[R2 + R2start] - task_offsets[R2start];
+                                int Soff2 = task_offsets[S2 + S2start] - task_offsets[S2start];
+                                for (int r = 0; r < Rsize; r++) {
+                                    for (int s = 0; s < Ssize; s++) {
+                                        stripe_add<atomic_update>(Jp[r + Roff][s + Soff], J2p[(r + Roff2) * dSsize + s + Soff2]);
+                                    }
+                                }
                             }
                         }
                     }
-                }
-            }
-
-            if (build_K) {
-
-                // > K_PR < //
 
-                for (int P2 = 0; P2 < nPtask; P2++) {
-                    for (int R2 = 0; R2 < nRtask; R2++) {
-                        int P = task_shells[P2start + P2];
-                        int R = task_shells[R2start + R2];
-                        int Psize = primary_->shell(P).nfunction();
-                        int Rsize = primary_->shell(R).nfunction();
-                        int Poff = primary_->shell(P).function_index();
-                        int Roff = primary_->shell(R).function_index();
-                        int Poff2 = task_offsets[P2 + P2start] - task_offsets[P2start];
-                        int Roff2 = task_offsets[R2 + R2start] - task_offsets[R2start];
-                        for (int p = 0; p < Psize; p++) {
-                            for (int r = 0; r < Rsize; r++) {
-#pragma omp atomic
-                                Kp[p + Poff][r + Roff] += K1p[(p + Poff2) * dRsize + r + Roff2];
-                                if (!lr_symmetric_) {
-#pragma omp atomic
-                                    Kp[r + Roff][p + Poff] += K5p[(r + Roff2) * dPsize + p + Poff2];
+                    if (build_K) {
+
+                        // > K_PR < //
+
+                        for (int P2 = 0; P2 < nPtask; P2++) {
+                            for (int R2 = 0; R2 < nRtask; R2++) {
+                                int P = task_shells[P2start + P2];
+                                int R = task_shells[R2start + R2];
+                                int Psize = primary_->shell(P).nfunction();
+                                int Rsize = primary_->shell(R).nfunction();
+                                int Poff = primary_->shell(P).function_index();
+                                int Roff = primary_->shell(R).function_index();
+                                int Poff2 = task_offsets[P2 + P2start] - task_offsets[P2start];
+                                int Roff2 = task_offsets[R2 + R2start] - task_offsets[R2start];
+                                for (int p = 0; p < Psize; p++) {
+                                    for (int r = 0; r < Rsize; r++) {
+                                        stripe_add<atomic_update>(Kp[p + Poff][r + Roff], K1p[(p + Poff2) * dRsize + r + Roff2]);
+                                        if (!lr_symmetric_) {
+                                            stripe_add<atomic_update>(Kp[r + Roff][p + Poff], K5p[(r + Roff2) * dPsize + p + Poff2]);
+                                        }
+                                    }
                                 }
                             }
                         }
-                    }
-                }
 
-                // > K_PS < //
-
-                for (int P2 = 0; P2 < nPtask; P2++) {
-                    for (int S2 = 0; S2 < nStask; S2++) {
-                        int P = task_shells[P2start + P2];
-                        int S = task_shells[S2start + S2];
-                        int Psize = primary_->shell(P).nfunction();
-                        int Ssize = primary_->shell(S).nfunction();
-                        int Poff = primary_->shell(P).function_index();
-                        int Soff = primary_->shell(S).function_index();
-                        int Poff2 = task_offsets[P2 + P2start] - task_offsets[P2start];
-                        int Soff2 = task_offsets[S2 + S2start] - task_offsets[S2start];
-                        for (int p = 0; p < Psize; p++) {
-                            for (int s = 0; s < Ssize; s++) {
-#pragma omp atomic
-                                Kp[p + Poff][s + Soff] += K2p[(p + Poff2) * dSsize + s + Soff2];
-                                if (!lr_symmetric_) {
-#pragma omp atomic
-                                    Kp[s + Soff][p + Poff] += K6p[(s + Soff2) * dPsize + p + Poff2];
+                        // > K_PS < //
+
+                        for (int P2 = 0; P2 < nPtask; P2++) {
+                            for (int S2 = 0; S2 < nStask; S2++) {
+                                int P = task_shells[P2start + P2];
+                                int S = task_shells[S2start + S2];
+                                int Psize = primary_->shell(P).nfunction();
+                                int Ssize = primary_->shell(S).nfunction();
+                                int Poff = primary_->shell(P).function_index();
+                                int Soff = primary_->shell(S).function_index();
+                                int Poff2 = task_offsets[P2 + P2start] - task_offsets[P2start];
+                                int Soff2 = task_offsets[S2 + S2start] - task_offsets[S2start];
+                                for (int p = 0; p < Psize; p++) {
+                                    for (int s = 0; s < Ssize; s++) {
+                                        stripe_add<atomic_update>(Kp[p + Poff][s + Soff], K2p[(p + Poff2) * dSsize + s + Soff2]);
+                                        if (!lr_symmetric_) {
+                                            stripe_add<atomic_update>(Kp[s + Soff][p + Poff], K6p[(s + Soff2) * dPsize + p + Poff2]);
+                                        }
+                                    }
                                 }
                             }
                         }
-                    }
-                }
 
-                // > K_QR < //
-
-                for (int Q2 = 0; Q2 < nQtask; Q2++) {
-                    for (int R2 = 0; R2 < nRtask; R2++) {
-                        int Q = task_shells[Q2start + Q2];
-                        int R = task_shells[R2start + R2];
-                        int Qsize = primary_->shell(Q).nfunction();
-                        int Rsize = primary_->shell(R).nfunction();
-                        int Qoff = primary_->shell(Q).function_index();
-                        int Roff = primary_->shell(R).function_index();
-                        int Qoff2 = task_offsets[Q2 + Q2start] - task_offsets[Q2start];
-                        int Roff2 = task_offsets[R2 + R2start] - task_offsets[R2start];
-                        for (int q = 0; q < Qsize; q++) {
-                            for (int r = 0; r < Rsize; r++) {
-#pragma omp atomic
-                                Kp[q + Qoff][r + Roff] += K3p[(q + Qoff2) * dRsize + r + Roff2];
-                                if (!lr_symmetric_) {
-#pragma omp atomic
-                                    Kp[r + Roff][q + Qoff] += K7p[(r + Roff2) * dQsize + q + Qoff2];
+                        // > K_QR < //
+
+                        for (int Q2 = 0; Q2 < nQtask; Q2++) {
+                            for (int R2 = 0; R2 < nRtask; R2++) {
+                                int Q = task_shells[Q2start + Q2];
+                                int R = task_shells[R2start + R2];
+                                int Qsize = primary_->shell(Q).nfunction();
+                                int Rsize = primary_->shell(R).nfunction();
+                                int Qoff = primary_->shell(Q).function_index();
+                                int Roff = primary_->shell(R).function_index();
+                                int Qoff2 = task_offsets[Q2 + Q2start] - task_offsets[Q2start];
+                                int Roff2 = task_offsets[R2 + R2start] - task_offsets[R2start];
+                                for (int q = 0; q < Qsize; q++) {
+                                    for (int r = 0; r < Rsize; r++) {
+                                        stripe_add<atomic_update>(Kp[q + Qoff][r + Roff], K3p[(q + Qoff2) * dRsize + r + Roff2]);
+                                        if (!lr_symmetric_) {
+                                            stripe_add<atomic_update>(Kp[r + Roff][q + Qoff], K7p[(r + Roff2) * dQsize + q + Qoff2]);
+                                        }
+                                    }
                                 }
                             }
                         }
-                    }
-                }
 
-                // > K_QS < //
-
-                for (int Q2 = 0; Q2 < nQtask; Q2++) {
-                    for (int S2 = 0; S2 < nStask; S2++) {
-                        int Q = task_shells[Q2start + Q2];
-                        int S = task_shells[S2start + S2];
-                        int Qsize = primary_->shell(Q).nfunction();
-                        int Ssize = primary_->shell(S).nfunction();
-                        int Qoff = primary_->shell(Q).function_index();
-                        int Soff = primary_->shell(S).function_index();
-                        int Qoff2 = task_offsets[Q2 + Q2start] - task_offsets[Q2start];
-                        int Soff2 = task_offsets[S2 + S2start] - task_offsets[S2start];
-                        for (int q = 0; q < Qsize; q++) {
-                            for (int s = 0; s < Ssize; s++) {
-#pragma omp atomic
-                                Kp[q + Qoff][s + Soff] += K4p[(q + Qoff2) * dSsize + s + Soff2];
-                                if (!lr_symmetric_) {
-#pragma omp atomic
-                                    Kp[s + Soff][q + Qoff] += K8p[(s + Soff2) * dQsize + q + Qoff2];
+                        // > K_QS < //
+
+                        for (int Q2 = 0; Q2 < nQtask; Q2++) {
+                            for (int S2 = 0; S2 < nStask; S2++) {
+                                int Q = task_shells[Q2start + Q2];
+                                int S = task_shells[S2start + S2];
+                                int Qsize = primary_->shell(Q).nfunction();
+                                int Ssize = primary_->shell(S).nfunction();
+                                int Qoff = primary_->shell(Q).function_index();
+                                int Soff = primary_->shell(S).function_index();
+                                int Qoff2 = task_offsets[Q2 + Q2start] - task_offsets[Q2start];
+                                int Soff2 = task_offsets[S2 + S2start] - task_offsets[S2start];
+                                for (int q = 0; q < Qsize; q++) {
+                                    for (int s = 0; s < Ssize; s++) {
+                                        stripe_add<atomic_update>(Kp[q + Qoff][s + Soff], K4p[(q + Qoff2) * dSsize + s + Soff2]);
+                                        if (!lr_symmetric_) {
+                                            stripe_add<atomic_update>(Kp[s + Soff][q + Qoff], K8p[(s + Soff2) * dQsize + q + Qoff2]);
+                                        }
+                                    }
                                 }
                             }
                         }
                     }
-                }
+                }  // End stripe out
+            };
+            if (accumulate_per_thread_) {
+                stripe_out(std::false_type());
+            } else {
+                stripe_out(std::true_type());
             }
+            // if (thread == 0) timer_off("JK: Atomic");
+
+        }  // End ket task pairs
+
+        computed_shells[thread] += computed_shells_task;
+    });  // End master task list
 
-        }  // End stripe out
-        // if (thread == 0) timer_off("JK: Atomic");
+    // => Reduction of thread-private J/K <= //
 
-    }  // End master task list
+    if (accumulate_per_thread_) {
+        timer_on("DirectJK: Reduction");
+        Timer reduction_timer;
+        if (build_J) tree_reduce_thread_buffers(J_thread, J, nthread);
+        if (build_K) tree_reduce_thread_buffers(K_thread, K, nthread);
+        double reduction_time = reduction_timer.get();
+        timer_off("DirectJK: Reduction");
+
+        if (get_bench()) {
+            outfile->Printf("    DirectJK: Reduced %d thread-private J/K copies in %.3f [s]\n", nthread,
+                            reduction_time);
+        }
+    }
 
     for (auto& Jmat : J) {
         Jmat->hermitivitize();
@@ -951,9 +1073,10 @@ void DirectJK::build_JK_matrices(std::vector<std::shared_ptr<TwoBodyAOInt>>& int
         }
     }
 
-    num_computed_shells_ = computed_shells;
+    num_computed_shells_ = std::accumulate(computed_shells.begin(), computed_shells.end(), size_t(0));
     if (get_bench()) {
         computed_shells_per_iter_["Quartets"].push_back(num_computed_shells());
+        scheduler.print_statistics("DirectJK");
     }
 
     timer_off("build_JK_matrices()");
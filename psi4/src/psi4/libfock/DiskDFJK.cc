@@ -42,11 +42,12 @@
 
 #include "jk.h"
 
+#include <algorithm>
 #include <sstream>
 #include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/libpsi4util/process.h"
 #ifdef _OPENMP
 #include <omp.h>
-#include "psi4/libpsi4util/process.h"
 #endif
 
 using namespace psi;
@@ -68,6 +69,10 @@ void DiskDFJK::common_init() {
     unit_ = PSIF_DFSCF_BJ;
     if (options_["SCF_SUBTYPE"].has_changed()) set_subalgo(options_.get_str("SCF_SUBTYPE"));
     is_core_ = true;
+
+    // INCFOCK is an SCF option, other modules build this object too
+    incfock_ = options_.exists("INCFOCK") && options_.get_bool("INCFOCK");
+    if (incfock_) incfock_df_ = std::make_unique<DFIncFock>(primary_, options_);
     psio_ = PSIO::shared_object();
     // We need to make an integral object so we can figure out memory requirements from the sieve
     std::shared_ptr<BasisSet> zero = BasisSet::zero_ao_basis_set();
@@ -280,6 +285,7 @@ void DiskDFJK::print_header() const {
         outfile->Printf("    Memory [MiB]:      %11ld\n", (memory_ * 8L) / (1024L * 1024L));
         outfile->Printf("    Algorithm:         %11s\n", (is_core_ ? "Core" : "Disk"));
         outfile->Printf("    Integral Cache:    %11s\n", df_ints_io_.c_str());
+        outfile->Printf("    Incremental Fock:  %11s\n", (incfock_ ? "Yes" : "No"));
         outfile->Printf("    Schwarz Cutoff:    %11.0E\n", cutoff_);
         outfile->Printf("    Fitting Condition: %11.0E\n\n", condition_);
 
@@ -468,13 +474,81 @@ void DiskDFJK::preiterations() {
     }
 }
 
+void DiskDFJK::incfock_build(const std::vector<SharedMatrix>& C, const std::vector<SharedMatrix>& D, bool do_J,
+                             bool do_K) {
+    // The J/K blocks read the C/D members, so swap the factors in around the build
+    std::vector<SharedMatrix> C_left_full = C_left_;
+    std::vector<SharedMatrix> C_right_full = C_right_;
+    std::vector<SharedMatrix> C_left_ao_full = C_left_ao_;
+    std::vector<SharedMatrix> C_right_ao_full = C_right_ao_;
+    std::vector<SharedMatrix> D_full = D_ao_;
+    bool do_J_full = do_J_;
+    bool do_K_full = do_K_;
+
+    // block_K checks C_left_/C_right_ to see whether the sides differ
+    C_left_ao_ = C;
+    C_right_ao_ = C;
+    C_left_ = C;
+    C_right_ = C;
+    D_ao_ = D;
+    do_J_ = do_J;
+    do_K_ = do_K;
+    max_nocc_ = max_nocc();
+    max_rows_ = max_rows();
+
+    initialize_temps();
+    if (is_core_) {
+        manage_JK_core();
+    } else {
+        manage_JK_disk();
+    }
+    free_temps();
+
+    C_left_ = C_left_full;
+    C_right_ = C_right_full;
+    C_left_ao_ = C_left_ao_full;
+    C_right_ao_ = C_right_ao_full;
+    D_ao_ = D_full;
+    do_J_ = do_J_full;
+    do_K_ = do_K_full;
+}
 void DiskDFJK::compute_JK() {
-    // zero out J, K, and wK matrices
-    zero();
+    // Incremental iterations add the density difference onto the previous J,
+    // and onto the previous K when that is cheaper than rebuilding it
+    bool incremental = false;
+    if (incfock_) {
+        timer_on("DiskDFJK: INCFOCK Preprocessing");
+        incremental = incfock_df_->setup(D_ao_, lr_symmetric_ && !do_wK_ && !initial_iteration_, max_nocc());
+        timer_off("DiskDFJK: INCFOCK Preprocessing");
+    }
+
+    bool full_J = do_J_;
+    bool full_K = do_K_;
+    if (incremental) {
+        if (is_core_ && (!Qmn_ || Qmn_.use_count() == 0)) {
+            throw PSIEXCEPTION(
+                "DiskDFJK(in-core mode) tried to compute J or K in compute_JK with a Qmn_ that does not point to a "
+                "Matrix object!");
+        }
+        timer_on("DiskDFJK: INCFOCK Build");
+        incfock_df_->build(K_ao_, do_J_, do_K_,
+                           [this](const std::vector<SharedMatrix>& C, const std::vector<SharedMatrix>& D, bool do_J,
+                                  bool do_K) { incfock_build(C, D, do_J, do_K); });
+        timer_off("DiskDFJK: INCFOCK Build");
+        full_J = false;
+        full_K = do_K_ && !incfock_df_->incremental_K();
+    } else {
+        // zero out J, K, and wK matrices
+        zero();
+    }
     max_nocc_ = max_nocc();
     max_rows_ = max_rows();
 
-    if (do_J_ || do_K_) {
+    if (full_J || full_K) {
+        bool do_J = do_J_;
+        bool do_K = do_K_;
+        do_J_ = full_J;
+        do_K_ = full_K;
         initialize_temps();
         if (is_core_) {
             if (!Qmn_ || Qmn_.use_count() == 0) {
@@ -487,6 +561,8 @@ void DiskDFJK::compute_JK() {
             manage_JK_disk();
         }
         free_temps();
+        do_J_ = do_J;
+        do_K_ = do_K;
     }
 
     if (do_wK_) {
@@ -503,6 +579,10 @@ void DiskDFJK::compute_JK() {
             }
         }
     }
+
+    if (incfock_) incfock_df_->postiter(D_ao_);
+
+    if (initial_iteration_) initial_iteration_ = false;
 }
 
 void DiskDFJK::postiterations() {
@@ -28,6 +28,8 @@
 
 #include "jk.h"
 #include "SplitJK.h"
+#include "task_scheduler.h"
+#include "thread_reduction.h"
 #include "psi4/libqt/qt.h"
 #include "psi4/libfock/cubature.h"
 #include "psi4/libfock/points.h"
@@ -40,11 +42,13 @@
 #include "psi4/liboptions/liboptions.h"
 #include "psi4/lib3index/dftensor.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/libpsi4util/libpsi4util.h"
 
 #include <unordered_set>
 #include <vector>
 #include <map>
 #include <algorithm>
+#include <numeric>
 #ifdef _OPENMP
 #include <omp.h>
 #endif
@@ -74,6 +78,8 @@ LinK::LinK(std::shared_ptr<BasisSet> primary, Options& options) : SplitJK(primar
         linK_ints_cutoff_ = cutoff_;
     }
 
+    accumulate_per_thread_ = options.get_str("JK_ACCUMULATION") == "THREAD";
+
     timer_off("LinK: Setup");
 }
 
@@ -83,12 +89,19 @@ size_t LinK::num_computed_shells() {
     return num_computed_shells_;
 }
 
+size_t LinK::memory_estimate(size_t ndensity) {
+    if (!accumulate_per_thread_) return 0;
+    size_t nbf = primary_->nbf();
+    return ndensity * nthreads_ * nbf * nbf;
+}
+
 void LinK::print_header() const {
     if (print_) {
         outfile->Printf("\n");
         outfile->Printf("  ==> LinK: Linear Exchange K <==\n\n");
 
         outfile->Printf("    K Screening Cutoff:%11.0E\n", linK_ints_cutoff_);
+        outfile->Printf("    K Accumulation:    %11s\n", accumulate_per_thread_ ? "THREAD" : "ATOMIC");
     }
 }
 
@@ -256,15 +269,43 @@ void LinK::build_G_component(std::vector<std::shared_ptr<Matrix>>& D, std::vecto
         KT.push_back(K2);
     }
 
+    // With per-thread accumulation, each thread stripes out into a private
+    // copy of K, and the copies are tree-reduced after the task loop
+    std::vector<std::vector<SharedMatrix>> K_thread;
+    if (accumulate_per_thread_) K_thread = thread_private_copies(K, nthread);
+
+    // ==> Task Costs <== //
+
+    // Estimated cost of each atom-pair task: every significant bra shell pair PQ
+    // is weighted by the number of ket shells that survive density screening for P and Q
+    std::vector<double> atom_pair_cost(natom_pair, 0.0);
+    for (size_t ipair = 0L; ipair < natom_pair; ipair++) {
+        int Patom = atom_pairs[ipair].first;
+        int Qatom = atom_pairs[ipair].second;
+        for (int P = shell_endpoints_for_atom[Patom]; P < shell_endpoints_for_atom[Patom + 1]; P++) {
+            for (int Q = shell_endpoints_for_atom[Qatom]; Q < shell_endpoints_for_atom[Qatom + 1]; Q++) {
+                if (Q > P) continue;
+                if (!eri_computers[0]->shell_pair_significant(P, Q)) continue;
+                double nket = significant_kets[P].size() + significant_kets[Q].size();
+                atom_pair_cost[ipair] += TaskScheduler::shell_pair_cost(primary_->shell(P), primary_->shell(Q)) * nket;
+            }
+        }
+    }
+
+    TaskScheduler scheduler(nthread);
+    scheduler.schedule(atom_pair_cost);
+
     // ==> Start "Loop over significant 'bra'-shell pairs uh" in Fig. 1 of paper <== //
     // Number of computed shell quartets is tracked for benchmarking purposes
     num_computed_shells_ = 0L;
-    size_t computed_shells = 0L;
+    std::vector<size_t> computed_shells(nthread, 0L);
+
+    // Per-thread shell quartet batches
+    std::vector<std::vector<ShellQuartet>> batch_quartets(nthread);
 
     // ==> Integral Formation Loop <== //
 
-#pragma omp parallel for num_threads(nthread) schedule(dynamic) reduction(+ : computed_shells)
-    for (size_t ipair = 0L; ipair < natom_pair; ipair++) { // O(N) shell-pairs in asymptotic limit
+    scheduler.run([&](size_t ipair, int thread) { // O(N) shell-pairs in asymptotic limit
         int Patom = atom_pairs[ipair].first;
         int Qatom = atom_pairs[ipair].second;
 
@@ -280,15 +321,11 @@ void LinK::build_G_component(std::vector<std::shared_ptr<Matrix>>& D, std::vecto
         int nPbasis = basis_endpoints_for_shell[Pstart + nPshell] - basis_endpoints_for_shell[Pstart];
         int nQbasis = basis_endpoints_for_shell[Qstart + nQshell] - basis_endpoints_for_shell[Qstart];
 
-        int thread = 0;
-#ifdef _OPENMP
-        thread = omp_get_thread_num();
-#endif
-
         // Keep track of contraction indices for stripeout (Towards end of this function)
         std::vector<std::unordered_set<int>> P_stripeout_list(nPshell);
         std::vector<std::unordered_set<int>> Q_stripeout_list(nQshell);
 
+        size_t computed_shells_task = 0L;
         bool touched = false;
         for (int P = Pstart; P < Pstart + nPshell; P++) {
             for (int Q = Qstart; Q < Qstart + nQshell; Q++) {
@@ -342,7 +379,94 @@ void LinK::build_G_component(std::vector<std::shared_ptr<Matrix>>& D, std::vecto
                     if (!is_significant) break;
                 }
 
-                // Loop over significant RS pairs
+                // Loop over significant RS pairs, gathering the quartets into batches of about
+                // batch_target_size integrals that the engine computes in one call
+                auto& batch = batch_quartets[thread];
+                size_t batch_size = 0;
+
+                auto contract_batch = [&]() {
+                    if (batch.empty()) return;
+                    eri_computers[thread]->compute_shell_batch(batch);
+                    const double* batch_buffer = eri_computers[thread]->batch_buffer();
+                    const auto& batch_offsets = eri_computers[thread]->batch_offsets();
+                    const auto& batch_sizes = eri_computers[thread]->batch_sizes();
+
+                    for (size_t quartet = 0; quartet < batch.size(); quartet++) {
+                        if (batch_sizes[quartet] == 0) continue;
+                        computed_shells_task++;
+
+                        int R = batch[quartet][2];
+                        int S = batch[quartet][3];
+                        const double* buffer = batch_buffer + batch_offsets[quartet];
+
+                        // Number of basis functions in shells P, Q, R, S
+                        int shell_P_nfunc = primary_->shell(P).nfunction();
+                        int shell_Q_nfunc = primary_->shell(Q).nfunction();
+                        int shell_R_nfunc = primary_->shell(R).nfunction();
+                        int shell_S_nfunc = primary_->shell(S).nfunction();
+
+                        // Basis Function Starting index for shell
+                        int shell_P_start = primary_->shell(P).function_index();
+                        int shell_Q_start = primary_->shell(Q).function_index();
+                        int shell_R_start = primary_->shell(R).function_index();
+                        int shell_S_start = primary_->shell(S).function_index();
+
+                        // Basis Function offset from first basis function in the atom
+                        int shell_P_offset = basis_endpoints_for_shell[P] - basis_endpoints_for_shell[Pstart];
+                        int shell_Q_offset = basis_endpoints_for_shell[Q] - basis_endpoints_for_shell[Qstart];
+
+                        for (size_t ind = 0; ind < D.size(); ind++) {
+                            double** Kp = K[ind]->pointer();
+                            double** Dp = D[ind]->pointer();
+                            double** KTp = KT[thread][ind]->pointer();
+                            const double* buffer2 = buffer;
+
+                            if (!touched) {
+                                ::memset((void*)KTp[0L * max_functions_per_atom], '\0', nPbasis * nbf * sizeof(double));
+                                ::memset((void*)KTp[1L * max_functions_per_atom], '\0', nPbasis * nbf * sizeof(double));
+                                ::memset((void*)KTp[2L * max_functions_per_atom], '\0', nQbasis * nbf * sizeof(double));
+                                ::memset((void*)KTp[3L * max_functions_per_atom], '\0', nQbasis * nbf * sizeof(double));
+                            }
+
+                            // Four pointers needed for PR, PS, QR, QS
+                            double* K1p = KTp[0L * max_functions_per_atom];
+                            double* K2p = KTp[1L * max_functions_per_atom];
+                            double* K3p = KTp[2L * max_functions_per_atom];
+                            double* K4p = KTp[3L * max_functions_per_atom];
+
+                            double prefactor = 1.0;
+                            if (P == Q) prefactor *= 0.5;
+                            if (R == S) prefactor *= 0.5;
+                            if (P == R && Q == S) prefactor *= 0.5;
+
+                            // => Computing integral contractions to K buffers <= //
+                            for (int p = 0; p < shell_P_nfunc; p++) {
+                                for (int q = 0; q < shell_Q_nfunc; q++) {
+                                    for (int r = 0; r < shell_R_nfunc; r++) {
+                                        for (int s = 0; s < shell_S_nfunc; s++) {
+
+                                            K1p[(p + shell_P_offset) * nbf + r + shell_R_start] +=
+                                                prefactor * (Dp[q + shell_Q_start][s + shell_S_start]) * (*buffer2);
+                                            K2p[(p + shell_P_offset) * nbf + s + shell_S_start] +=
+                                                prefactor * (Dp[q + shell_Q_start][r + shell_R_start]) * (*buffer2);
+                                            K3p[(q + shell_Q_offset) * nbf + r + shell_R_start] +=
+                                                prefactor * (Dp[p + shell_P_start][s + shell_S_start]) * (*buffer2);
+                                            K4p[(q + shell_Q_offset) * nbf + s + shell_S_start] +=
+                                                prefactor * (Dp[p + shell_P_start][r + shell_R_start]) * (*buffer2);
+
+                                            buffer2++;
+                                        }
+                                    }
+                                }
+                            }
+                        }
+                        touched = true;
+                    }
+
+                    batch.clear();
+                    batch_size = 0;
+                };
+
                 for (const int RS : ML_PQ) {
 
                     int R = RS / nshell;
@@ -351,149 +475,107 @@ void LinK::build_G_component(std::vector<std::shared_ptr<Matrix>>& D, std::vecto
                     if (!eri_computers[0]->shell_pair_significant(R, S)) continue;
                     if (!eri_computers[0]->shell_significant(P, Q, R, S)) continue;
 
-                    if (eri_computers[thread]->compute_shell(P, Q, R, S) == 0)
-                        continue;
-                    computed_shells++;
-
-                    const double* buffer = eri_computers[thread]->buffer();
-
-                    // Number of basis functions in shells P, Q, R, S
-                    int shell_P_nfunc = primary_->shell(P).nfunction();
-                    int shell_Q_nfunc = primary_->shell(Q).nfunction();
-                    int shell_R_nfunc = primary_->shell(R).nfunction();
-                    int shell_S_nfunc = primary_->shell(S).nfunction();
-
-                    // Basis Function Starting index for shell
-                    int shell_P_start = primary_->shell(P).function_index();
-                    int shell_Q_start = primary_->shell(Q).function_index();
-                    int shell_R_start = primary_->shell(R).function_index();
-                    int shell_S_start = primary_->shell(S).function_index();
-
-                    // Basis Function offset from first basis function in the atom
-                    int shell_P_offset = basis_endpoints_for_shell[P] - basis_endpoints_for_shell[Pstart];
-                    int shell_Q_offset = basis_endpoints_for_shell[Q] - basis_endpoints_for_shell[Qstart];
-
-                    for (size_t ind = 0; ind < D.size(); ind++) {
-                        double** Kp = K[ind]->pointer();
-                        double** Dp = D[ind]->pointer();
-                        double** KTp = KT[thread][ind]->pointer();
-                        const double* buffer2 = buffer;
-
-                        if (!touched) {
-                            ::memset((void*)KTp[0L * max_functions_per_atom], '\0', nPbasis * nbf * sizeof(double));
-                            ::memset((void*)KTp[1L * max_functions_per_atom], '\0', nPbasis * nbf * sizeof(double));
-                            ::memset((void*)KTp[2L * max_functions_per_atom], '\0', nQbasis * nbf * sizeof(double));
-                            ::memset((void*)KTp[3L * max_functions_per_atom], '\0', nQbasis * nbf * sizeof(double));
-                        }
-
-                        // Four pointers needed for PR, PS, QR, QS
-                        double* K1p = KTp[0L * max_functions_per_atom];
-                        double* K2p = KTp[1L * max_functions_per_atom];
-                        double* K3p = KTp[2L * max_functions_per_atom];
-                        double* K4p = KTp[3L * max_functions_per_atom];
-
-                        double prefactor = 1.0;
-                        if (P == Q) prefactor *= 0.5;
-                        if (R == S) prefactor *= 0.5;
-                        if (P == R && Q == S) prefactor *= 0.5;
-
-                        // => Computing integral contractions to K buffers <= //
-                        for (int p = 0; p < shell_P_nfunc; p++) {
-                            for (int q = 0; q < shell_Q_nfunc; q++) {
-                                for (int r = 0; r < shell_R_nfunc; r++) {
-                                    for (int s = 0; s < shell_S_nfunc; s++) {
-
-                                        K1p[(p + shell_P_offset) * nbf + r + shell_R_start] +=
-                                            prefactor * (Dp[q + shell_Q_start][s + shell_S_start]) * (*buffer2);
-                                        K2p[(p + shell_P_offset) * nbf + s + shell_S_start] +=
-                                            prefactor * (Dp[q + shell_Q_start][r + shell_R_start]) * (*buffer2);
-                                        K3p[(q + shell_Q_offset) * nbf + r + shell_R_start] +=
-                                            prefactor * (Dp[p + shell_P_start][s + shell_S_start]) * (*buffer2);
-                                        K4p[(q + shell_Q_offset) * nbf + s + shell_S_start] +=
-                                            prefactor * (Dp[p + shell_P_start][r + shell_R_start]) * (*buffer2);
-
-                                        buffer2++;
-                                    }
-                                }
-                            }
-                        }
-                    }
-                    touched = true;
+                    batch.push_back({P, Q, R, S});
+                    batch_size += static_cast<size_t>(primary_->shell(P).nfunction()) * primary_->shell(Q).nfunction() *
+                                  primary_->shell(R).nfunction() * primary_->shell(S).nfunction();
+                    if (batch_size >= TwoBodyAOInt::batch_target_size) contract_batch();
                 }
+                contract_batch();
             }
         }
 
         // => Master shell quartet loops <= //
 
-        if (!touched) continue;
+        computed_shells[thread] += computed_shells_task;
+        if (!touched) return;
 
         // => Stripe out (Writing to K matrix) <= //
         for (auto& KTmat : KT[thread]) {
             KTmat->scale(2.0);
         }
 
-        for (size_t ind = 0; ind < D.size(); ind++) {
-            double** KTp = KT[thread][ind]->pointer();
-            double** Kp = K[ind]->pointer();
-
-            double* K1p = KTp[0L * max_functions_per_atom];
-            double* K2p = KTp[1L * max_functions_per_atom];
-            double* K3p = KTp[2L * max_functions_per_atom];
-            double* K4p = KTp[3L * max_functions_per_atom];
+        // Stripe out once with atomic updates into the shared matrices, or without into the thread's copy
+        auto stripe_out = [&](auto atomic) {
+            constexpr bool atomic_update = decltype(atomic)::value;
+            for (size_t ind = 0; ind < D.size(); ind++) {
+                double** KTp = KT[thread][ind]->pointer();
+                double** Kp = (atomic_update ? K[ind] : K_thread[thread][ind])->pointer();
+
+                double* K1p = KTp[0L * max_functions_per_atom];
+                double* K2p = KTp[1L * max_functions_per_atom];
+                double* K3p = KTp[2L * max_functions_per_atom];
+                double* K4p = KTp[3L * max_functions_per_atom];
+
+                // K_PR and K_PS
+                for (int P = Pstart; P < Pstart + nPshell; P++) {
+                    int dP = P - Pstart;
+                    int shell_P_start = primary_->shell(P).function_index();
+                    int shell_P_nfunc = primary_->shell(P).nfunction();
+                    int shell_P_offset = basis_endpoints_for_shell[P] - basis_endpoints_for_shell[Pstart];
+                    for (const int S : P_stripeout_list[dP]) {
+                        int shell_S_start = primary_->shell(S).function_index();
+                        int shell_S_nfunc = primary_->shell(S).nfunction();
 
-            // K_PR and K_PS
-            for (int P = Pstart; P < Pstart + nPshell; P++) {
-                int dP = P - Pstart;
-                int shell_P_start = primary_->shell(P).function_index();
-                int shell_P_nfunc = primary_->shell(P).nfunction();
-                int shell_P_offset = basis_endpoints_for_shell[P] - basis_endpoints_for_shell[Pstart];
-                for (const int S : P_stripeout_list[dP]) {
-                    int shell_S_start = primary_->shell(S).function_index();
-                    int shell_S_nfunc = primary_->shell(S).nfunction();
-
-                    for (int p = 0; p < shell_P_nfunc; p++) {
-                        for (int s = 0; s < shell_S_nfunc; s++) {
-#pragma omp atomic
-                            Kp[shell_P_start + p][shell_S_start + s] += K1p[(p + shell_P_offset) * nbf + s + shell_S_start];
-#pragma omp atomic
-                            Kp[shell_P_start + p][shell_S_start + s] += K2p[(p + shell_P_offset) * nbf + s + shell_S_start];
+                        for (int p = 0; p < shell_P_nfunc; p++) {
+                            for (int s = 0; s < shell_S_nfunc; s++) {
+                                stripe_add<atomic_update>(Kp[shell_P_start + p][shell_S_start + s], K1p[(p + shell_P_offset) * nbf + s + shell_S_start]);
+                                stripe_add<atomic_update>(Kp[shell_P_start + p][shell_S_start + s], K2p[(p + shell_P_offset) * nbf + s + shell_S_start]);
+                            }
                         }
-                    }
 
+                    }
                 }
-            }
 
-            // K_QR and K_QS
-            for (int Q = Qstart; Q < Qstart + nQshell; Q++) {
-                int dQ = Q - Qstart;
-                int shell_Q_start = primary_->shell(Q).function_index();
-                int shell_Q_nfunc = primary_->shell(Q).nfunction();
-                int shell_Q_offset = basis_endpoints_for_shell[Q] - basis_endpoints_for_shell[Qstart];
-                for (const int S : Q_stripeout_list[dQ]) {
-                    int shell_S_start = primary_->shell(S).function_index();
-                    int shell_S_nfunc = primary_->shell(S).nfunction();
-
-                    for (int q = 0; q < shell_Q_nfunc; q++) {
-                        for (int s = 0; s < shell_S_nfunc; s++) {
-#pragma omp atomic
-                            Kp[shell_Q_start + q][shell_S_start + s] += K3p[(q + shell_Q_offset) * nbf + s + shell_S_start];
-#pragma omp atomic
-                            Kp[shell_Q_start + q][shell_S_start + s] += K4p[(q + shell_Q_offset) * nbf + s + shell_S_start];
+                // K_QR and K_QS
+                for (int Q = Qstart; Q < Qstart + nQshell; Q++) {
+                    int dQ = Q - Qstart;
+                    int shell_Q_start = primary_->shell(Q).function_index();
+                    int shell_Q_nfunc = primary_->shell(Q).nfunction();
+                    int shell_Q_offset = basis_endpoints_for_shell[Q] - basis_endpoints_for_shell[Qstart];
+                    for (const int S : Q_stripeout_list[dQ]) {
+                        int shell_S_start = primary_->shell(S).function_index();
+                        int shell_S_nfunc = primary_->shell(S).nfunction();
+
+                        for (int q = 0; q < shell_Q_nfunc; q++) {
+                            for (int s = 0; s < shell_S_nfunc; s++) {
+                                stripe_add<atomic_update>(Kp[shell_Q_start + q][shell_S_start + s], K3p[(q + shell_Q_offset) * nbf + s + shell_S_start]);
+                                stripe_add<atomic_update>(Kp[shell_Q_start + q][shell_S_start + s], K4p[(q + shell_Q_offset) * nbf + s + shell_S_start]);
+                            }
                         }
-                    }
 
+                    }
                 }
-            }
+            }  // End stripe out
+        };
+        if (accumulate_per_thread_) {
+            stripe_out(std::false_type());
+        } else {
+            stripe_out(std::true_type());
+        }
 
-        }  // End stripe out
+    });  // End master task list
 
-    }  // End master task list
+    if (accumulate_per_thread_) {
+        timer_on("LinK: Reduction");
+        Timer reduction_timer;
+        tree_reduce_thread_buffers(K_thread, K, nthread);
+        double reduction_time = reduction_timer.get();
+        timer_off("LinK: Reduction");
+
+        if (bench_) {
+            outfile->Printf("    LinK: Reduced %d thread-private K copies in %.3f [s]\n", nthread, reduction_time);
+        }
+    }
 
     for (auto& Kmat : K) {
         Kmat->hermitivitize();
     }
 
-    num_computed_shells_ = computed_shells;
+    num_computed_shells_ = std::accumulate(computed_shells.begin(), computed_shells.end(), size_t(0));
+
+    if (bench_) {
+        scheduler.print_statistics("LinK");
+    }
 }
 
 }  // namespace psi
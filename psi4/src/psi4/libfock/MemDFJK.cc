@@ -42,11 +42,12 @@
 
 #include "jk.h"
 
+#include <algorithm>
 #include <sstream>
 #include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/libpsi4util/process.h"
 #ifdef _OPENMP
 #include <omp.h>
-#include "psi4/libpsi4util/process.h"
 #endif
 
 using namespace psi;
@@ -61,7 +62,17 @@ MemDFJK::MemDFJK(std::shared_ptr<BasisSet> primary, std::shared_ptr<BasisSet> au
 
 MemDFJK::~MemDFJK() {}
 
-void MemDFJK::common_init() { dfh_ = std::make_shared<DFHelper>(primary_, auxiliary_); }
+void MemDFJK::common_init() {
+    dfh_ = std::make_shared<DFHelper>(primary_, auxiliary_);
+
+    // INCFOCK is an SCF option, other modules build this object too
+    incfock_ = options_.exists("INCFOCK") && options_.get_bool("INCFOCK");
+    if (incfock_) incfock_df_ = std::make_unique<DFIncFock>(primary_, options_);
+
+    // DF_LOCAL_K is an SCF option as well
+    local_K_ = options_.exists("DF_LOCAL_K") && options_.get_bool("DF_LOCAL_K");
+    local_K_cutoff_ = (local_K_ ? options_.get_double("DF_LOCAL_K_CUTOFF") : 0.0);
+}
 size_t MemDFJK::memory_estimate() {
     dfh_->set_nthreads(omp_nthread_);
     dfh_->set_schwarz_cutoff(cutoff_);
@@ -88,26 +99,75 @@ void MemDFJK::preiterations() {
     }
     dfh_->set_omega_alpha(omega_alpha_);
     dfh_->set_omega_beta(omega_beta_);
+    dfh_->set_K_domain_cutoff(local_K_ ? local_K_cutoff_ : 0.0);
 
     // we need to prepare the AOs here, and that's it.
     // DFHelper takes care of all the housekeeping
 
     dfh_->initialize();
 }
+void MemDFJK::incfock_build(const std::vector<SharedMatrix>& C, const std::vector<SharedMatrix>& D, bool do_J,
+                            bool do_K) {
+    size_t nocc = 0;
+    for (auto const& Ci : C) nocc = std::max(nocc, static_cast<size_t>(Ci->colspi()[0]));
+    dfh_->build_JK(C, C, D, J_ao_, K_ao_, wK_ao_, nocc, do_J, do_K, false, true);
+}
 void MemDFJK::compute_JK() {
+    // Incremental iterations add the density difference onto the previous J,
+    // and onto the previous K when that is cheaper than rebuilding it
+    bool incremental = false;
+    if (incfock_) {
+        timer_on("MemDFJK: INCFOCK Preprocessing");
+        incremental = incfock_df_->setup(D_ao_, lr_symmetric_ && !do_wK_ && !initial_iteration_, max_nocc());
+        timer_off("MemDFJK: INCFOCK Preprocessing");
+    }
 
-    // zero out J, K, and wK matrices
-    zero();
+    bool full_J = do_J_;
+    bool full_K = do_K_;
+    if (incremental) {
+        timer_on("MemDFJK: INCFOCK Build");
+        incfock_df_->build(K_ao_, do_J_, do_K_,
+                           [this](const std::vector<SharedMatrix>& C, const std::vector<SharedMatrix>& D, bool do_J,
+                                  bool do_K) { incfock_build(C, D, do_J, do_K); });
+        timer_off("MemDFJK: INCFOCK Build");
+        full_J = false;
+        full_K = do_K_ && !incfock_df_->incremental_K();
+    } else {
+        // zero out J, K, and wK matrices
+        zero();
+    }
 
-    dfh_->build_JK(C_left_ao_, C_right_ao_, D_ao_, J_ao_, K_ao_, wK_ao_, max_nocc(), do_J_, do_K_, do_wK_,
-                   lr_symmetric_);
-    if (lr_symmetric_) {
-        if (do_wK_) {
-            for (size_t N = 0; N < wK_ao_.size(); N++) {
-                wK_ao_[N]->hermitivitize();
+    if (full_J || full_K || do_wK_) {
+        // For local K, trade the occupied orbitals for pivoted Cholesky factors of D,
+        // which are localized in insulators and so have small AO domains
+        std::vector<SharedMatrix> C_left = C_left_ao_;
+        std::vector<SharedMatrix> C_right = C_right_ao_;
+        size_t nocc = max_nocc();
+        if (local_K_ && lr_symmetric_ && (full_K || do_wK_)) {
+            timer_on("MemDFJK: Cholesky Orbitals");
+            C_left.clear();
+            nocc = 0;
+            for (auto const& Di : D_ao_) {
+                C_left.push_back(Di->partial_cholesky_factorize(local_K_cutoff_));
+                nocc = std::max(nocc, static_cast<size_t>(C_left.back()->colspi()[0]));
+            }
+            C_right = C_left;
+            timer_off("MemDFJK: Cholesky Orbitals");
+        }
+
+        dfh_->build_JK(C_left, C_right, D_ao_, J_ao_, K_ao_, wK_ao_, nocc, full_J, full_K, do_wK_, lr_symmetric_);
+        if (lr_symmetric_) {
+            if (do_wK_) {
+                for (size_t N = 0; N < wK_ao_.size(); N++) {
+                    wK_ao_[N]->hermitivitize();
+                }
             }
         }
     }
+
+    if (incfock_) incfock_df_->postiter(D_ao_);
+
+    if (initial_iteration_) initial_iteration_ = false;
 }
 void MemDFJK::postiterations() {}
 void MemDFJK::print_header() const {
@@ -124,6 +184,9 @@ void MemDFJK::print_header() const {
         outfile->Printf("    Algorithm:          %11s\n", (dfh_->get_AO_core() ? "Core" : "Disk"));
         outfile->Printf("    Schwarz Cutoff:     %11.0E\n", cutoff_);
         outfile->Printf("    Mask sparsity (%%):  %11.4f\n", 100. * dfh_->ao_sparsity());
+        outfile->Printf("    Incremental Fock:   %11s\n", (incfock_ ? "Yes" : "No"));
+        outfile->Printf("    Local K:            %11s\n", (local_K_ ? "Yes" : "No"));
+        if (local_K_) outfile->Printf("    Local K Cutoff:     %11.0E\n", local_K_cutoff_);
         outfile->Printf("    Fitting Condition:  %11.0E\n\n", condition_);
 
         outfile->Printf("   => Auxiliary Basis Set <=\n\n");
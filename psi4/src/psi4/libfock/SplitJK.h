@@ -29,6 +29,7 @@
 #ifndef SPLITJK_H
 #define SPLITJK_H
 
+#include <string>
 #include <vector>
 
 #ifdef USING_gauxc
@@ -139,6 +140,12 @@ class PSI_API SplitJK {
     */
     virtual size_t num_computed_shells();
 
+    /**
+    * Memory (in doubles) held by the algorithm beyond its O(N^2) work arrays,
+    * for a build with ndensity densities
+    */
+    virtual size_t memory_estimate(size_t ndensity) { return 0; }
+
     /**
     * print name of method
     */
@@ -210,6 +217,8 @@ class PSI_API LinK : public SplitJK {
 
     // Density-based ERI Screening tolerance to use in the LinK algorithm
     double linK_ints_cutoff_;
+    // Accumulate K in thread-private copies with a tree reduction instead of atomics? (JK_ACCUMULATION)
+    bool accumulate_per_thread_;
 
    public:
     // => Constructors < = //
@@ -243,6 +252,11 @@ class PSI_API LinK : public SplitJK {
     */
     size_t num_computed_shells() override;
 
+    /**
+    * The thread-private K copies of JK_ACCUMULATION THREAD
+    */
+    size_t memory_estimate(size_t ndensity) override;
+
     /**
     * print name of method
     */
@@ -323,15 +337,57 @@ class PSI_API COSK : public SplitJK {
 
 
 /**
- * @brief constructs the K matrix using the GauXC implementation of the 
- * seminumerical Linear Exchange (sn-LinK) algorithm, 
- * doi: https://doi.org/10.1063/5.0151070 
+ * Upper bound on the one-electron ESP integrals of each shell pair over all grid points,
+ * DOI 10.1016/j.chemphys.2008.10.036, EQ. 20. Shared by COSK and the native snLinK backend.
+ */
+Matrix compute_esp_bound(const BasisSet &primary);
+
+/**
+ * @brief constructs the K matrix using the seminumerical Linear Exchange
+ * (sn-LinK) algorithm, doi: https://doi.org/10.1063/5.0151070
+ *
+ * Two backends are available (SNLINK_BACKEND): the GauXC library, when Psi4
+ * is built with it, and a native one on Psi4's own DFTGrid, BasisFunctions
+ * collocation and ElectrostaticInt grid integrals.
  */
 class PSI_API snLinK : public SplitJK {
     // => general Psi4 settings <= //
     // are we doing an incremental Fock build this iteration?
     bool incfock_iter_;
 
+    // => Semi-Numerical Stuff <= //
+    // what grid pruning scheme is being used?
+    std::string pruning_scheme_;
+    // what radial quadrature scheme is being used?
+    std::string radial_scheme_;
+    // how many radial points for the grid?
+    size_t radial_points_; 
+    // how many spherical/angular points for the grid?
+    size_t spherical_points_; 
+    // basis cutoff
+    double basis_tol_;
+
+    // => Native backend <= //
+    // use the native backend instead of GauXC?
+    bool native_;
+    // grid of the native backend
+    std::shared_ptr<DFTGrid> grid_;
+    // integral cutoff
+    double kscreen_;
+    // shell-pair density cutoff
+    double dscreen_;
+    // ESP integral bound of each shell pair
+    SharedMatrix esp_bound_;
+    // shells whose extents overlap, for each shell
+    std::vector<std::vector<int>> shell_extent_map_;
+    // estimated cost of each grid block, for the task scheduler
+    std::vector<double> block_cost_;
+
+    /// Set up the native backend: grid, ESP bounds and shell-pair extents
+    void native_init();
+    /// Build K with the native backend
+    void build_K_native(std::vector<std::shared_ptr<Matrix>>& D, std::vector<std::shared_ptr<Matrix>>& K);
+
   #ifdef USING_gauxc
     // use Eigen for matrix inputs to GauXC
     // perhaps this can be changed later
@@ -349,19 +405,9 @@ class PSI_API snLinK : public SplitJK {
     Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic> generate_permutation_matrix(
         const std::shared_ptr<BasisSet> psi4_basisset);
 
-    // => Semi-Numerical Stuff <= //
+    // => GauXC Semi-Numerical Stuff <= //
     // are we running snLinK on GPUs?
     bool use_gpu_; 
-    // what grid pruning scheme is being used?
-    std::string pruning_scheme_;
-    // what radial quadrature scheme is being used?
-    std::string radial_scheme_;
-    // how many radial points for the grid?
-    size_t radial_points_; 
-    // how many spherical/angular points for the grid?
-    size_t spherical_points_; 
-    // basis cutoff
-    double basis_tol_;
    
     /// Factory for generating GauXC "Load Balancer" objects
     std::unique_ptr<GauXC::LoadBalancerFactory> gauxc_load_balancer_factory_;
@@ -419,6 +465,11 @@ class PSI_API snLinK : public SplitJK {
     */
     void print_header() const override;
 
+    /**
+    * Return number of ESP shell pairs computed by the native backend.
+    */
+    size_t num_computed_shells() override;
+
     /**
     * print name of method
     */
@@ -429,7 +480,8 @@ class PSI_API snLinK : public SplitJK {
 
     int get_max_am() {
       #ifdef USING_gauxc
-        return gauxc_max_am_;
+        if (!native_) return gauxc_max_am_;
+        throw PSIEXCEPTION("snLinK is running on the native backend, not GauXC!");
       #else
         throw PSIEXCEPTION("Psi4 is not installed with GauXC support!");
       #endif
@@ -0,0 +1,216 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2026 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#include "collocation_cache.h"
+
+#include "psi4/libmints/matrix.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace psi {
+
+namespace {
+
+// Every component starts 8-byte aligned in the arena
+size_t align8(size_t size) { return (size + 7) & ~static_cast<size_t>(7); }
+
+template <typename T>
+void pack_component(double** vp, size_t nrows, size_t ncols, double threshold, bool sparse, size_t nstored,
+                    char* dest) {
+    if (sparse) {
+        uint32_t* idx = reinterpret_cast<uint32_t*>(dest);
+        T* vals = reinterpret_cast<T*>(dest + align8(nstored * sizeof(uint32_t)));
+        size_t k = 0;
+        for (size_t i = 0; i < nrows; i++) {
+            for (size_t j = 0; j < ncols; j++) {
+                if (std::fabs(vp[i][j]) < threshold) continue;
+                idx[k] = static_cast<uint32_t>(i * ncols + j);
+                vals[k] = static_cast<T>(vp[i][j]);
+                k++;
+            }
+        }
+    } else {
+        T* vals = reinterpret_cast<T*>(dest);
+        for (size_t i = 0; i < nrows; i++) {
+            for (size_t j = 0; j < ncols; j++) {
+                vals[i * ncols + j] = static_cast<T>(vp[i][j]);
+            }
+        }
+    }
+}
+
+template <typename T>
+void unpack_component(const char* src, size_t nrows, size_t ncols, bool sparse, size_t nstored, double** vp) {
+    if (sparse) {
+        const uint32_t* idx = reinterpret_cast<const uint32_t*>(src);
+        const T* vals = reinterpret_cast<const T*>(src + align8(nstored * sizeof(uint32_t)));
+        for (size_t i = 0; i < nrows; i++) {
+            std::fill_n(vp[i], ncols, 0.0);
+        }
+        for (size_t k = 0; k < nstored; k++) {
+            vp[idx[k] / ncols][idx[k] % ncols] = static_cast<double>(vals[k]);
+        }
+    } else {
+        const T* vals = reinterpret_cast<const T*>(src);
+        for (size_t i = 0; i < nrows; i++) {
+            std::copy_n(vals + i * ncols, ncols, vp[i]);
+        }
+    }
+}
+
+}  // namespace
+
+void CollocationCache::reset(size_t capacity, Precision precision, double cutoff) {
+    clear();
+    precision_ = precision;
+    cutoff_ = cutoff;
+    capacity_ = capacity;
+    if (capacity_) arena_ = std::unique_ptr<char[]>(new char[capacity_]);
+}
+void CollocationCache::clear() {
+    entries_.clear();
+    arena_.reset();
+    capacity_ = 0;
+    used_ = 0;
+}
+bool CollocationCache::reserve(size_t size, size_t& offset) {
+    size_t current = used_.load();
+    do {
+        if (current + size > capacity_) return false;
+    } while (!used_.compare_exchange_weak(current, current + size));
+    offset = current;
+    return true;
+}
+size_t CollocationCache::block_size(size_t nrows, size_t ncols, size_t ncomponents, Precision precision) {
+    size_t value = (precision == Precision::Float ? sizeof(float) : sizeof(double));
+    return ncomponents * align8(nrows * ncols * value);
+}
+bool CollocationCache::store(size_t block, size_t nrows, size_t ncols,
+                             const std::map<std::string, SharedMatrix>& values) {
+    size_t nvalue = nrows * ncols;
+    size_t vsize = value_size();
+    bool can_index = (nvalue <= std::numeric_limits<uint32_t>::max());
+
+    // => Screening and sizes <= //
+
+    Entry entry;
+    entry.nrows = nrows;
+    entry.ncols = ncols;
+    std::vector<double> thresholds;
+    std::vector<size_t> sizes;
+    size_t total = 0;
+    for (const auto& kv : values) {
+        Component comp;
+        comp.name = kv.first;
+        comp.sparse = false;
+        comp.nstored = nvalue;
+
+        double threshold = 0.0;
+        if (cutoff_ > 0.0 && can_index) {
+            double** vp = kv.second->pointer();
+            double vmax = 0.0;
+            for (size_t i = 0; i < nrows; i++) {
+                for (size_t j = 0; j < ncols; j++) vmax = std::max(vmax, std::fabs(vp[i][j]));
+            }
+            // the cutoff is relative to the largest value of this component in this block
+            threshold = cutoff_ * vmax;
+            size_t nkeep = 0;
+            for (size_t i = 0; i < nrows; i++) {
+                for (size_t j = 0; j < ncols; j++) nkeep += (std::fabs(vp[i][j]) >= threshold);
+            }
+            if (nkeep * (sizeof(uint32_t) + vsize) < nvalue * vsize) {
+                comp.sparse = true;
+                comp.nstored = nkeep;
+            }
+        }
+
+        size_t size = (comp.sparse ? align8(comp.nstored * sizeof(uint32_t)) + align8(comp.nstored * vsize)
+                                   : align8(nvalue * vsize));
+        thresholds.push_back(threshold);
+        sizes.push_back(size);
+        total += size;
+        entry.components.push_back(comp);
+    }
+
+    size_t offset;
+    if (!reserve(total, offset)) return false;
+
+    // => Pack <= //
+
+    size_t ind = 0;
+    for (const auto& kv : values) {
+        Component& comp = entry.components[ind];
+        comp.offset = offset;
+        char* dest = arena_.get() + offset;
+        if (precision_ == Precision::Float) {
+            pack_component<float>(kv.second->pointer(), nrows, ncols, thresholds[ind], comp.sparse, comp.nstored, dest);
+        } else {
+            pack_component<double>(kv.second->pointer(), nrows, ncols, thresholds[ind], comp.sparse, comp.nstored,
+                                   dest);
+        }
+        offset += sizes[ind];
+        ind++;
+    }
+
+#pragma omp critical(collocation_cache_entries)
+    entries_[block] = std::move(entry);
+
+    return true;
+}
+bool CollocationCache::load(size_t block, std::map<std::string, SharedMatrix>& values) const {
+    auto it = entries_.find(block);
+    if (it == entries_.end()) return false;
+    const Entry& entry = it->second;
+
+    // Every requested component has to be there, or the caller recomputes them all
+    std::vector<const Component*> components;
+    for (const auto& kv : values) {
+        auto comp = std::find_if(entry.components.begin(), entry.components.end(),
+                                 [&](const Component& c) { return c.name == kv.first; });
+        if (comp == entry.components.end()) return false;
+        components.push_back(&(*comp));
+    }
+
+    size_t ind = 0;
+    for (auto& kv : values) {
+        const Component& comp = *components[ind++];
+        const char* src = arena_.get() + comp.offset;
+        if (precision_ == Precision::Float) {
+            unpack_component<float>(src, entry.nrows, entry.ncols, comp.sparse, comp.nstored, kv.second->pointer());
+        } else {
+            unpack_component<double>(src, entry.nrows, entry.ncols, comp.sparse, comp.nstored, kv.second->pointer());
+        }
+    }
+    return true;
+}
+
+}  // namespace psi
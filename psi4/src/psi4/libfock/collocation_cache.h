@@ -0,0 +1,126 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2026 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#ifndef libfock_collocation_cache_H
+#define libfock_collocation_cache_H
+
+#include "psi4/libmints/typedefs.h"
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace psi {
+
+/**
+ * Class CollocationCache
+ *
+ * Basis function values (PHI, PHI_X, ...) of DFT grid blocks, kept
+ * between SCF iterations so that they are computed only once.
+ *
+ * All blocks share one contiguous arena, sized once by reset(). Each
+ * component of a block is stored in double or float precision. With a
+ * nonzero cutoff, values smaller than cutoff times the largest value of
+ * that component in the block are dropped, and the component is kept as
+ * (index, value) pairs whenever that is smaller than the dense form.
+ *
+ * store() may be called from several threads at once; load() may be
+ * called from several threads once all stores are done.
+ */
+class CollocationCache {
+   public:
+    enum class Precision { Double, Float };
+
+   protected:
+    /// Where one component (PHI, PHI_X, ...) of a block lives in the arena
+    struct Component {
+        std::string name;
+        /// Byte offset into the arena
+        size_t offset;
+        /// Number of stored values
+        size_t nstored;
+        /// Stored as (index, value) pairs?
+        bool sparse;
+    };
+    struct Entry {
+        size_t nrows;
+        size_t ncols;
+        std::vector<Component> components;
+    };
+
+    Precision precision_ = Precision::Double;
+    double cutoff_ = 0.0;
+
+    std::unique_ptr<char[]> arena_;
+    size_t capacity_ = 0;
+    std::atomic<size_t> used_{0};
+    /// Block index -> entry
+    std::unordered_map<size_t, Entry> entries_;
+
+    size_t value_size() const { return (precision_ == Precision::Float ? sizeof(float) : sizeof(double)); }
+    /// Claim size bytes of the arena; false if they do not fit
+    bool reserve(size_t size, size_t& offset);
+
+   public:
+    CollocationCache() = default;
+
+    /// Drop all blocks and allocate an arena of capacity bytes
+    void reset(size_t capacity, Precision precision, double cutoff);
+    /// Drop all blocks and free the arena
+    void clear();
+
+    /**
+     * Store the upper left nrows x ncols corner of every matrix in values
+     * @param block the index of the block
+     * @return false if the block did not fit, in which case nothing is stored
+     */
+    bool store(size_t block, size_t nrows, size_t ncols, const std::map<std::string, SharedMatrix>& values);
+    /**
+     * Unpack a block into the upper left corner of the matching matrices in values
+     * @return false if the block, or one of the components in values, is not cached
+     */
+    bool load(size_t block, std::map<std::string, SharedMatrix>& values) const;
+
+    bool contains(size_t block) const { return entries_.count(block); }
+    size_t nblocks() const { return entries_.size(); }
+    /// Bytes of the arena in use
+    size_t used() const { return used_; }
+    size_t capacity() const { return capacity_; }
+    Precision precision() const { return precision_; }
+
+    /// Upper bound on the bytes a block with ncomponents nrows x ncols components takes
+    static size_t block_size(size_t nrows, size_t ncols, size_t ncomponents, Precision precision);
+};
+
+}  // namespace psi
+
+#endif
@@ -44,7 +44,11 @@
 #include <string>
 #include <sstream>
 #include <cstdio>
+#include <cstdint>
 #include <limits>
+#include <list>
+#include <mutex>
+#include <numeric>
 #include <cctype>
 #include <cassert>
 
@@ -3721,10 +3725,137 @@ int RadialPruneMgr::ShellPruning(int ri, int Z, int radial_pts) {
     return LebedevGridMgr::findNPointsByOrder_roundUp(pruned_order);
 }
 
+// => GridCache <= //
+
+namespace {
+
+/// Guards the GridCache maps
+std::mutex grid_cache_lock;
+/// Standard atomic grids, by atomic_grid_key
+std::map<std::string, std::shared_ptr<const GridCache::AtomicGrid>> grid_cache_atomic;
+/// Molecular entries by molecular_grid_key, most recently used first
+std::list<std::pair<std::string, std::shared_ptr<GridCache::MolecularEntry>>> grid_cache_molecular;
+/// Shell extents by basis set fingerprint and tolerance
+std::map<std::string, std::shared_ptr<Vector>> grid_cache_extents;
+
+/// Molecular entries kept, each one holds a full copy of its grid
+const size_t grid_cache_max_molecular = 4;
+/// The block partition is rebuilt once a point moves by more than this fraction of DFT_BLOCK_MAX_RADIUS
+const double grid_cache_max_shift = 0.1;
+
+/// Everything the standard atomic grid of element Z depends on
+std::string atomic_grid_key(const MolecularGrid::MolecularGridOptions &opt, int Z) {
+    std::ostringstream key;
+    key.precision(17);
+    key << "Z=" << Z << " grid=" << opt.namedGrid << " radial=" << opt.radscheme << "/" << opt.nradpts
+        << " spherical=" << opt.nangpts << " pruning=" << opt.prunescheme << "/" << opt.prunetype << "/"
+        << opt.prunefunction << "/" << opt.pruning_alpha << " bs_alpha=" << opt.bs_radius_alpha;
+    return key.str();
+}
+
+/// Everything the nuclear-weighted grid of molecule depends on, besides its geometry
+std::string molecular_grid_key(const MolecularGrid::MolecularGridOptions &opt, const Molecule &molecule) {
+    std::ostringstream key;
+    key.precision(17);
+    key << atomic_grid_key(opt, 0) << " nuclear=" << opt.nucscheme << " cutoff=" << opt.weights_cutoff << " atoms=";
+    for (int A = 0; A < molecule.natom(); A++) {
+        key << molecule.true_atomic_number(A) << ",";
+    }
+    return key.str();
+}
+
+}  // namespace
+
+std::shared_ptr<const GridCache::AtomicGrid> GridCache::find_atomic_grid(const std::string &key) {
+    std::lock_guard<std::mutex> guard(grid_cache_lock);
+    auto it = grid_cache_atomic.find(key);
+    return (it == grid_cache_atomic.end() ? nullptr : it->second);
+}
+void GridCache::store_atomic_grid(const std::string &key, std::shared_ptr<const AtomicGrid> grid) {
+    std::lock_guard<std::mutex> guard(grid_cache_lock);
+    grid_cache_atomic[key] = grid;
+}
+std::shared_ptr<GridCache::MolecularEntry> GridCache::molecular_entry(const std::string &key) {
+    std::lock_guard<std::mutex> guard(grid_cache_lock);
+    for (auto it = grid_cache_molecular.begin(); it != grid_cache_molecular.end(); ++it) {
+        if (it->first == key) {
+            grid_cache_molecular.splice(grid_cache_molecular.begin(), grid_cache_molecular, it);
+            return grid_cache_molecular.front().second;
+        }
+    }
+    grid_cache_molecular.emplace_front(key, std::make_shared<MolecularEntry>());
+    if (grid_cache_molecular.size() > grid_cache_max_molecular) grid_cache_molecular.pop_back();
+    return grid_cache_molecular.front().second;
+}
+std::shared_ptr<BasisExtents> GridCache::extents(std::shared_ptr<BasisSet> primary, double delta) {
+    std::ostringstream key;
+    key.precision(17);
+    key << primary->fingerprint() << " delta=" << delta;
+
+    {
+        std::lock_guard<std::mutex> guard(grid_cache_lock);
+        auto it = grid_cache_extents.find(key.str());
+        if (it != grid_cache_extents.end()) {
+            // BasisExtents::set_delta overwrites its extents, never hand out the cached copy
+            return std::make_shared<BasisExtents>(primary, delta, std::make_shared<Vector>(*it->second));
+        }
+    }
+
+    auto extents = std::make_shared<BasisExtents>(primary, delta);
+    std::lock_guard<std::mutex> guard(grid_cache_lock);
+    grid_cache_extents[key.str()] = std::make_shared<Vector>(*extents->shell_extents());
+    return extents;
+}
+void GridCache::clear() {
+    std::lock_guard<std::mutex> guard(grid_cache_lock);
+    grid_cache_atomic.clear();
+    grid_cache_molecular.clear();
+    grid_cache_extents.clear();
+}
+
+namespace {
+
+/// Build the standard atomic grid of element Z: radial nodes times pruned Lebedev spheres
+std::shared_ptr<GridCache::AtomicGrid> build_atomic_grid(const MolecularGrid::MolecularGridOptions &opt,
+                                                         RadialPruneMgr &prune, int Z) {
+    auto grid = std::make_shared<GridCache::AtomicGrid>();
+    grid->r.resize(opt.nradpts);
+    grid->wr.resize(opt.nradpts);
+    grid->alpha = GetBSRadius(Z) * opt.bs_radius_alpha;
+    RadialGridMgr::makeRadialGrid(opt.nradpts, RadialGridMgr::MuraKnowlesHack(opt.radscheme, Z), grid->r.data(),
+                                  grid->wr.data(), grid->alpha);
+
+    for (int i = 0; i < opt.nradpts; i++) {
+        int numAngPts = 0;
+        if (opt.prunetype == "REGION") {
+            if (opt.prunescheme == "TREUTLER") {
+                numAngPts = prune.TreutlerShellPruning(i, Z, opt.nradpts);
+            } else if (opt.prunescheme == "ROBUST") {
+                numAngPts = prune.ShellPruning(i, Z, opt.nradpts);
+            }
+        } else if (opt.prunetype == "FUNCTION" || opt.prunescheme == "NONE") {
+            numAngPts = prune.GetPrunedNumAngPts(grid->r[i] / grid->alpha);
+        }
+        assert(numAngPts > 0);
+        grid->nang.push_back(numAngPts);
+
+        const MassPoint *anggrid = LebedevGridMgr::findGridByNPoints(numAngPts);
+        for (int j = 0; j < numAngPts; j++) {
+            grid->points.push_back({grid->r[i] * anggrid[j].x, grid->r[i] * anggrid[j].y, grid->r[i] * anggrid[j].z,
+                                    grid->wr[i] * anggrid[j].w});
+        }
+    }
+    return grid;
+}
+
+}  // namespace
+
 void MolecularGrid::buildGridFromOptions(MolecularGridOptions const &opt) {
     options_ = opt;  // Save a copy
     atomic_grids_.clear();
     atomic_grids_.resize(molecule_->natom());
+    atomic_ids_.clear();
+    atomic_ids_.resize(molecule_->natom());
 
     OrientationMgr std_orientation(molecule_);
     RadialPruneMgr prune(opt);
@@ -3741,19 +3872,58 @@ void MolecularGrid::buildGridFromOptions(MolecularGridOptions const &opt) {
         spherical_grids_.resize(molecule_->natom());
     }
 
+    bool use_cache = opt.cache;
+#ifdef USING_BrianQC
+    // BrianQC is handed the grid while it is built
+    if (brianEnable and brianEnableDFT) use_cache = false;
+#endif
+
+    // The points of this geometry were built before, with identical nuclear weights?
+    cache_entry_ = nullptr;
+    cache_same_geometry_ = false;
+    cache_status_ = "MISS";
+    if (use_cache) {
+        cache_entry_ = GridCache::molecular_entry(molecular_grid_key(opt, *molecule_));
+        const auto &geometry = cache_entry_->geometry;
+        cache_same_geometry_ = (geometry.size() == 3 * (size_t)molecule_->natom());
+        for (int A = 0; A < molecule_->natom() && cache_same_geometry_; A++) {
+            Vector3 xyz = molecule_->xyz(A);
+            for (int k = 0; k < 3; k++) {
+                if (std::fabs(geometry[3 * A + k] - xyz[k]) > 1.0E-12) cache_same_geometry_ = false;
+            }
+        }
+    }
+
 #ifdef USING_BrianQC
     std::vector<std::vector<double>> atomRotations(molecule_->natom());
     std::vector<std::vector<BrianBlock>> atomBlocks(molecule_->natom());
 #endif
 
-    // Check grid per-atom first so throws happen outside threaded block
+    // Check grid per-atom first so throws happen outside threaded block.
+    // Atoms of the same element share their standard atomic grid, along with
+    // every earlier grid built with the same options if the GridCache is on.
+    std::map<int, std::shared_ptr<const GridCache::AtomicGrid>> standard_grids;
+    std::vector<size_t> id_offsets(molecule_->natom() + 1, 0);
     for (int A = 0; A < molecule_->natom(); A++) {
         int Z = molecule_->true_atomic_number(A);
 
+        size_t npts = 0;
         if (opt.namedGrid != -1) {  // Using a named grid
             assert(opt.namedGrid == 0 || opt.namedGrid == 1);
-            int npts = (opt.namedGrid == 0) ? StandardGridMgr::GetSG0size(Z) : StandardGridMgr::GetSG1size(Z);
+            npts = (opt.namedGrid == 0) ? StandardGridMgr::GetSG0size(Z) : StandardGridMgr::GetSG1size(Z);
+        } else {
+            if (!standard_grids.count(Z)) {
+                std::string key = atomic_grid_key(opt, Z);
+                std::shared_ptr<const GridCache::AtomicGrid> grid = (use_cache ? GridCache::find_atomic_grid(key) : nullptr);
+                if (!grid) {
+                    grid = build_atomic_grid(opt, prune, Z);
+                    if (use_cache) GridCache::store_atomic_grid(key, grid);
+                }
+                standard_grids[Z] = grid;
+            }
+            npts = standard_grids[Z]->points.size();
         }
+        id_offsets[A + 1] = id_offsets[A] + npts;
     }
 
 // Iterate over atoms
@@ -3770,10 +3940,9 @@ void MolecularGrid::buildGridFromOptions(MolecularGridOptions const &opt) {
 #endif
 
         if (opt.namedGrid == -1) {  // Not using a named grid
-            std::vector<double> r(opt.nradpts), wr(opt.nradpts);
-            double alpha = GetBSRadius(Z) * opt.bs_radius_alpha;
-            RadialGridMgr::makeRadialGrid(opt.nradpts, RadialGridMgr::MuraKnowlesHack(opt.radscheme, Z), r.data(),
-                                          wr.data(), alpha);
+            const GridCache::AtomicGrid &standard = *standard_grids.at(Z);
+            std::vector<double> r(standard.r), wr(standard.wr);
+            double alpha = standard.alpha;
 
             // RMP: Want this stuff too
             radial_grids_[A] = RadialGrid::build("Unknown", opt.nradpts, r.data(), wr.data(), alpha, Z);
@@ -3781,18 +3950,9 @@ void MolecularGrid::buildGridFromOptions(MolecularGridOptions const &opt) {
             spherical_grids_[A] = spheres;
 
             int currentBlockIndex = -1;
+            size_t k = 0;
             for (int i = 0; i < opt.nradpts; i++) {
-                int numAngPts = 0;
-                if (opt.prunetype == "REGION") {
-                    if (opt.prunescheme == "TREUTLER") {
-                        numAngPts = prune.TreutlerShellPruning(i, Z, opt.nradpts);
-                    } else if (opt.prunescheme == "ROBUST") {
-                        numAngPts = prune.ShellPruning(i, Z, opt.nradpts);
-                    }
-                } else if (opt.prunetype == "FUNCTION" || opt.prunescheme == "NONE") {
-                    numAngPts = prune.GetPrunedNumAngPts(r[i] / alpha);
-                }
-                assert(numAngPts > 0);
+                int numAngPts = standard.nang[i];
                 const MassPoint *anggrid = LebedevGridMgr::findGridByNPoints(numAngPts);
 
 #ifdef USING_BrianQC
@@ -3814,14 +3974,17 @@ void MolecularGrid::buildGridFromOptions(MolecularGridOptions const &opt) {
 
                 // RMP: And this stuff! This whole thing is completely and utterly FUBAR.
                 spherical_grids_[A].push_back(SphericalGrid::build("Unknown", numAngPts, anggrid));
-                for (int j = 0; j < numAngPts; j++) {
-                    MassPoint mp = {r[i] * anggrid[j].x, r[i] * anggrid[j].y, r[i] * anggrid[j].z,
-                                    wr[i] * anggrid[j].w};
-                    mp = std_orientation.MoveIntoPosition(mp, A);
+
+                // Same geometry as the cached grid, its weighted points are copied below
+                if (cache_same_geometry_) continue;
+
+                for (int j = 0; j < numAngPts; j++, k++) {
+                    MassPoint mp = std_orientation.MoveIntoPosition(standard.points[k], A);
                     mp.w *= nuc.computeNuclearWeight(mp, A, stratmannCutoff);
 
                     if (std::abs(mp.w) > weightcut) {
                         atomic_grids_[A].push_back(mp);
+                        atomic_ids_[A].push_back(id_offsets[A] + k);
                     }
                     assert(!std::isnan(mp.w));
                 }
@@ -3833,6 +3996,8 @@ void MolecularGrid::buildGridFromOptions(MolecularGridOptions const &opt) {
                 atomBlocks[A] = brianStandardGrids.at(opt.namedGrid).at(Z);
             }
 #endif
+            if (cache_same_geometry_) continue;
+
             int npts = (opt.namedGrid == 0) ? StandardGridMgr::GetSG0size(Z) : StandardGridMgr::GetSG1size(Z);
             const MassPoint *sg =
                 (opt.namedGrid == 0) ? StandardGridMgr::GetSG0grid(Z) : StandardGridMgr::GetSG1grid(Z);
@@ -3842,12 +4007,31 @@ void MolecularGrid::buildGridFromOptions(MolecularGridOptions const &opt) {
                 mp.w *= nuc.computeNuclearWeight(mp, A, stratmannCutoff);
                 if (std::abs(mp.w) > weightcut) {
                     atomic_grids_[A].push_back(mp);
+                    atomic_ids_[A].push_back(id_offsets[A] + i);
                 }
                 assert(!std::isnan(mp.w));
             }
         }
     }
 
+    if (cache_entry_) {
+        if (cache_same_geometry_) {
+            cache_status_ = "POINTS";
+            atomic_grids_ = cache_entry_->atomic_grids;
+            atomic_ids_ = cache_entry_->atomic_ids;
+        } else {
+            cache_entry_->geometry.resize(3 * molecule_->natom());
+            for (int A = 0; A < molecule_->natom(); A++) {
+                Vector3 xyz = molecule_->xyz(A);
+                for (int k = 0; k < 3; k++) cache_entry_->geometry[3 * A + k] = xyz[k];
+            }
+            cache_entry_->atomic_grids = atomic_grids_;
+            cache_entry_->atomic_ids = atomic_ids_;
+            // The shells of the cached blocks belong to the old geometry
+            cache_entry_->shell_key.clear();
+        }
+    }
+
 #ifdef USING_BrianQC
     // TODO: do the same for the other version of buildGridFromOptions below
     if (brianEnable and brianEnableDFT) {
@@ -3916,13 +4100,16 @@ void MolecularGrid::buildGridFromOptions(MolecularGridOptions const &opt) {
     z_ = new double[npoints_];
     w_ = new double[npoints_];
 
+    point_ids_.resize(npoints_);
+
     int grid_vector_index = 0;
-    for (const auto &grid_per_atom : atomic_grids_) {  // loop over all atoms
-        for (const auto &Q : grid_per_atom) {          // grid points of a given atom
-            x_[grid_vector_index] = Q.x;
-            y_[grid_vector_index] = Q.y;
-            z_[grid_vector_index] = Q.z;
-            w_[grid_vector_index] = Q.w;
+    for (size_t A = 0; A < atomic_grids_.size(); A++) {  // loop over all atoms
+        for (size_t Q = 0; Q < atomic_grids_[A].size(); Q++) {  // grid points of a given atom
+            x_[grid_vector_index] = atomic_grids_[A][Q].x;
+            y_[grid_vector_index] = atomic_grids_[A][Q].y;
+            z_[grid_vector_index] = atomic_grids_[A][Q].z;
+            w_[grid_vector_index] = atomic_grids_[A][Q].w;
+            point_ids_[grid_vector_index] = atomic_ids_[A][Q];
             ++grid_vector_index;
         }
     }
@@ -3940,6 +4127,17 @@ BasisExtents::BasisExtents(std::shared_ptr<BasisSet> primary, double delta) : pr
     shell_extents_ = std::make_shared<Vector>("Shell Extents", primary_->nshell());
     computeExtents();
 }
+BasisExtents::BasisExtents(std::shared_ptr<BasisSet> primary, double delta, std::shared_ptr<Vector> shell_extents)
+    : primary_(primary), delta_(delta), shell_extents_(shell_extents) {
+    if (shell_extents_->dimpi().sum() != primary_->nshell()) {
+        throw PSIEXCEPTION("BasisExtents: Shell extents do not match the basis set.");
+    }
+    double *Rp = shell_extents_->pointer();
+    maxR_ = 0.0;
+    for (int P = 0; P < primary_->nshell(); P++) {
+        if (maxR_ < Rp[P]) maxR_ = Rp[P];
+    }
+}
 BasisExtents::~BasisExtents() {}
 void BasisExtents::computeExtents() {
     // Here we assume the absolute spherical basis functions
@@ -4089,6 +4287,23 @@ BlockOPoints::BlockOPoints(size_t index, size_t npoints, double *x, double *y, d
     bound();
     populate();
 }
+BlockOPoints::BlockOPoints(size_t index, size_t npoints, double *x, double *y, double *z, double *w,
+                           std::shared_ptr<BasisExtents> extents, const std::vector<int> &shells)
+    : index_(index), npoints_(npoints), x_(x), y_(y), z_(z), w_(w), extents_(extents) {
+    bound();
+
+    std::shared_ptr<BasisSet> primary = extents_->basis();
+    shells_local_to_global_ = shells;
+    functions_local_to_global_.clear();
+    for (int P : shells_local_to_global_) {
+        int nP = primary->shell(P).nfunction();
+        int pstart = primary->shell(P).function_index();
+        for (int oP = 0; oP < nP; oP++) {
+            functions_local_to_global_.push_back(oP + pstart);
+        }
+    }
+    local_nbf_ = functions_local_to_global_.size();
+}
 BlockOPoints::~BlockOPoints() {}
 void BlockOPoints::bound() {
     // Initially: mean center and max spread of point cloud
@@ -4263,6 +4478,7 @@ void DFTGrid::buildGridFromOptions(std::map<std::string, int> int_opts_map,
     opt.weights_cutoff = full_float_options["DFT_WEIGHTS_TOLERANCE"];
     opt.blockscheme = full_str_options["DFT_BLOCK_SCHEME"];
     opt.remove_distant_points = options_.get_bool("DFT_REMOVE_DISTANT_POINTS");
+    opt.cache = options_.get_bool("DFT_GRID_CACHE");
 
     // printing and debug options
     opt.print = full_int_options["PRINT"];
@@ -4304,7 +4520,7 @@ void DFTGrid::buildGridFromOptions(std::map<std::string, int> int_opts_map,
     int min_points = full_int_options["DFT_BLOCK_MIN_POINTS"];
     double max_radius = full_float_options["DFT_BLOCK_MAX_RADIUS"];
     double epsilon = full_float_options["DFT_BASIS_TOLERANCE"];
-    auto extents = std::make_shared<BasisExtents>(primary_, epsilon);
+    auto extents = (opt.cache ? GridCache::extents(primary_, epsilon) : std::make_shared<BasisExtents>(primary_, epsilon));
     timer_on("build grid");
     MolecularGrid::buildGridFromOptions(opt);
     timer_off("build grid");
@@ -4350,7 +4566,13 @@ void PseudospectralGrid::buildGridFromOptions() {
 }
 
 MolecularGrid::MolecularGrid(std::shared_ptr<Molecule> molecule)
-    : debug_(0), molecule_(molecule), npoints_(0), max_points_(0), max_functions_(0) {}
+    : debug_(0),
+      molecule_(molecule),
+      npoints_(0),
+      max_points_(0),
+      max_functions_(0),
+      cache_same_geometry_(false),
+      cache_status_("MISS") {}
 MolecularGrid::~MolecularGrid() {
     if (npoints_) {
         delete[] x_;
@@ -4361,6 +4583,16 @@ MolecularGrid::~MolecularGrid() {
 }
 
 void MolecularGrid::block(int max_points, int min_points, double max_radius) {
+    // The atomic blocks are tied to atomic_grids_, always block them anew
+    std::string partition_key;
+    if (cache_entry_ && options_.blockscheme != "ATOMIC") {
+        std::ostringstream key;
+        key.precision(17);
+        key << options_.blockscheme << " " << max_points << " " << min_points << " " << max_radius;
+        partition_key = key.str();
+        if (reuse_partition(partition_key, max_radius)) return;
+    }
+
     std::shared_ptr<GridBlocker> blocker;
     if (options_.blockscheme == "NAIVE") {
         blocker = std::make_shared<NaiveGridBlocker>(npoints_, x_, y_, z_, w_, max_points, min_points, max_radius, extents_);
@@ -4395,6 +4627,136 @@ void MolecularGrid::block(int max_points, int min_points, double max_radius) {
     if (options_.blockscheme == "ATOMIC") {
         atomic_blocks_ = blocker->atomic_blocks();
     }
+
+    // Store the partition for the next grid on these atoms
+    if (!partition_key.empty() && blocker->ref_index().size() == (size_t)npoints_) {
+        const std::vector<int> &ref_index = blocker->ref_index();
+        const std::vector<size_t> &starts = blocker->block_starts();
+        GridCache::MolecularEntry &entry = *cache_entry_;
+        entry.partition_key = partition_key;
+        entry.block_index = blocker->block_indices();
+        entry.block_ids.assign(entry.block_index.size(), std::vector<size_t>());
+        entry.block_xyz.assign(entry.block_index.size(), std::vector<Vector3>());
+        entry.block_shells.assign(entry.block_index.size(), std::vector<int>());
+        for (size_t B = 0; B < entry.block_index.size(); B++) {
+            for (size_t Q = starts[B]; Q < starts[B + 1]; Q++) {
+                entry.block_ids[B].push_back(point_ids_[ref_index[Q]]);
+                entry.block_xyz[B].push_back(Vector3(x_[Q], y_[Q], z_[Q]));
+            }
+        }
+        std::map<size_t, size_t> block_of_index;
+        for (size_t B = 0; B < entry.block_index.size(); B++) block_of_index[entry.block_index[B]] = B;
+        for (const auto &block : blocks_) {
+            entry.block_shells[block_of_index.at(block->index())] = block->shells_local_to_global();
+        }
+        std::ostringstream shell_key;
+        shell_key.precision(17);
+        shell_key << primary_->fingerprint(true) << " delta=" << extents_->delta();
+        entry.shell_key = shell_key.str();
+    }
+}
+
+bool MolecularGrid::reuse_partition(const std::string &partition_key, double max_radius) {
+    GridCache::MolecularEntry &entry = *cache_entry_;
+    if (entry.partition_key != partition_key) return false;
+
+    // Every point must belong to a cached block, close to where it was when the partition was built
+    std::map<size_t, size_t> position;
+    for (size_t Q = 0; Q < (size_t)npoints_; Q++) position[point_ids_[Q]] = Q;
+
+    std::vector<std::vector<size_t>> block_points(entry.block_ids.size());
+    size_t covered = 0;
+    double max_shift2 = grid_cache_max_shift * max_radius * grid_cache_max_shift * max_radius;
+    for (size_t B = 0; B < entry.block_ids.size(); B++) {
+        for (size_t i = 0; i < entry.block_ids[B].size(); i++) {
+            auto it = position.find(entry.block_ids[B][i]);
+            if (it == position.end()) continue;
+            size_t Q = it->second;
+            const Vector3 &v = entry.block_xyz[B][i];
+            double R2 = (x_[Q] - v[0]) * (x_[Q] - v[0]) + (y_[Q] - v[1]) * (y_[Q] - v[1]) +
+                        (z_[Q] - v[2]) * (z_[Q] - v[2]);
+            if (R2 > max_shift2) return false;
+            block_points[B].push_back(Q);
+            covered++;
+        }
+    }
+    if (covered != (size_t)npoints_) return false;
+
+    std::ostringstream key;
+    key.precision(17);
+    key << primary_->fingerprint(true) << " delta=" << extents_->delta();
+    bool same_shells = (cache_same_geometry_ && entry.shell_key == key.str());
+
+    // => Reorder the points block by block <= //
+
+    double *x = new double[npoints_];
+    double *y = new double[npoints_];
+    double *z = new double[npoints_];
+    double *w = new double[npoints_];
+    std::vector<size_t> point_ids(npoints_);
+    std::vector<size_t> starts;
+    size_t index = 0;
+    for (size_t B = 0; B < block_points.size(); B++) {
+        starts.push_back(index);
+        for (size_t Q : block_points[B]) {
+            x[index] = x_[Q];
+            y[index] = y_[Q];
+            z[index] = z_[Q];
+            w[index] = w_[Q];
+            point_ids[index] = point_ids_[Q];
+            index++;
+        }
+    }
+
+    delete[] x_;
+    delete[] y_;
+    delete[] z_;
+    delete[] w_;
+    x_ = x;
+    y_ = y;
+    z_ = z;
+    w_ = w;
+    point_ids_ = point_ids;
+
+    // => Blocks <= //
+
+    blocks_.clear();
+    max_points_ = 0;
+    for (size_t B = 0; B < block_points.size(); B++) {
+        size_t npoints = block_points[B].size();
+        if (!npoints) {
+            entry.block_shells[B].clear();
+            continue;
+        }
+        size_t offset = starts[B];
+        std::shared_ptr<BlockOPoints> bop;
+        if (same_shells) {
+            bop = std::make_shared<BlockOPoints>(entry.block_index[B], npoints, &x_[offset], &y_[offset],
+                                                 &z_[offset], &w_[offset], extents_, entry.block_shells[B]);
+        } else {
+            bop = std::make_shared<BlockOPoints>(entry.block_index[B], npoints, &x_[offset], &y_[offset],
+                                                 &z_[offset], &w_[offset], extents_);
+            entry.block_shells[B] = bop->shells_local_to_global();
+        }
+        // prevent blocks without bf that will crash collocation caching
+        if (bop->local_nbf()) {
+            blocks_.push_back(bop);
+            if ((size_t)max_points_ < npoints) max_points_ = npoints;
+        }
+    }
+    entry.shell_key = key.str();
+
+    max_functions_ = 0;
+    collocation_size_ = 0;
+    for (size_t A = 0; A < blocks_.size(); A++) {
+        collocation_size_ += blocks_[A]->local_nbf() * blocks_[A]->npoints();
+        if ((size_t)max_functions_ < blocks_[A]->local_nbf()) {
+            max_functions_ = blocks_[A]->local_nbf();
+        }
+    }
+
+    cache_status_ = (same_shells ? "FULL" : "BLOCKS");
+    return true;
 }
 
 void MolecularGrid::remove_distant_points(double Rmax) {
@@ -4404,6 +4766,7 @@ void MolecularGrid::remove_distant_points(double Rmax) {
     int offset = 0;
     int point_index = 0;
     std::vector<std::vector<MassPoint>> temp_grids(molecule_->natom());
+    std::vector<std::vector<size_t>> temp_ids(molecule_->natom());
     for (int atom = 0; atom < atomic_grids_.size(); ++atom) {
         for (int Q = 0; Q < atomic_grids_[atom].size(); ++Q) {
             auto P = atomic_grids_[atom][Q];
@@ -4421,10 +4784,12 @@ void MolecularGrid::remove_distant_points(double Rmax) {
                 npoints2--;
             } else {
                 temp_grids[atom].push_back(P);
+                temp_ids[atom].push_back(atomic_ids_[atom][Q]);
                 x_[offset] = x_[point_index];
                 y_[offset] = y_[point_index];
                 z_[offset] = z_[point_index];
                 w_[offset] = w_[point_index];
+                point_ids_[offset] = point_ids_[point_index];
                 offset++;
             }
             ++point_index;
@@ -4432,6 +4797,8 @@ void MolecularGrid::remove_distant_points(double Rmax) {
     }
     npoints_ = npoints2;
     atomic_grids_ = temp_grids;
+    atomic_ids_ = temp_ids;
+    point_ids_.resize(npoints_);
     // free up allocated storage capacity.
     for (size_t i = 0; i < atomic_grids_.size(); i++){
         atomic_grids_[i].shrink_to_fit();
@@ -4471,6 +4838,9 @@ void MolecularGrid::print(std::string out, int /*print*/) const {
     printer->Printf("    Max Points             = %14d\n", max_points_);
     printer->Printf("    Max Functions          = %14d\n", max_functions_);
     printer->Printf("    Weights Tolerance      = %14.2E\n", options_.weights_cutoff);
+    if (options_.cache) {
+        printer->Printf("    Grid Cache             = %14s\n", cache_status_.c_str());
+    }
     // printer->Printf("    Collocation Size [MiB] = %14d\n", (int)((8.0 * collocation_size_) / (1024.0 * 1024.0)));
     printer->Printf("\n");
     Process::environment.globals["XC GRID TOTAL POINTS"] = npoints_;
@@ -4595,15 +4965,23 @@ void NaiveGridBlocker::block() {
     ::memcpy((void *)z_, (void *)z_ref_, sizeof(double) * npoints_);
     ::memcpy((void *)w_, (void *)w_ref_, sizeof(double) * npoints_);
 
+    ref_index_.resize(npoints_);
+    std::iota(ref_index_.begin(), ref_index_.end(), 0);
+    block_starts_.clear();
+    block_indices_.clear();
+
     blocks_.clear();
     for (size_t Q = 0; Q < npoints_; Q += max_points_) {
         size_t n = (Q + max_points_ >= npoints_ ? npoints_ - Q : max_points_);
+        block_starts_.push_back(Q);
+        block_indices_.push_back(Q);
         auto bop = std::make_shared<BlockOPoints>(Q, n, &x_[Q], &y_[Q], &z_[Q], &w_[Q], extents_);
         // prevent blocks without bf that will crash collocation caching
         if (bop->local_nbf()) {
             blocks_.push_back(bop);
         }
     }
+    block_starts_.push_back(npoints_);
 
     max_functions_ = 0;
     collocation_size_ = 0;
@@ -4790,10 +5168,12 @@ void OctreeGridBlocker::block() {
         printer = std::make_shared<PsiOutStream>("finished_blocks.dat", mode);
         // outfile->Printf(fh_blocks, "#  %4s %15s %15s %15s %15s\n", "ID", "X", "Y", "Z", "W");
     }
+    ref_index_.resize(npoints_);
     for (size_t A = 0; A < completed_tree.size(); A++) {
         std::vector<int> block = completed_tree[A];
         for (size_t Q = 0; Q < block.size(); Q++) {
             int delta = block[Q];
+            ref_index_[index] = delta;
             x_[index] = x[delta];
             y_[index] = y[delta];
             z_[index] = z[delta];
@@ -4807,11 +5187,15 @@ void OctreeGridBlocker::block() {
     }
 
     blocks_.clear();
+    block_starts_.clear();
+    block_indices_.clear();
     index = 0;
     max_points_ = 0;
     for (size_t A = 0; A < completed_tree.size(); A++) {
         std::vector<int> block = completed_tree[A];
         if (!block.size()) continue;
+        block_starts_.push_back(index);
+        block_indices_.push_back(A);
         auto bop =
             std::make_shared<BlockOPoints>(A, block.size(), &x_[index], &y_[index], &z_[index], &w_[index], extents_);
         // BlockOPoints construction performs additional pruning. Need to test if any points remain.
@@ -4823,6 +5207,7 @@ void OctreeGridBlocker::block() {
         }
         index += block.size();
     }
+    block_starts_.push_back(index);
 
     max_functions_ = 0;
     collocation_size_ = 0;
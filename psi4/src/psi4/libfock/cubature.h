@@ -37,6 +37,7 @@
 #include "psi4/libpsi4util/exception.h"
 
 #include <map>
+#include <string>
 #include <vector>
 
 namespace psi {
@@ -61,6 +62,83 @@ struct MassPoint {
     double x, y, z, w;
 };
 
+/**
+ * Class GridCache
+ *
+ * Process-wide store of the DFT grid data that a new DFTGrid on the same
+ * atoms does not have to rebuild, as happens at every geometry optimization
+ * step, findif displacement, SAPT monomer and SCF restart. It is used by
+ * MolecularGrid when MolecularGridOptions::cache is set (DFT_GRID_CACHE).
+ *
+ *  - Atomic grids in the standard atomic frame (radial nodes and pruned
+ *    spherical grids), per element and grid options.
+ *  - Shell extents, per basis set and basis function tolerance. They do not
+ *    depend on the geometry.
+ *  - Per set of atoms and grid options, the last nuclear-weighted grid and the
+ *    block partition of its points. The weighted points are reused for an
+ *    identical geometry only. The partition is reused as long as no point has
+ *    moved by more than a small fraction of the block radius since it was
+ *    built. The block-to-shell maps are reused if the geometry and the basis
+ *    are unchanged, and rebuilt otherwise.
+ *
+ * None of this changes the quadrature: the points and weights are always
+ * those of a fresh build, only their grouping into blocks may differ.
+ */
+class PSI_API GridCache {
+   public:
+    /// An atomic grid in the standard atomic frame, before orientation and nuclear weights
+    struct AtomicGrid {
+        /// Radial scale
+        double alpha;
+        /// Radial nodes
+        std::vector<double> r;
+        /// Radial weights
+        std::vector<double> wr;
+        /// Number of spherical points on each radial node
+        std::vector<int> nang;
+        /// Points, radial node by radial node
+        std::vector<MassPoint> points;
+    };
+
+    /// The grid last built on a set of atoms, see MolecularGrid
+    struct MolecularEntry {
+        /// Cartesian coordinates of the atoms, 3 * natom
+        std::vector<double> geometry;
+        /// Nuclear-weighted points per atom, before distant points are removed
+        std::vector<std::vector<MassPoint>> atomic_grids;
+        /// Point ids of atomic_grids
+        std::vector<std::vector<size_t>> atomic_ids;
+
+        // => Block partition <= //
+
+        /// Blocking scheme and tolerances the partition was built with, empty if none
+        std::string partition_key;
+        /// Index of each block
+        std::vector<size_t> block_index;
+        /// Point ids of each block
+        std::vector<std::vector<size_t>> block_ids;
+        /// Position of each point of each block when the partition was built
+        std::vector<std::vector<Vector3>> block_xyz;
+        /// Significant shells of each block at geometry, empty if the block had none
+        std::vector<std::vector<int>> block_shells;
+        /// Basis set and tolerance block_shells were found with, empty if unknown
+        std::string shell_key;
+    };
+
+    /// Cached standard atomic grid for key, nullptr if none
+    static std::shared_ptr<const AtomicGrid> find_atomic_grid(const std::string& key);
+    static void store_atomic_grid(const std::string& key, std::shared_ptr<const AtomicGrid> grid);
+
+    /// Entry for a set of atoms and grid options, created empty if there is none yet
+    static std::shared_ptr<MolecularEntry> molecular_entry(const std::string& key);
+
+    /// Basis extents of primary, reusing the shell extents of a basis set with the same shells
+    static std::shared_ptr<BasisExtents> extents(std::shared_ptr<BasisSet> primary, double delta);
+
+    /// Drop everything
+    static void clear();
+};
+
 class MolecularGrid {
    protected:
     int debug_;
@@ -97,6 +175,17 @@ class MolecularGrid {
     std::vector<std::vector<std::shared_ptr<SphericalGrid>>> spherical_grids_;
     /// Grid points, per atom. Available for any grid blocking scheme unlike atomic_blocks_.
     std::vector<std::vector<MassPoint>> atomic_grids_;
+    /// Index of each point of atomic_grids_ in the standard atomic grid of its atom
+    std::vector<std::vector<size_t>> atomic_ids_;
+    /// Unique id of each point in x_, stable between grids on the same atoms
+    std::vector<size_t> point_ids_;
+
+    /// GridCache entry for these atoms and options, nullptr if the cache is off
+    std::shared_ptr<GridCache::MolecularEntry> cache_entry_;
+    /// Is the geometry the one cache_entry_ was last built on?
+    bool cache_same_geometry_;
+    /// What the GridCache provided (MISS, POINTS, BLOCKS or FULL), for printing
+    std::string cache_status_;
 
     /// Vector of blocks
     std::vector<std::shared_ptr<BlockOPoints>> blocks_;
@@ -112,6 +201,8 @@ class MolecularGrid {
     void postProcess(std::shared_ptr<BasisExtents> extents, int max_points, int min_points, double max_radius);
     void remove_distant_points(double Rcut);
     void block(int max_points, int min_points, double max_radius);
+    /// Block with the partition in cache_entry_, if it is still compact. False if it cannot be used.
+    bool reuse_partition(const std::string& partition_key, double max_radius);
 
    public:
     struct MolecularGridOptions {
@@ -131,6 +222,7 @@ class MolecularGrid {
         std::string prunescheme;
         std::string prunetype;
         std::string blockscheme;
+        bool cache = false;  // Use the GridCache
     };
 
    protected:
@@ -405,6 +497,9 @@ class BlockOPoints {
     BlockOPoints(SharedVector x, SharedVector y, SharedVector z, SharedVector w, std::shared_ptr<BasisExtents> extents);
     BlockOPoints(size_t index, size_t npoints, double* x, double* y, double* z, double* w,
                  std::shared_ptr<BasisExtents> extents);
+    /// Use known significant shells instead of searching the extents for them
+    BlockOPoints(size_t index, size_t npoints, double* x, double* y, double* z, double* w,
+                 std::shared_ptr<BasisExtents> extents, const std::vector<int>& shells);
     virtual ~BlockOPoints();
 
     /// Refresh populations (if extents_->delta() changes)
@@ -439,6 +534,8 @@ class BlockOPoints {
     double* w() const { return w_; }
     /// The center of the block
     Vector3 center() const { return xc_; }
+    /// The radius of the sphere around center() that holds all points
+    double radius() const { return R_; }
 
     /// Relevant shells, local -> global
     const std::vector<int>& shells_local_to_global() const { return shells_local_to_global_; }
@@ -462,6 +559,8 @@ class BasisExtents {
 
    public:
     BasisExtents(std::shared_ptr<BasisSet> primary, double delta);
+    /// Use known shell extents of a basis set with the same shells
+    BasisExtents(std::shared_ptr<BasisSet> primary, double delta, std::shared_ptr<Vector> shell_extents);
     virtual ~BasisExtents();
 
     /// Print a trace of these extents
@@ -177,8 +177,8 @@ inline void rks_integrator(std::shared_ptr<BlockOPoints> block, std::shared_ptr<
     }
 
     // ==> Contract T aginst φ, replacing a point index with  an AO index <==
-    C_DGEMM('T', 'N', nlocal, nlocal, npoints, 1.0, phi[0], coll_funcs, Tp[0], max_functions, 0.0, V2p[0],
-            max_functions);
+    pworker->block_gemm('T', 'N', nlocal, nlocal, npoints, 1.0, phi[0], coll_funcs, Tp[0], max_functions, 0.0, V2p[0],
+                        max_functions);
 
     // ==> Add the adjoint to complete the LDA and GGA contributions  <==
     for (int m = 0; m < nlocal; m++) {
@@ -206,8 +206,8 @@ inline void rks_integrator(std::shared_ptr<BlockOPoints> block, std::shared_ptr<
                 std::fill(Tp[P], Tp[P] + nlocal, 0.0);
                 C_DAXPY(nlocal, v_tau_a[P] * w[P], phiw[P], 1, Tp[P], 1);
             }
-            C_DGEMM('T', 'N', nlocal, nlocal, npoints, 1.0, phiw[0], coll_funcs, Tp[0], max_functions, 1.0, V2p[0],
-                    max_functions);
+            pworker->block_gemm('T', 'N', nlocal, nlocal, npoints, 1.0, phiw[0], coll_funcs, Tp[0], max_functions,
+                                1.0, V2p[0], max_functions);
         }
         // parallel_timer_off("Meta", rank);
     }
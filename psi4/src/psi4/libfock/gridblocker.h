@@ -73,6 +73,14 @@ class GridBlocker {
     double* w_;
     std::vector<std::shared_ptr<BlockOPoints>> blocks_;
 
+    // Partition of the new layout, including blocks without significant functions (for the GridCache)
+    /// Index into the reference layout of each point
+    std::vector<int> ref_index_;
+    /// First point of each block, plus the end of the last one
+    std::vector<size_t> block_starts_;
+    /// BlockOPoints index of each block
+    std::vector<size_t> block_indices_;
+
    public:
     GridBlocker(const int npoints_ref, double const* x_ref, double const* y_ref, double const* z_ref,
                 double const* w_ref, const int max_points, const int min_points, const double max_radius,
@@ -90,6 +98,10 @@ class GridBlocker {
     double* z() const { return z_; }
     double* w() const { return w_; }
     const std::vector<std::shared_ptr<BlockOPoints>>& blocks() const { return blocks_; }
+    /// Empty if the blocker does not record its partition
+    const std::vector<int>& ref_index() const { return ref_index_; }
+    const std::vector<size_t>& block_starts() const { return block_starts_; }
+    const std::vector<size_t>& block_indices() const { return block_indices_; }
     virtual const std::vector<std::vector<std::shared_ptr<BlockOPoints>>>& atomic_blocks() {
         throw PSIEXCEPTION("GridBlocker: Atomic blocks not implemented in parent class.");
     }
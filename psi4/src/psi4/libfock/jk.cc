@@ -38,6 +38,7 @@
 #include "psi4/libiwl/iwl.hpp"
 #include "psi4/libmints/matrix.h"
 #include "psi4/libmints/basisset.h"
+#include "psi4/libmints/vector.h"
 #include "psi4/lib3index/cholesky.h"
 #include "psi4/lib3index/dfhelper.h"
 #include "psi4/libmints/petitelist.h"
@@ -45,6 +46,8 @@
 #include "psi4/libpsi4util/PsiOutStream.h"
 #include "psi4/libpsi4util/process.h"
 
+#include <algorithm>
+#include <cmath>
 #include <sstream>
 #include <vector>
 #ifdef _OPENMP
@@ -696,6 +699,142 @@ void JK::zero() {
     }
 }
 
+DFIncFock::DFIncFock(std::shared_ptr<BasisSet> primary, Options& options)
+    : primary_(primary), count_(0), incremental_(false), incremental_K_(false), num_J_builds_(0), num_K_builds_(0) {
+    reset_ = options.get_int("INCFOCK_FULL_FOCK_EVERY");
+    if (reset_ <= 0) {
+        throw PSIEXCEPTION("Invalid input for option INCFOCK_FULL_FOCK_EVERY (<= 0)");
+    }
+    convergence_ = options.get_double("INCFOCK_CONVERGENCE");
+    cutoff_ = options.get_double("INCFOCK_DF_CUTOFF");
+}
+void DFIncFock::factor(SharedMatrix dD, SharedMatrix& Cp, SharedMatrix& Cn) const {
+    int nbf = dD->rowspi()[0];
+    double** dDp = dD->pointer();
+
+    // => Shell-pair screening <= //
+
+    for (int P = 0; P < primary_->nshell(); P++) {
+        int P0 = primary_->shell_to_basis_function(P);
+        int nP = primary_->shell(P).nfunction();
+        for (int Q = 0; Q <= P; Q++) {
+            int Q0 = primary_->shell_to_basis_function(Q);
+            int nQ = primary_->shell(Q).nfunction();
+            double dDmax = 0.0;
+            for (int p = P0; p < P0 + nP; p++) {
+                for (int q = Q0; q < Q0 + nQ; q++) {
+                    dDmax = std::max(dDmax, std::max(std::fabs(dDp[p][q]), std::fabs(dDp[q][p])));
+                }
+            }
+            if (dDmax >= cutoff_) continue;
+            for (int p = P0; p < P0 + nP; p++) {
+                for (int q = Q0; q < Q0 + nQ; q++) {
+                    dDp[p][q] = 0.0;
+                    dDp[q][p] = 0.0;
+                }
+            }
+        }
+    }
+
+    // => Low-rank factorization <= //
+
+    auto U = std::make_shared<Matrix>("dD Eigenvectors", nbf, nbf);
+    auto e = std::make_shared<Vector>("dD Eigenvalues", nbf);
+    auto dDcopy = dD->clone();
+    dDcopy->diagonalize(U, e, descending);
+    double** Up = U->pointer();
+    double* ep = e->pointer();
+
+    // Drop the smallest eigenpairs of either sign while their summed magnitude,
+    // which bounds the trace norm of the error in dD, stays below the cutoff
+    std::vector<int> order(nbf);
+    for (int i = 0; i < nbf; i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](int a, int b) { return std::fabs(ep[a]) < std::fabs(ep[b]); });
+    double dropped = 0.0;
+    int first = 0;
+    while (first < nbf && dropped + std::fabs(ep[order[first]]) < cutoff_) dropped += std::fabs(ep[order[first++]]);
+
+    std::vector<int> pos, neg;
+    for (int i = first; i < nbf; i++) (ep[order[i]] > 0.0 ? pos : neg).push_back(order[i]);
+
+    // Keep a zero column on an empty side, so both factors can be contracted as usual
+    Cp = std::make_shared<Matrix>("dC Positive", nbf, std::max<int>(pos.size(), 1));
+    Cn = std::make_shared<Matrix>("dC Negative", nbf, std::max<int>(neg.size(), 1));
+    double** Cpp = Cp->pointer();
+    double** Cnp = Cn->pointer();
+    for (size_t i = 0; i < pos.size(); i++) {
+        double scale = std::sqrt(ep[pos[i]]);
+        for (int m = 0; m < nbf; m++) Cpp[m][i] = scale * Up[m][pos[i]];
+    }
+    for (size_t i = 0; i < neg.size(); i++) {
+        double scale = std::sqrt(-ep[neg[i]]);
+        for (int m = 0; m < nbf; m++) Cnp[m][i] = scale * Up[m][neg[i]];
+    }
+}
+bool DFIncFock::setup(const std::vector<SharedMatrix>& D, bool eligible, size_t nocc) {
+    size_t njk = D.size();
+    double Dnorm = Process::environment.globals["SCF D NORM"];
+
+    dD_.clear();
+    C_pos_.clear();
+    C_neg_.clear();
+    incremental_K_ = false;
+
+    bool have_prev = D_prev_.size() == njk;
+    incremental_ = eligible && have_prev && (Dnorm >= convergence_) && (count_ % reset_ != reset_ - 1);
+    if (eligible && have_prev && (Dnorm >= convergence_)) count_ += 1;
+    if (!incremental_) return false;
+
+    size_t ncol = 0;
+    for (size_t jki = 0; jki < njk; jki++) {
+        dD_.push_back(D[jki]->clone());
+        dD_[jki]->subtract(D_prev_[jki]);
+        SharedMatrix Cp, Cn;
+        factor(dD_[jki], Cp, Cn);
+        C_pos_.push_back(Cp);
+        C_neg_.push_back(Cn);
+        ncol = std::max(ncol, static_cast<size_t>(Cp->colspi()[0] + Cn->colspi()[0]));
+    }
+
+    // A full K costs one half-transform and one contraction, each 2 naux nbf^2 flops,
+    // per occupied orbital, and the difference costs the same per column of its two
+    // factors. The eigendecomposition above is already paid for, so the columns decide.
+    incremental_K_ = ncol < nocc;
+
+    return true;
+}
+void DFIncFock::build(std::vector<SharedMatrix>& K, bool do_J, bool do_K, const Build& build) {
+    if (!incremental_) return;
+    bool inc_K = do_K && incremental_K_;
+
+    // J(dD) rides along with K(P), so the integrals are traversed once for both
+    if (do_J || inc_K) build(C_pos_, dD_, do_J, inc_K);
+    if (inc_K) {
+        // The symmetric contraction only adds, so K(dD) = K(P) - K(N) subtracts K(N)
+        // by flipping the sign of K around it
+        for (auto& Ki : K) Ki->scale(-1.0);
+        build(C_neg_, dD_, false, true);
+        for (auto& Ki : K) Ki->scale(-1.0);
+    } else if (do_K) {
+        // Left for a full build by the caller
+        for (auto& Ki : K) Ki->zero();
+    }
+
+    if (do_J) num_J_builds_++;
+    if (inc_K) num_K_builds_++;
+}
+void DFIncFock::postiter(const std::vector<SharedMatrix>& D) {
+    dD_.clear();
+    C_pos_.clear();
+    C_neg_.clear();
+
+    // Save a copy of the density for the next iteration
+    D_prev_.clear();
+    for (auto const& Di : D) {
+        D_prev_.push_back(Di->clone());
+    }
+}
+
 size_t JK::num_computed_shells() {
     outfile->Printf("WARNING: JK::num_computed_shells() was called, but benchmarking is disabled for the chosen JK algorithm.");
     outfile->Printf(" Returning 0 as computed shells count.\n");
@@ -34,6 +34,7 @@
 #include "psi4/pragma.h"
 PRAGMA_WARNING_PUSH
 PRAGMA_WARNING_IGNORE_DEPRECATED_DECLARATIONS
+#include <functional>
 #include <memory>
 #include <unordered_map>
 PRAGMA_WARNING_POP
@@ -734,6 +735,8 @@ class PSI_API DirectJK : public JK {
 
     // Perform Density matrix-based integral screening?
     bool density_screening_;
+    /// Accumulate J/K in thread-private copies with a tree reduction instead of atomics? (JK_ACCUMULATION)
+    bool accumulate_per_thread_;
 
     // => Incremental Fock build variables <= //
     
@@ -878,6 +881,91 @@ class GTFockJK : public JK {
     GTFockJK(std::shared_ptr<psi::BasisSet> Primary);
 };
 
+/**
+ * Class DFIncFock
+ *
+ * Incremental Fock bookkeeping shared by DiskDFJK and MemDFJK.
+ *
+ * J is linear in the density, so every incremental iteration builds
+ * it from the difference dD = D - D_prev. K is built from the
+ * truncated eigendecomposition dD = P - N, contracted as the
+ * symmetric factors of P and N, only when that costs less than
+ * contracting the occupied orbitals again; otherwise K is zeroed
+ * and left to a full build by the owning JK object.
+ */
+class PSI_API DFIncFock {
+   public:
+    /**
+     * Contract symmetric factors C (Cl = Cr = C) and densities D,
+     * adding the result onto the current J and/or K
+     */
+    typedef std::function<void(const std::vector<SharedMatrix>& C, const std::vector<SharedMatrix>& D, bool do_J,
+                               bool do_K)>
+        Build;
+
+   protected:
+    /// Primary basis, for shell-pair screening of dD
+    std::shared_ptr<BasisSet> primary_;
+    /// INCFOCK_FULL_FOCK_EVERY
+    int reset_;
+    /// INCFOCK_CONVERGENCE
+    double convergence_;
+    /// INCFOCK_DF_CUTOFF
+    double cutoff_;
+
+    /// The number of times INCFOCK has been performed (includes resets)
+    int count_;
+    /// Is J (and maybe K) of this iteration built from the difference?
+    bool incremental_;
+    /// Is K of this iteration built from the difference?
+    bool incremental_K_;
+    /// Number of J and K builds done from the difference
+    size_t num_J_builds_;
+    size_t num_K_builds_;
+
+    /// Previous iteration density matrices
+    std::vector<SharedMatrix> D_prev_;
+    /// Screened density differences of this iteration
+    std::vector<SharedMatrix> dD_;
+    /// Symmetric factors of the positive and negative parts of dD
+    std::vector<SharedMatrix> C_pos_;
+    std::vector<SharedMatrix> C_neg_;
+
+    /**
+     * Screen dD in place and factor it as dD = Cp Cp^T - Cn Cn^T.
+     * Shell pairs of dD with no element above the cutoff are zeroed,
+     * then the smallest eigenpairs are dropped while their summed
+     * magnitude stays below the cutoff. Each factor keeps at least
+     * one (possibly zero) column.
+     */
+    void factor(SharedMatrix dD, SharedMatrix& Cp, SharedMatrix& Cn) const;
+
+   public:
+    DFIncFock(std::shared_ptr<BasisSet> primary, Options& options);
+
+    /**
+     * Decide how this iteration is built, given the current densities
+     * @param eligible whether the owner can build incrementally at all
+     *        (symmetric densities, no omega exchange, not the first iteration)
+     * @param nocc the largest number of occupied orbitals
+     * @return whether J (and maybe K) is built from the difference
+     */
+    bool setup(const std::vector<SharedMatrix>& D, bool eligible, size_t nocc);
+    /**
+     * Add the difference contributions onto J (and K, if incremental_K()).
+     * If K is not incremental, it is zeroed for a full build instead.
+     */
+    void build(std::vector<SharedMatrix>& K, bool do_J, bool do_K, const Build& build);
+    /// Save the densities of this iteration for the next one
+    void postiter(const std::vector<SharedMatrix>& D);
+
+    bool incremental() const { return incremental_; }
+    bool incremental_K() const { return incremental_ && incremental_K_; }
+    size_t num_J_builds() const { return num_J_builds_; }
+    size_t num_K_builds() const { return num_K_builds_; }
+    void clear_D_prev() { D_prev_.clear(); }
+};
+
 /**
  * Class DiskDFJK
  *
@@ -941,6 +1029,16 @@ class PSI_API DiskDFJK : public JK {
     std::vector<SharedMatrix> C_temp_;
     std::vector<SharedMatrix> Q_temp_;
 
+    // => Incremental Fock build variables <= //
+
+    /// Perform Incremental Fock Build for J and K Matrices? (default false)
+    bool incfock_;
+    /// Incremental Fock bookkeeping, if incfock_
+    std::unique_ptr<DFIncFock> incfock_df_;
+
+    // Is the JK currently on the first SCF iteration of this SCF cycle?
+    bool initial_iteration_ = true;
+
     // => Required Algorithm-Specific Methods <= //
 
     /// Do we need to backtransform to C1 under the hood?
@@ -964,6 +1062,9 @@ class PSI_API DiskDFJK : public JK {
     void initialize_w_temps();
     void free_w_temps();
 
+    /// Contract C (Cl = Cr = C) and D onto J/K in place of the current C/D, for DFIncFock
+    void incfock_build(const std::vector<SharedMatrix>& C, const std::vector<SharedMatrix>& D, bool do_J, bool do_K);
+
     // => J and K <= //
     virtual void initialize_JK_core();
     virtual void initialize_JK_disk();
@@ -1038,6 +1139,18 @@ class PSI_API DiskDFJK : public JK {
     void set_subalgo(std::string subalgo) { subalgo_ = subalgo; }
 
     // => Accessors <= //
+    bool do_incfock_iter() { return incfock_df_ && incfock_df_->incremental(); }
+    /// Number of J builds done from the density difference
+    size_t num_incfock_J_builds() { return (incfock_df_ ? incfock_df_->num_J_builds() : 0); }
+    /// Number of K builds done from the density difference
+    size_t num_incfock_K_builds() { return (incfock_df_ ? incfock_df_->num_K_builds() : 0); }
+
+    /**
+     * Clear D_prev_
+     */
+    void clear_D_prev() {
+        if (incfock_df_) incfock_df_->clear_D_prev();
+    }
 
     /**
     * Print header information regarding JK
@@ -1146,6 +1259,23 @@ class PSI_API MemDFJK : public JK {
     /// Condition cutoff in fitting metric, defaults to 1.0E-12
     double condition_ = 1.0E-12;
 
+    // => Incremental Fock build variables <= //
+
+    /// Perform Incremental Fock Build for J and K Matrices? (default false)
+    bool incfock_;
+    /// Incremental Fock bookkeeping, if incfock_
+    std::unique_ptr<DFIncFock> incfock_df_;
+
+    // => Local exchange variables <= //
+
+    /// Build K from pivoted Cholesky orbitals restricted to their AO domains? (default false)
+    bool local_K_;
+    /// Cholesky truncation and orbital-domain coefficient cutoff of the local K
+    double local_K_cutoff_;
+
+    // Is the JK currently on the first SCF iteration of this SCF cycle?
+    bool initial_iteration_ = true;
+
     // => Required Algorithm-Specific Methods <= //
 
     int max_nocc() const;
@@ -1162,6 +1292,9 @@ class PSI_API MemDFJK : public JK {
     /// Common initialization
     void common_init();
 
+    /// Contract C (Cl = Cr = C) and D onto J/K in place of the current C/D, for DFIncFock
+    void incfock_build(const std::vector<SharedMatrix>& C, const std::vector<SharedMatrix>& D, bool do_J, bool do_K);
+
    public:
     // => Constructors < = //
 
@@ -1198,6 +1331,18 @@ class PSI_API MemDFJK : public JK {
     void set_do_wK(bool do_wK) override;
 
     // => Accessors <= //
+    bool do_incfock_iter() { return incfock_df_ && incfock_df_->incremental(); }
+    /// Number of J builds done from the density difference
+    size_t num_incfock_J_builds() { return (incfock_df_ ? incfock_df_->num_J_builds() : 0); }
+    /// Number of K builds done from the density difference
+    size_t num_incfock_K_builds() { return (incfock_df_ ? incfock_df_->num_K_builds() : 0); }
+
+    /**
+     * Clear D_prev_
+     */
+    void clear_D_prev() {
+        if (incfock_df_) incfock_df_->clear_D_prev();
+    }
 
     /**
     * Print header information regarding JK
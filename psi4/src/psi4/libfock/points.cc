@@ -27,6 +27,7 @@
  */
 
 #include "points.h"
+#include "collocation_cache.h"
 #include "cubature.h"
 
 #include "psi4/libmints/basisset.h"
@@ -61,13 +62,7 @@ void SAPFunctions::allocate() {
 }
 void SAPFunctions::compute_points(std::shared_ptr<BlockOPoints> block, bool force_compute) {
     // => Build basis function values <= //
-    block_index_ = block->index();
-    if (!force_compute && cache_map_ && (cache_map_->find(block->index()) != cache_map_->end())) {
-        current_basis_map_ = &(*cache_map_)[block->index()];
-    } else {
-        current_basis_map_ = &basis_values_;
-        BasisFunctions::compute_functions(block);
-    }
+    load_basis_values(block, force_compute);
 }
 void SAPFunctions::print(std::string out, int print) const {
     std::shared_ptr<psi::PsiOutStream> printer = (out == "outfile" ? outfile : std::make_shared<PsiOutStream>(out));
@@ -154,13 +149,7 @@ void RKSFunctions::compute_points(std::shared_ptr<BlockOPoints> block, bool forc
     if (!D_AO_) throw PSIEXCEPTION("RKSFunctions: call set_pointers.");
 
     // => Build basis function values <= //
-    block_index_ = block->index();
-    if (!force_compute && cache_map_ && (cache_map_->find(block->index()) != cache_map_->end())) {
-        current_basis_map_ = &(*cache_map_)[block->index()];
-    } else {
-        current_basis_map_ = &basis_values_;
-        BasisFunctions::compute_functions(block);
-    }
+    load_basis_values(block, force_compute);
 
     // => Global information <= //
     int npoints = block->npoints();
@@ -192,7 +181,7 @@ void RKSFunctions::compute_points(std::shared_ptr<BlockOPoints> block, bool forc
     size_t coll_funcs = basis_value("PHI")->ncol();
 
     // Rho_a = 2.0 * D_xy phi_xa phi_ya
-    C_DGEMM('N', 'N', npoints, nlocal, nlocal, 2.0, phip[0], coll_funcs, D2p[0], nglobal, 0.0, Tp[0], nglobal);
+    block_gemm('N', 'N', npoints, nlocal, nlocal, 2.0, phip[0], coll_funcs, D2p[0], nglobal, 0.0, Tp[0], nglobal);
     for (int P = 0; P < npoints; P++) {
         rhoap[P] = C_DDOT(nlocal, phip[P], 1, Tp[P], 1);
     }
@@ -236,7 +225,8 @@ void RKSFunctions::compute_points(std::shared_ptr<BlockOPoints> block, bool forc
 
         for (int x = 0; x < 3; x++) {
             double** phic = phi[x];
-            C_DGEMM('N', 'N', npoints, nlocal, nlocal, 1.0, phic[0], coll_funcs, D2p[0], nglobal, 0.0, Tp[0], nglobal);
+            block_gemm('N', 'N', npoints, nlocal, nlocal, 1.0, phic[0], coll_funcs, D2p[0], nglobal, 0.0, Tp[0],
+                       nglobal);
             for (int P = 0; P < npoints; P++) {
                 taup[P] += C_DDOT(nlocal, phic[P], 1, Tp[P], 1);
             }
@@ -299,13 +289,7 @@ void RKSFunctions::set_Cs(SharedMatrix /*Ca_AO*/, SharedMatrix /*Cb_AO*/) {
 }
 void RKSFunctions::compute_orbitals(std::shared_ptr<BlockOPoints> block, bool force_compute) {
     // => Build basis function values <= //
-    block_index_ = block->index();
-    if (!force_compute && cache_map_ && (cache_map_->find(block->index()) != cache_map_->end())) {
-        current_basis_map_ = &(*cache_map_)[block->index()];
-    } else {
-        current_basis_map_ = &basis_values_;
-        BasisFunctions::compute_functions(block);
-    }
+    load_basis_values(block, force_compute);
     // timer_off("Functions: Points");
 
     // => Global information <= //
@@ -423,13 +407,7 @@ void UKSFunctions::compute_points(std::shared_ptr<BlockOPoints> block, bool forc
     if (!Da_AO_) throw PSIEXCEPTION("UKSFunctions: call set_pointers.");
 
     // => Build basis function values <= //
-    block_index_ = block->index();
-    if (!force_compute && cache_map_ && (cache_map_->find(block->index()) != cache_map_->end())) {
-        current_basis_map_ = &(*cache_map_)[block->index()];
-    } else {
-        current_basis_map_ = &basis_values_;
-        BasisFunctions::compute_functions(block);
-    }
+    load_basis_values(block, force_compute);
 
     // => Global information <= //
     int npoints = block->npoints();
@@ -467,12 +445,12 @@ void UKSFunctions::compute_points(std::shared_ptr<BlockOPoints> block, bool forc
     double* rhobp = point_value("RHO_B")->pointer();
     size_t coll_funcs = basis_value("PHI")->ncol();
 
-    C_DGEMM('N', 'N', npoints, nlocal, nlocal, 1.0, phip[0], coll_funcs, Da2p[0], nglobal, 0.0, Tap[0], nglobal);
+    block_gemm('N', 'N', npoints, nlocal, nlocal, 1.0, phip[0], coll_funcs, Da2p[0], nglobal, 0.0, Tap[0], nglobal);
     for (int P = 0; P < npoints; P++) {
         rhoap[P] = C_DDOT(nlocal, phip[P], 1, Tap[P], 1);
     }
 
-    C_DGEMM('N', 'N', npoints, nlocal, nlocal, 1.0, phip[0], coll_funcs, Db2p[0], nglobal, 0.0, Tbp[0], nglobal);
+    block_gemm('N', 'N', npoints, nlocal, nlocal, 1.0, phip[0], coll_funcs, Db2p[0], nglobal, 0.0, Tbp[0], nglobal);
     for (int P = 0; P < npoints; P++) {
         rhobp[P] = C_DDOT(nlocal, phip[P], 1, Tbp[P], 1);
     }
@@ -546,8 +524,8 @@ void UKSFunctions::compute_points(std::shared_ptr<BlockOPoints> block, bool forc
                 double** Dc = D[t];
                 double** Tc = T[t];
                 double* tauc = tau[t];
-                C_DGEMM('N', 'N', npoints, nlocal, nlocal, 1.0, phic[0], coll_funcs, Dc[0], nglobal, 0.0, Tc[0],
-                        nglobal);
+                block_gemm('N', 'N', npoints, nlocal, nlocal, 1.0, phic[0], coll_funcs, Dc[0], nglobal, 0.0, Tc[0],
+                           nglobal);
                 for (int P = 0; P < npoints; P++) {
                     tauc[P] += 0.5 * C_DDOT(nlocal, phic[P], 1, Tc[P], 1);
                 }
@@ -569,13 +547,7 @@ void UKSFunctions::set_Cs(SharedMatrix Ca_AO, SharedMatrix Cb_AO) {
 }
 void UKSFunctions::compute_orbitals(std::shared_ptr<BlockOPoints> block, bool force_compute) {
     // => Build basis function values <= //
-    block_index_ = block->index();
-    if (!force_compute && cache_map_ && (cache_map_->find(block->index()) != cache_map_->end())) {
-        current_basis_map_ = &(*cache_map_)[block->index()];
-    } else {
-        current_basis_map_ = &basis_values_;
-        BasisFunctions::compute_functions(block);
-    }
+    load_basis_values(block, force_compute);
 
     // => Global information <= //
 
@@ -644,6 +616,59 @@ PointFunctions::PointFunctions(std::shared_ptr<BasisSet> primary, int max_points
     set_ansatz(0);
 }
 PointFunctions::~PointFunctions() {}
+void PointFunctions::load_basis_values(std::shared_ptr<BlockOPoints> block, bool force_compute) {
+    block_index_ = block->index();
+    current_basis_map_ = &basis_values_;
+    if (force_compute || !collocation_cache_ || !collocation_cache_->load(block->index(), basis_values_)) {
+        BasisFunctions::compute_functions(block);
+    }
+}
+void PointFunctions::block_gemm(char transa, char transb, int m, int n, int k, double alpha, double* a, int lda,
+                                double* b, int ldb, double beta, double* c, int ldc) {
+    if (!mixed_precision_) {
+        C_DGEMM(transa, transb, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+        return;
+    }
+    if (m == 0 || n == 0 || k == 0) return;
+
+    // Pack a row-major rows x cols block into a contiguous single-precision buffer
+    auto pack = [](const double* src, int rows, int cols, int ld, std::vector<float>& dst) {
+        if (dst.size() < (size_t)rows * cols) dst.resize((size_t)rows * cols);
+        for (int i = 0; i < rows; i++) {
+            const double* srcp = src + (size_t)i * ld;
+            float* dstp = dst.data() + (size_t)i * cols;
+            for (int j = 0; j < cols; j++) {
+                dstp[j] = static_cast<float>(srcp[j]);
+            }
+        }
+    };
+
+    // op(A) is m x k and op(B) is k x n
+    bool trans_a = (transa == 'T' || transa == 't');
+    bool trans_b = (transb == 'T' || transb == 't');
+    int a_cols = (trans_a ? m : k);
+    int b_cols = (trans_b ? k : n);
+    pack(a, (trans_a ? k : m), a_cols, lda, gemm_a_);
+    pack(b, (trans_b ? n : k), b_cols, ldb, gemm_b_);
+    if (gemm_c_.size() < (size_t)m * n) gemm_c_.resize((size_t)m * n);
+
+    C_SGEMM(transa, transb, m, n, k, 1.0f, gemm_a_.data(), a_cols, gemm_b_.data(), b_cols, 0.0f, gemm_c_.data(), n);
+
+    // Accumulate in double precision
+    for (int i = 0; i < m; i++) {
+        double* cp = c + (size_t)i * ldc;
+        const float* gp = gemm_c_.data() + (size_t)i * n;
+        if (beta == 0.0) {
+            for (int j = 0; j < n; j++) {
+                cp[j] = alpha * static_cast<double>(gp[j]);
+            }
+        } else {
+            for (int j = 0; j < n; j++) {
+                cp[j] = beta * cp[j] + alpha * static_cast<double>(gp[j]);
+            }
+        }
+    }
+}
 SharedVector PointFunctions::point_value(const std::string& key) { return point_values_[key]; }
 
 SharedMatrix PointFunctions::orbital_value(const std::string& key) { return orbital_values_[key]; }
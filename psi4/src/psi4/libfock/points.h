@@ -44,6 +44,7 @@ namespace psi {
 class BasisSet;
 class Vector;
 class BlockOPoints;
+class CollocationCache;
 
 class PSI_API BasisFunctions {
    protected:
@@ -110,8 +111,8 @@ class PointFunctions : public BasisFunctions {
     /// The index of the current referenced block.
     size_t block_index_;
 
-    // Contains a map to the cache the global basis_values
-    std::unordered_map<size_t, std::map<std::string, SharedMatrix>>* cache_map_ = nullptr;
+    // Cached basis function values of the grid blocks, owned by the VBase
+    const CollocationCache* collocation_cache_ = nullptr;
 
     // Contains a pointer to the current map to use for basis_values
     std::map<std::string, SharedMatrix>* current_basis_map_ = nullptr;
@@ -126,6 +127,18 @@ class PointFunctions : public BasisFunctions {
     /// Map of value names to Matrices containing values
     std::map<std::string, std::shared_ptr<Matrix>> orbital_values_;
 
+    /// Fill basis_values_ for block, from the collocation cache unless force_compute is set or the block is not cached
+    void load_basis_values(std::shared_ptr<BlockOPoints> block, bool force_compute);
+
+    // => Mixed Precision <= //
+
+    /// Run the grid GEMMs (block_gemm) in single precision?
+    bool mixed_precision_ = false;
+    /// Single-precision copies of the block_gemm operands
+    std::vector<float> gemm_a_;
+    std::vector<float> gemm_b_;
+    std::vector<float> gemm_c_;
+
    public:
     // => Constructors <= //
 
@@ -133,9 +146,8 @@ class PointFunctions : public BasisFunctions {
     ~PointFunctions() override;
 
     // => Setters <= //
-    void set_cache_map(std::unordered_map<size_t, std::map<std::string, SharedMatrix>>* cache_map) {
-        cache_map_ = cache_map;
-    }
+    void set_collocation_cache(const CollocationCache* collocation_cache) { collocation_cache_ = collocation_cache; }
+    void set_mixed_precision(bool mixed_precision) { mixed_precision_ = mixed_precision; }
 
     // => Computers <= //
     /// Compute needed DFT intermediates, e.g. rho, gamma, at the points in block.
@@ -143,6 +155,15 @@ class PointFunctions : public BasisFunctions {
     /// force_compute forces basis function values at points to be re-computed.
     virtual void compute_points(std::shared_ptr<BlockOPoints> block, bool force_compute = true) = 0;
 
+    /**
+     * C := alpha op(A) op(B) + beta C for the point-by-function contractions of a block,
+     * with the arguments of C_DGEMM.
+     * If mixed_precision() is set, op(A) op(B) is formed by C_SGEMM on single-precision
+     * copies of A and B, and is then scaled and added into C in double precision.
+     */
+    void block_gemm(char transa, char transb, int m, int n, int k, double alpha, double* a, int lda, double* b,
+                    int ldb, double beta, double* c, int ldc);
+
     // => Accessors <= //
 
     std::shared_ptr<Vector> point_value(const std::string& key);
@@ -155,6 +176,7 @@ class PointFunctions : public BasisFunctions {
     virtual std::vector<SharedMatrix> D_scratch() = 0;
 
     int ansatz() const { return ansatz_; }
+    bool mixed_precision() const { return mixed_precision_; }
 
     // => Setters <= //
 
@@ -296,9 +318,6 @@ class UKSFunctions : public PointFunctions {
 
     void set_pointers(SharedMatrix Da_occ_AO) override;
     void set_pointers(SharedMatrix Da_occ_AO, SharedMatrix Db_occ_AO) override;
-    void set_cache_map(std::unordered_map<size_t, std::map<std::string, SharedMatrix>>* cache_map) {
-        cache_map_ = cache_map;
-    }
 
     /// Compute the needed DFT intermediates at the points in the block.
     /// "Which DFT intermediates are needed?" is determined from ansatz_.
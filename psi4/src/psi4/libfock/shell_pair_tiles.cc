@@ -0,0 +1,148 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2026 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#include "shell_pair_tiles.h"
+#include "cubature.h"
+
+#include "psi4/libmints/basisset.h"
+#include "psi4/libmints/matrix.h"
+#include "psi4/libpsi4util/exception.h"
+
+#include <algorithm>
+
+namespace psi {
+
+namespace {
+/// Locks shared by the tiles of a ShellPairTiles
+const size_t shell_pair_tiles_nlocks = 1024;
+}  // namespace
+
+ShellPairTiles::Pattern::Pattern(std::shared_ptr<BasisSet> primary,
+                                 const std::vector<std::shared_ptr<BlockOPoints>>& blocks)
+    : primary_(primary), size_(0) {
+    int nshell = primary_->nshell();
+
+    // Lower triangle of the shell pairs that meet on a block
+    std::vector<std::vector<bool>> significant(nshell);
+    for (int P = 0; P < nshell; P++) {
+        significant[P].resize(P + 1, false);
+    }
+    for (const auto& block : blocks) {
+        const auto& shells = block->shells_local_to_global();
+        for (size_t i = 0; i < shells.size(); i++) {
+            if (i && shells[i] <= shells[i - 1]) {
+                throw PSIEXCEPTION("ShellPairTiles: Block shells are not in increasing order.");
+            }
+            for (size_t j = 0; j <= i; j++) {
+                significant[shells[i]][shells[j]] = true;
+            }
+        }
+    }
+
+    pair_start_.push_back(0);
+    for (int P = 0; P < nshell; P++) {
+        int nP = primary_->shell(P).nfunction();
+        for (int Q = 0; Q <= P; Q++) {
+            if (!significant[P][Q]) continue;
+            pair_shell_.push_back(Q);
+            pair_offset_.push_back(size_);
+            size_ += nP * primary_->shell(Q).nfunction();
+        }
+        pair_start_.push_back(pair_shell_.size());
+    }
+}
+
+ShellPairTiles::ShellPairTiles(std::shared_ptr<const Pattern> pattern)
+    : pattern_(pattern),
+      values_(pattern->size(), 0.0),
+      locks_(std::max<size_t>(1, std::min(pattern->npairs(), shell_pair_tiles_nlocks))) {}
+
+void ShellPairTiles::add(const BlockOPoints& block, const double* V, size_t ldv) {
+    const auto& primary = pattern_->primary_;
+    const auto& shells = block.shells_local_to_global();
+
+    // Local functions come shell by shell, in the order of shells
+    size_t oP = 0;
+    for (size_t i = 0; i < shells.size(); i++) {
+        int P = shells[i];
+        int nP = primary->shell(P).nfunction();
+
+        size_t pair = pattern_->pair_start_[P];
+        size_t oQ = 0;
+        for (size_t j = 0; j <= i; j++) {
+            int Q = shells[j];
+            int nQ = primary->shell(Q).nfunction();
+
+            // Both lists increase in Q
+            while (pair < pattern_->pair_start_[P + 1] && pattern_->pair_shell_[pair] != Q) pair++;
+            if (pair == pattern_->pair_start_[P + 1]) {
+                throw PSIEXCEPTION("ShellPairTiles: Block shell pair is not in the pattern.");
+            }
+
+            double* tile = &values_[pattern_->pair_offset_[pair]];
+            std::lock_guard<std::mutex> guard(locks_[pair % locks_.size()]);
+            for (int p = 0; p < nP; p++) {
+                int nq = (P == Q ? p + 1 : nQ);
+                for (int q = 0; q < nq; q++) {
+                    tile[p * nQ + q] += V[(oP + p) * ldv + oQ + q];
+                }
+            }
+            oQ += nQ;
+        }
+        oP += nP;
+    }
+}
+
+void ShellPairTiles::merge(SharedMatrix ret) const {
+    const auto& primary = pattern_->primary_;
+    double** Rp = ret->pointer();
+
+    // Tile (P, Q), Q <= P, adds into block (P, Q) and its transpose (Q, P). Each unordered shell pair has
+    // exactly one tile, so the elements written by different tiles are disjoint and no two threads clash.
+#pragma omp parallel for schedule(dynamic)
+    for (int P = 0; P < primary->nshell(); P++) {
+        int nP = primary->shell(P).nfunction();
+        int P0 = primary->shell(P).function_index();
+        for (size_t pair = pattern_->pair_start_[P]; pair < pattern_->pair_start_[P + 1]; pair++) {
+            int Q = pattern_->pair_shell_[pair];
+            int nQ = primary->shell(Q).nfunction();
+            int Q0 = primary->shell(Q).function_index();
+            const double* tile = &values_[pattern_->pair_offset_[pair]];
+            for (int p = 0; p < nP; p++) {
+                int nq = (P == Q ? p : nQ);
+                for (int q = 0; q < nq; q++) {
+                    Rp[P0 + p][Q0 + q] += tile[p * nQ + q];
+                    Rp[Q0 + q][P0 + p] += tile[p * nQ + q];
+                }
+                if (P == Q) Rp[P0 + p][P0 + p] += tile[p * nQ + p];
+            }
+        }
+    }
+}
+
+}  // namespace psi
@@ -0,0 +1,105 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2026 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#ifndef libfock_shell_pair_tiles_H
+#define libfock_shell_pair_tiles_H
+
+#include "psi4/libmints/typedefs.h"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace psi {
+
+class BasisSet;
+class BlockOPoints;
+
+/**
+ * Class ShellPairTiles
+ *
+ * Symmetric nbf x nbf matrix assembled from the block-local matrices of a
+ * DFT grid, as V and Vx are. Only the shell pairs (P >= Q) that are both
+ * significant on some block can become nonzero, so only those are stored,
+ * each as a dense nP x nQ tile. Memory goes with the number of significant
+ * shell pairs, not with nbf^2.
+ *
+ * add() may be called from several threads at once. Each tile is guarded
+ * by one of a fixed set of locks, so a block takes one lock per shell pair
+ * rather than one atomic update per matrix element. merge() then adds all
+ * tiles into a dense matrix, one shell row per thread.
+ */
+class ShellPairTiles {
+   public:
+    /// The significant shell pairs of a grid, shared by all matrices on that grid
+    class Pattern {
+        friend class ShellPairTiles;
+
+       protected:
+        std::shared_ptr<BasisSet> primary_;
+        /// Pairs of shell P are pair_start_[P] to pair_start_[P + 1], by increasing Q
+        std::vector<size_t> pair_start_;
+        /// Q of each pair
+        std::vector<int> pair_shell_;
+        /// Offset of the tile of each pair
+        std::vector<size_t> pair_offset_;
+        /// Total size of all tiles
+        size_t size_;
+
+       public:
+        Pattern(std::shared_ptr<BasisSet> primary, const std::vector<std::shared_ptr<BlockOPoints>>& blocks);
+
+        size_t npairs() const { return pair_shell_.size(); }
+        /// Number of doubles of a ShellPairTiles on this pattern
+        size_t size() const { return size_; }
+    };
+
+   protected:
+    std::shared_ptr<const Pattern> pattern_;
+    std::vector<double> values_;
+    std::vector<std::mutex> locks_;
+
+   public:
+    ShellPairTiles(std::shared_ptr<const Pattern> pattern);
+
+    /**
+     * Add the lower triangle of a symmetric block-local matrix
+     * @param block the block, whose shells all belong to the pattern
+     * @param V nlocal x nlocal matrix over the significant functions of block
+     * @param ldv leading dimension of V
+     */
+    void add(const BlockOPoints& block, const double* V, size_t ldv);
+
+    /// Add the full symmetric matrix to ret, which is nbf x nbf
+    void merge(SharedMatrix ret) const;
+};
+
+}  // namespace psi
+
+#endif
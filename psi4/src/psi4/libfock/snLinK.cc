@@ -28,6 +28,7 @@
 
 #include "jk.h"
 #include "SplitJK.h"
+#include "task_scheduler.h"
 #include "psi4/libqt/qt.h"
 #include "psi4/libfock/cubature.h"
 #include "psi4/libfock/points.h"
@@ -41,11 +42,14 @@
 #include "psi4/liboptions/liboptions.h"
 #include "psi4/lib3index/dftensor.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/libpsi4util/process.h"
 #include "psi4/pybind11.h"
 
 #include <algorithm>
 #include <iostream>
+#include <limits>
 #include <map>
+#include <numeric>
 #include <tuple>
 #include <unordered_set>
 #include <variant>
@@ -180,21 +184,41 @@ GauXC::BasisSet<T> snLinK::psi4_to_gauxc_basisset(std::shared_ptr<BasisSet> psi4
 // ==> SplitJK-inherited functions go here <== //
 
 snLinK::snLinK(std::shared_ptr<BasisSet> primary, Options& options) : SplitJK(primary, options) {
-
-#ifdef USING_gauxc
     timer_on("snLinK: Setup");
-    
-    // => Part #1: Options Processing <= //
-    timer_on("snLinK: Options Processing");
 
     // set a few Psi4-specific parameters
     incfock_iter_ = false;
-  
+    num_computed_shells_ = 0L;
+
     basis_tol_ = options.get_double("SNLINK_BASIS_TOLERANCE");
 
     pruning_scheme_ = options_.get_str("SNLINK_PRUNING_SCHEME");
     radial_scheme_ = options_.get_str("SNLINK_RADIAL_SCHEME");
- 
+
+    radial_points_ = options_.get_int("SNLINK_RADIAL_POINTS");
+    spherical_points_ = options_.get_int("SNLINK_SPHERICAL_POINTS");
+
+    // AUTO picks GauXC whenever Psi4 is built with it
+    auto backend = options_.get_str("SNLINK_BACKEND");
+#ifdef USING_gauxc
+    native_ = (backend == "NATIVE");
+#else
+    if (backend == "GAUXC") {
+        throw PSIEXCEPTION("snLinK was requested with SNLINK_BACKEND=GAUXC, but GauXC is not installed! Please recompile Psi4 with ENABLE_gauxc=ON, or use SNLINK_BACKEND=NATIVE.");
+    }
+    native_ = true;
+#endif
+
+    if (native_) {
+        native_init();
+        timer_off("snLinK: Setup");
+        return;
+    }
+
+#ifdef USING_gauxc
+    // => Part #1: Options Processing <= //
+    timer_on("snLinK: Options Processing");
+
 #if psi4_SHGSHELL_ORDERING == LIBINT_SHGSHELL_ORDERING_STANDARD
     is_cca_ = true;
 #elif psi4_SHGSHELL_ORDERING == LIBINT_SHGSHELL_ORDERING_GAUSSIAN
@@ -347,9 +371,6 @@ snLinK::snLinK(std::shared_ptr<BasisSet> primary, Options& options) : SplitJK(pr
     // => Part #3: Construct GauXC Integrator <= //
     timer_on("snLinK: Construct GauXC Integrator");
 
-    radial_points_ = options_.get_int("SNLINK_RADIAL_POINTS");
-    spherical_points_ = options_.get_int("SNLINK_SPHERICAL_POINTS");
-
     // convert Psi4 fundamental quantities to GauXC 
     auto gauxc_mol = psi4_to_gauxc_molecule(primary_->molecule());
     auto gauxc_primary = psi4_to_gauxc_basisset<double>(primary_, basis_tol_, force_cartesian);
@@ -407,18 +428,33 @@ snLinK::snLinK(std::shared_ptr<BasisSet> primary, Options& options) : SplitJK(pr
     integrator_ = integrator_factory_->get_shared_instance(dummy_func, gauxc_load_balancer); 
  
     timer_off("snLinK: Construct GauXC Integrator");
-    
-    timer_off("snLinK: Setup");
-
-#else
-    throw PSIEXCEPTION("snLinK was requested in SCF_TYPE, but GauXC is not installed! Please recompile Psi4 with ENABLE_gauxc=ON.");
 #endif
+
+    timer_off("snLinK: Setup");
 }
 
 snLinK::~snLinK() {}
 
+size_t snLinK::num_computed_shells() {
+    return num_computed_shells_;
+}
+
 void snLinK::print_header() const {
 
+    if (native_) {
+        if (print_) {
+            outfile->Printf("\n");
+            outfile->Printf("  ==> snLinK: Native Semi-Numerical Linear Exchange K <==\n\n");
+
+            outfile->Printf("    K Grid Radial Points: %zu\n", radial_points_);
+            outfile->Printf("    K Grid Spherical/Angular Points: %zu\n\n", spherical_points_);
+            outfile->Printf("    K Ints Cutoff:      %11.0E\n", kscreen_);
+            outfile->Printf("    K Density Cutoff:   %11.0E\n", dscreen_);
+            outfile->Printf("    K Basis Cutoff:     %11.0E\n", basis_tol_);
+        }
+        return;
+    }
+
 #ifdef USING_gauxc
     if (print_) {
         outfile->Printf("\n");
@@ -455,6 +491,11 @@ void snLinK::print_header() const {
 void snLinK::build_G_component(std::vector<std::shared_ptr<Matrix>>& D, std::vector<std::shared_ptr<Matrix>>& K,
     std::vector<std::shared_ptr<TwoBodyAOInt> >& eri_computers) {
 
+    if (native_) {
+        build_K_native(D, K);
+        return;
+    }
+
 #ifdef USING_gauxc
     // we need to know if we are using a spherical harmonic basis
     // much of the behavior here is influenced by this
@@ -552,4 +593,388 @@ void snLinK::build_G_component(std::vector<std::shared_ptr<Matrix>>& D, std::vec
     return;
 }
 
+void snLinK::native_init() {
+    timer_on("snLinK: Native Grid Construction");
+
+    // thread count
+    nthreads_ = 1;
+#ifdef _OPENMP
+    nthreads_ = Process::environment.get_n_threads();
+#endif
+
+    lr_symmetric_ = true;
+
+    // set up snLinK integral tolerance
+    if (options_["SNLINK_INTS_TOLERANCE"].has_changed() && options_.get_str("SCREENING") != "NONE") {
+        kscreen_ = options_.get_double("SNLINK_INTS_TOLERANCE");
+    } else {
+        kscreen_ = cutoff_;
+    }
+    dscreen_ = options_.get_double("SNLINK_DENSITY_TOLERANCE");
+
+    // the snLinK grid specification maps directly onto a DFTGrid
+    std::map<std::string, std::string> grid_str_options = {
+        {"DFT_PRUNING_SCHEME", pruning_scheme_},
+        {"DFT_RADIAL_SCHEME",  radial_scheme_},
+        {"DFT_NUCLEAR_SCHEME", "STRATMANN"},
+        {"DFT_GRID_NAME",      ""},
+        {"DFT_BLOCK_SCHEME",   "OCTREE"},
+    };
+
+    std::map<std::string, int> grid_int_options = {
+        {"DFT_SPHERICAL_POINTS", static_cast<int>(spherical_points_)},
+        {"DFT_RADIAL_POINTS",    static_cast<int>(radial_points_)},
+        {"DFT_BLOCK_MIN_POINTS", 100},
+        {"DFT_BLOCK_MAX_POINTS", 256},
+    };
+
+    std::map<std::string, double> grid_float_options = {
+        {"DFT_BASIS_TOLERANCE",   basis_tol_},
+        {"DFT_BS_RADIUS_ALPHA",   1.0},
+        {"DFT_PRUNING_ALPHA",     1.0},
+        {"DFT_BLOCK_MAX_RADIUS",  3.0},
+        {"DFT_WEIGHTS_TOLERANCE", 1e-15},
+    };
+    grid_ = std::make_shared<DFTGrid>(primary_->molecule(), primary_, grid_int_options, grid_str_options, grid_float_options, options_);
+
+    if (options_.get_int("DEBUG")) {
+        outfile->Printf("  ==> snLinK: Native Grid Details <==\n\n");
+        outfile->Printf("    Total Points:     %11d\n", grid_->npoints());
+        outfile->Printf("    Total Blocks:     %11zu\n", grid_->blocks().size());
+        outfile->Printf("    Max Points:       %11d\n", grid_->max_points());
+        outfile->Printf("    Max Functions:    %11d\n\n", grid_->max_functions());
+    }
+
+    timer_off("snLinK: Native Grid Construction");
+
+    size_t nshell = primary_->nshell();
+
+    // bounds for the one-electron ESP integrals, independent of the grid point
+    esp_bound_ = std::make_shared<Matrix>(compute_esp_bound(*primary_));
+
+    // map of shell pairs with overlapping extents
+    auto dist = primary_->molecule()->distance_matrix();
+    auto shell_extents = grid_->extents()->shell_extents();
+    shell_extent_map_.assign(nshell, std::vector<int>());
+    for (size_t s1 = 0; s1 < nshell; s1++) {
+        size_t c1 = primary_->shell_to_center(s1);
+        for (size_t s2 = 0; s2 < nshell; s2++) {
+            size_t c2 = primary_->shell_to_center(s2);
+            if (dist.get(c1, c2) <= shell_extents->get(s1) + shell_extents->get(s2)) {
+                shell_extent_map_[s1].push_back(s2);
+            }
+        }
+    }
+
+    // estimated cost of each grid block: points times the shell pairs between the
+    // block's shells and their overlapping neighbours
+    const auto& blocks = grid_->blocks();
+    block_cost_.assign(blocks.size(), 0.0);
+    for (size_t bi = 0; bi < blocks.size(); bi++) {
+        double pair_cost = 0.0;
+        for (int KAPPA : blocks[bi]->shells_local_to_global()) {
+            for (int NU : shell_extent_map_[KAPPA]) {
+                pair_cost += TaskScheduler::shell_pair_cost(primary_->shell(KAPPA), primary_->shell(NU));
+            }
+        }
+        block_cost_[bi] = blocks[bi]->npoints() * pair_cost;
+    }
+}
+
+// build K with the sn-LinK algorithm of Laqua, Thompson, Kussmann and Ochsenfeld
+// (https://doi.org/10.1021/acs.jctc.0c00062) on Psi4's own grids and integrals.
+// For each grid block, with X_gk the basis functions on the block,
+//   F_gt = X_gk D_kt                  (one GEMM, all densities at once)
+//   G_gn = w_g A_nt(g) F_gt           (one-electron ESP integrals at g)
+//   K_mn += X_gm G_gn                 (one GEMM, all densities at once)
+// where the t shells are restricted to the density partners of the block's shells
+// and the n shells to the extent partners of the t shells.
+void snLinK::build_K_native(std::vector<std::shared_ptr<Matrix>>& D, std::vector<std::shared_ptr<Matrix>>& K) {
+
+    // => Sizing <= //
+    size_t njk = D.size();
+    size_t nbf = primary_->nbf();
+    size_t nshell = primary_->nshell();
+    const auto& blocks = grid_->blocks();
+    auto esp_boundp = esp_bound_->pointer();
+    auto shell_extents = grid_->extents()->shell_extents();
+
+    // => Shell-pair maxima of the densities <= //
+    Matrix D_shell(nshell, nshell);
+    auto D_shellp = D_shell.pointer();
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads_)
+    for (size_t P = 0; P < nshell; P++) {
+        size_t p_start = primary_->shell(P).function_index();
+        size_t num_p = primary_->shell(P).nfunction();
+        for (size_t Q = 0; Q < nshell; Q++) {
+            size_t q_start = primary_->shell(Q).function_index();
+            size_t num_q = primary_->shell(Q).nfunction();
+            double dmax = 0.0;
+            for (size_t jki = 0; jki < njk; jki++) {
+                auto Dp = D[jki]->pointer();
+                for (size_t p = p_start; p < p_start + num_p; p++) {
+                    for (size_t q = q_start; q < q_start + num_q; q++) {
+                        dmax = std::max(dmax, std::abs(Dp[p][q]));
+                    }
+                }
+            }
+            D_shellp[P][Q] = dmax;
+        }
+    }
+
+    // => Per-thread objects <= //
+    std::vector<std::shared_ptr<ElectrostaticInt>> int_computers(nthreads_);
+    std::vector<std::shared_ptr<BasisFunctions>> bf_computers(nthreads_);
+    std::vector<std::vector<SharedMatrix>> KT(njk, std::vector<SharedMatrix>(nthreads_));
+
+    // global shell -> local function offset in the t and n lists of the current block (-1 if absent)
+    std::vector<std::vector<int>> tau_offsets(nthreads_, std::vector<int>(nshell, -1));
+    std::vector<std::vector<int>> nu_offsets(nthreads_, std::vector<int>(nshell, -1));
+
+    IntegralFactory factory(primary_);
+    for (size_t thread = 0; thread < nthreads_; thread++) {
+        int_computers[thread] = std::shared_ptr<ElectrostaticInt>(static_cast<ElectrostaticInt*>(factory.electrostatic().release()));
+        bf_computers[thread] = std::make_shared<BasisFunctions>(primary_, grid_->max_points(), grid_->max_functions());
+        for (size_t jki = 0; jki < njk; jki++) {
+            KT[jki][thread] = std::make_shared<Matrix>(nbf, nbf);
+        }
+    }
+
+    TaskScheduler scheduler(nthreads_);
+    scheduler.schedule(block_cost_);
+
+    std::vector<size_t> int_shells_computed(nthreads_, 0);
+
+    timer_on("snLinK: Native Grid Loop");
+
+    scheduler.run([&](size_t bi, int rank) {
+        const auto& block = blocks[bi];
+        size_t npoints = block->npoints();
+        const double* x = block->x();
+        const double* y = block->y();
+        const double* z = block->z();
+        const double* w = block->w();
+
+        const auto& bf_map = block->functions_local_to_global();
+        const auto& shell_map = block->shells_local_to_global();
+        size_t nbf_block = bf_map.size();
+        if (npoints == 0 || nbf_block == 0) return;
+
+        auto& tau_offset = tau_offsets[rank];
+        auto& nu_offset = nu_offsets[rank];
+
+        // => Shell lists <= //
+
+        // t shells: density partners of the shells significant on this block
+        std::vector<int> tau_shells;
+        for (size_t TAU = 0; TAU < nshell; TAU++) {
+            for (int KAPPA : shell_map) {
+                if (D_shellp[KAPPA][TAU] > dscreen_) {
+                    tau_shells.push_back(TAU);
+                    break;
+                }
+            }
+        }
+        if (tau_shells.empty()) return;
+
+        size_t ntau = 0;
+        for (int TAU : tau_shells) {
+            tau_offset[TAU] = ntau;
+            ntau += primary_->shell(TAU).nfunction();
+        }
+
+        // n shells: extent partners of the t shells (every t shell is its own partner)
+        std::vector<int> nu_shells;
+        for (int TAU : tau_shells) {
+            for (int NU : shell_extent_map_[TAU]) {
+                if (nu_offset[NU] < 0) {
+                    nu_offset[NU] = 0;
+                    nu_shells.push_back(NU);
+                }
+            }
+        }
+        std::sort(nu_shells.begin(), nu_shells.end());
+        size_t nnu = 0;
+        for (int NU : nu_shells) {
+            nu_offset[NU] = nnu;
+            nnu += primary_->shell(NU).nfunction();
+        }
+
+        // => Basis functions on the block <= //
+        bf_computers[rank]->compute_functions(block);
+        auto phi = bf_computers[rank]->basis_values()["PHI"];
+        auto phip = phi->pointer();
+        size_t phi_ld = phi->colspi()[0];
+
+        // |phi| maximum at each point, scaled by |w|, for point screening
+        std::vector<double> X_gmax(npoints, 0.0);
+        double X_max = 0.0;
+        for (size_t g = 0; g < npoints; g++) {
+            double xmax = 0.0;
+            for (size_t k = 0; k < nbf_block; k++) {
+                xmax = std::max(xmax, std::abs(phip[g][k]));
+            }
+            X_gmax[g] = xmax * std::abs(w[g]);
+            X_max = std::max(X_max, X_gmax[g]);
+        }
+
+        // => F Matrix <= //
+
+        // D_kt of every density, packed side by side: nbf_block x (njk * ntau)
+        size_t ldf = njk * ntau;
+        std::vector<double> D_block(nbf_block * ldf);
+        for (size_t jki = 0; jki < njk; jki++) {
+            auto Dp = D[jki]->pointer();
+            for (size_t k = 0; k < nbf_block; k++) {
+                double* D_blockp = D_block.data() + k * ldf + jki * ntau;
+                for (int TAU : tau_shells) {
+                    size_t tau_start = primary_->shell(TAU).function_index();
+                    size_t num_tau = primary_->shell(TAU).nfunction();
+                    std::copy(&Dp[bf_map[k]][tau_start], &Dp[bf_map[k]][tau_start] + num_tau, D_blockp + tau_offset[TAU]);
+                }
+            }
+        }
+
+        std::vector<double> F_block(npoints * ldf);
+        C_DGEMM('N', 'N', npoints, ldf, nbf_block, 1.0, phip[0], phi_ld, D_block.data(), ldf, 0.0, F_block.data(), ldf);
+
+        // shell maxima of F at each point and over the block
+        size_t ntau_shells = tau_shells.size();
+        std::vector<double> F_shell(npoints * ntau_shells, 0.0);
+        std::vector<double> F_shell_max(ntau_shells, 0.0);
+        for (size_t g = 0; g < npoints; g++) {
+            for (size_t t = 0; t < ntau_shells; t++) {
+                size_t tau_start = tau_offset[tau_shells[t]];
+                size_t num_tau = primary_->shell(tau_shells[t]).nfunction();
+                double fmax = 0.0;
+                for (size_t jki = 0; jki < njk; jki++) {
+                    const double* Fp = F_block.data() + g * ldf + jki * ntau + tau_start;
+                    for (size_t tau = 0; tau < num_tau; tau++) {
+                        fmax = std::max(fmax, std::abs(Fp[tau]));
+                    }
+                }
+                F_shell[g * ntau_shells + t] = fmax;
+                F_shell_max[t] = std::max(F_shell_max[t], fmax);
+            }
+        }
+
+        // t shell -> index in tau_shells, reusing the offsets already stored
+        auto tau_index = [&](int TAU) {
+            return std::lower_bound(tau_shells.begin(), tau_shells.end(), TAU) - tau_shells.begin();
+        };
+
+        // => G Matrix <= //
+        size_t ldg = njk * nnu;
+        std::vector<double> G_block(npoints * ldg, 0.0);
+
+        const double* int_buff = int_computers[rank]->buffers()[0];
+        const auto mol = primary_->molecule();
+
+        for (size_t t = 0; t < ntau_shells; t++) {
+            int TAU = tau_shells[t];
+            size_t num_tau = primary_->shell(TAU).nfunction();
+            size_t tau_f = tau_offset[TAU];
+            size_t tau_g = nu_offset[TAU];
+            size_t center_TAU = primary_->shell_to_center(TAU);
+            double x_TAU = mol->x(center_TAU);
+            double y_TAU = mol->y(center_TAU);
+            double z_TAU = mol->z(center_TAU);
+
+            for (int NU : shell_extent_map_[TAU]) {
+                // (n|t) with both shells in the t list is done once, for NU <= TAU,
+                // and contracted in both directions
+                bool symm = (NU != TAU) && tau_offset[NU] >= 0;
+                if (symm && NU > TAU) continue;
+                size_t u = symm ? tau_index(NU) : 0;
+
+                size_t num_nu = primary_->shell(NU).nfunction();
+                size_t nu_g = nu_offset[NU];
+                size_t nu_f = symm ? tau_offset[NU] : 0;
+                size_t center_NU = primary_->shell_to_center(NU);
+                double x_NU = mol->x(center_NU);
+                double y_NU = mol->y(center_NU);
+                double z_NU = mol->z(center_NU);
+
+                // block screening over the K_mn = X_gm A_nt(g) F_gt upper bound
+                double k_bound = X_max * esp_boundp[NU][TAU] * F_shell_max[t];
+                if (symm) k_bound = std::max(k_bound, X_max * esp_boundp[TAU][NU] * F_shell_max[u]);
+                if (k_bound < kscreen_) continue;
+
+                for (size_t g = 0; g < npoints; g++) {
+                    // point screening, with the decay of the ESP integrals away from the shell pair
+                    double dist_TAU_g = std::sqrt((x_TAU - x[g]) * (x_TAU - x[g]) + (y_TAU - y[g]) * (y_TAU - y[g]) + (z_TAU - z[g]) * (z_TAU - z[g]));
+                    double dist_NU_g = std::sqrt((x_NU - x[g]) * (x_NU - x[g]) + (y_NU - y[g]) * (y_NU - y[g]) + (z_NU - z[g]) * (z_NU - z[g]));
+                    double dist_decay = 1.0 / std::max(1.0, std::min(dist_TAU_g - shell_extents->get(TAU), dist_NU_g - shell_extents->get(NU)));
+
+                    k_bound = X_gmax[g] * esp_boundp[NU][TAU] * dist_decay * F_shell[g * ntau_shells + t];
+                    if (symm) k_bound = std::max(k_bound, X_gmax[g] * esp_boundp[TAU][NU] * dist_decay * F_shell[g * ntau_shells + u]);
+                    if (k_bound < kscreen_) continue;
+
+                    int_computers[rank]->set_origin({x[g], y[g], z[g]});
+                    int_computers[rank]->compute_shell(NU, TAU);
+                    int_shells_computed[rank]++;
+
+                    for (size_t jki = 0; jki < njk; jki++) {
+                        const double* Fp = F_block.data() + g * ldf + jki * ntau;
+                        double* Gp = G_block.data() + g * ldg + jki * nnu;
+                        for (size_t nu = 0, index = 0; nu < num_nu; nu++) {
+                            double G_nu = 0.0;
+                            for (size_t tau = 0; tau < num_tau; tau++, index++) {
+                                G_nu += int_buff[index] * Fp[tau_f + tau];
+                                if (symm) Gp[tau_g + tau] += int_buff[index] * Fp[nu_f + nu];
+                            }
+                            Gp[nu_g + nu] += G_nu;
+                        }
+                    }
+                }
+            }
+        }
+
+        // fold in the quadrature weights
+        for (size_t g = 0; g < npoints; g++) {
+            C_DSCAL(ldg, w[g], G_block.data() + g * ldg, 1);
+        }
+
+        // => K Matrix <= //
+        std::vector<double> K_block(nbf_block * ldg);
+        C_DGEMM('T', 'N', nbf_block, ldg, npoints, 1.0, phip[0], phi_ld, G_block.data(), ldg, 0.0, K_block.data(), ldg);
+
+        for (size_t jki = 0; jki < njk; jki++) {
+            auto KTp = KT[jki][rank]->pointer();
+            for (size_t k = 0; k < nbf_block; k++) {
+                const double* K_blockp = K_block.data() + k * ldg + jki * nnu;
+                for (int NU : nu_shells) {
+                    size_t nu_start = primary_->shell(NU).function_index();
+                    size_t num_nu = primary_->shell(NU).nfunction();
+                    for (size_t nu = 0; nu < num_nu; nu++) {
+                        KTp[bf_map[k]][nu_start + nu] += K_blockp[nu_offset[NU] + nu];
+                    }
+                }
+            }
+        }
+
+        // reset the per-thread offset maps for the next block
+        for (int TAU : tau_shells) tau_offset[TAU] = -1;
+        for (int NU : nu_shells) nu_offset[NU] = -1;
+    });
+
+    timer_off("snLinK: Native Grid Loop");
+
+    if (bench_) {
+        scheduler.print_statistics("snLinK");
+    }
+
+    // Reduce per-thread contributions
+    for (size_t jki = 0; jki < njk; jki++) {
+        for (size_t thread = 0; thread < nthreads_; thread++) {
+            K[jki]->add(KT[jki][thread]);
+        }
+        if (lr_symmetric_) {
+            K[jki]->hermitivitize();
+        }
+    }
+
+    num_computed_shells_ = std::accumulate(int_shells_computed.begin(), int_shells_computed.end(), size_t(0));
+}
+
 }  // namespace psi
@@ -0,0 +1,130 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2026 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#include "task_scheduler.h"
+
+#include "psi4/psi4-dec.h"
+#include "psi4/libmints/gshell.h"
+#include "psi4/libpsi4util/PsiOutStream.h"
+
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <utility>
+
+namespace psi {
+
+TaskScheduler::TaskScheduler(int nthread) : nthread_(std::max(nthread, 1)), ntask_(0), wall_time_(0.0) {
+    for (int thread = 0; thread < nthread_; thread++) {
+        queues_.push_back(std::make_unique<TaskQueue>());
+    }
+    scheduled_cost_.resize(nthread_, 0.0);
+    busy_time_.resize(nthread_, 0.0);
+    idle_time_.resize(nthread_, 0.0);
+    tasks_run_.resize(nthread_, 0);
+    tasks_stolen_.resize(nthread_, 0);
+}
+
+void TaskScheduler::schedule(const std::vector<double>& costs) {
+    for (auto& queue : queues_) queue->tasks.clear();
+    std::fill(scheduled_cost_.begin(), scheduled_cost_.end(), 0.0);
+
+    // Most expensive tasks first
+    std::vector<size_t> order;
+    for (size_t task = 0; task < costs.size(); task++) {
+        if (costs[task] > 0.0) order.push_back(task);
+    }
+    std::stable_sort(order.begin(), order.end(), [&costs](size_t a, size_t b) { return costs[a] > costs[b]; });
+    ntask_ = order.size();
+
+    // Deal each task to the currently least loaded thread
+    using Load = std::pair<double, int>;
+    std::priority_queue<Load, std::vector<Load>, std::greater<Load>> loads;
+    for (int thread = 0; thread < nthread_; thread++) loads.emplace(0.0, thread);
+
+    for (size_t task : order) {
+        auto [load, thread] = loads.top();
+        loads.pop();
+        queues_[thread]->tasks.push_back(task);
+        scheduled_cost_[thread] = load + costs[task];
+        loads.emplace(scheduled_cost_[thread], thread);
+    }
+}
+
+bool TaskScheduler::next_task(int thread, size_t& task) {
+    {
+        auto& own = *queues_[thread];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (!own.tasks.empty()) {
+            task = own.tasks.front();
+            own.tasks.pop_front();
+            tasks_run_[thread]++;
+            return true;
+        }
+    }
+
+    for (int offset = 1; offset < nthread_; offset++) {
+        auto& victim = *queues_[(thread + offset) % nthread_];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.back();
+            victim.tasks.pop_back();
+            tasks_run_[thread]++;
+            tasks_stolen_[thread]++;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void TaskScheduler::print_statistics(const std::string& name) const {
+    double busy_total = std::accumulate(busy_time_.begin(), busy_time_.end(), 0.0);
+    double busy_max = *std::max_element(busy_time_.begin(), busy_time_.end());
+    double busy_mean = busy_total / nthread_;
+
+    outfile->Printf("  ==> %s: Task Scheduler Statistics <==\n\n", name.c_str());
+    outfile->Printf("    Tasks:             %11zu\n", ntask_);
+    outfile->Printf("    Wall Time [s]:     %11.3f\n", wall_time_);
+    outfile->Printf("    Load Imbalance:    %11.3f\n", (busy_mean > 0.0 ? busy_max / busy_mean : 1.0));
+    outfile->Printf("\n");
+    outfile->Printf("    %6s %10s %10s %10s %8s %8s\n", "Thread", "Est. Cost", "Busy [s]", "Idle [s]", "Tasks", "Stolen");
+    for (int thread = 0; thread < nthread_; thread++) {
+        outfile->Printf("    %6d %10.3E %10.3f %10.3f %8zu %8zu\n", thread, scheduled_cost_[thread], busy_time_[thread],
+                        idle_time_[thread], tasks_run_[thread], tasks_stolen_[thread]);
+    }
+    outfile->Printf("\n");
+}
+
+double TaskScheduler::shell_pair_cost(const GaussianShell& P, const GaussianShell& Q) {
+    double nfunction = (double)P.nfunction() * Q.nfunction();
+    double nprimitive = (double)P.nprimitive() * Q.nprimitive();
+    return nfunction * nprimitive * (1.0 + P.am() + Q.am());
+}
+
+}  // namespace psi
@@ -0,0 +1,178 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2026 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#ifndef libfock_task_scheduler_H
+#define libfock_task_scheduler_H
+
+#include "psi4/pragma.h"
+#include "psi4/libpsi4util/libpsi4util.h"
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace psi {
+
+class GaussianShell;
+
+/**
+ * Class TaskScheduler
+ *
+ * Cost-model-driven work-stealing scheduler for the integral loops
+ * of the JK/SplitJK backends.
+ *
+ * The caller supplies an estimated cost for every task (see
+ * shell_pair_cost for the integral cost model). Tasks are sorted by
+ * decreasing cost and dealt out, largest first, to the thread with the
+ * smallest accumulated cost (LPT binning), which gives every thread a
+ * double-ended queue ordered from expensive to cheap. Each thread works
+ * from the front of its own queue; once it runs dry it steals from the
+ * back of the other queues, so the cheap tail of the task list is what
+ * gets redistributed to balance out a poor cost estimate.
+ *
+ * Per-thread busy/idle time and task counts are recorded for every
+ * run() and can be printed with print_statistics().
+ *
+ * Usage:
+ * \code
+ *      TaskScheduler scheduler(nthread);
+ *      scheduler.schedule(costs);
+ *      scheduler.run([&](size_t task, int thread) {
+ *          // work on task with thread-private buffers [thread]
+ *      });
+ *      if (bench_) scheduler.print_statistics("LinK");
+ * \endcode
+ */
+class PSI_API TaskScheduler {
+   protected:
+    /// A thread's task queue, padded to avoid false sharing between the locks
+    struct alignas(64) TaskQueue {
+        std::mutex lock;
+        std::deque<size_t> tasks;
+    };
+
+    /// Number of threads tasks are distributed to
+    int nthread_;
+    /// Total number of scheduled tasks
+    size_t ntask_;
+    /// Per-thread task queues
+    std::vector<std::unique_ptr<TaskQueue>> queues_;
+
+    /// Estimated cost dealt to each thread by schedule()
+    std::vector<double> scheduled_cost_;
+    /// Time each thread spent inside task bodies in the last run() [s]
+    std::vector<double> busy_time_;
+    /// Time each thread spent outside task bodies in the last run() [s]
+    std::vector<double> idle_time_;
+    /// Number of tasks each thread ran in the last run()
+    std::vector<size_t> tasks_run_;
+    /// Number of those tasks that were stolen from another thread's queue
+    std::vector<size_t> tasks_stolen_;
+    /// Wall time of the last run() [s]
+    double wall_time_;
+
+    /// Pop the next task for this thread, stealing if its own queue is empty. False if no work is left.
+    bool next_task(int thread, size_t& task);
+
+   public:
+    /// @param nthread number of OpenMP threads run() will use
+    TaskScheduler(int nthread);
+
+    /**
+     * Distribute tasks over the thread queues
+     *
+     * @param costs estimated relative cost of each task, indexed by task.
+     *        Tasks with a cost of zero are known to do no work and are dropped.
+     */
+    void schedule(const std::vector<double>& costs);
+
+    /**
+     * Run every scheduled task exactly once on nthread OpenMP threads
+     *
+     * @param body callable as body(size_t task, int thread); thread is the
+     *        OpenMP thread number, for indexing thread-private buffers
+     */
+    template <typename Body>
+    void run(Body&& body) {
+        std::fill(busy_time_.begin(), busy_time_.end(), 0.0);
+        std::fill(idle_time_.begin(), idle_time_.end(), 0.0);
+        std::fill(tasks_run_.begin(), tasks_run_.end(), 0);
+        std::fill(tasks_stolen_.begin(), tasks_stolen_.end(), 0);
+
+        Timer wall;
+#pragma omp parallel num_threads(nthread_)
+        {
+            int thread = 0;
+#ifdef _OPENMP
+            thread = omp_get_thread_num();
+#endif
+            double busy = 0.0;
+            size_t task;
+            while (next_task(thread, task)) {
+                Timer task_timer;
+                body(task, thread);
+                busy += task_timer.get();
+            }
+            busy_time_[thread] = busy;
+        }
+        wall_time_ = wall.get();
+
+        for (int thread = 0; thread < nthread_; thread++) {
+            idle_time_[thread] = wall_time_ - busy_time_[thread];
+        }
+    }
+
+    /// Print per-thread busy/idle statistics of the last run() to the outfile
+    void print_statistics(const std::string& name) const;
+
+    // => Cost Model <= //
+
+    /**
+     * Estimated relative cost of a shell pair (PQ| in an ERI.
+     * Scales with the number of functions and primitive pairs,
+     * with an extra factor for the recursion depth in total angular momentum.
+     */
+    static double shell_pair_cost(const GaussianShell& P, const GaussianShell& Q);
+
+    // => Accessors <= //
+
+    int nthread() const { return nthread_; }
+    size_t ntask() const { return ntask_; }
+    const std::vector<double>& busy_time() const { return busy_time_; }
+    const std::vector<double>& idle_time() const { return idle_time_; }
+};
+
+}  // namespace psi
+
+#endif
@@ -0,0 +1,141 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2026 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#ifndef libfock_thread_reduction_H
+#define libfock_thread_reduction_H
+
+#include "psi4/libmints/matrix.h"
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+namespace psi {
+
+/*
+ * Helpers for the JK_ACCUMULATION = THREAD mode of the integral-direct
+ * J/K builders. Instead of pushing every contribution into the shared
+ * J/K matrices with omp atomic updates, each thread owns a full copy of
+ * the output matrices, writes into it without synchronization, and the
+ * copies are summed pairwise in a tree after the task loop.
+ *
+ * The copies live for the whole build, so they cost nthread x nmat x nbf^2
+ * doubles, which the memory estimates of DirectJK and CompositeJK (LinK)
+ * include. Flushing tiles of the copies after each task batch would bound
+ * this, but needs a reduction per batch; at O(N^2) per thread the full
+ * copies are kept instead.
+ */
+
+/// Add value to target, with an omp atomic update if other threads may touch target at the same time.
+/// atomic is a template parameter so that the stripe-out loops are compiled once per mode without a branch.
+template <bool atomic>
+inline void stripe_add(double& target, double value) {
+    if constexpr (atomic) {
+#pragma omp atomic
+        target += value;
+    } else {
+        target += value;
+    }
+}
+
+/**
+ * Allocate one zeroed copy of every matrix in targets per thread
+ *
+ * @param targets the shared output matrices
+ * @param nthread number of threads that will accumulate into the copies
+ * @return buffers[thread][ind], same shape as targets[ind]
+ */
+inline std::vector<std::vector<SharedMatrix>> thread_private_copies(const std::vector<SharedMatrix>& targets,
+                                                                    int nthread) {
+    std::vector<std::vector<SharedMatrix>> buffers(nthread);
+    for (int thread = 0; thread < nthread; thread++) {
+        for (const auto& target : targets) {
+            buffers[thread].push_back(std::make_shared<Matrix>(target->name() + " (thread)", target->rowspi(),
+                                                               target->colspi(), target->symmetry()));
+        }
+    }
+    return buffers;
+}
+
+/**
+ * Sum thread-private buffers into targets with a pairwise tree reduction
+ *
+ * Level k adds buffer t + 2^k into buffer t for every t that is a multiple
+ * of 2^(k+1). Each level is split into contiguous row chunks so that all
+ * threads stay busy even when only one pair is left. The buffers are
+ * overwritten; buffers[0] holds the full sum on exit, which is then added
+ * (not assigned) to targets, so incremental builds keep working.
+ *
+ * @param buffers buffers[thread][ind], as made by thread_private_copies
+ * @param targets the shared output matrices, targets[ind] += sum_t buffers[t][ind]
+ * @param nthread number of threads to use for the reduction
+ */
+inline void tree_reduce_thread_buffers(std::vector<std::vector<SharedMatrix>>& buffers,
+                                       std::vector<SharedMatrix>& targets, int nthread) {
+    size_t nbuffer = buffers.size();
+    if (nbuffer == 0) return;
+
+    // Rows are reduced in chunks of this many doubles to keep each piece of work in cache
+    const size_t chunk = 4096;
+
+    for (size_t ind = 0; ind < targets.size(); ind++) {
+        for (int h = 0; h < targets[ind]->nirrep(); h++) {
+            size_t size = (size_t)targets[ind]->rowspi()[h] * targets[ind]->colspi()[h ^ targets[ind]->symmetry()];
+            if (size == 0) continue;
+            size_t nchunk = (size + chunk - 1) / chunk;
+
+            for (size_t stride = 1; stride < nbuffer; stride *= 2) {
+                size_t npair = (nbuffer + 2 * stride - 1) / (2 * stride);
+#pragma omp parallel for num_threads(nthread) schedule(static)
+                for (size_t work = 0; work < npair * nchunk; work++) {
+                    size_t left = (work / nchunk) * 2 * stride;
+                    size_t right = left + stride;
+                    if (right >= nbuffer) continue;
+                    size_t start = (work % nchunk) * chunk;
+                    size_t stop = std::min(size, start + chunk);
+                    double* Lp = buffers[left][ind]->pointer(h)[0];
+                    const double* Rp = buffers[right][ind]->pointer(h)[0];
+                    for (size_t i = start; i < stop; i++) {
+                        Lp[i] += Rp[i];
+                    }
+                }
+            }
+
+            double* Tp = targets[ind]->pointer(h)[0];
+            const double* Bp = buffers[0][ind]->pointer(h)[0];
+#pragma omp parallel for num_threads(nthread) schedule(static)
+            for (size_t i = 0; i < size; i++) {
+                Tp[i] += Bp[i];
+            }
+        }
+    }
+}
+
+}  // namespace psi
+
+#endif
@@ -92,6 +92,20 @@ extern bool brianBuildingNLCGrid;
 
 namespace psi {
 
+namespace {
+/**
+ * Number of trial densities (or alpha/beta pairs, with ncomponents = 2)
+ * whose Vx are built together on a block by compute_Vx. The batch scratch
+ * of each thread, ncomponents * nbatch * max_functions * (max_points +
+ * max_functions) doubles, is kept below 64 MiB.
+ */
+size_t vx_batch_size(size_t ndensities, int max_points, int max_functions, size_t ncomponents = 1) {
+    size_t per_density = ncomponents * sizeof(double) * max_functions * (max_points + max_functions);
+    size_t nbatch = (64L * 1024L * 1024L) / std::max<size_t>(per_density, 1);
+    return std::max<size_t>(1, std::min(ndensities, nbatch));
+}
+}  // namespace
+
 VBase::VBase(std::shared_ptr<SuperFunctional> functional, std::shared_ptr<BasisSet> primary, Options& options)
     : options_(options), primary_(primary), functional_(functional) {
     common_init();
@@ -110,7 +124,9 @@ void VBase::common_init() {
     }
     vv10_rho_cutoff_ = options_.get_double("DFT_VV10_RHO_CUTOFF");
     grac_initialized_ = false;
-    cache_map_deriv_ = -1;
+    mixed_precision_ = false;
+    block_density_tolerance_ = options_.get_double("DFT_BLOCK_DENSITY_TOLERANCE");
+    nblocks_skipped_ = 0;
     num_threads_ = 1;
 #ifdef _OPENMP
     num_threads_ = omp_get_max_threads();
@@ -176,6 +192,8 @@ void VBase::set_D(std::vector<SharedMatrix> Dvec) {
 void VBase::initialize() {
     timer_on("V: Grid");
     grid_ = std::make_shared<DFTGrid>(primary_->molecule(), primary_, options_);
+    grid_tiles_ = std::make_shared<ShellPairTiles::Pattern>(primary_, grid_->blocks());
+    if (block_density_tolerance_ > 0.0) build_block_bounds();
     timer_off("V: Grid");
 
     for (size_t i = 0; i < num_threads_; i++) {
@@ -678,9 +696,12 @@ void VBase::compute_V(std::vector<SharedMatrix> ret) {
 void VBase::compute_Vx(std::vector<SharedMatrix> Dx, std::vector<SharedMatrix> ret) {
     throw PSIEXCEPTION("VBase: deriv not implemented for this Vx instance.");
 }
-std::vector<SharedMatrix> VBase::compute_fock_derivatives() {
+std::vector<SharedMatrix> VBase::compute_fock_derivatives(int first_atom, int natom_batch) {
     throw PSIEXCEPTION("VBase: compute_fock_derivatives not implemented for this Vx instance.");
 }
+std::vector<SharedMatrix> VBase::compute_fock_derivatives() {
+    return compute_fock_derivatives(0, primary_->molecule()->natom());
+}
 void VBase::set_grac_shift(double grac_shift) {
     // Well this is a flaw in my plan
     if (!grac_initialized_) {
@@ -730,83 +751,207 @@ void VBase::print_header() const {
     functional_->print("outfile", print_);
     grid_->print("outfile", print_);
     if (print_ > 2) grid_->print_details("outfile", print_);
+    if (options_.get_bool("DFT_MIXED_PRECISION")) {
+        outfile->Printf("  ==> Mixed Precision <==\n\n");
+        outfile->Printf("    Grid GEMMs in single precision until the DIIS error drops below %11.3E\n\n",
+                        options_.get_double("DFT_MIXED_PRECISION_SWITCH"));
+    }
+    if (block_density_tolerance_ > 0.0) {
+        outfile->Printf("  ==> Block Density Screening <==\n\n");
+        outfile->Printf("    Blocks with density and gradient bounds below %11.3E are skipped\n\n",
+                        block_density_tolerance_);
+    }
 }
 std::shared_ptr<BlockOPoints> VBase::get_block(int block) { return grid_->blocks()[block]; }
 size_t VBase::nblocks() { return grid_->blocks().size(); }
-void VBase::finalize() { grid_.reset(); }
-void VBase::build_collocation_cache(size_t memory) {
-    // Figure out many blocks to skip
+void VBase::finalize() {
+    grid_.reset();
+    grid_tiles_.reset();
+    block_bound_start_.clear();
+    block_phi_bound_.clear();
+    block_grad_bound_.clear();
+}
+void VBase::build_block_bounds() {
+    // Same model as BasisExtents, |phi|_P(r) <= sum_k |C_k| r^l exp(-a_k r^2), and for the gradient
+    // |grad phi|_P(r) <= sum_k |C_k| (l r^(l-1) + 2 a_k r^(l+1)) exp(-a_k r^2). Each of these terms peaks
+    // once in r, so its largest value on a block is at the closest approach d of the block's bounding sphere
+    // to the shell center, or at the peak itself if that is further out.
+    // The angular part of a Cartesian component obeys |x^a y^b z^c| <= r^l and |grad x^a y^b z^c| <= l r^(l-1).
+    // A pure function is a solid-harmonic combination of those components, so both bounds pick up the largest
+    // absolute coefficient sum over its rows of the Cartesian-to-pure transform.
+    std::vector<double> pure_factor(primary_->max_am() + 1, 1.0);
+    for (int l = 2; l <= primary_->max_am(); l++) {
+        SphericalTransform trans(l);
+        std::vector<double> row_sum(2 * l + 1, 0.0);
+        for (int i = 0; i < trans.n(); i++) row_sum[trans.pureindex(i)] += std::fabs(trans.coef(i));
+        pure_factor[l] = std::max(1.0, *std::max_element(row_sum.begin(), row_sum.end()));
+    }
 
-    size_t collocation_size = grid_->collocation_size();
-    if (functional_->ansatz() == 1) {
-        collocation_size *= 4;  // For gradients
+    const auto& blocks = grid_->blocks();
+    block_bound_start_.assign(blocks.size() + 1, 0);
+    for (size_t Q = 0; Q < blocks.size(); Q++) {
+        block_bound_start_[Q + 1] = block_bound_start_[Q] + blocks[Q]->shells_local_to_global().size();
     }
-    if (functional_->ansatz() == 2) {
-        collocation_size *= 10;  // For gradients and Hessians
+    block_phi_bound_.assign(block_bound_start_.back(), 0.0);
+    block_grad_bound_.assign(block_bound_start_.back(), 0.0);
+
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads_)
+    for (size_t Q = 0; Q < blocks.size(); Q++) {
+        const auto& block = blocks[Q];
+        Vector3 xc = block->center();
+        double R = block->radius();
+        const auto& shells = block->shells_local_to_global();
+        double* phi_bound = &block_phi_bound_[block_bound_start_[Q]];
+        double* grad_bound = &block_grad_bound_[block_bound_start_[Q]];
+        for (size_t Pl = 0; Pl < shells.size(); Pl++) {
+            const GaussianShell& Pshell = primary_->shell(shells[Pl]);
+            Vector3 v = Pshell.center();
+            double d = std::max(0.0, v.distance(xc) - R);
+            int l = Pshell.am();
+            const double* alpha = Pshell.exps();
+            const double* norm = Pshell.coefs();
+            double phi = 0.0;
+            double grad = 0.0;
+            for (int K = 0; K < Pshell.nprimitive(); K++) {
+                double a = alpha[K];
+                double c = std::fabs(norm[K]);
+                double r0 = std::max(d, std::sqrt(l / (2.0 * a)));
+                phi += c * std::pow(r0, l) * std::exp(-a * r0 * r0);
+                double r1 = std::max(d, std::sqrt((l + 1) / (2.0 * a)));
+                grad += c * 2.0 * a * std::pow(r1, l + 1) * std::exp(-a * r1 * r1);
+                if (l > 0) {
+                    double r2 = std::max(d, std::sqrt((l - 1) / (2.0 * a)));
+                    grad += c * l * std::pow(r2, l - 1) * std::exp(-a * r2 * r2);
+                }
+            }
+            double angular = (Pshell.is_pure() ? pure_factor[l] : 1.0);
+            phi_bound[Pl] = angular * phi;
+            grad_bound[Pl] = angular * grad;
+        }
+    }
+}
+std::vector<char> VBase::screen_blocks(const std::vector<SharedMatrix>& D, double scale) {
+    const auto& blocks = grid_->blocks();
+    std::vector<char> active(blocks.size(), 1);
+    nblocks_skipped_ = 0;
+    if (block_density_tolerance_ <= 0.0 || block_bound_start_.size() != blocks.size() + 1) return active;
+
+    // Shell-pair norms sum_{m in P, n in Q} |D_mn| of the spin-summed density
+    int nshell = primary_->nshell();
+    std::vector<double> D_shell(static_cast<size_t>(nshell) * nshell, 0.0);
+    for (const auto& Dspin : D) {
+        double** Dp = Dspin->pointer();
+        for (int P = 0; P < nshell; P++) {
+            int p0 = primary_->shell(P).function_index();
+            int np = primary_->shell(P).nfunction();
+            for (int Q = 0; Q < nshell; Q++) {
+                int q0 = primary_->shell(Q).function_index();
+                int nq = primary_->shell(Q).nfunction();
+                double sum = 0.0;
+                for (int p = p0; p < p0 + np; p++) {
+                    for (int q = q0; q < q0 + nq; q++) {
+                        sum += std::fabs(Dp[p][q]);
+                    }
+                }
+                D_shell[static_cast<size_t>(P) * nshell + Q] += scale * sum;
+            }
+        }
     }
 
-    // Figure out stride as closest whole number to amount we need
-    size_t stride = (size_t)(std::ceil(collocation_size / (double)memory));
+    // |rho| <= sum_PQ |D|_PQ |phi|_P |phi|_Q and |grad rho| <= 2 sum_PQ |D|_PQ |grad phi|_P |phi|_Q
+    size_t nskipped = 0;
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads_) reduction(+ : nskipped)
+    for (size_t Q = 0; Q < blocks.size(); Q++) {
+        const auto& shells = blocks[Q]->shells_local_to_global();
+        const double* phi_bound = &block_phi_bound_[block_bound_start_[Q]];
+        const double* grad_bound = &block_grad_bound_[block_bound_start_[Q]];
+        double rho = 0.0;
+        double rho_grad = 0.0;
+        for (size_t Pl = 0; Pl < shells.size(); Pl++) {
+            const double* D_row = &D_shell[static_cast<size_t>(shells[Pl]) * nshell];
+            double T = 0.0;
+            for (size_t Ql = 0; Ql < shells.size(); Ql++) {
+                T += D_row[shells[Ql]] * phi_bound[Ql];
+            }
+            rho += phi_bound[Pl] * T;
+            rho_grad += 2.0 * grad_bound[Pl] * T;
+        }
+        if (rho < block_density_tolerance_ && rho_grad < block_density_tolerance_) {
+            active[Q] = 0;
+            nskipped++;
+        }
+    }
+    nblocks_skipped_ = nskipped;
 
-    // More memory than needed
-    if (stride == 0) {
-        stride = 1;
+    if (debug_) {
+        outfile->Printf("    XC density screening: %zu of %zu blocks skipped\n", nblocks_skipped_, blocks.size());
     }
-    cache_map_.clear();
+    return active;
+}
+void VBase::build_collocation_cache(size_t memory) {
+    collocation_cache_.clear();
 
-    // Effectively zero blocks saved.
-    if (stride > grid_->blocks().size()) {
-        return;
+    const auto& blocks = grid_->blocks();
+    auto precision = (options_.get_str("DFT_COLLOCATION_CACHE_PRECISION") == "FLOAT"
+                          ? CollocationCache::Precision::Float
+                          : CollocationCache::Precision::Double);
+    double cutoff = options_.get_double("DFT_COLLOCATION_CACHE_CUTOFF");
+
+    // PHI plus all of its derivatives up to deriv
+    int deriv = point_workers_[0]->deriv();
+    size_t ncomponents = (deriv + 1) * (deriv + 2) * (deriv + 3) / 6;
+
+    // The blocks with the most local functions are the most expensive to recompute, cache them first
+    std::vector<size_t> order(blocks.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        if (blocks[a]->local_nbf() != blocks[b]->local_nbf()) return blocks[a]->local_nbf() > blocks[b]->local_nbf();
+        return blocks[a]->npoints() > blocks[b]->npoints();
+    });
+
+    // The arena never needs more than the dense size of every block
+    size_t needed = 0;
+    for (const auto& block : blocks) {
+        needed += CollocationCache::block_size(block->npoints(), block->local_nbf(), ncomponents, precision);
     }
+    size_t capacity = std::min(needed, memory * sizeof(double));
+    if (capacity == 0) return;
+    collocation_cache_.reset(capacity, precision, cutoff);
 
-    cache_map_deriv_ = point_workers_[0]->deriv();
-    auto saved_size_rank = std::vector<size_t>(num_threads_, 0);
     auto ncomputed_rank = std::vector<size_t>(num_threads_, 0);
 
 // Loop over the blocks
-#pragma omp parallel for schedule(guided) num_threads(num_threads_)
-    for (size_t Q = 0; Q < grid_->blocks().size(); Q += stride) {
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads_)
+    for (size_t ind = 0; ind < order.size(); ind++) {
         // Get thread info
         int rank = 0;
 #ifdef _OPENMP
         rank = omp_get_thread_num();
 #endif
 
-        // Compute a collocation block
-        std::shared_ptr<BlockOPoints> block = grid_->blocks()[Q];
-        std::shared_ptr<PointFunctions> pworker = point_workers_[rank];
-        pworker->compute_functions(block);
-
-        // Build temps
+        std::shared_ptr<BlockOPoints> block = blocks[order[ind]];
         size_t nrows = block->npoints();
         size_t ncols = block->local_nbf();
-        std::map<std::string, SharedMatrix> collocation_map;
-
-        // Loop over components PHI, PHI_X, PHI_Y, ...
-        for (auto& kv : pworker->basis_values()) {
-            auto coll = std::make_shared<Matrix>(kv.second->name(), nrows, ncols);
 
-            double** sourcep = kv.second->pointer();
-            double** collp = coll->pointer();
+        // Without screening the stored size is known up front, skip blocks that cannot fit
+        if (cutoff == 0.0 && CollocationCache::block_size(nrows, ncols, ncomponents, precision) >
+                                 collocation_cache_.capacity() - collocation_cache_.used()) {
+            continue;
+        }
 
-            // Matrices are packed in a upper left rectangle, cannot use pure DCOPY
-            for (size_t i = 0; i < nrows; i++) {
-                C_DCOPY(ncols, sourcep[i], 1, collp[i], 1);
-            }
-            collocation_map[kv.first] = coll;
+        // Compute a collocation block
+        std::shared_ptr<PointFunctions> pworker = point_workers_[rank];
+        pworker->compute_functions(block);
 
-            saved_size_rank[rank] += nrows * ncols;
+        if (collocation_cache_.store(block->index(), nrows, ncols, pworker->BasisFunctions::basis_values())) {
+            ncomputed_rank[rank]++;
         }
-        ncomputed_rank[rank]++;
-#pragma omp critical
-        cache_map_[block->index()] = collocation_map;
     }
 
-    size_t saved_size = std::accumulate(saved_size_rank.begin(), saved_size_rank.end(), 0.0);
     size_t ncomputed = std::accumulate(ncomputed_rank.begin(), ncomputed_rank.end(), 0.0);
 
-    double gib_saved = 8.0 * (double)saved_size / 1024.0 / 1024.0 / 1024.0;
-    double fraction = (double)ncomputed / grid_->blocks().size() * 100;
+    double gib_saved = (double)collocation_cache_.used() / 1024.0 / 1024.0 / 1024.0;
+    double fraction = (double)ncomputed / blocks.size() * 100;
     if (print_) {
         outfile->Printf("  Cached %.1lf%% of DFT collocation blocks in %.3lf [GiB].\n\n", fraction, gib_saved);
     }
@@ -913,7 +1058,7 @@ double VBase::vv10_nlc(SharedMatrix D, SharedMatrix ret) {
     // => Setup info <=
     int rank = 0;
     const int max_functions = nlgrid.max_functions();
-    double** Vp = ret->pointer();
+    ShellPairTiles V_tiles(std::make_shared<ShellPairTiles::Pattern>(primary_, nlgrid.blocks()));
 
     // VV10 temps
     std::vector<double> vv10_exc(num_threads_);
@@ -954,24 +1099,10 @@ double VBase::vv10_nlc(SharedMatrix D, SharedMatrix ret) {
         dft_integrators::rks_integrator(block, fworker, pworker, V_local[rank], 1);
 
         // => Unpacking <= //
-        const std::vector<int>& function_map = block->functions_local_to_global();
-        int nlocal = function_map.size();
-        double** V2p = V_local[rank]->pointer();
-
-        for (int ml = 0; ml < nlocal; ml++) {
-            int mg = function_map[ml];
-            for (int nl = 0; nl < ml; nl++) {
-                int ng = function_map[nl];
-#pragma omp atomic update
-                Vp[mg][ng] += V2p[ml][nl];
-#pragma omp atomic update
-                Vp[ng][mg] += V2p[ml][nl];
-            }
-#pragma omp atomic update
-            Vp[mg][mg] += V2p[ml][ml];
-        }
+        V_tiles.add(*block, V_local[rank]->pointer()[0], max_functions);
         parallel_timer_off("VV10 Fock", rank);
     }
+    V_tiles.merge(ret);
 
     double vv10_e = std::accumulate(vv10_exc.begin(), vv10_exc.end(), 0.0);
     timer_off("V: VV10");
@@ -1103,7 +1234,7 @@ void SAP::initialize() {
         auto point_tmp = std::make_shared<SAPFunctions>(primary_, max_points, max_functions);
         // This is like LDA
         point_tmp->set_ansatz(0);
-        point_tmp->set_cache_map(&cache_map_);
+        point_tmp->set_collocation_cache(&collocation_cache_);
         point_workers_.push_back(point_tmp);
     }
 
@@ -1141,7 +1272,7 @@ void SAP::compute_V(std::vector<SharedMatrix> ret) {
     }
 
     auto V_AO = std::make_shared<Matrix>("V AO Temp", nbf_, nbf_);
-    double** Vp = V_AO->pointer();
+    ShellPairTiles V_tiles(grid_tiles_);
 
     // Nuclear coordinates
     std::vector<double> nucx, nucy, nucz, nucZ;
@@ -1213,24 +1344,10 @@ void SAP::compute_V(std::vector<SharedMatrix> ret) {
         dft_integrators::sap_integrator(block, sap_potential, pworker, V_local[rank]);
 
         // => Unpacking <= //
-        double** V2p = V_local[rank]->pointer();
-        const std::vector<int>& function_map = block->functions_local_to_global();
-        int nlocal = function_map.size();
-
-        for (int ml = 0; ml < nlocal; ml++) {
-            int mg = function_map[ml];
-            for (int nl = 0; nl < ml; nl++) {
-                int ng = function_map[nl];
-#pragma omp atomic update
-                Vp[mg][ng] += V2p[ml][nl];
-#pragma omp atomic update
-                Vp[ng][mg] += V2p[ml][nl];
-            }
-#pragma omp atomic update
-            Vp[mg][mg] += V2p[ml][ml];
-        }
+        V_tiles.add(*block, V_local[rank]->pointer()[0], max_functions);
         parallel_timer_off("V_xc", rank);
     }
+    V_tiles.merge(V_AO);
 
     // Set the result
     if (AO2USO_) {
@@ -1252,7 +1369,7 @@ void RV::initialize() {
         // Need a points worker per thread
         auto point_tmp = std::make_shared<RKSFunctions>(primary_, max_points, max_functions);
         point_tmp->set_ansatz(functional_->ansatz());
-        point_tmp->set_cache_map(&cache_map_);
+        point_tmp->set_collocation_cache(&collocation_cache_);
         point_workers_.push_back(point_tmp);
     }
 }
@@ -1306,9 +1423,10 @@ void RV::compute_V(std::vector<SharedMatrix> ret) {
     int max_functions = grid_->max_functions();
     int max_points = grid_->max_points();
 
-    // Setup the pointers
+    // Setup the pointers, the grid GEMMs are in single precision only while building V
     for (size_t i = 0; i < num_threads_; i++) {
         point_workers_[i]->set_pointers(D_AO_[0]);
+        point_workers_[i]->set_mixed_precision(mixed_precision_);
     }
 
     // Per thread temporaries
@@ -1318,7 +1436,7 @@ void RV::compute_V(std::vector<SharedMatrix> ret) {
     }
 
     auto V_AO = std::make_shared<Matrix>("V AO Temp", nbf_, nbf_);
-    auto Vp = V_AO->pointer();
+    ShellPairTiles V_tiles(grid_tiles_);
 
     std::vector<double> functionalq(num_threads_);
     std::vector<double> rhoaq(num_threads_);
@@ -1329,9 +1447,15 @@ void RV::compute_V(std::vector<SharedMatrix> ret) {
 // VV10 kernel data if requested
 
     // => Compute V <=
+    // Blocks whose density bound for the current D is below the tolerance.
+    // D_AO_ holds the alpha density only, so the total density is twice it.
+    auto block_active = screen_blocks(D_AO_, 2.0);
+
 // Traverse the blocks of points
 #pragma omp parallel for private(rank) schedule(guided) num_threads(num_threads_)
     for (size_t Q = 0; Q < grid_->blocks().size(); Q++) {
+        if (!block_active[Q]) continue;
+
         // ==> Define block/thread-specific variables <==
 #ifdef _OPENMP
         rank = omp_get_thread_num();
@@ -1371,24 +1495,14 @@ void RV::compute_V(std::vector<SharedMatrix> ret) {
         dft_integrators::rks_integrator(block, fworker, pworker, V_local[rank]);
 
         // ==> Unpacking <== //
-        auto V2p = V_local[rank]->pointer();
-        const auto& function_map = block->functions_local_to_global();
-        int nlocal = function_map.size();
-
-        for (int ml = 0; ml < nlocal; ml++) {
-            int mg = function_map[ml];
-            for (int nl = 0; nl < ml; nl++) {
-                int ng = function_map[nl];
-#pragma omp atomic update
-                Vp[mg][ng] += V2p[ml][nl];
-#pragma omp atomic update
-                Vp[ng][mg] += V2p[ml][nl];
-            }
-#pragma omp atomic update
-            Vp[mg][mg] += V2p[ml][ml];
-        }
+        V_tiles.add(*block, V_local[rank]->pointer()[0], max_functions);
         parallel_timer_off("V_xc", rank);
     }
+    V_tiles.merge(V_AO);
+
+    for (size_t i = 0; i < num_threads_; i++) {
+        point_workers_[i]->set_mixed_precision(false);
+    }
 
     // Do we need VV10?
     double vv10_e = 0.0;
@@ -1432,13 +1546,17 @@ void RV::compute_V(std::vector<SharedMatrix> ret) {
     timer_off("RV: Form V");
 }
 
-std::vector<SharedMatrix> RV::compute_fock_derivatives() {
+std::vector<SharedMatrix> RV::compute_fock_derivatives(int first_atom, int natom_batch) {
     timer_on("RV: Form Fx");
 
     int natoms = primary_->molecule()->natom();
-    std::vector<SharedMatrix> Vx(3*natoms);
-    for(int n = 0; n < 3*natoms; ++n)
-        Vx[n] = std::make_shared<Matrix>("Vx for Perturbation " + std::to_string(n), nbf_, nbf_);
+    if (first_atom < 0 || natom_batch < 0 || first_atom + natom_batch > natoms) {
+        throw PSIEXCEPTION("DFT Hessian: Fock derivative atom batch is out of range.");
+    }
+    int last_atom = first_atom + natom_batch;
+    std::vector<SharedMatrix> Vx(3*natom_batch);
+    for(int n = 0; n < 3*natom_batch; ++n)
+        Vx[n] = std::make_shared<Matrix>("Vx for Perturbation " + std::to_string(3*first_atom + n), nbf_, nbf_);
     if (D_AO_.size() != 1) {
         throw PSIEXCEPTION("DFT Hessian: RKS should have only one D Matrix");
     }
@@ -1477,12 +1595,6 @@ std::vector<SharedMatrix> RV::compute_fock_derivatives() {
         functional_workers_[i]->set_deriv(2);
         functional_workers_[i]->allocate();
     }
-    // Output quantities
-    std::vector<SharedMatrix> Vx_AO;
-    for (size_t i = 0; i < 3*natoms; i++) {
-        Vx_AO.push_back(std::make_shared<Matrix>("Vx AO Temp", nbf_, nbf_));
-    }
-
 // Traverse the blocks of points
 #pragma omp parallel for private(rank) schedule(guided) num_threads(num_threads_)
     for (size_t Q = 0; Q < grid_->blocks().size(); Q++) {
@@ -1533,7 +1645,7 @@ std::vector<SharedMatrix> RV::compute_fock_derivatives() {
             }
         }
         size_t coll_funcs = pworker->basis_value("PHI")->ncol();
-        for(int atom = 0; atom < primary_->molecule()->natom(); ++atom){
+        for(int atom = first_atom; atom < last_atom; ++atom){
             // Find first and last basis functions on this atom, from the subset of bfs being handled by this block of points
             auto first_func_iter = std::find_if(function_map.begin(), function_map.end(), [&](int i) {return primary_->function_to_center(i) == atom;});
             if(first_func_iter == function_map.end()) continue;
@@ -1570,7 +1682,7 @@ std::vector<SharedMatrix> RV::compute_fock_derivatives() {
             //         |  /
             C_DGEMM('T', 'N', nlocal, nlocal, npoints, 1.0, Tp[0], max_functions, phi[0], coll_funcs, 0.0, Vx_localp[0], max_functions);
             // => Accumulate the result <= //
-            double **Vxp = Vx[3*atom + 0]->pointer();
+            double **Vxp = Vx[3*(atom - first_atom) + 0]->pointer();
             for (int ml = 0; ml < nlocal; ml++) {
                 int mg = function_map[ml];
                 for (int nl = 0; nl < nlocal; nl++) {
@@ -1609,7 +1721,7 @@ std::vector<SharedMatrix> RV::compute_fock_derivatives() {
             //         |  /
             C_DGEMM('T', 'N', nlocal, nlocal, npoints, 1.0, Tp[0], max_functions, phi[0], coll_funcs, 0.0, Vx_localp[0], max_functions);
             // => Accumulate the result <= //
-            double **Vyp = Vx[3*atom + 1]->pointer();
+            double **Vyp = Vx[3*(atom - first_atom) + 1]->pointer();
             for (int ml = 0; ml < nlocal; ml++) {
                 int mg = function_map[ml];
                 for (int nl = 0; nl < nlocal; nl++) {
@@ -1648,7 +1760,7 @@ std::vector<SharedMatrix> RV::compute_fock_derivatives() {
             //         |  /
             C_DGEMM('T', 'N', nlocal, nlocal, npoints, 1.0, Tp[0], max_functions, phi[0], coll_funcs, 0.0, Vx_localp[0], max_functions);
             // => Accumulate the result <= //
-            double **Vzp = Vx[3*atom + 2]->pointer();
+            double **Vzp = Vx[3*(atom - first_atom) + 2]->pointer();
             for (int ml = 0; ml < nlocal; ml++) {
                 int mg = function_map[ml];
                 for (int nl = 0; nl < nlocal; nl++) {
@@ -1721,12 +1833,15 @@ void RV::compute_Vx_full(std::vector<SharedMatrix> Dx, std::vector<SharedMatrix>
         }
     }
 
+    // Trial densities handled together on a block
+    auto nbatch = vx_batch_size(Dx_vec.size(), max_points, max_functions);
+
     // Per [R]ank quantities
-    std::vector<SharedMatrix> R_Vx_local, R_Dx_local;
+    std::vector<SharedMatrix> R_S_batch, R_T_batch;
     std::vector<std::shared_ptr<Vector>> R_rho_k, R_rho_k_x, R_rho_k_y, R_rho_k_z, R_gamma_k;
     for (size_t i = 0; i < num_threads_; i++) {
-        R_Vx_local.push_back(std::make_shared<Matrix>("Vx Temp", max_functions, max_functions));
-        R_Dx_local.push_back(std::make_shared<Matrix>("Dk Temp", max_functions, max_functions));
+        R_S_batch.push_back(std::make_shared<Matrix>("Dk/Vx Batch Temp", max_functions, nbatch * max_functions));
+        R_T_batch.push_back(std::make_shared<Matrix>("T Batch Temp", max_points, nbatch * max_functions));
 
         R_rho_k.push_back(std::make_shared<Vector>("Rho K Temp", max_points));
 
@@ -1743,8 +1858,10 @@ void RV::compute_Vx_full(std::vector<SharedMatrix> Dx, std::vector<SharedMatrix>
 
     // Output quantities
     std::vector<SharedMatrix> Vx_AO;
+    std::vector<std::shared_ptr<ShellPairTiles>> Vx_tiles;
     for (size_t i = 0; i < Dx.size(); i++) {
         Vx_AO.push_back(std::make_shared<Matrix>("Vx AO Temp", nbf_, nbf_));
+        Vx_tiles.push_back(std::make_shared<ShellPairTiles>(grid_tiles_));
     }
 
     // => Compute Vx <=
@@ -1759,12 +1876,11 @@ void RV::compute_Vx_full(std::vector<SharedMatrix> Dx, std::vector<SharedMatrix>
         // => Setup <= //
         auto fworker = functional_workers_[rank];
         auto pworker = point_workers_[rank];
-        auto Vx_localp = R_Vx_local[rank]->pointer();
-        auto Dx_localp = R_Dx_local[rank]->pointer();
+        // Batch matrices are packed, with leading dimension nd * nlocal
+        auto Sp = R_S_batch[rank]->pointer()[0];
+        auto Tp = R_T_batch[rank]->pointer()[0];
 
         // => Compute blocks <= //
-        auto Tp = pworker->scratch()[0]->pointer();
-
         auto block = grid_->blocks()[Q];
         auto npoints = block->npoints();
         auto w = block->w();
@@ -1816,137 +1932,144 @@ void RV::compute_Vx_full(std::vector<SharedMatrix> Dx, std::vector<SharedMatrix>
         // Meta
         // Forget that!
 
-        // ==> Compute Vx contribution for each x <==
-        for (size_t dindex = 0; dindex < Dx_vec.size(); dindex++) {
-            auto Dxp = Dx_vec[dindex]->pointer();
-
-            // ===> Build Rotated Densities <=== //
-            for (int ml = 0; ml < nlocal; ml++) {
-                int mg = function_map[ml];
-                for (int nl = 0; nl < nlocal; nl++) {
-                    int ng = function_map[nl];
-                    Dx_localp[ml][nl] = Dxp[mg][ng];
+        // ==> Compute Vx contributions, nbatch trial densities at a time <==
+        for (size_t dstart = 0; dstart < Dx_vec.size(); dstart += nbatch) {
+            size_t nd = std::min(nbatch, Dx_vec.size() - dstart);
+            size_t ld = nd * nlocal;
+
+            // ===> Build Rotated Densities, side by side <=== //
+            // S[:, k] := add_trans(Dk, (1, 0))
+            for (size_t d = 0; d < nd; d++) {
+                auto Dxp = Dx_vec[dstart + d]->pointer();
+                for (int ml = 0; ml < nlocal; ml++) {
+                    int mg = function_map[ml];
+                    for (int nl = 0; nl < nlocal; nl++) {
+                        int ng = function_map[nl];
+                        Sp[ml * ld + d * nlocal + nl] = Dxp[mg][ng] + Dxp[ng][mg];
+                    }
                 }
             }
 
             // ===> Compute quantities using effective densities <===
             // N.B. We spin-sum over true density spin-indices, never effective density spin-indices. 
-            // T := einsum("pm, mn -> pn", φ, add_trans(Dk, (1, 0, 2)))
+            // T := einsum("pm, mnk -> pnk", φ, S), one GEMM for the whole batch
             parallel_timer_on("Derivative Properties", rank);
-            C_DGEMM('N', 'N', npoints, nlocal, nlocal, 1.0, phi[0], coll_funcs, Dx_localp[0], max_functions, 0.0, Tp[0],
-                    max_functions);
-            C_DGEMM('N', 'T', npoints, nlocal, nlocal, 1.0, phi[0], coll_funcs, Dx_localp[0], max_functions, 1.0, Tp[0],
-                    max_functions);
+            C_DGEMM('N', 'N', npoints, ld, nlocal, 1.0, phi[0], coll_funcs, Sp, ld, 0.0, Tp, ld);
+            parallel_timer_off("Derivative Properties", rank);
 
-            // ρk = einsum("mn, pm, pn -> pσ", Dk, φ, φ)
-            // ρk = 1/2 * add_trans(ρκ, (1, 0, 2))
-            for (int P = 0; P < npoints; P++) {
-                rho_k[P] = 0.5 * C_DDOT(nlocal, phi[P], 1, Tp[P], 1);
-            }
+            for (size_t d = 0; d < nd; d++) {
+                // Columns of trial density d in T, row P at Td + P * ld
+                double* Td = Tp + d * nlocal;
 
-            // ∇ρk = einsum("mn, pm, pn -> p", add_trans(Dk, (1, 0, 2)), ∇φ, φ)
-            //  Γk = add_trans(einsum("xp, xp -> p", ∇ρk, ∇ρ), (0, 2, 1))
-            //      ...2x the size of UKS alpha-spin counterpart thanks to spin-summing of ∇ρ
-            if (ansatz >= 1) {
+                // ρk = einsum("mn, pm, pn -> pσ", Dk, φ, φ)
+                // ρk = 1/2 * add_trans(ρκ, (1, 0, 2))
+                parallel_timer_on("Derivative Properties", rank);
                 for (int P = 0; P < npoints; P++) {
-                    rho_k_x[P] = C_DDOT(nlocal, phi_x[P], 1, Tp[P], 1);
-                    rho_k_y[P] = C_DDOT(nlocal, phi_y[P], 1, Tp[P], 1);
-                    rho_k_z[P] = C_DDOT(nlocal, phi_z[P], 1, Tp[P], 1);
-                    gamma_k[P] = rho_k_x[P] * rho_x[P];
-                    gamma_k[P] += rho_k_y[P] * rho_y[P];
-                    gamma_k[P] += rho_k_z[P] * rho_z[P];
-                    gamma_k[P] *= 2;
+                    rho_k[P] = 0.5 * C_DDOT(nlocal, phi[P], 1, Td + P * ld, 1);
                 }
-            }
-            parallel_timer_off("Derivative Properties", rank);
 
-            // ===> LSDA contribution <=== //
-            //                                         ∂^2
-            // T := 1/2 einsum("p, p, pm, p -> pm", w, ---- f , ρk, φ)
-            //                                         ∂ρ^2
-            parallel_timer_on("V_XCd", rank);
-            for (int P = 0; P < npoints; P++) {
-                std::fill(Tp[P], Tp[P] + nlocal, 0.0);
-                // Do a simple screen: ignore contributions where rho is too small.
-                if (rho_a[P] < v2_rho_cutoff_) continue;
-                C_DAXPY(nlocal, 0.5 * v2_rho2[P] * w[P] * rho_k[P], phi[P], 1, Tp[P], 1);
-            }
-
-            // ===> GGA contribution <=== //
-            if (ansatz >= 1) {
-                // ====> Define pointers for future use <====
-                auto v_gamma = vals["V_GAMMA_AA"]->pointer();
-                auto v2_gamma_gamma = vals["V_GAMMA_AA_GAMMA_AA"]->pointer();
-                auto v2_rho_gamma = vals["V_RHO_A_GAMMA_AA"]->pointer();
-                double tmp_val = 0.0, v2_val = 0.0;
+                // ∇ρk = einsum("mn, pm, pn -> p", add_trans(Dk, (1, 0, 2)), ∇φ, φ)
+                //  Γk = add_trans(einsum("xp, xp -> p", ∇ρk, ∇ρ), (0, 2, 1))
+                //      ...2x the size of UKS alpha-spin counterpart thanks to spin-summing of ∇ρ
+                if (ansatz >= 1) {
+                    for (int P = 0; P < npoints; P++) {
+                        rho_k_x[P] = C_DDOT(nlocal, phi_x[P], 1, Td + P * ld, 1);
+                        rho_k_y[P] = C_DDOT(nlocal, phi_y[P], 1, Td + P * ld, 1);
+                        rho_k_z[P] = C_DDOT(nlocal, phi_z[P], 1, Td + P * ld, 1);
+                        gamma_k[P] = rho_k_x[P] * rho_x[P];
+                        gamma_k[P] += rho_k_y[P] * rho_y[P];
+                        gamma_k[P] += rho_k_z[P] * rho_z[P];
+                        gamma_k[P] *= 2;
+                    }
+                }
+                parallel_timer_off("Derivative Properties", rank);
 
-                // There are lots of GGA terms.
+                // ===> LSDA contribution <=== //
+                //                                         ∂^2
+                // T := 1/2 einsum("p, p, pm, p -> pm", w, ---- f , ρk, φ)
+                //                                         ∂ρ^2
+                parallel_timer_on("V_XCd", rank);
                 for (int P = 0; P < npoints; P++) {
+                    std::fill(Td + P * ld, Td + P * ld + nlocal, 0.0);
+                    // Do a simple screen: ignore contributions where rho is too small.
                     if (rho_a[P] < v2_rho_cutoff_) continue;
+                    C_DAXPY(nlocal, 0.5 * v2_rho2[P] * w[P] * rho_k[P], phi[P], 1, Td + P * ld, 1);
+                }
 
-                    // ====> Term 2b, V in DOI: 10.1063/1.466887 <====
-                    //                                         ∂^2
-                    // T += 1/2 einsum("p, p, p, pr -> pr", w, ---- f, Γk, φ)
-                    //                                         ∂ρ∂γ
-                    // V contributions
-                    C_DAXPY(nlocal, (0.5 * w[P] * v2_rho_gamma[P] * gamma_k[P]), phi[P], 1, Tp[P], 1);
-
-                    // ====> All other terms, W in above DOI  <==== //
-                    //                            ∂^2
-                    // temp = einsum("p, p -> p", ---- f, ρk)
-                    //                            ∂ρ∂γ
-                    //                             ∂^2
-                    // temp += einsum("p, p -> p", ---- f, Γk)
-                    //                             ∂γ∂γ
-                    
-                    // Define Γk terms in 3 intermediate
-                    v2_val = (v2_rho_gamma[P] * rho_k[P] + v2_gamma_gamma[P] * gamma_k[P]);
-
-                    //                                      ∂
-                    // temp2 = einsum("p, p, xp -> xpσ", w, -- f, ∇ρk)
-                    //                                      ∂Γ
-                    // temp2 += einsum("p, p, x -> xp", w, temp, ∇ρ)
-                    // T += einsum("xp, xpm -> pm", temp2, ∇φ)
-
-                    tmp_val = 2.0 * w[P] * (v_gamma[P] * rho_k_x[P] + v2_val * rho_x[P]);
-                    C_DAXPY(nlocal, tmp_val, phi_x[P], 1, Tp[P], 1);
-
-                    tmp_val = 2.0 * w[P] * (v_gamma[P] * rho_k_y[P] + v2_val * rho_y[P]);
-                    C_DAXPY(nlocal, tmp_val, phi_y[P], 1, Tp[P], 1);
+                // ===> GGA contribution <=== //
+                if (ansatz >= 1) {
+                    // ====> Define pointers for future use <====
+                    auto v_gamma = vals["V_GAMMA_AA"]->pointer();
+                    auto v2_gamma_gamma = vals["V_GAMMA_AA_GAMMA_AA"]->pointer();
+                    auto v2_rho_gamma = vals["V_RHO_A_GAMMA_AA"]->pointer();
+                    double tmp_val = 0.0, v2_val = 0.0;
 
-                    tmp_val = 2.0 * w[P] * (v_gamma[P] * rho_k_z[P] + v2_val * rho_z[P]);
-                    C_DAXPY(nlocal, tmp_val, phi_z[P], 1, Tp[P], 1);
+                    // There are lots of GGA terms.
+                    for (int P = 0; P < npoints; P++) {
+                        if (rho_a[P] < v2_rho_cutoff_) continue;
+                        double* TP = Td + P * ld;
+
+                        // ====> Term 2b, V in DOI: 10.1063/1.466887 <====
+                        //                                         ∂^2
+                        // T += 1/2 einsum("p, p, p, pr -> pr", w, ---- f, Γk, φ)
+                        //                                         ∂ρ∂γ
+                        // V contributions
+                        C_DAXPY(nlocal, (0.5 * w[P] * v2_rho_gamma[P] * gamma_k[P]), phi[P], 1, TP, 1);
+
+                        // ====> All other terms, W in above DOI  <==== //
+                        //                            ∂^2
+                        // temp = einsum("p, p -> p", ---- f, ρk)
+                        //                            ∂ρ∂γ
+                        //                             ∂^2
+                        // temp += einsum("p, p -> p", ---- f, Γk)
+                        //                             ∂γ∂γ
+
+                        // Define Γk terms in 3 intermediate
+                        v2_val = (v2_rho_gamma[P] * rho_k[P] + v2_gamma_gamma[P] * gamma_k[P]);
+
+                        //                                      ∂
+                        // temp2 = einsum("p, p, xp -> xpσ", w, -- f, ∇ρk)
+                        //                                      ∂Γ
+                        // temp2 += einsum("p, p, x -> xp", w, temp, ∇ρ)
+                        // T += einsum("xp, xpm -> pm", temp2, ∇φ)
+
+                        tmp_val = 2.0 * w[P] * (v_gamma[P] * rho_k_x[P] + v2_val * rho_x[P]);
+                        C_DAXPY(nlocal, tmp_val, phi_x[P], 1, TP, 1);
+
+                        tmp_val = 2.0 * w[P] * (v_gamma[P] * rho_k_y[P] + v2_val * rho_y[P]);
+                        C_DAXPY(nlocal, tmp_val, phi_y[P], 1, TP, 1);
+
+                        tmp_val = 2.0 * w[P] * (v_gamma[P] * rho_k_z[P] + v2_val * rho_z[P]);
+                        C_DAXPY(nlocal, tmp_val, phi_z[P], 1, TP, 1);
+                    }
                 }
+                parallel_timer_off("V_XCd", rank);
             }
 
-            // ===> Contract Ta and Tb aginst φ, replacing a point index with  an AO index <===
-            C_DGEMM('T', 'N', nlocal, nlocal, npoints, 1.0, phi[0], coll_funcs, Tp[0], max_functions, 0.0, Vx_localp[0],
-                    max_functions);
+            // ===> Contract T against φ, replacing a point index with an AO index <===
+            // Vx := einsum("pm, pnk -> mnk", φ, T), one GEMM for the whole batch, into S
+            parallel_timer_on("V_XCd", rank);
+            C_DGEMM('T', 'N', nlocal, ld, npoints, 1.0, phi[0], coll_funcs, Tp, ld, 0.0, Sp, ld);
 
-            // ===> Add the adjoint to complete the LDA and GGA contributions  <===
-            for (int m = 0; m < nlocal; m++) {
-                for (int n = 0; n <= m; n++) {
-                    Vx_localp[m][n] = Vx_localp[n][m] = Vx_localp[m][n] + Vx_localp[n][m];
-                }
-            }
+            for (size_t d = 0; d < nd; d++) {
+                double* Vd = Sp + d * nlocal;
 
-            // => Unpacking <= //
-            auto Vxp = Vx_AO[dindex]->pointer();
-            for (int ml = 0; ml < nlocal; ml++) {
-                int mg = function_map[ml];
-                for (int nl = 0; nl < ml; nl++) {
-                    int ng = function_map[nl];
-#pragma omp atomic update
-                    Vxp[mg][ng] += Vx_localp[ml][nl];
-#pragma omp atomic update
-                    Vxp[ng][mg] += Vx_localp[ml][nl];
+                // ===> Add the adjoint to complete the LDA and GGA contributions  <===
+                for (int m = 0; m < nlocal; m++) {
+                    for (int n = 0; n <= m; n++) {
+                        Vd[m * ld + n] = Vd[n * ld + m] = Vd[m * ld + n] + Vd[n * ld + m];
+                    }
                 }
-#pragma omp atomic update
-                Vxp[mg][mg] += Vx_localp[ml][ml];
+
+                // => Unpacking <= //
+                Vx_tiles[dstart + d]->add(*block, Vd, ld);
             }
             parallel_timer_off("V_XCd", rank);
         }
     }
+    for (size_t i = 0; i < Dx.size(); i++) {
+        Vx_tiles[i]->merge(Vx_AO[i]);
+    }
 
     // Set the result
     for (size_t i = 0; i < Dx.size(); i++) {
@@ -2105,7 +2228,6 @@ SharedMatrix RV::compute_hessian() {
     // ==> Build the target Hessian Matrix <==
     int natom = primary_->molecule()->natom();
     auto H = std::make_shared<Matrix>("XC Hessian", 3 * natom, 3 * natom);
-    auto Hp = H->pointer();
 
     // ==> Thread info <==
     int rank = 0;
@@ -2137,10 +2259,27 @@ SharedMatrix RV::compute_hessian() {
         Q_temp.push_back(std::make_shared<Vector>("Quadrature Tempt", max_points));
     }
 
-    auto QT = std::make_shared<Vector>("Quadrature Temp", max_points);
+    // The nine Cartesian blocks of the local Hessian and the directional temps are allocated once per thread
+    // rather than cloned on every block, and each thread accumulates into its own copy of the Hessian so that
+    // the blocks can be shared out without atomics.  The copies are summed once all blocks are done.
+    std::vector<SharedMatrix> H_local;
+    std::vector<std::vector<SharedMatrix>> H_blocks(num_threads_), U_local(num_threads_), T_local(num_threads_);
+    std::vector<std::vector<int>> centers_local(num_threads_);
+    for (size_t i = 0; i < num_threads_; i++) {
+        H_local.push_back(std::make_shared<Matrix>("XC Hessian Temp", 3 * natom, 3 * natom));
+        for (int c = 0; c < 9; c++) {
+            H_blocks[i].push_back(std::make_shared<Matrix>("H Temp", max_functions, max_functions));
+        }
+        U_local[i].push_back(std::make_shared<Matrix>("U Temp", max_points, max_functions));
+        for (int c = 0; c < 3; c++) {
+            T_local[i].push_back(std::make_shared<Matrix>("T Temp", max_points, max_functions));
+        }
+    }
+
     const auto& blocks = grid_->blocks();
 
     // => Master Loop <=
+#pragma omp parallel for private(rank) schedule(guided) num_threads(num_threads_)
     for (size_t Q = 0; Q < blocks.size(); Q++) {
         // ==> Get thread info <==
 #ifdef _OPENMP
@@ -2151,39 +2290,26 @@ SharedMatrix RV::compute_hessian() {
         auto fworker = functional_workers_[rank];
         auto pworker = point_workers_[rank];
         auto V2p = V_local[rank]->pointer();
+        auto Hl = H_local[rank]->pointer();
         auto Dp = pworker->D_scratch()[0]->pointer();
-        auto tmpHXX = pworker->D_scratch()[0]->clone();
-        auto tmpHXY = pworker->D_scratch()[0]->clone();
-        auto tmpHXZ = pworker->D_scratch()[0]->clone();
-        auto tmpHYX = pworker->D_scratch()[0]->clone();
-        auto tmpHYY = pworker->D_scratch()[0]->clone();
-        auto tmpHYZ = pworker->D_scratch()[0]->clone();
-        auto tmpHZX = pworker->D_scratch()[0]->clone();
-        auto tmpHZY = pworker->D_scratch()[0]->clone();
-        auto tmpHZZ = pworker->D_scratch()[0]->clone();
-        auto pHXX = tmpHXX->pointer();
-        auto pHXY = tmpHXY->pointer();
-        auto pHXZ = tmpHXZ->pointer();
-        auto pHYX = tmpHYX->pointer();
-        auto pHYY = tmpHYY->pointer();
-        auto pHYZ = tmpHYZ->pointer();
-        auto pHZX = tmpHZX->pointer();
-        auto pHZY = tmpHZY->pointer();
-        auto pHZZ = tmpHZZ->pointer();
+        auto pHXX = H_blocks[rank][0]->pointer();
+        auto pHXY = H_blocks[rank][1]->pointer();
+        auto pHXZ = H_blocks[rank][2]->pointer();
+        auto pHYX = H_blocks[rank][3]->pointer();
+        auto pHYY = H_blocks[rank][4]->pointer();
+        auto pHYZ = H_blocks[rank][5]->pointer();
+        auto pHZX = H_blocks[rank][6]->pointer();
+        auto pHZY = H_blocks[rank][7]->pointer();
+        auto pHZZ = H_blocks[rank][8]->pointer();
 
         // Scratch
         auto Tp = pworker->scratch()[0]->pointer();
-        auto U_local(pworker->scratch()[0]->clone());
-        auto Up = U_local->pointer();
+        auto Up = U_local[rank][0]->pointer();
 
-        // TODO: these need to be threaded eventually, to fit in with the new infrastructure
         // Directional Temps
-        auto Tx(U_local->clone());
-        auto Ty(U_local->clone());
-        auto Tz(U_local->clone());
-        auto pTx2 = Tx->pointer();
-        auto pTy2 = Ty->pointer();
-        auto pTz2 = Tz->pointer();
+        auto pTx2 = T_local[rank][0]->pointer();
+        auto pTy2 = T_local[rank][1]->pointer();
+        auto pTz2 = T_local[rank][2]->pointer();
 
         auto block = blocks[Q];
         int npoints = block->npoints();
@@ -2193,6 +2319,11 @@ SharedMatrix RV::compute_hessian() {
         auto w = block->w();
         const auto& function_map = block->functions_local_to_global();
         int nlocal = function_map.size();
+        auto& centers = centers_local[rank];
+        centers.resize(nlocal);
+        for (int ml = 0; ml < nlocal; ml++) {
+            centers[ml] = primary_->function_to_center(function_map[ml]);
+        }
 
         // ==> Compute values at points <==
         pworker->compute_points(block);
@@ -2242,22 +2373,22 @@ SharedMatrix RV::compute_hessian() {
             }
         }
         for (int ml = 0; ml < nlocal; ml++) {
-            int A = primary_->function_to_center(function_map[ml]);
+            int A = centers[ml];
             double Txx = C_DDOT(npoints, &Up[0][ml], max_functions, &phi_xx[0][ml], coll_funcs);
             double Txy = C_DDOT(npoints, &Up[0][ml], max_functions, &phi_xy[0][ml], coll_funcs);
             double Txz = C_DDOT(npoints, &Up[0][ml], max_functions, &phi_xz[0][ml], coll_funcs);
             double Tyy = C_DDOT(npoints, &Up[0][ml], max_functions, &phi_yy[0][ml], coll_funcs);
             double Tyz = C_DDOT(npoints, &Up[0][ml], max_functions, &phi_yz[0][ml], coll_funcs);
             double Tzz = C_DDOT(npoints, &Up[0][ml], max_functions, &phi_zz[0][ml], coll_funcs);
-            Hp[3 * A + 0][3 * A + 0] += Txx;
-            Hp[3 * A + 0][3 * A + 1] += Txy;
-            Hp[3 * A + 0][3 * A + 2] += Txz;
-            Hp[3 * A + 1][3 * A + 0] += Txy;
-            Hp[3 * A + 1][3 * A + 1] += Tyy;
-            Hp[3 * A + 1][3 * A + 2] += Tyz;
-            Hp[3 * A + 2][3 * A + 0] += Txz;
-            Hp[3 * A + 2][3 * A + 1] += Tyz;
-            Hp[3 * A + 2][3 * A + 2] += Tzz;
+            Hl[3 * A + 0][3 * A + 0] += Txx;
+            Hl[3 * A + 0][3 * A + 1] += Txy;
+            Hl[3 * A + 0][3 * A + 2] += Txz;
+            Hl[3 * A + 1][3 * A + 0] += Txy;
+            Hl[3 * A + 1][3 * A + 1] += Tyy;
+            Hl[3 * A + 1][3 * A + 2] += Tyz;
+            Hl[3 * A + 2][3 * A + 0] += Txz;
+            Hl[3 * A + 2][3 * A + 1] += Tyz;
+            Hl[3 * A + 2][3 * A + 2] += Tzz;
         }
 
         /*
@@ -2376,22 +2507,26 @@ SharedMatrix RV::compute_hessian() {
 
         // Accumulate contributions to the full Hessian: N.B. these terms are not symmetric!
         for (int ml = 0; ml < nlocal; ml++) {
-            int A = primary_->function_to_center(function_map[ml]);
+            int A = centers[ml];
             for (int nl = 0; nl < nlocal; nl++) {
-                int B = primary_->function_to_center(function_map[nl]);
-                Hp[3 * A + 0][3 * B + 0] += pHXX[ml][nl];
-                Hp[3 * A + 1][3 * B + 0] += pHYX[ml][nl];
-                Hp[3 * A + 2][3 * B + 0] += pHZX[ml][nl];
-                Hp[3 * A + 0][3 * B + 1] += pHXY[ml][nl];
-                Hp[3 * A + 1][3 * B + 1] += pHYY[ml][nl];
-                Hp[3 * A + 2][3 * B + 1] += pHZY[ml][nl];
-                Hp[3 * A + 0][3 * B + 2] += pHXZ[ml][nl];
-                Hp[3 * A + 1][3 * B + 2] += pHYZ[ml][nl];
-                Hp[3 * A + 2][3 * B + 2] += pHZZ[ml][nl];
+                int B = centers[nl];
+                Hl[3 * A + 0][3 * B + 0] += pHXX[ml][nl];
+                Hl[3 * A + 1][3 * B + 0] += pHYX[ml][nl];
+                Hl[3 * A + 2][3 * B + 0] += pHZX[ml][nl];
+                Hl[3 * A + 0][3 * B + 1] += pHXY[ml][nl];
+                Hl[3 * A + 1][3 * B + 1] += pHYY[ml][nl];
+                Hl[3 * A + 2][3 * B + 1] += pHZY[ml][nl];
+                Hl[3 * A + 0][3 * B + 2] += pHXZ[ml][nl];
+                Hl[3 * A + 1][3 * B + 2] += pHYZ[ml][nl];
+                Hl[3 * A + 2][3 * B + 2] += pHZZ[ml][nl];
             }
         }
     }
 
+    for (size_t i = 0; i < num_threads_; i++) {
+        H->add(H_local[i]);
+    }
+
     if (std::isnan(quad_values_["FUNCTIONAL"])) {
         throw PSIEXCEPTION("V: Integrated DFT functional to get NaN. The functional is not numerically stable. Pick a different one.");
     }
@@ -2586,7 +2721,7 @@ void UV::initialize() {
         // Need a points worker per thread
         std::shared_ptr<PointFunctions> point_tmp = std::make_shared<UKSFunctions>(primary_, max_points, max_functions);
         point_tmp->set_ansatz(functional_->ansatz());
-        point_tmp->set_cache_map(&cache_map_);
+        point_tmp->set_collocation_cache(&collocation_cache_);
         point_workers_.push_back(point_tmp);
     }
 }
@@ -2642,9 +2777,10 @@ void UV::compute_V(std::vector<SharedMatrix> ret) {
     int max_functions = grid_->max_functions();
     int max_points = grid_->max_points();
 
-    // Setup the pointers
+    // Setup the pointers, the grid GEMMs are in single precision only while building V
     for (size_t i = 0; i < num_threads_; i++) {
         point_workers_[i]->set_pointers(D_AO_[0], D_AO_[1]);
+        point_workers_[i]->set_mixed_precision(mixed_precision_);
     }
 
     // Per thread temporaries
@@ -2659,8 +2795,8 @@ void UV::compute_V(std::vector<SharedMatrix> ret) {
 
     auto Va_AO = std::make_shared<Matrix>("Va Temp", nbf_, nbf_);
     auto Vb_AO = std::make_shared<Matrix>("Vb Temp", nbf_, nbf_);
-    auto Vap = Va_AO->pointer();
-    auto Vbp = Vb_AO->pointer();
+    ShellPairTiles Va_tiles(grid_tiles_);
+    ShellPairTiles Vb_tiles(grid_tiles_);
 
     std::vector<double> functionalq(num_threads_);
     std::vector<double> rhoaq(num_threads_);
@@ -2673,8 +2809,13 @@ void UV::compute_V(std::vector<SharedMatrix> ret) {
     std::vector<double> rhobzq(num_threads_);
 
     // => Compute V <=
+    // Blocks whose density bound for the current D is below the tolerance
+    auto block_active = screen_blocks(D_AO_);
+
 #pragma omp parallel for private(rank) schedule(guided) num_threads(num_threads_)
     for (size_t Q = 0; Q < grid_->blocks().size(); Q++) {
+        if (!block_active[Q]) continue;
+
         // ==> Define block/thread-specific variables <==
 #ifdef _OPENMP
         rank = omp_get_thread_num();
@@ -2791,10 +2932,10 @@ void UV::compute_V(std::vector<SharedMatrix> ret) {
 
         // timer_on("V: LSDA");
         // ==> Contract Ta and Tba aginst φ, replacing a point index with  an AO index <==
-        C_DGEMM('T', 'N', nlocal, nlocal, npoints, 1.0, phi[0], coll_funcs, Tap[0], max_functions, 0.0, Va2p[0],
-                max_functions);
-        C_DGEMM('T', 'N', nlocal, nlocal, npoints, 1.0, phi[0], coll_funcs, Tbp[0], max_functions, 0.0, Vb2p[0],
-                max_functions);
+        pworker->block_gemm('T', 'N', nlocal, nlocal, npoints, 1.0, phi[0], coll_funcs, Tap[0], max_functions, 0.0,
+                            Va2p[0], max_functions);
+        pworker->block_gemm('T', 'N', nlocal, nlocal, npoints, 1.0, phi[0], coll_funcs, Tbp[0], max_functions, 0.0,
+                            Vb2p[0], max_functions);
 
         // ==> Add the adjoint to complete the LDA and GGA contributions  <==
         for (int m = 0; m < nlocal; m++) {
@@ -2836,8 +2977,8 @@ void UV::compute_V(std::vector<SharedMatrix> ret) {
                         std::fill(Tap[P], Tap[P] + nlocal, 0.0);
                         C_DAXPY(nlocal, v_taup[P] * w[P], phiw[P], 1, Tap[P], 1);
                     }
-                    C_DGEMM('T', 'N', nlocal, nlocal, npoints, 1.0, phiw[0], coll_funcs, Tap[0], max_functions, 1.0,
-                            V2p[0], max_functions);
+                    pworker->block_gemm('T', 'N', nlocal, nlocal, npoints, 1.0, phiw[0], coll_funcs, Tap[0],
+                                        max_functions, 1.0, V2p[0], max_functions);
                 }
             }
 
@@ -2845,26 +2986,16 @@ void UV::compute_V(std::vector<SharedMatrix> ret) {
         }
 
         // ==> Unpacking <== //
-        for (int ml = 0; ml < nlocal; ml++) {
-            int mg = function_map[ml];
-            for (int nl = 0; nl < ml; nl++) {
-                int ng = function_map[nl];
-#pragma omp atomic update
-                Vap[mg][ng] += Va2p[ml][nl];
-#pragma omp atomic update
-                Vap[ng][mg] += Va2p[ml][nl];
-#pragma omp atomic update
-                Vbp[mg][ng] += Vb2p[ml][nl];
-#pragma omp atomic update
-                Vbp[ng][mg] += Vb2p[ml][nl];
-            }
-#pragma omp atomic update
-            Vap[mg][mg] += Va2p[ml][ml];
-#pragma omp atomic update
-            Vbp[mg][mg] += Vb2p[ml][ml];
-        }
+        Va_tiles.add(*block, Va2p[0], max_functions);
+        Vb_tiles.add(*block, Vb2p[0], max_functions);
         parallel_timer_off("V_xc", rank);
     }
+    Va_tiles.merge(Va_AO);
+    Vb_tiles.merge(Vb_AO);
+
+    for (size_t i = 0; i < num_threads_; i++) {
+        point_workers_[i]->set_mixed_precision(false);
+    }
 
     // Do we need VV10?
     double vv10_e = 0.0;
@@ -2918,14 +3049,18 @@ void UV::compute_V(std::vector<SharedMatrix> ret) {
     }
     timer_off("UV: Form V");
 }
-std::vector<SharedMatrix> UV::compute_fock_derivatives() {
+std::vector<SharedMatrix> UV::compute_fock_derivatives(int first_atom, int natom_batch) {
     timer_on("UV: Form Fx");
 
     int natoms = primary_->molecule()->natom();
-    std::vector<SharedMatrix> Vx(6*natoms);
+    if (first_atom < 0 || natom_batch < 0 || first_atom + natom_batch > natoms) {
+        throw PSIEXCEPTION("DFT Hessian: Fock derivative atom batch is out of range.");
+    }
+    int last_atom = first_atom + natom_batch;
+    std::vector<SharedMatrix> Vx(6*natom_batch);
     for(int n = 0; n < Vx.size(); ++n) {
         std::string spin = (n % 2) ? "beta" : "alpha";
-        Vx[n] = std::make_shared<Matrix>("Vx for Perturbation " + std::to_string(n / 2) + ", " + spin, nbf_, nbf_);
+        Vx[n] = std::make_shared<Matrix>("Vx for Perturbation " + std::to_string(3*first_atom + n / 2) + ", " + spin, nbf_, nbf_);
     }
     if (D_AO_.size() != 2) {
         throw PSIEXCEPTION("DFT Hessian: UKS should have two D Matrices");
@@ -2966,12 +3101,6 @@ std::vector<SharedMatrix> UV::compute_fock_derivatives() {
         functional_workers_[i]->set_deriv(2);
         functional_workers_[i]->allocate();
     }
-    // Output quantities
-    std::vector<SharedMatrix> Vx_AO;
-    for (size_t i = 0; i < 6*natoms; i++) {
-        Vx_AO.push_back(std::make_shared<Matrix>("Vx AO Temp", nbf_, nbf_));
-    }
-
 // Traverse the blocks of points
 #pragma omp parallel for private(rank) schedule(guided) num_threads(num_threads_)
     for (size_t Q = 0; Q < grid_->blocks().size(); Q++) {
@@ -3032,7 +3161,7 @@ std::vector<SharedMatrix> UV::compute_fock_derivatives() {
             }
         }
         size_t coll_funcs = pworker->basis_value("PHI")->ncol();
-        for(int atom = 0; atom < primary_->molecule()->natom(); ++atom){
+        for(int atom = first_atom; atom < last_atom; ++atom){
             // Find first and last basis functions on this atom, from the subset of bfs being handled by this block of points
             auto first_func_iter = std::find_if(function_map.begin(), function_map.end(), [&](int i) {return primary_->function_to_center(i) == atom;});
             if(first_func_iter == function_map.end()) continue;
@@ -3076,7 +3205,7 @@ std::vector<SharedMatrix> UV::compute_fock_derivatives() {
             C_DGEMM('T', 'N', nlocal, nlocal, npoints, 1.0, Tap[0], max_functions, phi[0], coll_funcs, 0.0, Vxa_localp[0], max_functions);
             C_DGEMM('T', 'N', nlocal, nlocal, npoints, 1.0, Tbp[0], max_functions, phi[0], coll_funcs, 0.0, Vxb_localp[0], max_functions);
             // => Accumulate the result <= //
-            auto Vxap = Vx[6*atom + 0]->pointer();
+            auto Vxap = Vx[6*(atom - first_atom) + 0]->pointer();
             for (int ml = 0; ml < nlocal; ml++) {
                 int mg = function_map[ml];
                 for (int nl = 0; nl < nlocal; nl++) {
@@ -3088,7 +3217,7 @@ std::vector<SharedMatrix> UV::compute_fock_derivatives() {
                      Vxap[ng][mg] += result;
                 }
             }
-            auto Vxbp = Vx[6*atom + 1]->pointer();
+            auto Vxbp = Vx[6*(atom - first_atom) + 1]->pointer();
             for (int ml = 0; ml < nlocal; ml++) {
                 int mg = function_map[ml];
                 for (int nl = 0; nl < nlocal; nl++) {
@@ -3134,7 +3263,7 @@ std::vector<SharedMatrix> UV::compute_fock_derivatives() {
             C_DGEMM('T', 'N', nlocal, nlocal, npoints, 1.0, Tap[0], max_functions, phi[0], coll_funcs, 0.0, Vxa_localp[0], max_functions);
             C_DGEMM('T', 'N', nlocal, nlocal, npoints, 1.0, Tbp[0], max_functions, phi[0], coll_funcs, 0.0, Vxb_localp[0], max_functions);
             // => Accumulate the result <= //
-            auto Vyap = Vx[6*atom + 2]->pointer();
+            auto Vyap = Vx[6*(atom - first_atom) + 2]->pointer();
             for (int ml = 0; ml < nlocal; ml++) {
                 int mg = function_map[ml];
                 for (int nl = 0; nl < nlocal; nl++) {
@@ -3146,7 +3275,7 @@ std::vector<SharedMatrix> UV::compute_fock_derivatives() {
                      Vyap[ng][mg] += result;
                 }
             }
-            auto Vybp = Vx[6*atom + 3]->pointer();
+            auto Vybp = Vx[6*(atom - first_atom) + 3]->pointer();
             for (int ml = 0; ml < nlocal; ml++) {
                 int mg = function_map[ml];
                 for (int nl = 0; nl < nlocal; nl++) {
@@ -3192,7 +3321,7 @@ std::vector<SharedMatrix> UV::compute_fock_derivatives() {
             C_DGEMM('T', 'N', nlocal, nlocal, npoints, 1.0, Tap[0], max_functions, phi[0], coll_funcs, 0.0, Vxa_localp[0], max_functions);
             C_DGEMM('T', 'N', nlocal, nlocal, npoints, 1.0, Tbp[0], max_functions, phi[0], coll_funcs, 0.0, Vxb_localp[0], max_functions);
             // => Accumulate the result <= //
-            auto Vzap = Vx[6*atom + 4]->pointer();
+            auto Vzap = Vx[6*(atom - first_atom) + 4]->pointer();
             for (int ml = 0; ml < nlocal; ml++) {
                 int mg = function_map[ml];
                 for (int nl = 0; nl < nlocal; nl++) {
@@ -3204,7 +3333,7 @@ std::vector<SharedMatrix> UV::compute_fock_derivatives() {
                      Vzap[ng][mg] += result;
                 }
             }
-            auto Vzbp = Vx[6*atom + 5]->pointer();
+            auto Vzbp = Vx[6*(atom - first_atom) + 5]->pointer();
             for (int ml = 0; ml < nlocal; ml++) {
                 int mg = function_map[ml];
                 for (int nl = 0; nl < nlocal; nl++) {
@@ -3279,17 +3408,17 @@ void UV::compute_Vx(std::vector<SharedMatrix> Dx, std::vector<SharedMatrix> ret)
         }
     }
 
+    // Alpha/beta trial density pairs handled together on a block
+    auto nbatch = vx_batch_size(Dx_vec.size() / 2, max_points, max_functions, 2);
+
     // Per [R]ank quantities
-    std::vector<SharedMatrix> R_Vax_local, R_Dax_local;
-    std::vector<SharedMatrix> R_Vbx_local, R_Dbx_local;
+    std::vector<SharedMatrix> R_S_batch, R_T_batch;
     std::vector<std::shared_ptr<Vector>> R_rho_ak, R_rho_ak_x, R_rho_ak_y, R_rho_ak_z, R_gamma_ak;
     std::vector<std::shared_ptr<Vector>> R_rho_bk, R_rho_bk_x, R_rho_bk_y, R_rho_bk_z, R_gamma_bk;
     std::vector<std::shared_ptr<Vector>> R_gamma_abk;
     for (size_t i = 0; i < num_threads_; i++) {
-        R_Vax_local.push_back(std::make_shared<Matrix>("Vax Temp", max_functions, max_functions));
-        R_Vbx_local.push_back(std::make_shared<Matrix>("Vbx Temp", max_functions, max_functions));
-        R_Dax_local.push_back(std::make_shared<Matrix>("Dak Temp", max_functions, max_functions));
-        R_Dbx_local.push_back(std::make_shared<Matrix>("Dbk Temp", max_functions, max_functions));
+        R_S_batch.push_back(std::make_shared<Matrix>("Dk/Vx Batch Temp", max_functions, 2 * nbatch * max_functions));
+        R_T_batch.push_back(std::make_shared<Matrix>("T Batch Temp", max_points, 2 * nbatch * max_functions));
 
         R_rho_ak.push_back(std::make_shared<Vector>("Rho aK Temp", max_points));
         R_rho_bk.push_back(std::make_shared<Vector>("Rho bK Temp", max_points));
@@ -3315,9 +3444,13 @@ void UV::compute_Vx(std::vector<SharedMatrix> Dx, std::vector<SharedMatrix> ret)
     // Output quantities
     std::vector<SharedMatrix> Vax_AO;
     std::vector<SharedMatrix> Vbx_AO;
-    for (size_t i = 0; i < Dx.size(); i++) {
+    std::vector<std::shared_ptr<ShellPairTiles>> Vax_tiles;
+    std::vector<std::shared_ptr<ShellPairTiles>> Vbx_tiles;
+    for (size_t i = 0; i < Dx.size() / 2; i++) {
         Vbx_AO.push_back(std::make_shared<Matrix>("Vax AO Temp", nbf_, nbf_));
         Vax_AO.push_back(std::make_shared<Matrix>("Vbx AO Temp", nbf_, nbf_));
+        Vax_tiles.push_back(std::make_shared<ShellPairTiles>(grid_tiles_));
+        Vbx_tiles.push_back(std::make_shared<ShellPairTiles>(grid_tiles_));
     }
 
     // => Compute Vx <=
@@ -3331,15 +3464,11 @@ void UV::compute_Vx(std::vector<SharedMatrix> Dx, std::vector<SharedMatrix> ret)
         // => Setup <= //
         auto fworker = functional_workers_[rank];
         auto pworker = point_workers_[rank];
-        auto Vax_localp = R_Vax_local[rank]->pointer();
-        auto Vbx_localp = R_Vbx_local[rank]->pointer();
-        auto Dax_localp = R_Dax_local[rank]->pointer();
-        auto Dbx_localp = R_Dbx_local[rank]->pointer();
+        // Batch matrices are packed, with leading dimension 2 * nd * nlocal
+        auto Sp = R_S_batch[rank]->pointer()[0];
+        auto Tp = R_T_batch[rank]->pointer()[0];
 
         // => Compute blocks <= //
-        auto Tap = pworker->scratch()[0]->pointer();
-        auto Tbp = pworker->scratch()[1]->pointer();
-
         auto block = grid_->blocks()[Q];
         auto npoints = block->npoints();
         auto w = block->w();
@@ -3412,314 +3541,305 @@ void UV::compute_Vx(std::vector<SharedMatrix> Dx, std::vector<SharedMatrix> ret)
         // Meta
         // Forget that!
 
-        // ==> Compute Vx contribution for each x <==
-        for (size_t dindex = 0; dindex < (Dx_vec.size() / 2); dindex++) {
-            auto Daxp = Dx_vec[2 * dindex]->pointer();
-            auto Dbxp = Dx_vec[2 * dindex + 1]->pointer();
-
-            // ===> Build Rotated Densities <=== //
-            for (int ml = 0; ml < nlocal; ml++) {
-                int mg = function_map[ml];
-                for (int nl = 0; nl < nlocal; nl++) {
-                    int ng = function_map[nl];
-                    Dax_localp[ml][nl] = Daxp[mg][ng];
-                    Dbx_localp[ml][nl] = Dbxp[mg][ng];
+        // ==> Compute Vx contributions, nbatch alpha/beta pairs at a time <==
+        for (size_t dstart = 0; dstart < (Dx_vec.size() / 2); dstart += nbatch) {
+            size_t nd = std::min(nbatch, Dx_vec.size() / 2 - dstart);
+            size_t ld = 2 * nd * nlocal;
+
+            // ===> Build Rotated Densities, side by side <=== //
+            // S[:, kσ] := add_trans(Dk, (1, 0, 2))[σ = α, β]
+            for (size_t d = 0; d < 2 * nd; d++) {
+                auto Dxp = Dx_vec[2 * dstart + d]->pointer();
+                for (int ml = 0; ml < nlocal; ml++) {
+                    int mg = function_map[ml];
+                    for (int nl = 0; nl < nlocal; nl++) {
+                        int ng = function_map[nl];
+                        Sp[ml * ld + d * nlocal + nl] = Dxp[mg][ng] + Dxp[ng][mg];
+                    }
                 }
             }
 
             // ===> Compute quantities using effective densities <===
             // Ta, Tb := einsum("pm, mnσ -> pnσ", φ, add_trans(Dk, (1, 0, 2)))[σ = α, β]
-            // Alpha
+            // One GEMM for the whole batch
             parallel_timer_on("Derivative Properties", rank);
-            C_DGEMM('N', 'N', npoints, nlocal, nlocal, 1.0, phi[0], coll_funcs, Dax_localp[0], max_functions, 0.0,
-                    Tap[0], max_functions);
-            C_DGEMM('N', 'T', npoints, nlocal, nlocal, 1.0, phi[0], coll_funcs, Dax_localp[0], max_functions, 1.0,
-                    Tap[0], max_functions);
+            C_DGEMM('N', 'N', npoints, ld, nlocal, 1.0, phi[0], coll_funcs, Sp, ld, 0.0, Tp, ld);
+            parallel_timer_off("Derivative Properties", rank);
 
-            // Beta
-            C_DGEMM('N', 'N', npoints, nlocal, nlocal, 1.0, phi[0], coll_funcs, Dbx_localp[0], max_functions, 0.0,
-                    Tbp[0], max_functions);
-            C_DGEMM('N', 'T', npoints, nlocal, nlocal, 1.0, phi[0], coll_funcs, Dbx_localp[0], max_functions, 1.0,
-                    Tbp[0], max_functions);
+            for (size_t d = 0; d < nd; d++) {
+                // Columns of the alpha and beta parts of trial density d in T, row P at Ta + P * ld
+                double* Ta = Tp + 2 * d * nlocal;
+                double* Tb = Ta + nlocal;
 
-            // ρk = einsum("mnσ, pm, pn -> pσ", Dk, φ, φ)
-            // ρk = 1/2 * add_trans(ρκ, (1, 0, 2))
-            for (int P = 0; P < npoints; P++) {
-                rho_ak[P] = 0.5 * C_DDOT(nlocal, phi[P], 1, Tap[P], 1);
-                rho_bk[P] = 0.5 * C_DDOT(nlocal, phi[P], 1, Tbp[P], 1);
-            }
-
-            // ∇ρk = einsum("mnσ, pm, pn -> pσ", add_trans(Dk, (1, 0, 2)), ∇φ, φ)
-            //  Γk = add_trans(einsum("xpσ, xpτ -> pστ", ∇ρk, ∇ρ), (0, 2, 1))
-            if (ansatz >= 1) {
+                parallel_timer_on("Derivative Properties", rank);
+                // ρk = einsum("mnσ, pm, pn -> pσ", Dk, φ, φ)
+                // ρk = 1/2 * add_trans(ρκ, (1, 0, 2))
                 for (int P = 0; P < npoints; P++) {
-                    // Alpha
-                    rho_ak_x[P] = C_DDOT(nlocal, phi_x[P], 1, Tap[P], 1);
-                    rho_ak_y[P] = C_DDOT(nlocal, phi_y[P], 1, Tap[P], 1);
-                    rho_ak_z[P] = C_DDOT(nlocal, phi_z[P], 1, Tap[P], 1);
-                    gamma_aak[P] = rho_ak_x[P] * rho_ax[P];
-                    gamma_aak[P] += rho_ak_y[P] * rho_ay[P];
-                    gamma_aak[P] += rho_ak_z[P] * rho_az[P];
-                    gamma_aak[P] *= 2.0;
-
-                    // Beta
-                    rho_bk_x[P] = C_DDOT(nlocal, phi_x[P], 1, Tbp[P], 1);
-                    rho_bk_y[P] = C_DDOT(nlocal, phi_y[P], 1, Tbp[P], 1);
-                    rho_bk_z[P] = C_DDOT(nlocal, phi_z[P], 1, Tbp[P], 1);
-                    gamma_bbk[P] = rho_bk_x[P] * rho_bx[P];
-                    gamma_bbk[P] += rho_bk_y[P] * rho_by[P];
-                    gamma_bbk[P] += rho_bk_z[P] * rho_bz[P];
-                    gamma_bbk[P] *= 2.0;
-
-                    // Alpha-Beta
-                    gamma_abk[P] = rho_ak_x[P] * rho_bx[P] + rho_bk_x[P] * rho_ax[P];
-                    gamma_abk[P] += rho_ak_y[P] * rho_by[P] + rho_bk_y[P] * rho_ay[P];
-                    gamma_abk[P] += rho_ak_z[P] * rho_bz[P] + rho_bk_z[P] * rho_az[P];
+                    rho_ak[P] = 0.5 * C_DDOT(nlocal, phi[P], 1, Ta + P * ld, 1);
+                    rho_bk[P] = 0.5 * C_DDOT(nlocal, phi[P], 1, Tb + P * ld, 1);
                 }
-            }
-            parallel_timer_off("Derivative Properties", rank);
 
-            parallel_timer_on("V_XCd", rank);
-            // ===> LSDA contribution (symmetrized) <=== //
-            //                                                  ∂^2
-            // Ta, Tb := 1/2 einsum("p, pστ, pm, pτ -> pmσ", w, ---- f , ρk, φ)
-            //                                                  ∂ρ^2
-            double tmp_val = 0.0, tmp_ab_val = 0.0;
-            for (int P = 0; P < npoints; P++) {
-                std::fill(Tap[P], Tap[P] + nlocal, 0.0);
-                std::fill(Tbp[P], Tbp[P] + nlocal, 0.0);
-
-                // Do a simple screen: ignore contributions where rho is too small.
-                if (rho_a[P] + rho_b[P] > v2_rho_cutoff_) {
-                    tmp_val = v2_rho2_aa[P] * rho_ak[P];
-                    tmp_val += v2_rho2_ab[P] * rho_bk[P];
-                    tmp_val *= 0.5 * w[P];
-                    C_DAXPY(nlocal, tmp_val, phi[P], 1, Tap[P], 1);
-
-                    tmp_val = v2_rho2_bb[P] * rho_bk[P];
-                    tmp_val += v2_rho2_ab[P] * rho_ak[P];
-                    tmp_val *= 0.5 * w[P];
-                    C_DAXPY(nlocal, tmp_val, phi[P], 1, Tbp[P], 1);
+                // ∇ρk = einsum("mnσ, pm, pn -> pσ", add_trans(Dk, (1, 0, 2)), ∇φ, φ)
+                //  Γk = add_trans(einsum("xpσ, xpτ -> pστ", ∇ρk, ∇ρ), (0, 2, 1))
+                if (ansatz >= 1) {
+                    for (int P = 0; P < npoints; P++) {
+                        // Alpha
+                        rho_ak_x[P] = C_DDOT(nlocal, phi_x[P], 1, Ta + P * ld, 1);
+                        rho_ak_y[P] = C_DDOT(nlocal, phi_y[P], 1, Ta + P * ld, 1);
+                        rho_ak_z[P] = C_DDOT(nlocal, phi_z[P], 1, Ta + P * ld, 1);
+                        gamma_aak[P] = rho_ak_x[P] * rho_ax[P];
+                        gamma_aak[P] += rho_ak_y[P] * rho_ay[P];
+                        gamma_aak[P] += rho_ak_z[P] * rho_az[P];
+                        gamma_aak[P] *= 2.0;
+
+                        // Beta
+                        rho_bk_x[P] = C_DDOT(nlocal, phi_x[P], 1, Tb + P * ld, 1);
+                        rho_bk_y[P] = C_DDOT(nlocal, phi_y[P], 1, Tb + P * ld, 1);
+                        rho_bk_z[P] = C_DDOT(nlocal, phi_z[P], 1, Tb + P * ld, 1);
+                        gamma_bbk[P] = rho_bk_x[P] * rho_bx[P];
+                        gamma_bbk[P] += rho_bk_y[P] * rho_by[P];
+                        gamma_bbk[P] += rho_bk_z[P] * rho_bz[P];
+                        gamma_bbk[P] *= 2.0;
+
+                        // Alpha-Beta
+                        gamma_abk[P] = rho_ak_x[P] * rho_bx[P] + rho_bk_x[P] * rho_ax[P];
+                        gamma_abk[P] += rho_ak_y[P] * rho_by[P] + rho_bk_y[P] * rho_ay[P];
+                        gamma_abk[P] += rho_ak_z[P] * rho_bz[P] + rho_bk_z[P] * rho_az[P];
+                    }
                 }
-            }
-
-            // ===> GGA contribution <=== //
-            if (ansatz >= 1) {
-                // ====> Define pointers for future use <====
-                auto gamma_aa = pworker->point_value("GAMMA_AA")->pointer();
-                auto gamma_ab = pworker->point_value("GAMMA_AB")->pointer();
-                auto gamma_bb = pworker->point_value("GAMMA_BB")->pointer();
-
-                auto v_gamma_aa = vals["V_GAMMA_AA"]->pointer();
-                auto v_gamma_ab = vals["V_GAMMA_AB"]->pointer();
-                auto v_gamma_bb = vals["V_GAMMA_BB"]->pointer();
-
-                auto v2_gamma_aa_gamma_aa = vals["V_GAMMA_AA_GAMMA_AA"]->pointer();
-                auto v2_gamma_aa_gamma_ab = vals["V_GAMMA_AA_GAMMA_AB"]->pointer();
-                auto v2_gamma_aa_gamma_bb = vals["V_GAMMA_AA_GAMMA_BB"]->pointer();
-                auto v2_gamma_ab_gamma_ab = vals["V_GAMMA_AB_GAMMA_AB"]->pointer();
-                auto v2_gamma_ab_gamma_bb = vals["V_GAMMA_AB_GAMMA_BB"]->pointer();
-                auto v2_gamma_bb_gamma_bb = vals["V_GAMMA_BB_GAMMA_BB"]->pointer();
-
-                auto v2_rho_a_gamma_aa = vals["V_RHO_A_GAMMA_AA"]->pointer();
-                auto v2_rho_a_gamma_ab = vals["V_RHO_A_GAMMA_AB"]->pointer();
-                auto v2_rho_a_gamma_bb = vals["V_RHO_A_GAMMA_BB"]->pointer();
-                auto v2_rho_b_gamma_aa = vals["V_RHO_B_GAMMA_AA"]->pointer();
-                auto v2_rho_b_gamma_ab = vals["V_RHO_B_GAMMA_AB"]->pointer();
-                auto v2_rho_b_gamma_bb = vals["V_RHO_B_GAMMA_BB"]->pointer();
-
-                double tmp_val = 0.0, v2_val_aa = 0.0, v2_val_ab = 0.0, v2_val_bb = 0.0;
-
-                // There are lots of GGA terms.
+                parallel_timer_off("Derivative Properties", rank);
+
+                parallel_timer_on("V_XCd", rank);
+                // ===> LSDA contribution (symmetrized) <=== //
+                //                                                  ∂^2
+                // Ta, Tb := 1/2 einsum("p, pστ, pm, pτ -> pmσ", w, ---- f , ρk, φ)
+                //                                                  ∂ρ^2
+                double tmp_val = 0.0, tmp_ab_val = 0.0;
                 for (int P = 0; P < npoints; P++) {
-                    if (rho_a[P] + rho_b[P] < v2_rho_cutoff_) continue;
-                    // ====> Term 2b, V in DOI: 10.1063/1.466887 <====
-                    //                                                    ∂^2
-                    // Ta, Tb += 1/2 einsum("p, pτσυ, pσυ, pr -> prτ", w, ---- f, Γk, φ)[τ = α, β]
-                    //                                                    ∂ρ∂γ
-                    // V alpha contributions
-                    tmp_val = v2_rho_a_gamma_aa[P] * gamma_aak[P];
-                    tmp_val += v2_rho_a_gamma_ab[P] * gamma_abk[P];
-                    tmp_val += v2_rho_a_gamma_bb[P] * gamma_bbk[P];
-                    C_DAXPY(nlocal, (0.5 * w[P] * tmp_val), phi[P], 1, Tap[P], 1);
-
-                    // V beta contributions
-                    tmp_val = v2_rho_b_gamma_aa[P] * gamma_aak[P];
-                    tmp_val += v2_rho_b_gamma_ab[P] * gamma_abk[P];
-                    tmp_val += v2_rho_b_gamma_bb[P] * gamma_bbk[P];
-                    C_DAXPY(nlocal, (0.5 * w[P] * tmp_val), phi[P], 1, Tbp[P], 1);
-
-                    // ====> All other terms, W in above DOI  <==== //
-                    // Compute α block of final result.
-
-                    //                                  ∂^2
-                    // temp = einsum("pτσυ, pτ -> pσυ", ---- f, ρk)[συ = αα, αβ]
-                    //                                  ∂ρ∂γ
-
-                    // Define ρk[τ=α] terms in 2a intermediate
-                    v2_val_aa = v2_rho_a_gamma_aa[P] * rho_ak[P];
-                    v2_val_ab = v2_rho_a_gamma_ab[P] * rho_ak[P];
-
-                    // Define ρk[τ=β] terms in 2a intermediate
-                    v2_val_aa += v2_rho_b_gamma_aa[P] * rho_bk[P];
-                    v2_val_ab += v2_rho_b_gamma_ab[P] * rho_bk[P];
+                    std::fill(Ta + P * ld, Ta + P * ld + nlocal, 0.0);
+                    std::fill(Tb + P * ld, Tb + P * ld + nlocal, 0.0);
+
+                    // Do a simple screen: ignore contributions where rho is too small.
+                    if (rho_a[P] + rho_b[P] > v2_rho_cutoff_) {
+                        tmp_val = v2_rho2_aa[P] * rho_ak[P];
+                        tmp_val += v2_rho2_ab[P] * rho_bk[P];
+                        tmp_val *= 0.5 * w[P];
+                        C_DAXPY(nlocal, tmp_val, phi[P], 1, Ta + P * ld, 1);
+
+                        tmp_val = v2_rho2_bb[P] * rho_bk[P];
+                        tmp_val += v2_rho2_ab[P] * rho_ak[P];
+                        tmp_val *= 0.5 * w[P];
+                        C_DAXPY(nlocal, tmp_val, phi[P], 1, Tb + P * ld, 1);
+                    }
+                }
+
+                // ===> GGA contribution <=== //
+                if (ansatz >= 1) {
+                    // ====> Define pointers for future use <====
+                    auto gamma_aa = pworker->point_value("GAMMA_AA")->pointer();
+                    auto gamma_ab = pworker->point_value("GAMMA_AB")->pointer();
+                    auto gamma_bb = pworker->point_value("GAMMA_BB")->pointer();
+
+                    auto v_gamma_aa = vals["V_GAMMA_AA"]->pointer();
+                    auto v_gamma_ab = vals["V_GAMMA_AB"]->pointer();
+                    auto v_gamma_bb = vals["V_GAMMA_BB"]->pointer();
+
+                    auto v2_gamma_aa_gamma_aa = vals["V_GAMMA_AA_GAMMA_AA"]->pointer();
+                    auto v2_gamma_aa_gamma_ab = vals["V_GAMMA_AA_GAMMA_AB"]->pointer();
+                    auto v2_gamma_aa_gamma_bb = vals["V_GAMMA_AA_GAMMA_BB"]->pointer();
+                    auto v2_gamma_ab_gamma_ab = vals["V_GAMMA_AB_GAMMA_AB"]->pointer();
+                    auto v2_gamma_ab_gamma_bb = vals["V_GAMMA_AB_GAMMA_BB"]->pointer();
+                    auto v2_gamma_bb_gamma_bb = vals["V_GAMMA_BB_GAMMA_BB"]->pointer();
+
+                    auto v2_rho_a_gamma_aa = vals["V_RHO_A_GAMMA_AA"]->pointer();
+                    auto v2_rho_a_gamma_ab = vals["V_RHO_A_GAMMA_AB"]->pointer();
+                    auto v2_rho_a_gamma_bb = vals["V_RHO_A_GAMMA_BB"]->pointer();
+                    auto v2_rho_b_gamma_aa = vals["V_RHO_B_GAMMA_AA"]->pointer();
+                    auto v2_rho_b_gamma_ab = vals["V_RHO_B_GAMMA_AB"]->pointer();
+                    auto v2_rho_b_gamma_bb = vals["V_RHO_B_GAMMA_BB"]->pointer();
+
+                    double tmp_val = 0.0, v2_val_aa = 0.0, v2_val_ab = 0.0, v2_val_bb = 0.0;
+
+                    // There are lots of GGA terms.
+                    for (int P = 0; P < npoints; P++) {
+                        if (rho_a[P] + rho_b[P] < v2_rho_cutoff_) continue;
+                        // ====> Term 2b, V in DOI: 10.1063/1.466887 <====
+                        //                                                    ∂^2
+                        // Ta, Tb += 1/2 einsum("p, pτσυ, pσυ, pr -> prτ", w, ---- f, Γk, φ)[τ = α, β]
+                        //                                                    ∂ρ∂γ
+                        // V alpha contributions
+                        tmp_val = v2_rho_a_gamma_aa[P] * gamma_aak[P];
+                        tmp_val += v2_rho_a_gamma_ab[P] * gamma_abk[P];
+                        tmp_val += v2_rho_a_gamma_bb[P] * gamma_bbk[P];
+                        C_DAXPY(nlocal, (0.5 * w[P] * tmp_val), phi[P], 1, Ta + P * ld, 1);
+
+                        // V beta contributions
+                        tmp_val = v2_rho_b_gamma_aa[P] * gamma_aak[P];
+                        tmp_val += v2_rho_b_gamma_ab[P] * gamma_abk[P];
+                        tmp_val += v2_rho_b_gamma_bb[P] * gamma_bbk[P];
+                        C_DAXPY(nlocal, (0.5 * w[P] * tmp_val), phi[P], 1, Tb + P * ld, 1);
+
+                        // ====> All other terms, W in above DOI  <==== //
+                        // Compute α block of final result.
+
+                        //                                  ∂^2
+                        // temp = einsum("pτσυ, pτ -> pσυ", ---- f, ρk)[συ = αα, αβ]
+                        //                                  ∂ρ∂γ
+
+                        // Define ρk[τ=α] terms in 2a intermediate
+                        v2_val_aa = v2_rho_a_gamma_aa[P] * rho_ak[P];
+                        v2_val_ab = v2_rho_a_gamma_ab[P] * rho_ak[P];
+
+                        // Define ρk[τ=β] terms in 2a intermediate
+                        v2_val_aa += v2_rho_b_gamma_aa[P] * rho_bk[P];
+                        v2_val_ab += v2_rho_b_gamma_ab[P] * rho_bk[P];
                     
-                    //                                     ∂^2
-                    // temp += einsum("pσυτχ, pτχ -> pσυ", ---- f, Γk)[συ = αα, αβ]
-                    //                                     ∂γ∂γ
+                        //                                     ∂^2
+                        // temp += einsum("pσυτχ, pτχ -> pσυ", ---- f, Γk)[συ = αα, αβ]
+                        //                                     ∂γ∂γ
 
-                    // Define Γk[τχ=αα] terms in 3 intermediate
-                    v2_val_aa += v2_gamma_aa_gamma_aa[P] * gamma_aak[P];
-                    v2_val_ab += v2_gamma_aa_gamma_ab[P] * gamma_aak[P];
+                        // Define Γk[τχ=αα] terms in 3 intermediate
+                        v2_val_aa += v2_gamma_aa_gamma_aa[P] * gamma_aak[P];
+                        v2_val_ab += v2_gamma_aa_gamma_ab[P] * gamma_aak[P];
 
-                    // Define Γk[τχ=αβ] terms in 3 intermediate
-                    v2_val_aa += v2_gamma_aa_gamma_ab[P] * gamma_abk[P];
-                    v2_val_ab += v2_gamma_ab_gamma_ab[P] * gamma_abk[P];
+                        // Define Γk[τχ=αβ] terms in 3 intermediate
+                        v2_val_aa += v2_gamma_aa_gamma_ab[P] * gamma_abk[P];
+                        v2_val_ab += v2_gamma_ab_gamma_ab[P] * gamma_abk[P];
 
-                    // Define Γk[τχ=ββ] terms in 3 intermediate
-                    v2_val_aa += v2_gamma_aa_gamma_bb[P] * gamma_bbk[P];
-                    v2_val_ab += v2_gamma_ab_gamma_bb[P] * gamma_bbk[P];
+                        // Define Γk[τχ=ββ] terms in 3 intermediate
+                        v2_val_aa += v2_gamma_aa_gamma_bb[P] * gamma_bbk[P];
+                        v2_val_ab += v2_gamma_ab_gamma_bb[P] * gamma_bbk[P];
 
-                    // Compute W terms, first 1 and then 2a and 3 at once
+                        // Compute W terms, first 1 and then 2a and 3 at once
        
-                    //                                         ∂
-                    // temp2 = einsum("p, pστ, xpτ -> xpσ", w, -- f, ∇ρk)[σ = α]
-                    //                                         ∂Γ
-                    // temp2 += einsum("p, pσυ, xpυ -> xpσ", w, temp, ∇ρ)[σ = α]
-                    //   N.B. A prefactor of 2 on the same-spin terms accounts for using γ rather than Γ in defining temp.
-                    // Ta += einsum("xpσ, xpm -> pmσ", temp2, ∇φ)[σ = α]
-
-                    // Wx
-                    tmp_val = 2.0 * v_gamma_aa[P] * rho_ak_x[P];
-                    tmp_val += v_gamma_ab[P] * rho_bk_x[P];
-                    tmp_val += 2.0 * v2_val_aa * rho_ax[P];
-                    tmp_val += v2_val_ab * rho_bx[P];
-                    tmp_val *= w[P];
-
-                    C_DAXPY(nlocal, tmp_val, phi_x[P], 1, Tap[P], 1);
-
-                    // Wy
-                    tmp_val = 2.0 * v_gamma_aa[P] * rho_ak_y[P];
-                    tmp_val += v_gamma_ab[P] * rho_bk_y[P];
-                    tmp_val += 2.0 * v2_val_aa * rho_ay[P];
-                    tmp_val += v2_val_ab * rho_by[P];
-                    tmp_val *= w[P];
-
-                    C_DAXPY(nlocal, tmp_val, phi_y[P], 1, Tap[P], 1);
-
-                    // Wz
-                    tmp_val = 2.0 * v_gamma_aa[P] * rho_ak_z[P];
-                    tmp_val += v_gamma_ab[P] * rho_bk_z[P];
-                    tmp_val += 2.0 * v2_val_aa * rho_az[P];
-                    tmp_val += v2_val_ab * rho_bz[P];
-                    tmp_val *= w[P];
-
-                    C_DAXPY(nlocal, tmp_val, phi_z[P], 1, Tap[P], 1);
-
-                    // Compute β block of final result.
+                        //                                         ∂
+                        // temp2 = einsum("p, pστ, xpτ -> xpσ", w, -- f, ∇ρk)[σ = α]
+                        //                                         ∂Γ
+                        // temp2 += einsum("p, pσυ, xpυ -> xpσ", w, temp, ∇ρ)[σ = α]
+                        //   N.B. A prefactor of 2 on the same-spin terms accounts for using γ rather than Γ in defining temp.
+                        // Ta += einsum("xpσ, xpm -> pmσ", temp2, ∇φ)[σ = α]
+
+                        // Wx
+                        tmp_val = 2.0 * v_gamma_aa[P] * rho_ak_x[P];
+                        tmp_val += v_gamma_ab[P] * rho_bk_x[P];
+                        tmp_val += 2.0 * v2_val_aa * rho_ax[P];
+                        tmp_val += v2_val_ab * rho_bx[P];
+                        tmp_val *= w[P];
+
+                        C_DAXPY(nlocal, tmp_val, phi_x[P], 1, Ta + P * ld, 1);
+
+                        // Wy
+                        tmp_val = 2.0 * v_gamma_aa[P] * rho_ak_y[P];
+                        tmp_val += v_gamma_ab[P] * rho_bk_y[P];
+                        tmp_val += 2.0 * v2_val_aa * rho_ay[P];
+                        tmp_val += v2_val_ab * rho_by[P];
+                        tmp_val *= w[P];
+
+                        C_DAXPY(nlocal, tmp_val, phi_y[P], 1, Ta + P * ld, 1);
+
+                        // Wz
+                        tmp_val = 2.0 * v_gamma_aa[P] * rho_ak_z[P];
+                        tmp_val += v_gamma_ab[P] * rho_bk_z[P];
+                        tmp_val += 2.0 * v2_val_aa * rho_az[P];
+                        tmp_val += v2_val_ab * rho_bz[P];
+                        tmp_val *= w[P];
+
+                        C_DAXPY(nlocal, tmp_val, phi_z[P], 1, Ta + P * ld, 1);
+
+                        // Compute β block of final result.
                     
-                    //                                  ∂^2
-                    // temp = einsum("pτσυ, pτ -> pσυ", ---- f, ρk)[συ = ββ, αβ]
-                    //                                  ∂ρ∂γ
+                        //                                  ∂^2
+                        // temp = einsum("pτσυ, pτ -> pσυ", ---- f, ρk)[συ = ββ, αβ]
+                        //                                  ∂ρ∂γ
 
-                    // Define ρk[τ=α] terms in 2a intermediate
-                    v2_val_bb = v2_rho_a_gamma_bb[P] * rho_ak[P];
-                    v2_val_ab = v2_rho_a_gamma_ab[P] * rho_ak[P];
+                        // Define ρk[τ=α] terms in 2a intermediate
+                        v2_val_bb = v2_rho_a_gamma_bb[P] * rho_ak[P];
+                        v2_val_ab = v2_rho_a_gamma_ab[P] * rho_ak[P];
 
-                    // Define ρk[τ=β] terms in 2a intermediate
-                    v2_val_bb += v2_rho_b_gamma_bb[P] * rho_bk[P];
-                    v2_val_ab += v2_rho_b_gamma_ab[P] * rho_bk[P];
+                        // Define ρk[τ=β] terms in 2a intermediate
+                        v2_val_bb += v2_rho_b_gamma_bb[P] * rho_bk[P];
+                        v2_val_ab += v2_rho_b_gamma_ab[P] * rho_bk[P];
 
-                    // Define Γk[τχ=ββ] terms in 3 intermediate
-                    v2_val_bb += v2_gamma_bb_gamma_bb[P] * gamma_bbk[P];
-                    v2_val_ab += v2_gamma_ab_gamma_bb[P] * gamma_bbk[P];
+                        // Define Γk[τχ=ββ] terms in 3 intermediate
+                        v2_val_bb += v2_gamma_bb_gamma_bb[P] * gamma_bbk[P];
+                        v2_val_ab += v2_gamma_ab_gamma_bb[P] * gamma_bbk[P];
 
-                    // Define Γk[τχ=αβ] terms in 3 intermediate
-                    v2_val_bb += v2_gamma_ab_gamma_bb[P] * gamma_abk[P];
-                    v2_val_ab += v2_gamma_ab_gamma_ab[P] * gamma_abk[P];
+                        // Define Γk[τχ=αβ] terms in 3 intermediate
+                        v2_val_bb += v2_gamma_ab_gamma_bb[P] * gamma_abk[P];
+                        v2_val_ab += v2_gamma_ab_gamma_ab[P] * gamma_abk[P];
 
-                    // Define Γk[τχ=αα] terms in 3 intermediate
-                    v2_val_bb += v2_gamma_aa_gamma_bb[P] * gamma_aak[P];
-                    v2_val_ab += v2_gamma_aa_gamma_ab[P] * gamma_aak[P];
+                        // Define Γk[τχ=αα] terms in 3 intermediate
+                        v2_val_bb += v2_gamma_aa_gamma_bb[P] * gamma_aak[P];
+                        v2_val_ab += v2_gamma_aa_gamma_ab[P] * gamma_aak[P];
 
-                    // Compute W terms, first 1 and then 2a and 3 at once
+                        // Compute W terms, first 1 and then 2a and 3 at once
        
-                    //                                         ∂
-                    // temp2 = einsum("p, pστ, xpτ -> xpσ", w, -- f, ∇ρk)[σ = β]
-                    //                                         ∂Γ
-                    // temp2 += einsum("p, pσυ, xpυ -> xpσ", w, temp, ∇ρ)[σ = β]
-                    //   N.B. That a prefactor of 2 on the same-spin terms accounts for using γ rather than Γ in defining temp.
-                    // Tb += einsum("xpσ, xpm -> pmσ", temp2, ∇φ)[σ = β]
-
-                    // Wx
-                    tmp_val = 2.0 * v_gamma_bb[P] * rho_bk_x[P];
-                    tmp_val += v_gamma_ab[P] * rho_ak_x[P];
-                    tmp_val += 2.0 * v2_val_bb * rho_bx[P];
-                    tmp_val += v2_val_ab * rho_ax[P];
-                    tmp_val *= w[P];
-
-                    C_DAXPY(nlocal, tmp_val, phi_x[P], 1, Tbp[P], 1);
-
-                    // Wy
-                    tmp_val = 2.0 * v_gamma_bb[P] * rho_bk_y[P];
-                    tmp_val += v_gamma_ab[P] * rho_ak_y[P];
-                    tmp_val += 2.0 * v2_val_bb * rho_by[P];
-                    tmp_val += v2_val_ab * rho_ay[P];
-                    tmp_val *= w[P];
-
-                    C_DAXPY(nlocal, tmp_val, phi_y[P], 1, Tbp[P], 1);
-
-                    // Wz
-                    tmp_val = 2.0 * v_gamma_bb[P] * rho_bk_z[P];
-                    tmp_val += v_gamma_ab[P] * rho_ak_z[P];
-                    tmp_val += 2.0 * v2_val_bb * rho_bz[P];
-                    tmp_val += v2_val_ab * rho_az[P];
-                    tmp_val *= w[P];
-
-                    C_DAXPY(nlocal, tmp_val, phi_z[P], 1, Tbp[P], 1);
-                }
-            }
-
-            // ===> Contract Ta and Tb aginst φ, replacing a point index with  an AO index <===
-            C_DGEMM('T', 'N', nlocal, nlocal, npoints, 1.0, phi[0], coll_funcs, Tap[0], max_functions, 0.0,
-                    Vax_localp[0], max_functions);
-            C_DGEMM('T', 'N', nlocal, nlocal, npoints, 1.0, phi[0], coll_funcs, Tbp[0], max_functions, 0.0,
-                    Vbx_localp[0], max_functions);
-
-            // ===> Add the adjoint to complete the LDA and GGA contributions  <===
-            for (int m = 0; m < nlocal; m++) {
-                for (int n = 0; n <= m; n++) {
-                    Vax_localp[m][n] = Vax_localp[n][m] = Vax_localp[m][n] + Vax_localp[n][m];
-                    Vbx_localp[m][n] = Vbx_localp[n][m] = Vbx_localp[m][n] + Vbx_localp[n][m];
+                        //                                         ∂
+                        // temp2 = einsum("p, pστ, xpτ -> xpσ", w, -- f, ∇ρk)[σ = β]
+                        //                                         ∂Γ
+                        // temp2 += einsum("p, pσυ, xpυ -> xpσ", w, temp, ∇ρ)[σ = β]
+                        //   N.B. That a prefactor of 2 on the same-spin terms accounts for using γ rather than Γ in defining temp.
+                        // Tb += einsum("xpσ, xpm -> pmσ", temp2, ∇φ)[σ = β]
+
+                        // Wx
+                        tmp_val = 2.0 * v_gamma_bb[P] * rho_bk_x[P];
+                        tmp_val += v_gamma_ab[P] * rho_ak_x[P];
+                        tmp_val += 2.0 * v2_val_bb * rho_bx[P];
+                        tmp_val += v2_val_ab * rho_ax[P];
+                        tmp_val *= w[P];
+
+                        C_DAXPY(nlocal, tmp_val, phi_x[P], 1, Tb + P * ld, 1);
+
+                        // Wy
+                        tmp_val = 2.0 * v_gamma_bb[P] * rho_bk_y[P];
+                        tmp_val += v_gamma_ab[P] * rho_ak_y[P];
+                        tmp_val += 2.0 * v2_val_bb * rho_by[P];
+                        tmp_val += v2_val_ab * rho_ay[P];
+                        tmp_val *= w[P];
+
+                        C_DAXPY(nlocal, tmp_val, phi_y[P], 1, Tb + P * ld, 1);
+
+                        // Wz
+                        tmp_val = 2.0 * v_gamma_bb[P] * rho_bk_z[P];
+                        tmp_val += v_gamma_ab[P] * rho_ak_z[P];
+                        tmp_val += 2.0 * v2_val_bb * rho_bz[P];
+                        tmp_val += v2_val_ab * rho_az[P];
+                        tmp_val *= w[P];
+
+                        C_DAXPY(nlocal, tmp_val, phi_z[P], 1, Tb + P * ld, 1);
+                    }
                 }
+                parallel_timer_off("V_XCd", rank);
             }
 
-            // => Unpacking <= //
-            auto Vaxp = Vax_AO[dindex]->pointer();
-            auto Vbxp = Vbx_AO[dindex]->pointer();
-            for (int ml = 0; ml < nlocal; ml++) {
-                int mg = function_map[ml];
-                for (int nl = 0; nl < ml; nl++) {
-                    int ng = function_map[nl];
+            // ===> Contract Ta and Tb against φ, replacing a point index with an AO index <===
+            // One GEMM for the whole batch, into S
+            parallel_timer_on("V_XCd", rank);
+            C_DGEMM('T', 'N', nlocal, ld, npoints, 1.0, phi[0], coll_funcs, Tp, ld, 0.0, Sp, ld);
 
-#pragma omp atomic update
-                    Vaxp[mg][ng] += Vax_localp[ml][nl];
-#pragma omp atomic update
-                    Vaxp[ng][mg] += Vax_localp[ml][nl];
+            for (size_t d = 0; d < nd; d++) {
+                double* Vax = Sp + 2 * d * nlocal;
+                double* Vbx = Vax + nlocal;
 
-#pragma omp atomic update
-                    Vbxp[mg][ng] += Vbx_localp[ml][nl];
-#pragma omp atomic update
-                    Vbxp[ng][mg] += Vbx_localp[ml][nl];
+                // ===> Add the adjoint to complete the LDA and GGA contributions  <===
+                for (int m = 0; m < nlocal; m++) {
+                    for (int n = 0; n <= m; n++) {
+                        Vax[m * ld + n] = Vax[n * ld + m] = Vax[m * ld + n] + Vax[n * ld + m];
+                        Vbx[m * ld + n] = Vbx[n * ld + m] = Vbx[m * ld + n] + Vbx[n * ld + m];
+                    }
                 }
-#pragma omp atomic update
-                Vaxp[mg][mg] += Vax_localp[ml][ml];
-#pragma omp atomic update
-                Vbxp[mg][mg] += Vbx_localp[ml][ml];
+
+                // => Unpacking <= //
+                Vax_tiles[dstart + d]->add(*block, Vax, ld);
+                Vbx_tiles[dstart + d]->add(*block, Vbx, ld);
             }
             parallel_timer_off("V_XCd", rank);
         }
     }
+    for (size_t i = 0; i < Dx.size() / 2; i++) {
+        Vax_tiles[i]->merge(Vax_AO[i]);
+        Vbx_tiles[i]->merge(Vbx_AO[i]);
+    }
 
     // Set the result
     for (size_t i = 0; i < (Dx.size() / 2); i++) {
@@ -4114,7 +4234,6 @@ SharedMatrix UV::compute_hessian() {
     // ==> Build the target Hessian Matrix <==
     int natom = primary_->molecule()->natom();
     auto H = std::make_shared<Matrix>("XC Hessian", 3 * natom, 3 * natom);
-    auto Hp = H->pointer();
 
     // ==> Thread info <==
     int rank = 0;
@@ -4146,10 +4265,29 @@ SharedMatrix UV::compute_hessian() {
         Q_temp.push_back(std::make_shared<Vector>("Quadrature Tempt", max_points));
     }
 
-    auto QT = std::make_shared<Vector>("Quadrature Temp", max_points);
+    // The nine Cartesian blocks of the local Hessian and the directional temps are allocated once per thread
+    // rather than cloned on every block, and each thread accumulates into its own copy of the Hessian so that
+    // the blocks can be shared out without atomics.  The copies are summed once all blocks are done.
+    std::vector<SharedMatrix> H_local;
+    std::vector<std::vector<SharedMatrix>> H_blocks(num_threads_), U_local(num_threads_), T_local(num_threads_);
+    std::vector<std::vector<int>> centers_local(num_threads_);
+    for (size_t i = 0; i < num_threads_; i++) {
+        H_local.push_back(std::make_shared<Matrix>("XC Hessian Temp", 3 * natom, 3 * natom));
+        for (int c = 0; c < 9; c++) {
+            H_blocks[i].push_back(std::make_shared<Matrix>("H Temp", max_functions, max_functions));
+        }
+        for (int s = 0; s < 2; s++) {
+            U_local[i].push_back(std::make_shared<Matrix>("U Temp", max_points, max_functions));
+        }
+        for (int c = 0; c < 6; c++) {
+            T_local[i].push_back(std::make_shared<Matrix>("T Temp", max_points, max_functions));
+        }
+    }
+
     const auto& blocks = grid_->blocks();
 
     // => Master Loop <=
+#pragma omp parallel for private(rank) schedule(guided) num_threads(num_threads_)
     for (size_t Q = 0; Q < blocks.size(); Q++) {
         // ==> Get thread info <==
 #ifdef _OPENMP
@@ -4160,50 +4298,33 @@ SharedMatrix UV::compute_hessian() {
         auto fworker = functional_workers_[rank];
         auto pworker = point_workers_[rank];
         auto V2p = V_local[rank]->pointer();
+        auto Hl = H_local[rank]->pointer();
         auto Dap = pworker->D_scratch()[0]->pointer();
         auto Dbp = pworker->D_scratch()[1]->pointer();
-        auto tmpHXX = pworker->D_scratch()[0]->clone();
-        auto tmpHXY = pworker->D_scratch()[0]->clone();
-        auto tmpHXZ = pworker->D_scratch()[0]->clone();
-        auto tmpHYX = pworker->D_scratch()[0]->clone();
-        auto tmpHYY = pworker->D_scratch()[0]->clone();
-        auto tmpHYZ = pworker->D_scratch()[0]->clone();
-        auto tmpHZX = pworker->D_scratch()[0]->clone();
-        auto tmpHZY = pworker->D_scratch()[0]->clone();
-        auto tmpHZZ = pworker->D_scratch()[0]->clone();
-        auto pHXX = tmpHXX->pointer();
-        auto pHXY = tmpHXY->pointer();
-        auto pHXZ = tmpHXZ->pointer();
-        auto pHYX = tmpHYX->pointer();
-        auto pHYY = tmpHYY->pointer();
-        auto pHYZ = tmpHYZ->pointer();
-        auto pHZX = tmpHZX->pointer();
-        auto pHZY = tmpHZY->pointer();
-        auto pHZZ = tmpHZZ->pointer();
+        auto pHXX = H_blocks[rank][0]->pointer();
+        auto pHXY = H_blocks[rank][1]->pointer();
+        auto pHXZ = H_blocks[rank][2]->pointer();
+        auto pHYX = H_blocks[rank][3]->pointer();
+        auto pHYY = H_blocks[rank][4]->pointer();
+        auto pHYZ = H_blocks[rank][5]->pointer();
+        auto pHZX = H_blocks[rank][6]->pointer();
+        auto pHZY = H_blocks[rank][7]->pointer();
+        auto pHZZ = H_blocks[rank][8]->pointer();
 
         // Scratch
         auto Tap = pworker->scratch()[0]->pointer();
         auto Tbp = pworker->scratch()[1]->pointer();
         // This seems dangerous. Is making U spin-free a good idea?
-        auto Ua_local(pworker->scratch()[0]->clone());
-        auto Uap = Ua_local->pointer();
-        auto Ub_local(pworker->scratch()[1]->clone());
-        auto Ubp = Ub_local->pointer();
+        auto Uap = U_local[rank][0]->pointer();
+        auto Ubp = U_local[rank][1]->pointer();
 
-        // TODO: these need to be threaded eventually, to fit in with the new infrastructure
         // Directional Temps
-        auto Txa(Ua_local->clone());
-        auto Tya(Ua_local->clone());
-        auto Tza(Ua_local->clone());
-        auto Txb(Ub_local->clone());
-        auto Tyb(Ub_local->clone());
-        auto Tzb(Ub_local->clone());
-        auto pTx2a = Txa->pointer();
-        auto pTy2a = Tya->pointer();
-        auto pTz2a = Tza->pointer();
-        auto pTx2b = Txb->pointer();
-        auto pTy2b = Tyb->pointer();
-        auto pTz2b = Tzb->pointer();
+        auto pTx2a = T_local[rank][0]->pointer();
+        auto pTy2a = T_local[rank][1]->pointer();
+        auto pTz2a = T_local[rank][2]->pointer();
+        auto pTx2b = T_local[rank][3]->pointer();
+        auto pTy2b = T_local[rank][4]->pointer();
+        auto pTz2b = T_local[rank][5]->pointer();
 
         auto block = blocks[Q];
         int npoints = block->npoints();
@@ -4213,6 +4334,11 @@ SharedMatrix UV::compute_hessian() {
         auto w = block->w();
         const auto& function_map = block->functions_local_to_global();
         int nlocal = function_map.size();
+        auto& centers = centers_local[rank];
+        centers.resize(nlocal);
+        for (int ml = 0; ml < nlocal; ml++) {
+            centers[ml] = primary_->function_to_center(function_map[ml]);
+        }
 
         // ==> Compute values at points <==
         pworker->compute_points(block);
@@ -4270,22 +4396,22 @@ SharedMatrix UV::compute_hessian() {
             }
         }
         for (int ml = 0; ml < nlocal; ml++) {
-            int A = primary_->function_to_center(function_map[ml]);
+            int A = centers[ml];
             double Txx = C_DDOT(npoints, &Uap[0][ml], max_functions, &phi_xx[0][ml], coll_funcs);
             double Txy = C_DDOT(npoints, &Uap[0][ml], max_functions, &phi_xy[0][ml], coll_funcs);
             double Txz = C_DDOT(npoints, &Uap[0][ml], max_functions, &phi_xz[0][ml], coll_funcs);
             double Tyy = C_DDOT(npoints, &Uap[0][ml], max_functions, &phi_yy[0][ml], coll_funcs);
             double Tyz = C_DDOT(npoints, &Uap[0][ml], max_functions, &phi_yz[0][ml], coll_funcs);
             double Tzz = C_DDOT(npoints, &Uap[0][ml], max_functions, &phi_zz[0][ml], coll_funcs);
-            Hp[3 * A + 0][3 * A + 0] += Txx;
-            Hp[3 * A + 0][3 * A + 1] += Txy;
-            Hp[3 * A + 0][3 * A + 2] += Txz;
-            Hp[3 * A + 1][3 * A + 0] += Txy;
-            Hp[3 * A + 1][3 * A + 1] += Tyy;
-            Hp[3 * A + 1][3 * A + 2] += Tyz;
-            Hp[3 * A + 2][3 * A + 0] += Txz;
-            Hp[3 * A + 2][3 * A + 1] += Tyz;
-            Hp[3 * A + 2][3 * A + 2] += Tzz;
+            Hl[3 * A + 0][3 * A + 0] += Txx;
+            Hl[3 * A + 0][3 * A + 1] += Txy;
+            Hl[3 * A + 0][3 * A + 2] += Txz;
+            Hl[3 * A + 1][3 * A + 0] += Txy;
+            Hl[3 * A + 1][3 * A + 1] += Tyy;
+            Hl[3 * A + 1][3 * A + 2] += Tyz;
+            Hl[3 * A + 2][3 * A + 0] += Txz;
+            Hl[3 * A + 2][3 * A + 1] += Tyz;
+            Hl[3 * A + 2][3 * A + 2] += Tzz;
         }
 
         /*
@@ -4439,22 +4565,26 @@ SharedMatrix UV::compute_hessian() {
 
         // Accumulate contributions to the full Hessian: N.B. these terms are not symmetric!
         for (int ml = 0; ml < nlocal; ml++) {
-            int A = primary_->function_to_center(function_map[ml]);
+            int A = centers[ml];
             for (int nl = 0; nl < nlocal; nl++) {
-                int B = primary_->function_to_center(function_map[nl]);
-                Hp[3 * A + 0][3 * B + 0] += pHXX[ml][nl];
-                Hp[3 * A + 1][3 * B + 0] += pHYX[ml][nl];
-                Hp[3 * A + 2][3 * B + 0] += pHZX[ml][nl];
-                Hp[3 * A + 0][3 * B + 1] += pHXY[ml][nl];
-                Hp[3 * A + 1][3 * B + 1] += pHYY[ml][nl];
-                Hp[3 * A + 2][3 * B + 1] += pHZY[ml][nl];
-                Hp[3 * A + 0][3 * B + 2] += pHXZ[ml][nl];
-                Hp[3 * A + 1][3 * B + 2] += pHYZ[ml][nl];
-                Hp[3 * A + 2][3 * B + 2] += pHZZ[ml][nl];
+                int B = centers[nl];
+                Hl[3 * A + 0][3 * B + 0] += pHXX[ml][nl];
+                Hl[3 * A + 1][3 * B + 0] += pHYX[ml][nl];
+                Hl[3 * A + 2][3 * B + 0] += pHZX[ml][nl];
+                Hl[3 * A + 0][3 * B + 1] += pHXY[ml][nl];
+                Hl[3 * A + 1][3 * B + 1] += pHYY[ml][nl];
+                Hl[3 * A + 2][3 * B + 1] += pHZY[ml][nl];
+                Hl[3 * A + 0][3 * B + 2] += pHXZ[ml][nl];
+                Hl[3 * A + 1][3 * B + 2] += pHYZ[ml][nl];
+                Hl[3 * A + 2][3 * B + 2] += pHZZ[ml][nl];
             }
         }
     }
 
+    for (size_t i = 0; i < num_threads_; i++) {
+        H->add(H_local[i]);
+    }
+
     if (std::isnan(quad_values_["FUNCTIONAL"])) {
         throw PSIEXCEPTION("V: Integrated DFT functional to get NaN. The functional is not numerically stable. Pick a different one.");
     }
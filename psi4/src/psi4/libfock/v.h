@@ -30,6 +30,10 @@
 #define LIBFOCK_DFT_H
 #include "psi4/libmints/typedefs.h"
 #include "psi4/pragma.h"
+
+#include "collocation_cache.h"
+#include "shell_pair_tiles.h"
+
 #include <vector>
 #include <map>
 #include <unordered_map>
@@ -78,11 +82,12 @@ class PSI_API VBase {
     std::vector<std::shared_ptr<PointFunctions>> point_workers_;
     /// Integration grid, built by KSPotential
     std::shared_ptr<DFTGrid> grid_;
+    /// Significant shell pairs of grid_, for assembling V and Vx
+    std::shared_ptr<const ShellPairTiles::Pattern> grid_tiles_;
     /// Quadrature values obtained during integration
     std::map<std::string, double> quad_values_;
     // Caches collocation grids
-    std::unordered_map<size_t, std::map<std::string, SharedMatrix>> cache_map_;
-    int cache_map_deriv_;
+    CollocationCache collocation_cache_;
 
     /// AO2USO matrix (if not C1)
     SharedMatrix AO2USO_;
@@ -94,6 +99,25 @@ class PSI_API VBase {
     // GRAC data
     bool grac_initialized_;
 
+    /// Run the grid GEMMs of compute_V in single precision?
+    bool mixed_precision_;
+
+    /// Blocks whose density and density gradient bounds are both below this are skipped in compute_V
+    double block_density_tolerance_;
+    /// Offsets of each block into block_phi_bound_ and block_grad_bound_
+    std::vector<size_t> block_bound_start_;
+    /// Bounds on |phi| and |grad phi| over each block, per shell in block->shells_local_to_global()
+    std::vector<double> block_phi_bound_;
+    std::vector<double> block_grad_bound_;
+    /// Blocks skipped by the last call to screen_blocks
+    size_t nblocks_skipped_;
+
+    /// Builds the per-block shell bounds from the shell exponents and the block bounding spheres
+    void build_block_bounds();
+    /// Flags the blocks that may carry density above block_density_tolerance_ for the AO densities D,
+    /// whose sum times scale is the total density
+    std::vector<char> screen_blocks(const std::vector<SharedMatrix>& D, double scale = 1.0);
+
     // VV10 dispersion, return vv10_nlc energy
     void prepare_vv10_cache(DFTGrid& nlgrid, SharedMatrix D,
                             std::vector<std::map<std::string, SharedVector>>& vv10_cache,
@@ -119,10 +143,12 @@ class PSI_API VBase {
     std::shared_ptr<BlockOPoints> get_block(int block);
     size_t nblocks();
     std::map<std::string, double>& quadrature_values() { return quad_values_; }
+    /// Blocks left out of the last compute_V by the density screening (DFT_BLOCK_DENSITY_TOLERANCE)
+    size_t nblocks_skipped() const { return nblocks_skipped_; }
 
-    // Creates a collocation cache map based on stride
+    // Fills the collocation cache, most expensive blocks first, until memory (in doubles) runs out
     void build_collocation_cache(size_t memory);
-    void clear_collocation_cache() { cache_map_.clear(); }
+    void clear_collocation_cache() { collocation_cache_.clear(); }
 
     // Set the D matrix, get it back if needed
     void set_D(std::vector<SharedMatrix> Dvec);
@@ -131,12 +157,20 @@ class PSI_API VBase {
     // Set the site of the grac shift
     void set_grac_shift(double value);
 
+    // Toggle the single-precision grid GEMMs of compute_V, accumulated into double-precision V and energies
+    void set_mixed_precision(bool mixed_precision) { mixed_precision_ = mixed_precision; }
+    bool mixed_precision() const { return mixed_precision_; }
+
     /// Throws by default
     virtual void compute_V(std::vector<SharedMatrix> ret);
     /// Throws by default. Compute the orbital derivative of the KS potential for each spin,
     /// contract against Dx, and putting the result in ret.
     virtual void compute_Vx(const std::vector<SharedMatrix> Dx, std::vector<SharedMatrix> ret);
-    virtual std::vector<SharedMatrix> compute_fock_derivatives();
+    /// Throws by default. The XC part of the Fock derivatives with respect to the Cartesian displacements of
+    /// atoms first_atom, ..., first_atom + natom_batch - 1 (x, y, z per atom; alpha and beta interleaved for UKS).
+    virtual std::vector<SharedMatrix> compute_fock_derivatives(int first_atom, int natom_batch);
+    /// All atoms at once
+    std::vector<SharedMatrix> compute_fock_derivatives();
     virtual SharedMatrix compute_gradient();
     virtual SharedMatrix compute_hessian();
 
@@ -184,7 +218,8 @@ class RV : public VBase {
     /// And no, we can't just make singlet a default argument. Then compute_Vx has different signatures for
     /// different VBase subclasses, so we can't call compute_Vx from VBase, which breaks the hessian code.
     void compute_Vx(const std::vector<SharedMatrix> Dx, std::vector<SharedMatrix> ret) override { compute_Vx_full(Dx, ret, true); };
-    std::vector<SharedMatrix> compute_fock_derivatives() override;
+    using VBase::compute_fock_derivatives;
+    std::vector<SharedMatrix> compute_fock_derivatives(int first_atom, int natom_batch) override;
     SharedMatrix compute_gradient() override;
     SharedMatrix compute_hessian() override;
 
@@ -205,7 +240,8 @@ class UV : public VBase {
     /// putting the result in ret. ret[i] is Vx where x = Dx[i].
     /// ret[2n], ret[2n+1] are alpha and beta Vx where x concatenates Dx[2n] (α) and Dx[2n+1] (β).
     void compute_Vx(const std::vector<SharedMatrix> Dx, std::vector<SharedMatrix> ret) override;
-    std::vector<SharedMatrix> compute_fock_derivatives() override;
+    using VBase::compute_fock_derivatives;
+    std::vector<SharedMatrix> compute_fock_derivatives(int first_atom, int natom_batch) override;
     SharedMatrix compute_gradient() override;
     SharedMatrix compute_hessian() override;
 
@@ -53,6 +53,7 @@
 #include <memory>
 #include <regex>
 #include <stdexcept>
+#include <cstdint>
 #include <cstdio>
 #include <iomanip>
 #include <cstdlib>
@@ -80,6 +81,15 @@ std::string to_upper_copy(const std::string &original) {
     to_upper(upper);
     return upper;
 }
+
+// 64-bit FNV-1a hash of the bytes of data
+void fnv1a_add(uint64_t &hash, const void *data, size_t size) {
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+}
 }  // namespace
 
 // Constructs a zero AO basis set
@@ -1283,3 +1293,27 @@ void BasisSet::negative_gaussian_normalization_to_coefficients() {
   // the usual renormalization steps
   update_l2_shells(false);
 }
+
+std::string BasisSet::fingerprint(bool centers) const {
+    uint64_t hash = 14695981039346656037ULL;
+    fnv1a_add(hash, &n_shells_, sizeof(n_shells_));
+    fnv1a_add(hash, &nbf_, sizeof(nbf_));
+    for (int P = 0; P < n_shells_; P++) {
+        const GaussianShell &sh = shell(P);
+        int am = sh.am();
+        bool pure = sh.is_pure();
+        int nprim = sh.nprimitive();
+        fnv1a_add(hash, &am, sizeof(am));
+        fnv1a_add(hash, &pure, sizeof(pure));
+        fnv1a_add(hash, &nprim, sizeof(nprim));
+        fnv1a_add(hash, sh.exps(), sizeof(double) * nprim);
+        fnv1a_add(hash, sh.coefs(), sizeof(double) * nprim);
+        if (centers) {
+            const double *center = sh.center();
+            fnv1a_add(hash, center, 3 * sizeof(double));
+        }
+    }
+    char buffer[17];
+    snprintf(buffer, sizeof(buffer), "%016llx", (unsigned long long)hash);
+    return std::string(buffer);
+}
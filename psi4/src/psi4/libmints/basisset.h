@@ -328,6 +328,10 @@ class PSI_API BasisSet {
     const std::string &target() const { return target_; }
     void set_target(const std::string str) { target_ = str; }
 
+    /// Hash of the angular momenta, exponents and contraction coefficients of the shells, and optionally of
+    /// their centers, so that identical basis sets can be recognized whatever their name
+    std::string fingerprint(bool centers = false) const;
+
     /** Print basis set information according to the level of detail in print_level
      *  @param out The file stream to use for printing. Defaults to outfile.
      *  @param print_level  < 1: Nothing
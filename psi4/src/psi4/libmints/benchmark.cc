@@ -2251,11 +2251,12 @@ void benchmark_integrals(int max_am, double min_time) {
     int_types.push_back("3C ERI");
     int_types.push_back("3C Overlap");
     int_types.push_back("4C ERI");
+    int_types.push_back("4C ERI Batch");
 
     std::vector<int> centers;
     for (int k = 0; k < 6; k++) centers.push_back(2);
     for (int k = 0; k < 2; k++) centers.push_back(3);
-    for (int k = 0; k < 1; k++) centers.push_back(4);
+    for (int k = 0; k < 2; k++) centers.push_back(4);
 
     std::map<int, int> ncombinations;
     ncombinations[2] = max_shell * max_shell;
@@ -2517,6 +2518,34 @@ void benchmark_integrals(int max_am, double min_time) {
         }
     }
 
+    // 4C ERI, through the batched interface
+    this_type = "4C ERI Batch";
+    this_ncenter = 4;
+    // Each batch holds the same quartet with its pairs in the (larger, smaller) shell order
+    // for which the engine keeps precomputed pair data
+    const size_t batch_length = 16;
+    for (int P = 0, index = 0; P < max_shell; P++) {
+        for (int Q = 0; Q < max_shell; Q++) {
+            for (int R = 0; R < max_shell; R++) {
+                for (int S = 0; S < max_shell; S++, index++) {
+                    std::vector<ShellQuartet> batch(
+                        batch_length, ShellQuartet{Q + max_shell, P, S + max_shell * 3, R + max_shell * 2});
+                    T = 0.0;
+                    rounds = 0L;
+                    qq = new Timer();
+                    while (T < min_time) {
+                        e4c->compute_shell_batch(batch);
+                        T = qq->get();
+                        rounds++;
+                    }
+                    delete qq;
+                    t = T / (double)(batch_length * rounds * n_per_combination[this_ncenter][index]);
+                    timings[this_type][index] = t;
+                }
+            }
+        }
+    }
+
     outfile->Printf("\n");
     outfile->Printf("                              ----------------------------------- \n");
     outfile->Printf("                              ======> INTEGRALS BENCHMARKS <===== \n");
@@ -2537,6 +2566,7 @@ void benchmark_integrals(int max_am, double min_time) {
     outfile->Printf("    -Timings are reported per double produced (function combination and possibly direction).\n");
     outfile->Printf("     Therefore, the cost for a (p|p) overlap shell would be 9x the value reported, while the\n");
     outfile->Printf("     cost for a (p|p) dipole shell would be 27x the value reported.\n");
+    outfile->Printf("    -4C ERI Batch computes each combination %zu times per compute_shell_batch call.\n", batch_length);
     outfile->Printf("\n");
 
     outfile->Printf("Test Basis Set:\n");
@@ -102,6 +102,9 @@ class Libint2TwoElectronInt : public TwoBodyAOInt {
     //! Setup metadata and screening info
     void common_init();
 
+    //! Precomputed libint2 data of shell pair (s1 s2|, or nullptr if there is none
+    const libint2::ShellPair *shell_pair_data(int s1, int s2) const;
+
    public:
     //! Constructor. Use an IntegralFactory to create this object.
     Libint2TwoElectronInt(const IntegralFactory *integral, int deriv = 0, double screening_threshold = 0,
@@ -121,6 +124,9 @@ class Libint2TwoElectronInt : public TwoBodyAOInt {
     /// Compute ERIs between 4 shells. Result is stored in buffer.
     size_t compute_shell(int s1, int s2, int s3, int s4) override;
 
+    /// Compute ERIs for a list of quartets, reusing the precomputed shell pair data. Result is stored in batch_buffer.
+    size_t compute_shell_batch(const std::vector<ShellQuartet> &quartets) override;
+
     /// Compute ERI derivatives between 4 shells. Result is stored in buffer.
     size_t compute_shell_deriv1(int s1, int s2, int s3, int s4) override;
 
@@ -245,6 +245,48 @@ size_t Libint2TwoElectronInt::compute_shell(int s1, int s2, int s3, int s4) {
     return ntot;
 }
 
+const libint2::ShellPair *Libint2TwoElectronInt::shell_pair_data(int s1, int s2) const {
+    // pairs12_ follows shell_pairs_, which only holds the significant s1 >= s2 pairs of one basis
+    if (!bra_same_ || !braket_same_ || s1 < s2 || shell_pairs_reverse_.empty()) return nullptr;
+    long int pair = shell_pairs_reverse_[s1 * (s1 + 1L) / 2L + s2];
+    if (pair < 0 || pair >= static_cast<long int>(pairs12_.size())) return nullptr;
+    return pairs12_[pair].get();
+}
+
+size_t Libint2TwoElectronInt::compute_shell_batch(const std::vector<ShellQuartet> &quartets) {
+#ifdef MINTS_TIMER
+    timer_on("Libint2ERI::compute_shell_batch");
+#endif
+
+    batch_setup(quartets);
+
+    size_t ntot = 0;
+    for (size_t ind : batch_order_) {
+        const auto &quartet = quartets[ind];
+        const auto &sh1 = bs1_->l2_shell(quartet[0]);
+        const auto &sh2 = bs2_->l2_shell(quartet[1]);
+        const auto &sh3 = bs3_->l2_shell(quartet[2]);
+        const auto &sh4 = bs4_->l2_shell(quartet[3]);
+
+        // Reusing the primitive pair data saves recomputing it for every quartet the pair takes part in
+        libint2_wrapper0(sh1, sh2, sh3, sh4, shell_pair_data(quartet[0], quartet[1]),
+                         shell_pair_data(quartet[2], quartet[3]));
+
+        const double *results = engines_[0].results()[0];
+        if (results == nullptr) continue;
+
+        size_t nints = sh1.size() * sh2.size() * sh3.size() * sh4.size();
+        std::copy(results, results + nints, batch_buffer_.begin() + batch_offsets_[ind]);
+        batch_sizes_[ind] = nints;
+        ntot += nints;
+    }
+
+#ifdef MINTS_TIMER
+    timer_off("Libint2ERI::compute_shell_batch");
+#endif
+    return ntot;
+}
+
 size_t Libint2TwoElectronInt::compute_shell_deriv1(int s1, int s2, int s3, int s4) {
 #ifdef MINTS_TIMER
     timer_on("Libint2ERI::compute_shell_deriv1");
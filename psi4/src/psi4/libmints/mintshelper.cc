@@ -802,26 +802,54 @@ SharedMatrix MintsHelper::ao_helper(const std::string &label, std::shared_ptr<Tw
     auto I = std::make_shared<Matrix>(label, nbf1 * nbf2, nbf3 * nbf4);
     double **Ip = I->pointer();
 
+    // The (PQ| quartets of each bra pair are computed in batches and scattered into I
+    std::vector<ShellQuartet> batch;
+    auto scatter_batch = [&]() {
+        if (batch.empty()) return;
+        ints->compute_shell_batch(batch);
+        const double *batch_buffer = ints->batch_buffer();
+        const auto &batch_offsets = ints->batch_offsets();
+        const auto &batch_sizes = ints->batch_sizes();
+
+        for (size_t quartet = 0; quartet < batch.size(); quartet++) {
+            int M = batch[quartet][0];
+            int N = batch[quartet][1];
+            int P = batch[quartet][2];
+            int Q = batch[quartet][3];
+            // I is zeroed on construction, so quartets without integrals are already in place
+            if (batch_sizes[quartet] == 0) continue;
+            const double *buffer = batch_buffer + batch_offsets[quartet];
+
+            for (int m = 0, index = 0; m < bs1->shell(M).nfunction(); m++) {
+                for (int n = 0; n < bs2->shell(N).nfunction(); n++) {
+                    for (int p = 0; p < bs3->shell(P).nfunction(); p++) {
+                        for (int q = 0; q < bs4->shell(Q).nfunction(); q++, index++) {
+                            Ip[(bs1->shell(M).function_index() + m) * nbf2 + bs2->shell(N).function_index() + n]
+                              [(bs3->shell(P).function_index() + p) * nbf4 + bs4->shell(Q).function_index() + q] =
+                                  buffer[index];
+                        }
+                    }
+                }
+            }
+        }
+        batch.clear();
+    };
+
     for (int M = 0; M < bs1->nshell(); M++) {
         for (int N = 0; N < bs2->nshell(); N++) {
+            size_t batch_size = 0;
             for (int P = 0; P < bs3->nshell(); P++) {
                 for (int Q = 0; Q < bs4->nshell(); Q++) {
-                    ints->compute_shell(M, N, P, Q);
-                    const double *buffer = ints->buffer();
-
-                    for (int m = 0, index = 0; m < bs1->shell(M).nfunction(); m++) {
-                        for (int n = 0; n < bs2->shell(N).nfunction(); n++) {
-                            for (int p = 0; p < bs3->shell(P).nfunction(); p++) {
-                                for (int q = 0; q < bs4->shell(Q).nfunction(); q++, index++) {
-                                    Ip[(bs1->shell(M).function_index() + m) * nbf2 + bs2->shell(N).function_index() + n]
-                                      [(bs3->shell(P).function_index() + p) * nbf4 + bs4->shell(Q).function_index() +
-                                       q] = buffer[index];
-                                }
-                            }
-                        }
+                    batch.push_back({M, N, P, Q});
+                    batch_size += static_cast<size_t>(bs1->shell(M).nfunction()) * bs2->shell(N).nfunction() *
+                                  bs3->shell(P).nfunction() * bs4->shell(Q).nfunction();
+                    if (batch_size >= TwoBodyAOInt::batch_target_size) {
+                        scatter_batch();
+                        batch_size = 0;
                     }
                 }
             }
+            scatter_batch();
         }
     }
 
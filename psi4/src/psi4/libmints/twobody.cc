@@ -498,6 +498,53 @@ bool TwoBodyAOInt::shell_pair_significant(int M, int N) const {
     return screening_type_ != ScreeningType::None ? shell_pair_values_[M * nshell_ + N] * max_integral_ >= screening_threshold_squared_ : true;
 }
 
+void TwoBodyAOInt::batch_setup(const std::vector<ShellQuartet> &quartets) {
+    size_t nquartet = quartets.size();
+    batch_offsets_.resize(nquartet);
+    batch_sizes_.assign(nquartet, 0);
+    batch_order_.resize(nquartet);
+
+    // Quartets keep the caller's order in the buffer
+    size_t offset = 0;
+    for (size_t ind = 0; ind < nquartet; ind++) {
+        const auto &quartet = quartets[ind];
+        batch_offsets_[ind] = offset;
+        offset += static_cast<size_t>(bs1_->shell(quartet[0]).nfunction()) * bs2_->shell(quartet[1]).nfunction() *
+                  bs3_->shell(quartet[2]).nfunction() * bs4_->shell(quartet[3]).nfunction();
+    }
+    if (batch_buffer_.size() < offset) batch_buffer_.resize(offset);
+
+    // ... but are computed one angular momentum class after the other
+    std::vector<int> am_class(nquartet);
+    for (size_t ind = 0; ind < nquartet; ind++) {
+        const auto &quartet = quartets[ind];
+        am_class[ind] = ((bs1_->shell(quartet[0]).am() * 16 + bs2_->shell(quartet[1]).am()) * 16 +
+                         bs3_->shell(quartet[2]).am()) * 16 + bs4_->shell(quartet[3]).am();
+    }
+    for (size_t ind = 0; ind < nquartet; ind++) batch_order_[ind] = ind;
+    std::stable_sort(batch_order_.begin(), batch_order_.end(),
+                     [&am_class](size_t a, size_t b) { return am_class[a] < am_class[b]; });
+}
+
+size_t TwoBodyAOInt::compute_shell_batch(const std::vector<ShellQuartet> &quartets) {
+    // Default implementation - compute the quartets one at a time and gather them
+    batch_setup(quartets);
+
+    size_t ntot = 0;
+    for (size_t ind : batch_order_) {
+        const auto &quartet = quartets[ind];
+        if (compute_shell(quartet[0], quartet[1], quartet[2], quartet[3]) == 0) continue;
+
+        size_t nints = static_cast<size_t>(bs1_->shell(quartet[0]).nfunction()) * bs2_->shell(quartet[1]).nfunction() *
+                       bs3_->shell(quartet[2]).nfunction() * bs4_->shell(quartet[3]).nfunction();
+        std::copy(buffer(), buffer() + nints, batch_buffer_.begin() + batch_offsets_[ind]);
+        batch_sizes_[ind] = nints;
+        ntot += nints;
+    }
+
+    return ntot;
+}
+
 void TwoBodyAOInt::compute_shell_blocks(int shellpair12, int shellpair34, int npair12, int npair34) {
     // Default implementation - go through the blocks and do each quartet
     // one at a time
@@ -31,6 +31,7 @@
 
 #include "psi4/pragma.h"
 
+#include <array>
 #include <functional>
 #include <memory>
 #include <tuple>
@@ -53,6 +54,9 @@ enum PermutedOrder { ABCD = 0, BACD = 1, ABDC = 2, BADC = 3, CDAB = 4, CDBA = 5,
 
 typedef std::vector<std::pair<int, int>> ShellPairBlock;
 
+/// Shell indices (P, Q, R, S) of a quartet (PQ|RS)
+typedef std::array<int, 4> ShellQuartet;
+
 class IntegralFactory;
 class AOShellCombinationsIterator;
 class BasisSet;
@@ -111,6 +115,18 @@ class PSI_API TwoBodyAOInt {
     /// The blocking scheme used for the integrals
     std::vector<ShellPairBlock> blocks12_, blocks34_;
 
+    /// Integrals of the last compute_shell_batch(), quartet after quartet
+    std::vector<double> batch_buffer_;
+    /// Start of each quartet's integrals in batch_buffer_
+    std::vector<size_t> batch_offsets_;
+    /// Number of integrals of each quartet, 0 if the engine found none
+    std::vector<size_t> batch_sizes_;
+    /// Order in which the quartets are computed, grouped by angular momentum class
+    std::vector<size_t> batch_order_;
+
+    /// Lay out batch_buffer_ for the quartets and sort them by angular momentum class into batch_order_
+    void batch_setup(const std::vector<ShellQuartet> &quartets);
+
     /*
      * Sieve information
      */
@@ -306,6 +322,29 @@ class PSI_API TwoBodyAOInt {
 
     virtual size_t compute_shell(int s1, int s2, int s3, int s4) = 0;
 
+    /// Number of integrals a batch should hold to stay in cache while it is contracted
+    static constexpr size_t batch_target_size = 32768;
+
+    /*! Compute ERIs for a list of shell quartets into one contiguous buffer
+     *
+     * The quartets are expected to have been screened already, e.g. with shell_significant().
+     * They are computed grouped by angular momentum class, so that the engine runs the same
+     * recursion back to back, and the integrals of quartet i are found at
+     * batch_buffer() + batch_offsets()[i] in the layout compute_shell() uses.
+     * If batch_sizes()[i] is zero the engine found no integrals for that quartet and its
+     * part of the buffer is undefined. buffer() is not changed by this call.
+     *
+     * \returns the total number of integrals computed
+     */
+    virtual size_t compute_shell_batch(const std::vector<ShellQuartet> &quartets);
+
+    /// Buffer where compute_shell_batch() places the integrals
+    const double *batch_buffer() const { return batch_buffer_.data(); }
+    /// Start of each quartet's integrals in batch_buffer()
+    const std::vector<size_t> &batch_offsets() const { return batch_offsets_; }
+    /// Number of integrals of each quartet in the last batch, 0 if there were none
+    const std::vector<size_t> &batch_sizes() const { return batch_sizes_; }
+
     /// Compute the first derivatives
     virtual size_t compute_shell_deriv1(int s1, int s2, int s3, int s4) = 0;
 
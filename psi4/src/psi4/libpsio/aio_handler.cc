@@ -37,446 +37,383 @@
 #include "psi4/libpsio/psio.h"
 #include "psi4/libpsio/psio.hpp"
 
+#include <cerrno>
 #include <cstdio>
 #include <memory>
 #include <algorithm>
 #include <functional>
+#include <tuple>
 
 namespace psi {
 
-AIOHandler::AIOHandler(std::shared_ptr<PSIO> psio) : psio_(psio) {
-    locked_ = new std::mutex();
+namespace {
+
+/// Largest piece of contiguous disk I/O handed to a single I/O thread [bytes]
+const size_t max_piece = 4L * 1024L * 1024L;
+
+#ifdef _MSC_VER
+/// There is no positional I/O on Windows, so seek + read/write has to be serialized
+std::mutex msvc_io_lock;
+#endif
+
+/// Read or write one piece of a job, retrying short transfers
+void segment_io(const psio_segment &piece, bool write, size_t unit) {
+#ifdef _MSC_VER
+    std::lock_guard<std::mutex> guard(msvc_io_lock);
+    if (SYSTEM_LSEEK(piece.stream, piece.offset, SEEK_SET) == -1) {
+        const int saved_errno = errno;
+        throw PSIEXCEPTION(psio_compose_err_msg("LSEEK failed.", "Error in asynchronous I/O", unit, saved_errno));
+    }
+#endif
+    size_t done = 0;
+    while (done < piece.size) {
+#ifdef _MSC_VER
+        auto count = (write ? SYSTEM_WRITE(piece.stream, piece.buffer + done, piece.size - done)
+                            : SYSTEM_READ(piece.stream, piece.buffer + done, piece.size - done));
+#else
+        auto count = (write ? ::pwrite(piece.stream, piece.buffer + done, piece.size - done, piece.offset + done)
+                            : ::pread(piece.stream, piece.buffer + done, piece.size - done, piece.offset + done));
+#endif
+        const int saved_errno = errno;
+        if (count == -1 && saved_errno == EINTR) continue;
+        if (count <= 0) {
+            const std::string beginning = (write ? "WRITE failed." : "READ failed.");
+            const std::string context = (write ? "Error in an asynchronous write" : "Error in an asynchronous read");
+            throw PSIEXCEPTION((count == -1) ? psio_compose_err_msg(beginning, context, unit, saved_errno)
+                                             : psio_compose_err_msg(beginning, context, unit));
+        }
+        done += count;
+    }
+}
+
+}  // namespace
+
+AIOHandler::AIOHandler(std::shared_ptr<PSIO> psio, size_t depth) : psio_(psio) {
+    depth_ = std::max(depth, (size_t)1);
     uniqueID_ = 0;
+    stop_ = false;
+
+    dispatcher_ = std::thread(&AIOHandler::dispatch, this);
+    for (size_t i = 0; i < depth_; i++) {
+        workers_.emplace_back(&AIOHandler::execute, this);
+    }
 }
 AIOHandler::~AIOHandler() {
-    synchronize();
-    delete locked_;
+    // Let everything finish, errors can no longer be reported at this point
+    {
+        std::unique_lock<std::mutex> lock(locked_);
+        condition_.wait(lock, [this] { return jobID_.empty(); });
+        stop_ = true;
+    }
+    dispatch_condition_.notify_all();
+    work_condition_.notify_all();
+
+    dispatcher_.join();
+    for (auto &worker : workers_) worker.join();
 }
 void AIOHandler::synchronize() {
-    // Joining a thread twice is an error. Thus, we check whether
-    // the thread is joinable before joining. Non-joinable threads
-    // have either been joined, detached (no synchronization possible)
-    // or have been moved from, and another thread object controls its execution.
-    //    std::unique_lock<std::mutex> lock(*locked_);
-    //    lock.unlock();
-    if (thread_)
-        if (thread_->joinable()) thread_->join();
+    std::unique_lock<std::mutex> lock(locked_);
+    condition_.wait(lock, [this] { return jobID_.empty(); });
+
+    if (!errors_.empty()) {
+        std::exception_ptr error = errors_.begin()->second;
+        errors_.clear();
+        lock.unlock();
+        std::rethrow_exception(error);
+    }
+}
+void AIOHandler::wait_for_job(size_t jobid) {
+    std::unique_lock<std::mutex> lock(locked_);
+    condition_.wait(lock, [this, jobid] { return jobID_.count(jobid) == 0; });
+
+    auto it = errors_.find(jobid);
+    if (it != errors_.end()) {
+        std::exception_ptr error = it->second;
+        errors_.erase(it);
+        lock.unlock();
+        std::rethrow_exception(error);
+    }
+}
+
+size_t AIOHandler::submit(std::shared_ptr<Job> job) {
+    std::unique_lock<std::mutex> lock(locked_);
+
+    job->id = ++uniqueID_;
+    jobID_.insert(job->id);
+    pending_.push_back(job);
+    dispatch_condition_.notify_all();
+
+    return job->id;
 }
 size_t AIOHandler::read(size_t unit, const char *key, char *buffer, size_t size, psio_address start,
                         psio_address *end) {
-    std::unique_lock<std::mutex> lock(*locked_);
-
-    ++uniqueID_;
-    job_.push(1);
-    unit_.push(unit);
-    key_.push(key);
-    buffer_.push(buffer);
-    size_.push(size);
-    start_.push(start);
-    end_.push(end);
-    jobID_.push_back(uniqueID_);
-
-    if (job_.size() > 1) return uniqueID_;
-
-    // In C++11, destructors of threads that are still joinable call terminate()
-    // Make sure current thread is joined before proceeding with next thread.
-    synchronize();
-
-    // thread start
-    thread_ = std::make_shared<std::thread>(std::bind(&AIOHandler::call_aio, this));
-    return uniqueID_;
+    auto job = std::make_shared<Job>();
+    job->type = JobType::Read;
+    job->unit = unit;
+    job->key = key;
+    job->buffer = buffer;
+    job->size = size;
+    job->start = start;
+    job->end = end;
+    return submit(job);
 }
 size_t AIOHandler::write(size_t unit, const char *key, char *buffer, size_t size, psio_address start,
                          psio_address *end) {
-    std::unique_lock<std::mutex> lock(*locked_);
-
-    ++uniqueID_;
-    job_.push(2);
-    unit_.push(unit);
-    key_.push(key);
-    buffer_.push(buffer);
-    size_.push(size);
-    start_.push(start);
-    end_.push(end);
-    jobID_.push_back(uniqueID_);
-
-    // printf("Adding a write to the queue\n");
-
-    if (job_.size() > 1) return uniqueID_;
-
-    // fprintf(stderr,"Starting a thread\n");
-    // thread start
-
-    // In C++11, destructors of threads that are still joinable call terminate()
-    // Make sure current thread is joined before proceeding with next thread.
-    synchronize();
-
-    thread_ = std::make_shared<std::thread>(std::bind(&AIOHandler::call_aio, this));
-    return uniqueID_;
+    auto job = std::make_shared<Job>();
+    job->type = JobType::Write;
+    job->unit = unit;
+    job->key = key;
+    job->buffer = buffer;
+    job->size = size;
+    job->start = start;
+    job->end = end;
+    return submit(job);
 }
 size_t AIOHandler::read_entry(size_t unit, const char *key, char *buffer, size_t size) {
-    std::unique_lock<std::mutex> lock(*locked_);
-
-    ++uniqueID_;
-    job_.push(3);
-    unit_.push(unit);
-    key_.push(key);
-    buffer_.push(buffer);
-    size_.push(size);
-    jobID_.push_back(uniqueID_);
-
-    if (job_.size() > 1) return uniqueID_;
-
-    // In C++11, destructors of threads that are still joinable call terminate()
-    // Make sure current thread is joined before proceeding with next thread.
-    synchronize();
-
-    // thread start
-    thread_ = std::make_shared<std::thread>(std::bind(&AIOHandler::call_aio, this));
-    return uniqueID_;
+    auto job = std::make_shared<Job>();
+    job->type = JobType::ReadEntry;
+    job->unit = unit;
+    job->key = key;
+    job->buffer = buffer;
+    job->size = size;
+    return submit(job);
 }
 size_t AIOHandler::write_entry(size_t unit, const char *key, char *buffer, size_t size) {
-    std::unique_lock<std::mutex> lock(*locked_);
-
-    ++uniqueID_;
-    job_.push(4);
-    unit_.push(unit);
-    key_.push(key);
-    buffer_.push(buffer);
-    size_.push(size);
-    jobID_.push_back(uniqueID_);
-
-    if (job_.size() > 1) return uniqueID_;
-
-    // In C++11, destructors of threads that are still joinable call terminate()
-    // Make sure current thread is joined before proceeding with next thread.
-    synchronize();
-
-    // thread start
-    thread_ = std::make_shared<std::thread>(std::bind(&AIOHandler::call_aio, this));
-    return uniqueID_;
+    auto job = std::make_shared<Job>();
+    job->type = JobType::WriteEntry;
+    job->unit = unit;
+    job->key = key;
+    job->buffer = buffer;
+    job->size = size;
+    return submit(job);
 }
 size_t AIOHandler::read_discont(size_t unit, const char *key, double **matrix, size_t row_length, size_t col_length,
                                 size_t col_skip, psio_address start) {
-    std::unique_lock<std::mutex> lock(*locked_);
-
-    ++uniqueID_;
-    job_.push(5);
-    unit_.push(unit);
-    key_.push(key);
-    matrix_.push(matrix);
-    row_length_.push(row_length);
-    col_length_.push(col_length);
-    col_skip_.push(col_skip);
-    start_.push(start);
-    jobID_.push_back(uniqueID_);
-
-    if (job_.size() > 1) return uniqueID_;
-
-    // In C++11, destructors of threads that are still joinable call terminate()
-    // Make sure current thread is joined before proceeding with next thread.
-    synchronize();
-
-    // thread start
-    thread_ = std::make_shared<std::thread>(std::bind(&AIOHandler::call_aio, this));
-    return uniqueID_;
+    auto job = std::make_shared<Job>();
+    job->type = JobType::ReadDiscont;
+    job->unit = unit;
+    job->key = key;
+    job->matrix = matrix;
+    job->row_length = row_length;
+    job->col_length = col_length;
+    job->col_skip = col_skip;
+    job->start = start;
+    return submit(job);
 }
 size_t AIOHandler::write_discont(size_t unit, const char *key, double **matrix, size_t row_length, size_t col_length,
                                  size_t col_skip, psio_address start) {
-    std::unique_lock<std::mutex> lock(*locked_);
-
-    ++uniqueID_;
-    job_.push(6);
-    unit_.push(unit);
-    key_.push(key);
-    matrix_.push(matrix);
-    row_length_.push(row_length);
-    col_length_.push(col_length);
-    col_skip_.push(col_skip);
-    start_.push(start);
-    jobID_.push_back(uniqueID_);
-
-    if (job_.size() > 1) return uniqueID_;
-
-    // In C++11, destructors of threads that are still joinable call terminate()
-    // Make sure current thread is joined before proceeding with next thread.
-    synchronize();
-
-    // thread start
-    thread_ = std::make_shared<std::thread>(std::bind(&AIOHandler::call_aio, this));
-    return uniqueID_;
+    auto job = std::make_shared<Job>();
+    job->type = JobType::WriteDiscont;
+    job->unit = unit;
+    job->key = key;
+    job->matrix = matrix;
+    job->row_length = row_length;
+    job->col_length = col_length;
+    job->col_skip = col_skip;
+    job->start = start;
+    return submit(job);
 }
 size_t AIOHandler::zero_disk(size_t unit, const char *key, size_t rows, size_t cols) {
-    std::unique_lock<std::mutex> lock(*locked_);
-
-    ++uniqueID_;
-    job_.push(7);
-    unit_.push(unit);
-    key_.push(key);
-    row_length_.push(rows);
-    col_length_.push(cols);
-    jobID_.push_back(uniqueID_);
-
-    if (job_.size() > 1) return uniqueID_;
-
-    // In C++11, destructors of threads that are still joinable call terminate()
-    // Make sure current thread is joined before proceeding with next thread.
-    synchronize();
-
-    // thread start
-    thread_ = std::make_shared<std::thread>(std::bind(&AIOHandler::call_aio, this));
-    return uniqueID_;
+    auto job = std::make_shared<Job>();
+    job->type = JobType::ZeroDisk;
+    job->unit = unit;
+    job->key = key;
+    job->row_length = rows;
+    job->col_length = cols;
+    return submit(job);
 }
 
 size_t AIOHandler::write_iwl(size_t unit, const char *key, size_t nints, int lastbuf, char *labels, char *values,
                              size_t labsize, size_t valsize, size_t *address) {
-    std::unique_lock<std::mutex> lock(*locked_);
-    ++uniqueID_;
-    job_.push(8);
-    unit_.push(unit);
-    key_.push(key);
-    buffer_.push(labels);
-    buffer_.push(values);
-    size_.push(labsize);
-    size_.push(valsize);
-    nints_.push(nints);
-    lastbuf_.push(lastbuf);
-    address_.push(address);
-    jobID_.push_back(uniqueID_);
-
-    if (job_.size() > 1) return uniqueID_;
-
-    // In C++11, destructors of threads that are still joinable call terminate()
-    // Make sure current thread is joined before proceeding with next thread.
-    synchronize();
-
-    // thread start
-    thread_ = std::make_shared<std::thread>(std::bind(&AIOHandler::call_aio, this));
-    return uniqueID_;
+    auto job = std::make_shared<Job>();
+    job->type = JobType::WriteIWL;
+    job->unit = unit;
+    job->key = key;
+    job->buffer = labels;
+    job->size = labsize;
+    job->values = values;
+    job->valsize = valsize;
+    job->address = address;
+    job->iwl_header[0] = lastbuf;
+    job->iwl_header[1] = nints;
+    return submit(job);
 }
 
-void AIOHandler::call_aio() {
-    std::unique_lock<std::mutex> lock(*locked_);
-
-    while (job_.size() > 0) {
-        int jobtype = job_.front();
-        lock.unlock();
-
-        if (jobtype == 1) {
-            lock.lock();
-
-            size_t unit = unit_.front();
-            const char *key = key_.front();
-            char *buffer = buffer_.front();
-            size_t size = size_.front();
-            psio_address start = start_.front();
-            psio_address *end = end_.front();
-
-            unit_.pop();
-            key_.pop();
-            buffer_.pop();
-            size_.pop();
-            start_.pop();
-            end_.pop();
-
-            lock.unlock();
-
-            psio_->read(unit, key, buffer, size, start, end);
-        } else if (jobtype == 2) {
-            lock.lock();
-
-            size_t unit = unit_.front();
-            const char *key = key_.front();
-            char *buffer = buffer_.front();
-            size_t size = size_.front();
-            psio_address start = start_.front();
-            psio_address *end = end_.front();
-
-            unit_.pop();
-            key_.pop();
-            buffer_.pop();
-            size_.pop();
-            start_.pop();
-            end_.pop();
-
-            // printf("Actually doing the psio_write from thread\n");
-            // printf("Unit is %d, key is %s, size is %d\n", unit, key, size);
-            lock.unlock();
-
-            // printf("Printing number %d now\n", *((int *) buffer));
-            // std::stringstream ss;
-            // ss << thread_->get_id();
-            // fprintf(stderr,"Printing from thread %s\n", ss.str().c_str());
-            // fprintf(stderr,"Starting address is %lu, %lu\n",start.page, start.offset);
-            psio_->write(unit, key, buffer, size, start, end);
-            // fprintf(stderr,"End address is %lu, %lu\n",end->page, end->offset);
-        } else if (jobtype == 3) {
-            lock.lock();
-
-            size_t unit = unit_.front();
-            const char *key = key_.front();
-            char *buffer = buffer_.front();
-            size_t size = size_.front();
-
-            unit_.pop();
-            key_.pop();
-            buffer_.pop();
-            size_.pop();
-
-            lock.unlock();
-
-            psio_->read_entry(unit, key, buffer, size);
-        } else if (jobtype == 4) {
-            lock.lock();
-
-            size_t unit = unit_.front();
-            const char *key = key_.front();
-            char *buffer = buffer_.front();
-            size_t size = size_.front();
-
-            unit_.pop();
-            key_.pop();
-            buffer_.pop();
-            size_.pop();
-
-            lock.unlock();
-
-            psio_->write_entry(unit, key, buffer, size);
-        } else if (jobtype == 5) {
-            lock.lock();
-
-            size_t unit = unit_.front();
-            const char *key = key_.front();
-            double **matrix = matrix_.front();
-            size_t row_length = row_length_.front();
-            size_t col_length = col_length_.front();
-            size_t col_skip = col_skip_.front();
-            psio_address start = start_.front();
-
-            unit_.pop();
-            key_.pop();
-            matrix_.pop();
-            row_length_.pop();
-            col_length_.pop();
-            col_skip_.pop();
-            start_.pop();
-
-            lock.unlock();
-
-            for (int i = 0; i < row_length; i++) {
-                psio_->read(unit, key, (char *)&(matrix[i][0]), sizeof(double) * col_length, start, &start);
-                start = psio_get_address(start, sizeof(double) * col_skip);
+void AIOHandler::plan(Job &job) {
+    // Append the pieces of size bytes at global address, at most max_piece each
+    std::vector<psio_segment> pieces;
+    auto add = [&](psio_address address, char *buffer, size_t size) {
+        pieces.clear();
+        psio_->segments(job.unit, buffer, address, size, pieces);
+        if (job.write) job.written.emplace_back(address, size);
+        for (const auto &piece : pieces) {
+            for (size_t done = 0; done < piece.size; done += max_piece) {
+                job.segments.push_back(
+                    {piece.stream, piece.offset + done, piece.buffer + done, std::min(max_piece, piece.size - done)});
             }
-        } else if (jobtype == 6) {
-            lock.lock();
-
-            size_t unit = unit_.front();
-            const char *key = key_.front();
-            double **matrix = matrix_.front();
-            size_t row_length = row_length_.front();
-            size_t col_length = col_length_.front();
-            size_t col_skip = col_skip_.front();
-            psio_address start = start_.front();
-
-            unit_.pop();
-            key_.pop();
-            matrix_.pop();
-            row_length_.pop();
-            col_length_.pop();
-            col_skip_.pop();
-            start_.pop();
-
-            lock.unlock();
-
-            for (int i = 0; i < row_length; i++) {
-                psio_->write(unit, key, (char *)&(matrix[i][0]), sizeof(double) * col_length, start, &start);
-                start = psio_get_address(start, sizeof(double) * col_skip);
+        }
+    };
+
+    psio_address end;
+    switch (job.type) {
+        case JobType::Read:
+            add(psio_->read_address(job.unit, job.key, job.size, job.start, job.end), job.buffer, job.size);
+            break;
+        case JobType::Write:
+            job.write = true;
+            add(psio_->write_address(job.unit, job.key, job.size, job.start, job.end), job.buffer, job.size);
+            break;
+        case JobType::ReadEntry:
+            add(psio_->read_address(job.unit, job.key, job.size, PSIO_ZERO, &end), job.buffer, job.size);
+            break;
+        case JobType::WriteEntry:
+            job.write = true;
+            add(psio_->write_address(job.unit, job.key, job.size, PSIO_ZERO, &end), job.buffer, job.size);
+            break;
+        case JobType::ReadDiscont:
+        case JobType::WriteDiscont: {
+            if (job.row_length == 0) break;
+            job.write = (job.type == JobType::WriteDiscont);
+            // Claim the whole strided block at once, then address the rows within it
+            size_t stride = sizeof(double) * (job.col_length + job.col_skip);
+            size_t extent = stride * (job.row_length - 1) + sizeof(double) * job.col_length;
+            psio_address first =
+                (job.write ? psio_->write_address(job.unit, job.key, extent, job.start, &end)
+                           : psio_->read_address(job.unit, job.key, extent, job.start, &end));
+            for (size_t i = 0; i < job.row_length; i++) {
+                add(psio_get_address(first, i * stride), (char *)&(job.matrix[i][0]), sizeof(double) * job.col_length);
             }
-        } else if (jobtype == 7) {
-            lock.lock();
+            break;
+        }
+        case JobType::ZeroDisk: {
+            job.write = true;
+            size_t total = sizeof(double) * job.row_length * job.col_length;
+            if (total == 0) break;
+            psio_address first = psio_->write_address(job.unit, job.key, total, PSIO_ZERO, &end);
+            // Every piece writes from the same block of zeros
+            job.zeros.assign(std::min(total, max_piece) / sizeof(double), 0.0);
+            size_t zsize = sizeof(double) * job.zeros.size();
+            for (size_t done = 0; done < total; done += zsize) {
+                add(psio_get_address(first, done), (char *)job.zeros.data(), std::min(zsize, total - done));
+            }
+            break;
+        }
+        case JobType::WriteIWL: {
+            job.write = true;
+            // Layout of an IWL buffer: lastbuf, nints, labels, values
+            psio_address start = psio_get_address(PSIO_ZERO, *job.address);
+            size_t header = sizeof(job.iwl_header);
+            *job.address += header + job.size + job.valsize;
+
+            psio_address first =
+                psio_->write_address(job.unit, job.key, header + job.size + job.valsize, start, &end);
+            add(first, (char *)job.iwl_header, header);
+            add(psio_get_address(first, header), job.buffer, job.size);
+            add(psio_get_address(first, header + job.size), job.values, job.valsize);
+            break;
+        }
+        default:
+            throw PsiException("Error in AIO: Unknown job type", __FILE__, __LINE__);
+    }
 
-            size_t unit = unit_.front();
-            const char *key = key_.front();
-            size_t row_length = row_length_.front();
-            size_t col_length = col_length_.front();
+    // Disk extent of the job in each volume, for conflicts()
+    for (const auto &piece : job.segments) {
+        auto it = std::find_if(job.extents.begin(), job.extents.end(),
+                               [&](const Extent &ext) { return std::get<0>(ext) == piece.stream; });
+        if (it == job.extents.end()) {
+            job.extents.emplace_back(piece.stream, piece.offset, piece.offset + piece.size);
+        } else {
+            std::get<1>(*it) = std::min(std::get<1>(*it), piece.offset);
+            std::get<2>(*it) = std::max(std::get<2>(*it), piece.offset + piece.size);
+        }
+    }
+}
 
-            unit_.pop();
-            key_.pop();
-            row_length_.pop();
-            col_length_.pop();
+bool AIOHandler::conflicts(const Job &job) const {
+    for (const auto &other : in_flight_) {
+        if (!job.write && !other->write) continue;
+        for (const auto &a : job.extents) {
+            for (const auto &b : other->extents) {
+                if (std::get<0>(a) == std::get<0>(b) && std::get<1>(a) < std::get<2>(b) &&
+                    std::get<1>(b) < std::get<2>(a))
+                    return true;
+            }
+        }
+    }
+    return false;
+}
 
-            lock.unlock();
+void AIOHandler::complete(const std::shared_ptr<Job> &job) {
+    in_flight_.erase(std::remove(in_flight_.begin(), in_flight_.end(), job), in_flight_.end());
+    jobID_.erase(job->id);
+    if (job->error) errors_[job->id] = job->error;
+    for (const auto &range : job->written) psio_->uncache(job->unit, range.first, range.second);
 
-            double *buf = new double[col_length];
-            memset(static_cast<void *>(buf), '\0', col_length * sizeof(double));
+    // Notify waiting threads to check again for their jobid, and the dispatcher to recheck conflicts
+    condition_.notify_all();
+    dispatch_condition_.notify_all();
+}
 
-            psio_address next_psio = PSIO_ZERO;
-            for (int i = 0; i < row_length; i++) {
-                psio_->write(unit, key, (char *)(buf), sizeof(double) * col_length, next_psio, &next_psio);
-            }
+void AIOHandler::dispatch() {
+    std::unique_lock<std::mutex> lock(locked_);
 
-            delete[] buf;
-        } else if (jobtype == 8) {
-            lock.lock();
-
-            size_t unit = unit_.front();
-            const char *key = key_.front();
-            char *labels = buffer_.front();
-            buffer_.pop();
-            char *values = buffer_.front();
-            size_t lab_size = size_.front();
-            size_.pop();
-            size_t val_size = size_.front();
-            int nints = nints_.front();
-            int lastbuf = lastbuf_.front();
-            size_t *address = address_.front();
-
-            psio_address start = psio_get_address(PSIO_ZERO, *address);
-            *address += val_size + lab_size + 2 * sizeof(int);
-
-            unit_.pop();
-            key_.pop();
-            buffer_.pop();
-            size_.pop();
-            nints_.pop();
-            lastbuf_.pop();
-            address_.pop();
-
-            lock.unlock();
-
-            psio_->write(unit, key, (char *)&(lastbuf), sizeof(int), start, &start);
-            psio_->write(unit, key, (char *)&(nints), sizeof(int), start, &start);
-            psio_->write(unit, key, labels, lab_size, start, &start);
-            psio_->write(unit, key, values, val_size, start, &start);
+    while (true) {
+        dispatch_condition_.wait(lock, [this] { return stop_ || !pending_.empty(); });
+        if (pending_.empty()) return;
 
-        } else {
-            throw PsiException("Error in AIO: Unknown job type", __FILE__, __LINE__);
+        auto job = pending_.front();
+        pending_.pop_front();
+        lock.unlock();
+
+        // The TOC work is done here, strictly in submission order
+        try {
+            plan(*job);
+        } catch (...) {
+            job->error = std::current_exception();
+            job->segments.clear();
         }
 
         lock.lock();
-        // Only pop the job once the work is actually done and we are gonna leave the loop.
-        // This way, job_.size() == 0 indicates there is no active thread.
-        job_.pop();
-        // We also pop the jobID so that external threads may check that the job completed
-        jobID_.pop_front();
-        // Once it is popped, notify waiting threads to check again for their jobid.
-        condition_.notify_all();
+        if (job->segments.empty()) {
+            complete(job);
+            continue;
+        }
+
+        // Keep the results identical to running the jobs one by one
+        dispatch_condition_.wait(lock, [this, &job] { return !conflicts(*job); });
+
+        job->remaining = job->segments.size();
+        in_flight_.push_back(job);
+        for (size_t i = 0; i < job->segments.size(); i++) {
+            work_.emplace_back(job, i);
+        }
+        work_condition_.notify_all();
     }
-    // printf("End of function call_aio\n");
 }
 
-void AIOHandler::wait_for_job(size_t jobid) {
-    std::deque<size_t>::iterator it;
-
-    std::unique_lock<std::mutex> lock(*locked_);
-    it = std::find(jobID_.begin(), jobID_.end(), jobid);
-    bool found = it != jobID_.end();
-    while (found) {
-        condition_.wait(lock);
-        it = std::find(jobID_.begin(), jobID_.end(), jobid);
-        found = it != jobID_.end();
+void AIOHandler::execute() {
+    std::unique_lock<std::mutex> lock(locked_);
+
+    while (true) {
+        work_condition_.wait(lock, [this] { return stop_ || !work_.empty(); });
+        if (work_.empty()) return;
+
+        auto job = work_.front().first;
+        size_t index = work_.front().second;
+        work_.pop_front();
+        lock.unlock();
+
+        std::exception_ptr error;
+        try {
+            segment_io(job->segments[index], job->write, job->unit);
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        lock.lock();
+        if (error && !job->error) job->error = error;
+        if (--job->remaining == 0) complete(job);
     }
-    return;
 }
 
 }  // Namespace psi
@@ -30,9 +30,17 @@
 #define AIOHANDLER_H
 
 #include <condition_variable>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
 #include <mutex>
-#include <queue>
+#include <set>
+#include <string>
 #include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 #include "config.h"
 
@@ -40,52 +48,130 @@ namespace psi {
 
 class PSIO;
 
+/**
+ * Asynchronous I/O on top of a PSIO object.
+ *
+ * Requests are taken in submission order by a dispatcher thread, which
+ * does the (serial) TOC bookkeeping through PSIO and splits each request
+ * into pieces of at most a few MiB of contiguous disk space. The pieces
+ * are then executed with positional reads and writes by a pool of I/O
+ * threads, so that up to depth requests are outstanding at the device
+ * at any time, also within a single large or discontinuous request.
+ *
+ * A request is only started once it no longer overlaps on disk with an
+ * earlier request still in flight of which either one writes, so the
+ * results are the same as if the requests were run one after another.
+ *
+ * Each request returns a unique job ID, which can be waited on with
+ * wait_for_job(). Errors raised while executing a job are rethrown from
+ * wait_for_job() for that job, or from synchronize().
+ */
 class AIOHandler {
    private:
-    /// What is the job type?
-    std::queue<size_t> job_;
-    /// Unique job ID to check for job completion. Should NEVER be 0.
-    std::deque<size_t> jobID_;
-    /// Unit number argument
-    std::queue<size_t> unit_;
-    /// Entry Key (80-char) argument
-    std::queue<const char *> key_;
-    /// Memory buffer argument
-    std::queue<char *> buffer_;
-    /// Size argument
-    std::queue<size_t> size_;
-    /// Start address argument
-    std::queue<psio_address> start_;
-    /// End address pointer argument
-    std::queue<psio_address *> end_;
-    /// Matrix pointer for discontinuous I/O
-    std::queue<double **> matrix_;
-    /// Size argument for discontinuous I/O
-    std::queue<size_t> row_length_;
-    /// Size argument for discontinuous I/O
-    std::queue<size_t> col_length_;
-    /// Size argument for discontinuous I/O
-    std::queue<size_t> col_skip_;
-    /// For IWL: number of ints in the buffer
-    std::queue<int> nints_;
-    /// For IWL: is this the last buffer ?
-    std::queue<int> lastbuf_;
-    /// For IWL: pointer to current position in file
-    std::queue<size_t *> address_;
+    /// Range [first, last) of bytes touched in a volume file
+    typedef std::tuple<int, size_t, size_t> Extent;
+
+    /// The kinds of request
+    enum class JobType { Read, Write, ReadEntry, WriteEntry, ReadDiscont, WriteDiscont, ZeroDisk, WriteIWL };
+
+    /// A request, and the pieces of disk I/O it is turned into
+    struct Job {
+        /// Unique job ID. Should NEVER be 0.
+        size_t id;
+        JobType type;
+        /// Unit number argument
+        size_t unit;
+        /// Entry Key (80-char) argument
+        const char *key;
+        /// Memory buffer argument (labels for IWL)
+        char *buffer = nullptr;
+        /// Size argument (label size for IWL)
+        size_t size = 0;
+        /// Start address argument
+        psio_address start = PSIO_ZERO;
+        /// End address pointer argument
+        psio_address *end = nullptr;
+        /// Matrix pointer for discontinuous I/O
+        double **matrix = nullptr;
+        /// Size arguments for discontinuous I/O and zero_disk
+        size_t row_length = 0;
+        size_t col_length = 0;
+        size_t col_skip = 0;
+        /// For IWL: the values buffer and its size
+        char *values = nullptr;
+        size_t valsize = 0;
+        /// For IWL: pointer to current position in file
+        size_t *address = nullptr;
+        /// For IWL: last buffer flag and number of ints, in file order
+        int iwl_header[2] = {0, 0};
+        /// For zero_disk: the zeros that are written
+        std::vector<double> zeros;
+
+        /// Does this job write to disk?
+        bool write = false;
+        /// Contiguous pieces of disk I/O, set by plan()
+        std::vector<psio_segment> segments;
+        /// Disk extent of the segments, per volume
+        std::vector<Extent> extents;
+        /// Global address ranges written, dropped from the PSIO page cache on completion
+        std::vector<std::pair<psio_address, size_t>> written;
+        /// Pieces that have not completed yet
+        size_t remaining = 0;
+        /// First error raised by this job
+        std::exception_ptr error;
+    };
+
     /// PSIO object this AIO_Handler is built on
     std::shared_ptr<PSIO> psio_;
-    /// Thread this AIO_Handler is currently running on
-    std::shared_ptr<std::thread> thread_;
-    /// Lock variable
-    std::mutex *locked_;
-    /// Latest unique job ID
-    size_t uniqueID_;
+    /// Number of I/O threads, i.e. the maximum number of pieces in flight
+    size_t depth_;
+
+    /// Lock variable for all of the below
+    std::mutex locked_;
+    /// Signals the dispatcher that a job was submitted or completed
+    std::condition_variable dispatch_condition_;
+    /// Signals the I/O threads that pieces are ready
+    std::condition_variable work_condition_;
     /// condition variable to wait for a specific job to finish
     std::condition_variable condition_;
 
+    /// Submitted jobs that have not been dispatched yet, in order
+    std::deque<std::shared_ptr<Job>> pending_;
+    /// Dispatched jobs with pieces still running
+    std::vector<std::shared_ptr<Job>> in_flight_;
+    /// Pieces ready to run: the job, and the index into its segments
+    std::deque<std::pair<std::shared_ptr<Job>, size_t>> work_;
+    /// IDs of all jobs that have not completed
+    std::set<size_t> jobID_;
+    /// Errors of completed jobs that have not been rethrown yet
+    std::map<size_t, std::exception_ptr> errors_;
+    /// Latest unique job ID
+    size_t uniqueID_;
+    /// Set to shut the threads down
+    bool stop_;
+
+    /// Thread running dispatch()
+    std::thread dispatcher_;
+    /// Threads running execute()
+    std::vector<std::thread> workers_;
+
+    /// Queue a job and hand out its ID
+    size_t submit(std::shared_ptr<Job> job);
+    /// Turn a job into segments, doing its TOC updates through PSIO
+    void plan(Job &job);
+    /// Is job overlapping on disk with a job in flight, with a write involved?
+    bool conflicts(const Job &job) const;
+    /// Mark a job as done. Lock must be held.
+    void complete(const std::shared_ptr<Job> &job);
+    /// Dispatcher thread: plans jobs in order and releases their pieces
+    void dispatch();
+    /// I/O thread: runs pieces until stop_
+    void execute();
+
    public:
     /// AIO_Handlers are constructed around a synchronous PSIO object
-    AIOHandler(std::shared_ptr<PSIO> psio);
+    /// @param depth number of I/O threads, and so of pieces of I/O in flight at once
+    AIOHandler(std::shared_ptr<PSIO> psio, size_t depth = 4);
     /// Destructor
     ~AIOHandler();
     /// When called, synchronize will not return until all requested data has been read or written
@@ -113,6 +199,8 @@ class AIOHandler {
     /// The buffer has dimensions row_length by col_length. The disk space
     /// has dimensions row_length by col_length + col_skip.
     ///
+    /// The rows are submitted as a single job, and are read in parallel.
+    ///
     /// These functions are not necessary for psio, but for aio they are.
     ///
     size_t read_discont(size_t unit, const char *key, double **matrix, size_t row_length, size_t col_length,
@@ -124,7 +212,7 @@ class AIOHandler {
     /// Zero disk
     /// Fills a double precision disk entry with zeros
     /// Total fill size is rows*cols*sizeof(double)
-    /// Buffer memory of cols*sizeof(double) is used
+    /// Buffer memory of at most one piece of I/O (a few MiB) is used
     size_t zero_disk(size_t unit, const char *key, size_t rows, size_t cols);
     size_t zero_disk(size_t unit, const std::string& key, size_t rows, size_t cols) { return zero_disk(unit, key.c_str(), rows, cols); };
 
@@ -135,8 +223,6 @@ class AIOHandler {
     /// counting the number of integrals in the current buffer
     size_t write_iwl(size_t unit, const char *key, size_t nints, int lastbuf, char *labels, char *values,
                      size_t labsize, size_t valsize, size_t *address);
-    /// Generic function bound to thread internally
-    void call_aio();
 
     /// Function that checks if a job has been completed using the JobID.
     /// The function only returns when the job is completed.
@@ -52,6 +52,8 @@ void PSIO::close(size_t unit, int keep) {
 
     /* Dump all DPD cached entries for this file.  */
     global_dpd_->file4_cache_del_filenum(unit);
+    /* Finish the DPD background reads and writes on this file */
+    global_dpd_->file4_io_sync_filenum(unit);
 
     /* Dump the current TOC back out to disk */
     tocwrite(unit);
@@ -63,6 +65,9 @@ void PSIO::close(size_t unit, int keep) {
         free(this_entry);
         this_entry = next_entry;
     }
+    this_unit->toc = nullptr;
+    tocindex(unit);
+    uncache(unit);
 
     /* Close each volume (remove if necessary) and free the path */
     for (i = 0; i < this_unit->numvols; i++) {
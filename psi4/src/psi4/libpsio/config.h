@@ -40,6 +40,8 @@ namespace psi {
 #define PSIO_MAXVOL 8
 #define PSIO_MAXUNIT 500
 #define PSIO_PAGELEN 65536
+/* Default number of pages per unit kept by the read cache */
+#define PSIO_CACHEPAGES 32
 
 #define PSIO_ERROR_INIT 1
 #define PSIO_ERROR_DONE 2
@@ -90,6 +92,18 @@ struct psio_ud {
     psio_tocentry *toc;
 };
 
+/** A contiguous piece of a read or write within one volume file of a unit */
+struct psio_segment {
+    /*! File descriptor of the volume */
+    int stream;
+    /*! Byte offset within the volume file */
+    size_t offset;
+    /*! Memory for the bytes */
+    char *buffer;
+    /*! Number of bytes */
+    size_t size;
+};
+
 /** A convenient address initialization struct */
 extern PSI_API psio_address PSIO_ZERO;
 }
@@ -77,6 +77,10 @@ PSIO::PSIO() {
         psio_unit[i].toc = nullptr;
     }
 
+    cache_.resize(PSIO_MAXUNIT);
+    toc_index_.resize(PSIO_MAXUNIT);
+    cache_pages_ = PSIO_CACHEPAGES;
+
     /* Open user's general .psirc file, if exists */
     //  char *userhome = getenv("HOME");
     //  char *filename = (char*) malloc((strlen(userhome)+8)*sizeof(char));
@@ -114,12 +114,16 @@ void PSIO::open(size_t unit, int status) {
         free(path);
     }
 
+    /* Pages cached from an earlier life of this unit are stale */
+    uncache(unit);
+
     if (status == PSIO_OPEN_OLD)
         tocread(unit);
     else if (status == PSIO_OPEN_NEW) {
         /* Init the TOC stats and write them to disk */
         this_unit->toclen = 0;
         this_unit->toc = nullptr;
+        tocindex(unit);
         wt_toclen(unit, 0);
     } else
         psio_error(unit, PSIO_ERROR_OSTAT);
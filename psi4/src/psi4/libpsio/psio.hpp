@@ -30,10 +30,14 @@
 #define _psi_src_lib_libpsio_psio_hpp_
 
 #include <string>
+#include <list>
 #include <map>
+#include <mutex>
 #include <set>
 #include <queue>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 #include "psi4/libpsio/config.h"
 
@@ -257,6 +261,17 @@ class PSI_API PSIO {
      */
     void write(size_t unit, const char *key, char *buffer, size_t size, psio_address start, psio_address *end);
 
+    /** Does the TOC lookup and checks of read() without reading any data.
+     ** Arguments as for read().
+     ** \return the global address of the first byte of the block
+     */
+    psio_address read_address(size_t unit, const char *key, size_t size, psio_address start, psio_address *end);
+    /** Creates or extends the TOC entry as write() does, but does not write the data.
+     ** Arguments as for write().
+     ** \return the global address the block has to be written to
+     */
+    psio_address write_address(size_t unit, const char *key, size_t size, psio_address start, psio_address *end);
+
     void read_entry(size_t unit, const char *key, char *buffer, size_t size);
     void read_entry(size_t unit, const std::string& key, char *buffer, size_t size) { read_entry(unit, key.c_str(), buffer, size); };
     void write_entry(size_t unit, const char *key, char *buffer, size_t size);
@@ -287,6 +302,18 @@ class PSI_API PSIO {
      */
     void rw(size_t unit, char *buffer, psio_address address, size_t size, int wrt);
 
+    /** Splits a read/write on a PSIO unit into the contiguous pieces it touches in the volume files.
+     ** Lets a caller issue the I/O itself, e.g. with pread/pwrite from several threads.
+     **
+     ** \param unit     = The PSI unit number.
+     ** \param buffer   = The buffer containing the bytes for the read/write event.
+     ** \param address  = the PSIO global address for the start of the read/write.
+     ** \param size     = The number of bytes to read/write.
+     ** \param segments = The pieces are appended here, in buffer order.
+     **
+     */
+    void segments(size_t unit, char *buffer, psio_address address, size_t size, std::vector<psio_segment> &segments);
+
     /// Delete all TOC entries after the given key. If a blank key is given, the entire TOC will be wiped.
     void tocclean(size_t unit, const char *key);
     /// Print the table of contents for the given unit
@@ -320,6 +347,16 @@ class PSI_API PSIO {
     /// delete a specific TOC entry (only deletes entry, not data)
     bool tocdel(size_t unit, const char *key);
 
+    /** Sets the size of the read cache.
+     ** Reads smaller than a page are served from a per-unit LRU cache of whole pages
+     ** (PSIO_PAGELEN bytes), so that repeated small reads do not go to the kernel.
+     **
+     ** \param pages = Maximum number of pages cached per open unit; 0 disables the cache.
+     */
+    void set_cache_size(size_t pages);
+    /// Maximum number of pages cached per open unit
+    size_t get_cache_size() const { return cache_pages_; }
+
    private:
     /// vector of units
     psio_ud *psio_unit;
@@ -354,7 +391,45 @@ class PSI_API PSIO {
     /// Read the table of contents for file number 'unit'.
     void tocread(size_t unit);
 
-    friend class AIO_Handler;
+    /// A page of a unit held by the read cache
+    struct CachePage {
+        std::vector<char> data;
+        /// Number of bytes of data that exist on disk
+        size_t valid;
+        /// Position in the LRU list
+        std::list<size_t>::iterator lru;
+    };
+    /// The read cache of a unit, by global page number
+    struct UnitCache {
+        std::unordered_map<size_t, CachePage> pages;
+        /// Cached page numbers, most recently used first
+        std::list<size_t> lru;
+    };
+    /// Lookup structures for the TOC list of a unit
+    struct TOCIndex {
+        std::unordered_map<std::string, psio_tocentry *> entries;
+        psio_tocentry *last = nullptr;
+    };
+
+    /// Read cache of each unit
+    std::vector<UnitCache> cache_;
+    /// Maximum number of pages cached per unit
+    size_t cache_pages_;
+    /// TOC entries of each unit by key
+    std::vector<TOCIndex> toc_index_;
+    /// Guards cache_ and toc_index_, which AIOHandler also reaches from its threads
+    std::mutex table_lock_;
+
+    /// Rebuild the TOC index of a unit from its TOC list
+    void tocindex(size_t unit);
+    /// Serve a read from the cache, loading missing pages. False if it can't be, e.g. past the end of the file
+    bool cached_read(size_t unit, char *buffer, psio_address address, size_t size);
+    /// Drop cached pages overlapping size bytes at global address
+    void uncache(size_t unit, psio_address address, size_t size);
+    /// Drop all cached pages of a unit
+    void uncache(size_t unit);
+
+    friend class AIOHandler;
 
    public:
     void set_pid(const std::string &pid) { pid_ = pid; }
@@ -41,7 +41,17 @@
 namespace psi {
 
 void PSIO::read(size_t unit, const char *key, char *buffer, size_t size, psio_address start, psio_address *end) {
-    psio_ud *this_unit;
+    psio_address start_data = read_address(unit, key, size, start, end);
+
+    /* Now read the actual data from the unit */
+    rw(unit, buffer, start_data, size, 0);
+
+#ifdef PSIO_STATS
+    psio_readlen[unit] += size;
+#endif
+}
+
+psio_address PSIO::read_address(size_t unit, const char *key, size_t size, psio_address start, psio_address *end) {
     psio_tocentry *this_entry;
     psio_address start_toc, start_data, end_data; /* global addresses */
     size_t tocentry_size;
@@ -51,8 +61,6 @@ void PSIO::read(size_t unit, const char *key, char *buffer, size_t size, psio_ad
         psio_error(unit, PSIO_ERROR_UNOPENED);
     }
 
-    this_unit = &(psio_unit[unit]);
-
     /* Find the entry in the TOC */
     this_entry = tocscan(unit, key);
 
@@ -88,12 +96,7 @@ void PSIO::read(size_t unit, const char *key, char *buffer, size_t size, psio_ad
         *end = psio_get_address(start, size);
     }
 
-    /* Now read the actual data from the unit */
-    rw(unit, buffer, start_data, size, 0);
-
-#ifdef PSIO_STATS
-    psio_readlen[unit] += size;
-#endif
+    return start_data;
 }
 
 /*!
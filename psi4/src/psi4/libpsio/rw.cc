@@ -31,14 +31,105 @@
  \ingroup PSIO
  */
 
+#include <algorithm>
 #include <cstdio>
+#include <cstring>
 #include <cerrno>
+#include <future>
+#ifndef _MSC_VER
+#include <sys/uio.h>
+#endif
 #include "psi4/libpsio/psio.h"
 #include "psi4/libpsio/psio.hpp"
 #include "psi4/psi4-dec.h"
 
 namespace psi {
 
+namespace {
+
+#ifndef _MSC_VER
+/// Largest number of buffers passed to one preadv/pwritev
+const size_t max_iov = 512;
+#endif
+
+/// Read or write the pieces [first, last) of a volume, which are contiguous on disk, with as few calls as possible
+void vector_io(size_t unit, const psio_segment *first, const psio_segment *last, int wrt) {
+    const std::string beginning_all = (wrt ? "WRITE failed." : "READ failed.");
+    const std::string beginning_some =
+        (wrt ? "WRITE failed. Only some of the bytes were written!" : "READ failed. Only some of the bytes were read!");
+    const std::string context = (wrt ? "Error writing to a volume" : "Error reading from a volume");
+
+#ifdef _MSC_VER
+    // No positional I/O, seek and transfer piece by piece
+    for (const psio_segment *piece = first; piece != last; piece++) {
+        if (SYSTEM_LSEEK(piece->stream, piece->offset, SEEK_SET) == -1) {
+            const int saved_errno = errno;
+            psio_error(unit, PSIO_ERROR_LSEEK, psio_compose_err_msg("LSEEK failed.", context, unit, saved_errno));
+        }
+        auto errcod = (wrt ? SYSTEM_WRITE(piece->stream, piece->buffer, piece->size)
+                           : SYSTEM_READ(piece->stream, piece->buffer, piece->size));
+        const int saved_errno = errno;
+        if (errcod != piece->size) {
+            const std::string errmsg = (errcod == -1)
+                                           ? psio_compose_err_msg(beginning_all, context, unit, saved_errno)
+                                           : psio_compose_err_msg(beginning_some, context, unit);
+            psio_error(unit, (wrt ? PSIO_ERROR_WRITE : PSIO_ERROR_READ), errmsg);
+        }
+    }
+#else
+    std::vector<struct iovec> iov;
+    for (const psio_segment *piece = first; piece != last; piece++) {
+        iov.push_back({piece->buffer, piece->size});
+    }
+
+    int stream = first->stream;
+    size_t offset = first->offset;
+    size_t next = 0;
+    while (next < iov.size()) {
+        int count = std::min(iov.size() - next, max_iov);
+        auto errcod = (wrt ? ::pwritev(stream, &iov[next], count, offset) : ::preadv(stream, &iov[next], count, offset));
+        const int saved_errno = errno;
+        if (errcod == -1 && saved_errno == EINTR) continue;
+        if (errcod <= 0) {
+            const std::string errmsg = (errcod == -1)
+                                           ? psio_compose_err_msg(beginning_all, context, unit, saved_errno)
+                                           : psio_compose_err_msg(beginning_some, context, unit);
+            psio_error(unit, (wrt ? PSIO_ERROR_WRITE : PSIO_ERROR_READ), errmsg);
+        }
+
+        // Skip the buffers that are done, and trim a partially transferred one
+        size_t done = errcod;
+        offset += done;
+        while (done && done >= iov[next].iov_len) {
+            done -= iov[next].iov_len;
+            next++;
+        }
+        if (done) {
+            iov[next].iov_base = static_cast<char *>(iov[next].iov_base) + done;
+            iov[next].iov_len -= done;
+        }
+    }
+#endif
+}
+
+/// Transfer all pieces that live on stream, merging the ones that are contiguous on disk
+void volume_io(size_t unit, const std::vector<psio_segment> &pieces, int stream, int wrt) {
+    std::vector<psio_segment> mine;
+    for (const auto &piece : pieces) {
+        if (piece.stream == stream) mine.push_back(piece);
+    }
+
+    size_t begin = 0;
+    for (size_t i = 1; i <= mine.size(); i++) {
+        if (i == mine.size() || mine[i].offset != mine[i - 1].offset + mine[i - 1].size) {
+            vector_io(unit, &mine[begin], &mine[i], wrt);
+            begin = i;
+        }
+    }
+}
+
+}  // namespace
+
 /*!
  ** PSIO_RW(): Central function for all reads and writes on a PSIO unit.
  **
@@ -51,127 +142,162 @@ namespace psi {
  ** \ingroup PSIO
  */
 void PSIO::rw(size_t unit, char *buffer, psio_address address, size_t size, int wrt) {
-    size_t i;
-    size_t errcod_uli;
-    size_t page, offset;
-    size_t buf_offset;
-    size_t this_page, this_page_max, this_page_total;
-    size_t first_vol, this_vol, numvols;
-    size_t bytes_left, num_full_pages;
-    psio_ud *this_unit;
-
-    this_unit = &(psio_unit[unit]);
-    numvols = this_unit->numvols;
-    page = address.page;
-    offset = address.offset;
-
-    /* Seek all volumes to correct starting positions */
-    first_vol = page % numvols;
-    psio_volseek(&(this_unit->vol[first_vol]), page, offset, numvols, unit);
-    for (i = 1, this_page = page + 1; i < numvols; i++, this_page++) {
-        this_vol = this_page % numvols;
-        psio_volseek(&(this_unit->vol[this_vol]), this_page, (size_t)0, numvols, unit);
-    }
+    if (size == 0) return;
 
-    /* Number of bytes left on the first page */
-    this_page_max = PSIO_PAGELEN - offset;
-
-    /* If we have enough room on this page, use it */
-    if (size <= this_page_max)
-        this_page_total = size;
-    else
-        this_page_total = this_page_max;
-    buf_offset = 0;
-    if (wrt) {
-        errcod_uli = SYSTEM_WRITE(this_unit->vol[first_vol].stream, &(buffer[buf_offset]), this_page_total);
-        const int saved_errno = errno;
-        if (errcod_uli != this_page_total) {
-            const std::string beginning =
-                (errcod_uli == -1) ? "WRITE failed." : "WRITE failed. Only some of the bytes were written!";
-            const std::string context = "Error writing the first partial page";
-            const std::string errmsg = (errcod_uli == -1) ? psio_compose_err_msg(beginning, context, unit, saved_errno)
-                                                          : psio_compose_err_msg(beginning, context, unit);
-            psio_error(unit, PSIO_ERROR_WRITE, errmsg);
+    /* Small reads come from the page cache if possible */
+    if (!wrt && cache_pages_ && size < PSIO_PAGELEN && cached_read(unit, buffer, address, size)) return;
+    if (wrt) uncache(unit, address, size);
+
+    std::vector<psio_segment> pieces;
+    segments(unit, buffer, address, size, pieces);
+
+    psio_ud *this_unit = &(psio_unit[unit]);
+    size_t numvols = this_unit->numvols;
+
+    if (numvols > 1 && size > PSIO_PAGELEN) {
+        /* Striped over several volumes: one request per volume, in parallel */
+        std::vector<std::future<void>> requests;
+        for (size_t i = 1; i < numvols; i++) {
+            int stream = this_unit->vol[i].stream;
+            requests.push_back(
+                std::async(std::launch::async, [&pieces, unit, stream, wrt] { volume_io(unit, pieces, stream, wrt); }));
         }
+        volume_io(unit, pieces, this_unit->vol[0].stream, wrt);
+        for (auto &request : requests) request.get();
     } else {
-        errcod_uli = SYSTEM_READ(this_unit->vol[first_vol].stream, &(buffer[buf_offset]), this_page_total);
-        const int saved_errno = errno;
-        if (errcod_uli != this_page_total) {
-            const std::string beginning =
-                (errcod_uli == -1) ? "READ failed." : "READ failed. Only some of the bytes were read!";
-            const std::string context = "Error reading the first partial page";
-            const std::string errmsg = (errcod_uli == -1) ? psio_compose_err_msg(beginning, context, unit, saved_errno)
-                                                          : psio_compose_err_msg(beginning, context, unit);
-            psio_error(unit, PSIO_ERROR_READ, errmsg);
+        size_t begin = 0;
+        for (size_t i = 1; i <= pieces.size(); i++) {
+            if (i == pieces.size() || pieces[i].stream != pieces[i - 1].stream ||
+                pieces[i].offset != pieces[i - 1].offset + pieces[i - 1].size) {
+                vector_io(unit, &pieces[begin], &pieces[i], wrt);
+                begin = i;
+            }
         }
     }
+}
 
-    /* Total number of bytes remaining to be read/written */
-    bytes_left = size - this_page_total;
-
-    /* Read/Write all the full pages */
-    num_full_pages = bytes_left / PSIO_PAGELEN;
-    buf_offset += this_page_total;
-    for (i = 0, this_page = page + 1; i < num_full_pages; i++, this_page++) {
-        this_vol = this_page % numvols;
-        this_page_total = PSIO_PAGELEN;
-        if (wrt) {
-            errcod_uli = SYSTEM_WRITE(this_unit->vol[this_vol].stream, &(buffer[buf_offset]), this_page_total);
-            const int saved_errno = errno;
-            if (errcod_uli != this_page_total) {
-                const std::string beginning =
-                    (errcod_uli == -1) ? "WRITE failed." : "WRITE failed. Only some of the bytes were written!";
-                const std::string context = "Error writing a full page";
-                const std::string errmsg = (errcod_uli == -1)
-                                               ? psio_compose_err_msg(beginning, context, unit, saved_errno)
-                                               : psio_compose_err_msg(beginning, context, unit);
-                psio_error(unit, PSIO_ERROR_WRITE, errmsg);
+bool PSIO::cached_read(size_t unit, char *buffer, psio_address address, size_t size) {
+    std::lock_guard<std::mutex> guard(table_lock_);
+    UnitCache &cache = cache_[unit];
+
+    size_t offset = address.offset;
+    size_t done = 0;
+    for (size_t page = address.page; done < size; page++, offset = 0) {
+        auto it = cache.pages.find(page);
+        if (it == cache.pages.end()) {
+            /* Load the whole page; it may extend past the end of the file */
+            CachePage fresh;
+            fresh.data.resize(PSIO_PAGELEN);
+            fresh.valid = 0;
+            std::vector<psio_segment> pieces;
+            psio_address start = {page, 0};
+            segments(unit, fresh.data.data(), start, PSIO_PAGELEN, pieces);
+            const psio_segment &piece = pieces.front();
+            while (fresh.valid < piece.size) {
+#ifdef _MSC_VER
+                if (SYSTEM_LSEEK(piece.stream, piece.offset + fresh.valid, SEEK_SET) == -1) return false;
+                auto count = SYSTEM_READ(piece.stream, piece.buffer + fresh.valid, piece.size - fresh.valid);
+#else
+                auto count = ::pread(piece.stream, piece.buffer + fresh.valid, piece.size - fresh.valid,
+                                     piece.offset + fresh.valid);
+#endif
+                if (count == -1 && errno == EINTR) continue;
+                if (count == -1) return false;
+                if (count == 0) break;
+                fresh.valid += count;
             }
-        } else {
-            errcod_uli = SYSTEM_READ(this_unit->vol[this_vol].stream, &(buffer[buf_offset]), this_page_total);
-            const int saved_errno = errno;
-            if (errcod_uli != this_page_total) {
-                const std::string beginning =
-                    (errcod_uli == -1) ? "READ failed." : "READ failed. Only some of the bytes were read!";
-                const std::string context = "Error reading a full page";
-                const std::string errmsg = (errcod_uli == -1)
-                                               ? psio_compose_err_msg(beginning, context, unit, saved_errno)
-                                               : psio_compose_err_msg(beginning, context, unit);
-                psio_error(unit, PSIO_ERROR_READ, errmsg);
+
+            cache.lru.push_front(page);
+            fresh.lru = cache.lru.begin();
+            it = cache.pages.emplace(page, std::move(fresh)).first;
+
+            while (cache.pages.size() > cache_pages_) {
+                cache.pages.erase(cache.lru.back());
+                cache.lru.pop_back();
             }
+            /* The new page itself is never the one evicted, as cache_pages_ > 0 */
+        } else {
+            cache.lru.splice(cache.lru.begin(), cache.lru, it->second.lru);
         }
-        buf_offset += this_page_total;
+
+        size_t this_page_total = std::min(size - done, (size_t)PSIO_PAGELEN - offset);
+        if (offset + this_page_total > it->second.valid) return false;
+        std::memcpy(&(buffer[done]), &(it->second.data[offset]), this_page_total);
+        done += this_page_total;
     }
 
-    /* Read/Write the final partial page */
-    bytes_left -= num_full_pages * PSIO_PAGELEN;
-    this_vol = this_page % numvols;
-    if (bytes_left) {
-        if (wrt) {
-            errcod_uli = SYSTEM_WRITE(this_unit->vol[this_vol].stream, &(buffer[buf_offset]), bytes_left);
-            const int saved_errno = errno;
-            if (errcod_uli != bytes_left) {
-                const std::string beginning =
-                    (errcod_uli == -1) ? "WRITE failed." : "WRITE failed. Only some of the bytes were written!";
-                const std::string context = "Error writing the last partial page";
-                const std::string errmsg = (errcod_uli == -1)
-                                               ? psio_compose_err_msg(beginning, context, unit, saved_errno)
-                                               : psio_compose_err_msg(beginning, context, unit);
-                psio_error(unit, PSIO_ERROR_WRITE, errmsg);
+    return true;
+}
+
+void PSIO::uncache(size_t unit, psio_address address, size_t size) {
+    std::lock_guard<std::mutex> guard(table_lock_);
+    UnitCache &cache = cache_[unit];
+    if (cache.pages.empty() || size == 0) return;
+
+    size_t first = address.page;
+    size_t last = psio_get_address(address, size - 1).page;
+    if (last - first < cache.pages.size()) {
+        for (size_t page = first; page <= last; page++) {
+            auto it = cache.pages.find(page);
+            if (it == cache.pages.end()) continue;
+            cache.lru.erase(it->second.lru);
+            cache.pages.erase(it);
+        }
+    } else {
+        for (auto it = cache.pages.begin(); it != cache.pages.end();) {
+            if (it->first >= first && it->first <= last) {
+                cache.lru.erase(it->second.lru);
+                it = cache.pages.erase(it);
+            } else {
+                ++it;
             }
+        }
+    }
+}
+
+void PSIO::uncache(size_t unit) {
+    std::lock_guard<std::mutex> guard(table_lock_);
+    cache_[unit].pages.clear();
+    cache_[unit].lru.clear();
+}
+
+void PSIO::set_cache_size(size_t pages) {
+    std::lock_guard<std::mutex> guard(table_lock_);
+    cache_pages_ = pages;
+    for (auto &cache : cache_) {
+        while (cache.pages.size() > cache_pages_) {
+            cache.pages.erase(cache.lru.back());
+            cache.lru.pop_back();
+        }
+    }
+}
+
+void PSIO::segments(size_t unit, char *buffer, psio_address address, size_t size,
+                    std::vector<psio_segment> &segments) {
+    psio_ud *this_unit = &(psio_unit[unit]);
+    size_t numvols = this_unit->numvols;
+    size_t page = address.page;
+    size_t offset = address.offset;
+
+    size_t buf_offset = 0;
+    while (buf_offset < size) {
+        size_t this_vol = page % numvols;
+        size_t this_page_total = std::min(size - buf_offset, (size_t)PSIO_PAGELEN - offset);
+        psio_segment piece = {this_unit->vol[this_vol].stream, (page / numvols) * PSIO_PAGELEN + offset,
+                              &(buffer[buf_offset]), this_page_total};
+
+        // Consecutive pages of a single-volume unit are contiguous on disk, merge them
+        psio_segment *last = (segments.empty() ? nullptr : &segments.back());
+        if (last && last->stream == piece.stream && last->offset + last->size == piece.offset &&
+            last->buffer + last->size == piece.buffer) {
+            last->size += piece.size;
         } else {
-            errcod_uli = SYSTEM_READ(this_unit->vol[this_vol].stream, &(buffer[buf_offset]), bytes_left);
-            const int saved_errno = errno;
-            if (errcod_uli != bytes_left) {
-                const std::string beginning =
-                    (errcod_uli == -1) ? "READ failed." : "READ failed. Only some of the bytes were read!";
-                const std::string context = "Error reading the last partial page";
-                const std::string errmsg = (errcod_uli == -1)
-                                               ? psio_compose_err_msg(beginning, context, unit, saved_errno)
-                                               : psio_compose_err_msg(beginning, context, unit);
-                psio_error(unit, PSIO_ERROR_READ, errmsg);
-            }
+            segments.push_back(piece);
         }
+
+        buf_offset += this_page_total;
+        page++;
+        offset = 0;
     }
 }
 }  // namespace psi
@@ -72,6 +72,9 @@ void PSIO::tocclean(size_t unit, const char *key) {
         last_entry = prev_entry;
         this_unit->toclen--;
     }
+    /* Terminate the list at the new tail */
+    if (last_entry != nullptr) last_entry->next = nullptr;
+    tocindex(unit);
 
     /* Update on disk */
     wt_toclen(unit, this_unit->toclen);
@@ -60,6 +60,7 @@ bool PSIO::tocdel(size_t unit, const char *key) {
     free(this_entry);
     psio_ud *this_unit = &(psio_unit[unit]);
     this_unit->toclen--;
+    tocindex(unit);
 
     return true;
 }
@@ -37,11 +37,27 @@
 namespace psi {
 
 psio_tocentry *PSIO::toclast(size_t unit) {
-    psio_tocentry *this_entry = psio_unit[unit].toc;
-
-    while (this_entry->next != nullptr) this_entry = this_entry->next;
+    std::lock_guard<std::mutex> guard(table_lock_);
+    return toc_index_[unit].last;
+}
 
-    return (this_entry);
+/*!
+** PSIO::tocindex(): Rebuild the key lookup table and the tail pointer of
+** a unit's TOC from its linked list. Must be called whenever the list is
+** replaced or entries are removed.
+**
+** \ingroup PSIO
+*/
+void PSIO::tocindex(size_t unit) {
+    std::lock_guard<std::mutex> guard(table_lock_);
+    TOCIndex &index = toc_index_[unit];
+    index.entries.clear();
+    index.last = nullptr;
+    for (psio_tocentry *this_entry = psio_unit[unit].toc; this_entry != nullptr; this_entry = this_entry->next) {
+        /* Keys are unique, but keep the first one like a linear scan would */
+        index.entries.emplace(this_entry->key, this_entry);
+        index.last = this_entry;
+    }
 }
 
 }  // namespace psi
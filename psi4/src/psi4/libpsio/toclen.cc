@@ -100,6 +100,7 @@ size_t PSIO::rd_toclen(const size_t unit) {
 /// @param len  : length value to write
 void PSIO::wt_toclen(const size_t unit, const size_t len) {
     if (!open_check(unit)) psio_error(unit, PSIO_ERROR_UNOPENED);
+    uncache(unit, PSIO_ZERO, sizeof(size_t));
     // Seek to the beginning
     rewind_toclen(unit);
     // Write the value
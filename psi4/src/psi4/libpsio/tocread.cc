@@ -79,6 +79,8 @@ void PSIO::tocread(size_t unit) {
         address = this_entry->eadd;
         this_entry = this_entry->next;
     }
+
+    tocindex(unit);
 }
 
 }  // namespace psi
@@ -49,18 +49,14 @@ psio_tocentry *PSIO::tocscan(size_t unit, const char *key) {
     bool already_open = open_check(unit);
     if (!already_open) open(unit, PSIO_OPEN_OLD);
 
-    this_entry = psio_unit[unit].toc;
-
-    while (this_entry != nullptr) {
-        if (!strcmp(this_entry->key, key)) {
-            if (!already_open) close(unit, 1);  // keep
-            return (this_entry);
-        }
-        this_entry = this_entry->next;
+    {
+        std::lock_guard<std::mutex> guard(table_lock_);
+        auto it = toc_index_[unit].entries.find(key);
+        this_entry = (it == toc_index_[unit].entries.end()) ? nullptr : it->second;
     }
 
     if (!already_open) close(unit, 1);  // keep
-    return (nullptr);
+    return (this_entry);
 }
 
 /*!
@@ -82,18 +78,14 @@ bool PSIO::tocentry_exists(size_t unit, const char *key) {
     bool already_open = open_check(unit);
     if (!already_open) open(unit, PSIO_OPEN_OLD);
 
-    this_entry = psio_unit[unit].toc;
-
-    while (this_entry != nullptr) {
-        if (!strcmp(this_entry->key, key)) {
-            if (!already_open) close(unit, 1);  // keep
-            return (true);
-        }
-        this_entry = this_entry->next;
+    {
+        std::lock_guard<std::mutex> guard(table_lock_);
+        auto it = toc_index_[unit].entries.find(key);
+        this_entry = (it == toc_index_[unit].entries.end()) ? nullptr : it->second;
     }
 
     if (!already_open) close(unit, 1);  // keep
-    return (false);
+    return (this_entry != nullptr);
 }
 
 /*!
@@ -41,6 +41,17 @@
 namespace psi {
 
 void PSIO::write(size_t unit, const char *key, char *buffer, size_t size, psio_address start, psio_address *end) {
+    psio_address start_data = write_address(unit, key, size, start, end);
+
+    /* Now write the actual data to the unit */
+    rw(unit, buffer, start_data, size, 1);
+
+#ifdef PSIO_STATS
+    psio_writlen[unit] += size;
+#endif
+}
+
+psio_address PSIO::write_address(size_t unit, const char *key, size_t size, psio_address start, psio_address *end) {
     psio_ud *this_unit;
     psio_tocentry *this_entry, *last_entry;
     psio_address start_toc, start_data, end_data; /* global addresses */
@@ -76,6 +87,11 @@ void PSIO::write(size_t unit, const char *key, char *buffer, size_t size, psio_a
             last_entry->next = this_entry;
             this_entry->last = last_entry;
         }
+        {
+            std::lock_guard<std::mutex> guard(table_lock_);
+            toc_index_[unit].entries.emplace(this_entry->key, this_entry);
+            toc_index_[unit].last = this_entry;
+        }
 
         /* compute important global addresses for the entry */
         start_toc = this_entry->sadd;
@@ -130,12 +146,7 @@ void PSIO::write(size_t unit, const char *key, char *buffer, size_t size, psio_a
     if (dirty) /* Need to first write/update the TOC header for this record */
         rw(unit, (char *)this_entry, start_toc, tocentry_size, 1);
 
-    /* Now write the actual data to the unit */
-    rw(unit, buffer, start_data, size, 1);
-
-#ifdef PSIO_STATS
-    psio_writlen[unit] += size;
-#endif
+    return start_data;
 }
 
 /*!
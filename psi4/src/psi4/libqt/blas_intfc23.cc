@@ -64,6 +64,7 @@ extern void F_DTRMM(char*, char*, char*, char*, int*, int*, double*, double*, in
 extern void F_DTRMV(char*, char*, char*, int*, double*, int*, double*, int*);
 extern void F_DTRSM(char*, char*, char*, char*, int*, int*, double*, double*, int*, double*, int*);
 extern void F_DTRSV(char*, char*, char*, int*, double*, int*, double*, int*);
+extern void F_SGEMM(char*, char*, int*, int*, int*, float*, float*, int*, float*, int*, float*, float*, int*);
 }
 
 namespace psi {
@@ -327,6 +328,20 @@ PSI_API void C_DGEMM(char transa, char transb, int m, int n, int k, double alpha
     ::F_DGEMM(&transb, &transa, &n, &m, &k, &alpha, b, &ldb, a, &lda, &beta, c, &ldc);
 }
 
+/**
+ *  Single-precision counterpart of C_DGEMM, with the same row-major
+ *  argument convention:
+ *
+ *     C := alpha*op( A )*op( B ) + beta*C,
+ *
+ *  Used by the mixed-precision DFT quadrature.
+ **/
+PSI_API void C_SGEMM(char transa, char transb, int m, int n, int k, float alpha, float* a, int lda, float* b, int ldb,
+                     float beta, float* c, int ldc) {
+    if (m == 0 || n == 0 || k == 0) return;
+    ::F_SGEMM(&transb, &transa, &n, &m, &k, &alpha, b, &ldb, a, &lda, &beta, c, &ldc);
+}
+
 /**
  *  Purpose
  *  =======
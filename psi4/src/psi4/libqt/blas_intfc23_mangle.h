@@ -64,6 +64,7 @@
 #define F_DTRMV FC_GLOBAL(dtrmv, DTRMV)
 #define F_DTRSM FC_GLOBAL(dtrsm, DTRSM)
 #define F_DTRSV FC_GLOBAL(dtrsv, DTRSV)
+#define F_SGEMM FC_GLOBAL(sgemm, SGEMM)
 #else  // USE_FCMANGLE_H
 #if FC_SYMBOL == 2
 #define F_DGBMV dgbmv_
@@ -88,6 +89,7 @@
 #define F_DTRMV dtrmv_
 #define F_DTRSM dtrsm_
 #define F_DTRSV dtrsv_
+#define F_SGEMM sgemm_
 #elif FC_SYMBOL == 1
 #define F_DGBMV dgbmv
 #define F_DGEMM dgemm
@@ -111,6 +113,7 @@
 #define F_DTRMV dtrmv
 #define F_DTRSM dtrsm
 #define F_DTRSV dtrsv
+#define F_SGEMM sgemm
 #elif FC_SYMBOL == 3
 #define F_DGBMV DGBMV
 #define F_DGEMM DGEMM
@@ -134,6 +137,7 @@
 #define F_DTRMV DTRMV
 #define F_DTRSM DTRSM
 #define F_DTRSV DTRSV
+#define F_SGEMM SGEMM
 #elif FC_SYMBOL == 4
 #define F_DGBMV DGBMV_
 #define F_DGEMM DGEMM_
@@ -157,6 +161,7 @@
 #define F_DTRMV DTRMV_
 #define F_DTRSM DTRSM_
 #define F_DTRSV DTRSV_
+#define F_SGEMM SGEMM_
 #endif
 #endif
 
@@ -155,6 +155,11 @@ void C_DSYR2K(char uplo, char trans, int n, int k, double alpha, double* a, int
 PSI_API
 void C_DTRSV(char uplo, char trans, char diag, int n, double* a, int lda, double* x, int incx);
 
+// BLAS 3 Single routines
+PSI_API
+void C_SGEMM(char transa, char transb, int m, int n, int k, float alpha, float* a, int lda, float* b, int ldb,
+             float beta, float* c, int ldc);
+
 // LAPACK 3.2 Double routines
 // Sorry guys, I know its rather epic
 int C_DBDSDC(char uplo, char compq, int n, double* d, double* e, double* u, int ldu, double* vt, int ldvt, double* q,
@@ -0,0 +1,321 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2026 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+/*
+ *  guess_history.cc
+ *
+ * Extrapolated SCF guess from the converged orbitals
+ * of previous SCF computations (GUESS EXTRAPOLATE)
+ *
+ */
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "psi4/libmints/basisset.h"
+#include "psi4/libmints/integral.h"
+#include "psi4/libmints/matrix.h"
+#include "psi4/libmints/onebody.h"
+#include "psi4/libmints/vector.h"
+#include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/liboptions/liboptions.h"
+#include "hf.h"
+#include "guess_history.h"
+
+namespace psi {
+namespace scf {
+
+// => GuessHistory <= //
+
+namespace {
+
+/// Guards the history
+std::mutex guess_history_lock;
+/// System the entries belong to
+std::string guess_history_key;
+/// Entries, most recent first
+std::deque<GuessHistory::Entry> guess_history;
+
+/// Binomial coefficient
+double binomial(int n, int k) {
+    if (k < 0 || k > n) return 0.0;
+    double value = 1.0;
+    for (int i = 1; i <= k; i++) value = value * (n - k + i) / i;
+    return value;
+}
+
+/// Y (YᵀY)^-1/2, the closest matrix to Y with orthonormal columns
+SharedMatrix lowdin_orthonormalize(SharedMatrix Y) {
+    auto M = linalg::doublet(Y, Y, true, false);
+    M->power(-0.5);
+    return linalg::doublet(Y, M);
+}
+
+/// Grassmann logarithm at Y0 of Y: the tangent vector at Y0 pointing to the span of Y
+SharedMatrix grassmann_log(SharedMatrix Y0, SharedMatrix Y) {
+    // (1 - Y0 Y0ᵀ) Y (Y0ᵀ Y)^-1 = Y (Y0ᵀ Y)^-1 - Y0
+    auto A = linalg::doublet(Y0, Y, true, false);
+    A->general_invert();
+    auto M = linalg::doublet(Y, A);
+    M->subtract(Y0);
+
+    auto [U, s, V] = M->svd_temps();
+    M->svd(U, s, V);
+    for (int i = 0; i < s->dim(); i++) U->scale_column(0, i, std::atan(s->get(i)));
+    return linalg::doublet(U, V);
+}
+
+/// Grassmann exponential at Y0 of the tangent vector G
+SharedMatrix grassmann_exp(SharedMatrix Y0, SharedMatrix G) {
+    auto [U, s, V] = G->svd_temps();
+    G->svd(U, s, V);
+
+    // Y0 Vᵀ cos(s) V + U sin(s) V
+    auto Y0V = linalg::doublet(Y0, V, false, true);
+    for (int i = 0; i < s->dim(); i++) {
+        Y0V->scale_column(0, i, std::cos(s->get(i)));
+        U->scale_column(0, i, std::sin(s->get(i)));
+    }
+    Y0V->add(U);
+    return linalg::doublet(Y0V, V);
+}
+
+}  // namespace
+
+void GuessHistory::push(const std::string& key, const Entry& entry, size_t max_size) {
+    std::lock_guard<std::mutex> guard(guess_history_lock);
+    if (key != guess_history_key) {
+        guess_history.clear();
+        guess_history_key = key;
+    }
+    guess_history.push_front(entry);
+    while (guess_history.size() > std::max(max_size, size_t(1))) guess_history.pop_back();
+}
+std::vector<GuessHistory::Entry> GuessHistory::entries(const std::string& key) {
+    std::lock_guard<std::mutex> guard(guess_history_lock);
+    if (key != guess_history_key) return {};
+    return std::vector<Entry>(guess_history.begin(), guess_history.end());
+}
+size_t GuessHistory::size() {
+    std::lock_guard<std::mutex> guard(guess_history_lock);
+    return guess_history.size();
+}
+void GuessHistory::clear() {
+    std::lock_guard<std::mutex> guard(guess_history_lock);
+    guess_history.clear();
+    guess_history_key.clear();
+}
+
+std::vector<double> GuessHistory::aspc_coefficients(size_t n) {
+    if (n <= 1) return std::vector<double>(n, 1.0);
+
+    // B_j = (-1)^(j+1) j C(2k+4, k+2-j) / C(2k+2, k+1), j = 1 .. k+2
+    int k = n - 2;
+    std::vector<double> B(n);
+    for (int j = 1; j <= k + 2; j++) {
+        B[j - 1] = (j % 2 ? 1.0 : -1.0) * j * binomial(2 * k + 4, k + 2 - j) / binomial(2 * k + 2, k + 1);
+    }
+    return B;
+}
+
+SharedMatrix GuessHistory::extrapolate(const std::vector<Entry>& history, bool alpha, std::shared_ptr<BasisSet> basis,
+                                       const std::string& scheme, double lindep) {
+    int nbf = basis->nbf();
+    int nocc = (alpha ? history[0].Ca : history[0].Cb)->colspi()[0];
+    auto D = std::make_shared<Matrix>("Extrapolated AO density", nbf, nbf);
+    if (!nocc) return D;
+
+    // Orthogonalizer X of the new basis, nbf x nmo
+    IntegralFactory factory(basis);
+    std::unique_ptr<OneBodyAOInt> overlap(factory.ao_overlap());
+    auto S = std::make_shared<Matrix>("S", nbf, nbf);
+    overlap->compute(S);
+
+    auto U = std::make_shared<Matrix>("U", nbf, nbf);
+    auto s = std::make_shared<Vector>("s", nbf);
+    S->diagonalize(U, s, descending);
+    int nmo = 0;
+    while (nmo < nbf && s->get(nmo) > lindep) nmo++;
+    auto X = std::make_shared<Matrix>("X", nbf, nmo);
+    for (int m = 0; m < nbf; m++) {
+        for (int p = 0; p < nmo; p++) X->set(m, p, U->get(m, p) / std::sqrt(s->get(p)));
+    }
+
+    // Occupied orbitals of every entry, projected into the orthonormalized new basis:
+    // Y = Xᵀ S (S^-1 S_BA C) = Xᵀ S_BA C
+    std::vector<SharedMatrix> Y;
+    for (const auto& entry : history) {
+        auto C = (alpha ? entry.Ca : entry.Cb);
+        if (C->colspi()[0] != nocc) {
+            throw PSIEXCEPTION("GuessHistory::extrapolate: the entries do not have the same number of electrons.");
+        }
+        IntegralFactory mixed(entry.basis, basis, entry.basis, basis);
+        std::unique_ptr<OneBodyAOInt> mixed_overlap(mixed.ao_overlap());
+        auto S_AB = std::make_shared<Matrix>("S_AB", entry.basis->nbf(), nbf);
+        mixed_overlap->compute(S_AB);
+
+        auto T = linalg::doublet(S_AB, C, true, false);
+        Y.push_back(lowdin_orthonormalize(linalg::doublet(X, T, true, false)));
+    }
+
+    auto B = aspc_coefficients(Y.size());
+
+    SharedMatrix Y_next;
+    if (scheme == "GRASSMANN") {
+        // tangent vectors at the most recent entry, whose own is zero
+        auto G = std::make_shared<Matrix>("G", nmo, nocc);
+        for (size_t j = 1; j < Y.size(); j++) {
+            auto Gj = grassmann_log(Y[0], Y[j]);
+            G->axpy(B[j], Gj);
+        }
+        Y_next = lowdin_orthonormalize(grassmann_exp(Y[0], G));
+    } else if (scheme == "ASPC") {
+        auto P = std::make_shared<Matrix>("P", nmo, nmo);
+        for (size_t j = 0; j < Y.size(); j++) {
+            P->gemm(false, true, B[j], Y[j], Y[j], 1.0);
+        }
+        // purify to the leading natural orbitals
+        auto V = std::make_shared<Matrix>("V", nmo, nmo);
+        auto n = std::make_shared<Vector>("n", nmo);
+        P->diagonalize(V, n, descending);
+        Y_next = std::make_shared<Matrix>("Y", nmo, nocc);
+        for (int p = 0; p < nmo; p++) {
+            for (int i = 0; i < nocc; i++) Y_next->set(p, i, V->get(p, i));
+        }
+    } else {
+        throw PSIEXCEPTION("GuessHistory::extrapolate: unknown extrapolation scheme " + scheme + ".");
+    }
+
+    auto C_next = linalg::doublet(X, Y_next);
+    D->gemm(false, true, 1.0, C_next, C_next, 0.0);
+    return D;
+}
+
+// => HF <= //
+
+namespace {
+
+/// Identifies the system of an SCF: the basis set, without its centers, and the electron count
+std::string history_key(const BasisSet& basis, int nalpha, int nbeta) {
+    std::ostringstream key;
+    key << basis.fingerprint() << " nalpha=" << nalpha << " nbeta=" << nbeta;
+    return key.str();
+}
+
+/// Number of orbitals per irrep among the nocc with the largest occupations
+Dimension leading_occupations(const Vector& n, int nocc) {
+    std::vector<std::pair<double, int>> all;
+    for (int h = 0; h < n.nirrep(); h++) {
+        for (int p = 0; p < n.dimpi()[h]; p++) all.emplace_back(n.get(h, p), h);
+    }
+    std::stable_sort(all.begin(), all.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    Dimension noccpi(n.nirrep());
+    for (int i = 0; i < nocc && i < static_cast<int>(all.size()); i++) noccpi[all[i].second]++;
+    return noccpi;
+}
+
+}  // namespace
+
+void HF::natural_orbitals_guess(SharedMatrix D_ao, SharedMatrix C, Vector& n) {
+    // CᵀSDSC = n with C = XV, in descending order per irrep
+    auto D = std::make_shared<Matrix>("D", nsopi_, nsopi_);
+    D->apply_symmetry(D_ao, AO2SO_);
+    auto SX = linalg::doublet(S_, X_);
+    auto Dmo = linalg::triplet(SX, D, SX, true, false, false);
+    auto V = std::make_shared<Matrix>("V", X_->colspi(), X_->colspi());
+    Dmo->diagonalize(*V, n, descending);
+    C->gemm(false, false, 1.0, X_, V, 0.0);
+}
+
+bool HF::compute_extrapolated_guess() {
+    // The entries are projected into basisset_ whichever basis they are keyed on
+    auto history = GuessHistory::entries(
+        history_key((guess_history_basis_ ? *guess_history_basis_ : *basisset_), nalpha_, nbeta_));
+    if (history.empty()) {
+        if (print_) outfile->Printf("  SCF Guess: No previous SCF solutions to extrapolate, falling back to SAD.\n\n");
+        return false;
+    }
+
+    auto scheme = options_.get_str("GUESS_EXTRAPOLATION");
+    double lindep = options_.get_double("S_TOLERANCE");
+    if (print_) {
+        outfile->Printf("  SCF Guess: %s extrapolation of %zu previous SCF solution%s", scheme.c_str(), history.size(),
+                        (history.size() > 1 ? "s" : ""));
+        outfile->Printf(", projected into the current basis.\n\n");
+    }
+
+    auto Da_ao = GuessHistory::extrapolate(history, true, basisset_, scheme, lindep);
+    Vector occ_a(X_->colspi());
+
+    if (same_a_b_orbs_) {
+        // natural orbitals of the total density, doubly occupied first
+        auto D_ao = Da_ao->clone();
+        if (same_a_b_dens_) {
+            D_ao->scale(2.0);
+        } else {
+            D_ao->add(GuessHistory::extrapolate(history, false, basisset_, scheme, lindep));
+        }
+        natural_orbitals_guess(D_ao, Ca_, occ_a);
+        if (!(input_docc_ || input_socc_)) {
+            nalphapi_ = leading_occupations(occ_a, nalpha_);
+            nbetapi_ = leading_occupations(occ_a, nbeta_);
+        }
+    } else {
+        auto Db_ao = GuessHistory::extrapolate(history, false, basisset_, scheme, lindep);
+        Vector occ_b(X_->colspi());
+        natural_orbitals_guess(Da_ao, Ca_, occ_a);
+        natural_orbitals_guess(Db_ao, Cb_, occ_b);
+        if (!(input_docc_ || input_socc_)) {
+            nalphapi_ = leading_occupations(occ_a, nalpha_);
+            nbetapi_ = leading_occupations(occ_b, nbeta_);
+        }
+    }
+
+    return true;
+}
+
+void HF::save_guess_history() {
+    // A solution in another basis than the history's only reads it, so that
+    // the small-basis step of a BASIS_GUESS does not displace the target's entries
+    if (guess_history_basis_) return;
+
+    GuessHistory::Entry entry;
+    entry.basis = basisset_;
+    entry.Ca = Ca_subset("AO", "OCC");
+    entry.Cb = Cb_subset("AO", "OCC");
+    GuessHistory::push(history_key(*basisset_, nalpha_, nbeta_), entry, options_.get_int("GUESS_HISTORY_SIZE"));
+}
+
+}  // namespace scf
+}  // namespace psi
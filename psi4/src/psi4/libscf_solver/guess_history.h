@@ -0,0 +1,106 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2026 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#ifndef LIBSCF_GUESS_HISTORY_H
+#define LIBSCF_GUESS_HISTORY_H
+
+#include "psi4/pragma.h"
+#include "psi4/libmints/typedefs.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace psi {
+
+class BasisSet;
+
+namespace scf {
+
+/**
+ * Class GuessHistory
+ *
+ * Process-wide record of the converged occupied orbitals of the last few SCF
+ * computations on a system, for the EXTRAPOLATE guess of the next one, as at
+ * every step of a geometry optimization or a trajectory.
+ *
+ * Each entry keeps the BasisSet it was converged in, and thereby its geometry.
+ * To extrapolate, the orbitals of every entry are first projected into the
+ * current basis through the mixed overlap (Werner's projection). Then either:
+ *
+ *  - GRASSMANN: the occupied spaces are mapped to tangent vectors at the most
+ *    recent one (Grassmann logarithm), extrapolated, and mapped back
+ *    (Grassmann exponential). The result is idempotent by construction.
+ *  - ASPC: the projected densities are combined directly and purified to
+ *    their leading natural orbitals.
+ *
+ * Both use the predictor coefficients of Kolafa's always stable
+ * predictor-corrector (J. Comput. Chem. 25, 335 (2004)) for the number of
+ * entries at hand, which reduce to linear extrapolation for two.
+ */
+class PSI_API GuessHistory {
+   public:
+    /// Converged occupied orbitals of one SCF
+    struct Entry {
+        /// Basis set, at the geometry of the SCF, the orbitals are expanded in
+        std::shared_ptr<BasisSet> basis;
+        /// Occupied alpha orbitals in the AO basis
+        SharedMatrix Ca;
+        /// Occupied beta orbitals in the AO basis
+        SharedMatrix Cb;
+    };
+
+    /// Adds entry for the system identified by key, keeping the max_size most recent.
+    /// Entries of any other system are dropped.
+    static void push(const std::string& key, const Entry& entry, size_t max_size);
+    /// Entries of the system identified by key, most recent first
+    static std::vector<Entry> entries(const std::string& key);
+    /// Number of entries kept
+    static size_t size();
+    /// Drops all entries
+    static void clear();
+
+    /// Predictor coefficients for n previous steps, most recent first
+    static std::vector<double> aspc_coefficients(size_t n);
+
+    /**
+     * Extrapolated AO density of the next step in basis
+     * @param history entries, most recent first
+     * @param alpha extrapolate the alpha (or else the beta) orbitals
+     * @param basis basis set of the next step
+     * @param scheme GRASSMANN or ASPC
+     * @param lindep eigenvalues of the overlap of basis below this are projected out
+     */
+    static SharedMatrix extrapolate(const std::vector<Entry>& history, bool alpha, std::shared_ptr<BasisSet> basis,
+                                    const std::string& scheme, double lindep);
+};
+
+}  // namespace scf
+}  // namespace psi
+
+#endif
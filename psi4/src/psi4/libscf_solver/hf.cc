@@ -68,6 +68,7 @@
 #include "psi4/libmints/sobasis.h"
 
 #include "hf.h"
+#include "guess_history.h"
 
 #include "psi4/psi4-dec.h"
 
@@ -1005,6 +1006,7 @@ void HF::guess() {
     // "CORE"-CORE Hamiltonain
     // "GWH"-Generalized Wolfsberg-Helmholtz
     // "SAD"-Superposition of Atomic Densities
+    // "EXTRAPOLATE"-Extrapolation of earlier SCF solutions, SAD if there are none
     std::string guess_type = options_.get_str("GUESS");
 
     // Take care of options that should be overridden
@@ -1075,7 +1077,15 @@ void HF::guess() {
         iteration_ = -1;
         guess_E = compute_initial_E();
 
-    } else if (guess_type == "SAD") {
+    } else if (guess_type == "EXTRAPOLATE" && compute_extrapolated_guess()) {
+        format_guess();
+        form_D();
+
+        // This is a guess iteration: orbital occupations may be reset in SCF
+        iteration_ = -1;
+        guess_E = compute_initial_E();
+
+    } else if (guess_type == "SAD" || guess_type == "EXTRAPOLATE") {
         if (print_)
             outfile->Printf(
                 "  SCF Guess: Superposition of Atomic Densities via on-the-fly atomic UHF (no occupation "
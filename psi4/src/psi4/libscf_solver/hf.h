@@ -90,6 +90,10 @@ class HF : public Wavefunction {
     std::vector<std::shared_ptr<BasisSet>> sad_basissets_;
     std::vector<std::shared_ptr<BasisSet>> sad_fitting_basissets_;
 
+    /// Basis the EXTRAPOLATE history is looked up in, if not basisset_
+    /// (the target basis, in the small-basis SCF of a BASIS_GUESS)
+    std::shared_ptr<BasisSet> guess_history_basis_;
+
     /// Current Iteration
     int iteration_;
 
@@ -216,6 +220,10 @@ class HF : public Wavefunction {
     virtual void compute_huckel_guess(bool updated_rule);
     /// Forms the SAPGAU guess
     virtual void compute_sapgau_guess();
+    /// Forms the EXTRAPOLATE guess from the saved solutions of earlier SCFs; false if there are none
+    bool compute_extrapolated_guess();
+    /// Natural orbitals C and occupations n of an AO density, from the orthogonalizer X_
+    void natural_orbitals_guess(SharedMatrix D_ao, SharedMatrix C, Vector& n);
 
     /** Transformation, diagonalization, and backtransform of Fock matrix */
     virtual void diagonalize_F(const SharedMatrix& F, SharedMatrix& C, std::shared_ptr<Vector>& eps);
@@ -369,6 +377,9 @@ class HF : public Wavefunction {
     /// Form the guess (guarantees C, D, and E)
     virtual void guess();
 
+    /// Saves the converged occupied orbitals for later EXTRAPOLATE guesses
+    void save_guess_history();
+
     /// Compute the MO coefficients (C_) using level shift
     virtual void form_C(double shift = 0.0);
     /** Computes the initial MO coefficients (default is to call form_C) */
@@ -427,6 +438,9 @@ class HF : public Wavefunction {
         sad_fitting_basissets_ = basis_vec;
     }
 
+    // EXTRAPOLATE information
+    void set_guess_history_basis(std::shared_ptr<BasisSet> basis) { guess_history_basis_ = basis; }
+
     // Energies data
     void set_energies(std::string key, double value) { energies_[key] = value; }
     double get_energies(std::string key) { return energies_[key]; }
@@ -2040,17 +2040,21 @@ std::shared_ptr<Matrix> RSCFDeriv::hessian_response() {
             for (int A = 0; A < 3 * natom; A++)
                 psio_->write(PSIF_HESS, "VXCpi^A", (char*)Up[0], static_cast<size_t>(nmo) * nocc * sizeof(double),
                              next_VXCpi, &next_VXCpi);
-            // For now we just compute all 3N matrices in one go.  If this becomes to burdensome
-            // in terms of memory we can reevaluate and implement a batching mechanism instead.
-            auto Vxc_matrices = potential_->compute_fock_derivatives();
-            for (int a = 0; a < 3 * natom; ++a) {
-                // Transform from SO basis to pi
-                C_DGEMM('N', 'N', nso, nocc, nso, 1.0, Vxc_matrices[a]->pointer()[0], nso, Cop[0], nocc, 0.0, Tp[0],
-                        nocc);
-                C_DGEMM('T', 'N', nmo, nocc, nso, 1.0, Cp[0], nmo, Tp[0], nocc, 0.0, Up[0], nocc);
-                next_VXCpi = psio_get_address(PSIO_ZERO, a * (size_t)nmo * nocc * sizeof(double));
-                psio_->write(PSIF_HESS, "VXCpi^A", (char*)Up[0], static_cast<size_t>(nmo) * nocc * sizeof(double),
-                             next_VXCpi, &next_VXCpi);
+            // The 3 Fock derivatives of each atom are built for as many atoms at a time as fit in memory
+            size_t max_atoms = (mem / 2L) / (3L * nso * nso);
+            max_atoms = std::max<size_t>(1, std::min<size_t>(max_atoms, natom));
+            for (int atom = 0; atom < natom; atom += max_atoms) {
+                int natom_batch = std::min<int>(max_atoms, natom - atom);
+                auto Vxc_matrices = potential_->compute_fock_derivatives(atom, natom_batch);
+                for (int a = 0; a < 3 * natom_batch; ++a) {
+                    // Transform from SO basis to pi
+                    C_DGEMM('N', 'N', nso, nocc, nso, 1.0, Vxc_matrices[a]->pointer()[0], nso, Cop[0], nocc, 0.0,
+                            Tp[0], nocc);
+                    C_DGEMM('T', 'N', nmo, nocc, nso, 1.0, Cp[0], nmo, Tp[0], nocc, 0.0, Up[0], nocc);
+                    next_VXCpi = psio_get_address(PSIO_ZERO, (3 * atom + a) * (size_t)nmo * nocc * sizeof(double));
+                    psio_->write(PSIF_HESS, "VXCpi^A", (char*)Up[0], static_cast<size_t>(nmo) * nocc * sizeof(double),
+                                 next_VXCpi, &next_VXCpi);
+                }
             }
         }
     }
@@ -4493,26 +4497,31 @@ void USCFDeriv::VXC_deriv(std::shared_ptr<Matrix> Ca,
         for (int A = 0; A < 3 * natom; A++)
             psio_->write(PSIF_HESS,"VXCpi^A_a",(char*)Uap[0], static_cast<size_t> (nmo)*naocc*sizeof(double),next_VXCpi,&next_VXCpi);
 
-        // For now we just compute all 3N matrices in one go.  If this becomes to burdensome
-        // in terms of memory we can reevaluate and implement a batching mechanism instead.
-        auto Vxc_matrices = potential_->compute_fock_derivatives();
-        for(int a =0; a < 3*natom; ++a){
-            // Transform from SO basis to pi
-            C_DGEMM('N','N',nso,naocc,nso,1.0,Vxc_matrices[2*a]->pointer()[0],nso,Caop[0],naocc,0.0,Tap[0],naocc);
-            C_DGEMM('T','N',nmo,naocc,nso,1.0,Cap[0],nmo,Tap[0],naocc,0.0,Uap[0],naocc);
-            next_VXCpi = psio_get_address(PSIO_ZERO,a * (size_t) nmo * naocc * sizeof(double));
+        next_VXCpi = PSIO_ZERO;
+        for (int A = 0; A < 3 * natom; A++)
+            psio_->write(PSIF_HESS,"VXCpi^A_b",(char*)Ubp[0], static_cast<size_t> (nmo)*nbocc*sizeof(double),next_VXCpi,&next_VXCpi);
 
-            psio_->write(PSIF_HESS,"VXCpi^A_a",(char*)Uap[0], static_cast<size_t> (nmo)*naocc*sizeof(double),next_VXCpi,&next_VXCpi);
-        }
+        // The 6 Fock derivatives of each atom are built for as many atoms at a time as fit in memory
+        size_t mem = 0.9 * memory_ / 8L;
+        size_t max_atoms = (mem / 2L) / (6L * nso * nso);
+        max_atoms = std::max<size_t>(1, std::min<size_t>(max_atoms, natom));
+        for (int atom = 0; atom < natom; atom += max_atoms) {
+            int natom_batch = std::min<int>(max_atoms, natom - atom);
+            auto Vxc_matrices = potential_->compute_fock_derivatives(atom, natom_batch);
+            for(int a =0; a < 3*natom_batch; ++a){
+                // Transform from SO basis to pi
+                C_DGEMM('N','N',nso,naocc,nso,1.0,Vxc_matrices[2*a]->pointer()[0],nso,Caop[0],naocc,0.0,Tap[0],naocc);
+                C_DGEMM('T','N',nmo,naocc,nso,1.0,Cap[0],nmo,Tap[0],naocc,0.0,Uap[0],naocc);
+                next_VXCpi = psio_get_address(PSIO_ZERO,(3 * atom + a) * (size_t) nmo * naocc * sizeof(double));
 
-        next_VXCpi = PSIO_ZERO;
-        for(int a =0; a < 3*natom; ++a){
-            // Transform from SO basis to pi
-            C_DGEMM('N','N',nso,nbocc,nso,1.0,Vxc_matrices[2*a+1]->pointer()[0],nso,Cbop[0],nbocc,0.0,Tbp[0],nbocc);
-            C_DGEMM('T','N',nmo,nbocc,nso,1.0,Cbp[0],nmo,Tbp[0],nbocc,0.0,Ubp[0],nbocc);
-            next_VXCpi = psio_get_address(PSIO_ZERO,a * (size_t) nmo * nbocc * sizeof(double));
+                psio_->write(PSIF_HESS,"VXCpi^A_a",(char*)Uap[0], static_cast<size_t> (nmo)*naocc*sizeof(double),next_VXCpi,&next_VXCpi);
 
-            psio_->write(PSIF_HESS,"VXCpi^A_b",(char*)Ubp[0], static_cast<size_t> (nmo)*nbocc*sizeof(double),next_VXCpi,&next_VXCpi);
+                C_DGEMM('N','N',nso,nbocc,nso,1.0,Vxc_matrices[2*a+1]->pointer()[0],nso,Cbop[0],nbocc,0.0,Tbp[0],nbocc);
+                C_DGEMM('T','N',nmo,nbocc,nso,1.0,Cbp[0],nmo,Tbp[0],nbocc,0.0,Ubp[0],nbocc);
+                next_VXCpi = psio_get_address(PSIO_ZERO,(3 * atom + a) * (size_t) nmo * nbocc * sizeof(double));
+
+                psio_->write(PSIF_HESS,"VXCpi^A_b",(char*)Ubp[0], static_cast<size_t> (nmo)*nbocc*sizeof(double),next_VXCpi,&next_VXCpi);
+            }
         }
     }
 }
@@ -177,6 +177,29 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
     options.add_str_i("WRITER_FILE_LABEL", "");
     /*- The density fitting basis to use in coupled cluster computations. -*/
     options.add_str("DF_BASIS_CC", "");
+    /*- Storage backend for the out-of-core three-index tensors handled by DFHelper
+    (e.g., DF-MP2 gradients, SAPT, and MemDF with ``SCF_SUBTYPE OUT_OF_CORE``).
+    ``MMAP`` memory-maps the scratch files instead of streaming them through stdio,
+    and prefetches the next block of AO integrals during transformations. !expert -*/
+    options.add_str("DF_IO_BACKEND", "STDIO", "STDIO MMAP");
+    /*- Directory of the persistent cache of metric-contracted three-index integrals
+    used by MemDF (``SCF_TYPE MEM_DF`` with in-core AOs). Entries are keyed by a hash
+    of the orbital and auxiliary basis sets, the geometry, and the screening and fitting
+    settings, so a later calculation on the same system and basis reads the tensor back
+    instead of recomputing it. The directory must exist and is never cleaned up by Psi4.
+    An empty string disables the cache. !expert -*/
+    options.add_str_i("DF_INTS_CACHE_DIR", "");
+    /*- Do overlap the disk I/O of the DPD-based coupled cluster codes with computation?
+    Four-index blocks that a contraction will need next are read in the background,
+    and written blocks are flushed in the background, using memory left over by the
+    DPD cache. !expert -*/
+    options.add_bool("DPD_IO_PIPELINE", false);
+    /*- Do use the threaded, cache-tiled in-core DPD sorts and contract independent irrep
+    blocks concurrently when no single block dominates the work? Concurrent blocks each
+    run a single-threaded BLAS, so they are only used with MKL or OpenBLAS, whose thread
+    count can be lowered; with any other BLAS the blocks run one after another on the
+    threaded BLAS. !expert -*/
+    options.add_bool("DPD_KERNEL_THREADS", true);
     /*- Assume external fields are arranged so that they have symmetry. It is up to the user to know what to do here.
        The code does NOT help you out in any way! !expert -*/
     options.add_bool("EXTERNAL_POTENTIAL_SYMMETRY", false);
@@ -1502,9 +1525,16 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_double("INTS_TOLERANCE", 1E-12);
         /*- The type of guess orbitals. See :ref:`sec:scfguess` for what the options mean and
          what the defaults are. -*/
-        options.add_str("GUESS", "AUTO", "AUTO CORE GWH SAD SADNO SAP SAPGAU HUCKEL MODHUCKEL READ");
+        options.add_str("GUESS", "AUTO", "AUTO CORE GWH SAD SADNO SAP SAPGAU HUCKEL MODHUCKEL READ EXTRAPOLATE");
         /*- The potential basis set used for the SAPGAU guess -*/
         options.add_str("SAPGAU_BASIS", "sap_helfem_large");
+        /*- How the EXTRAPOLATE guess combines the converged orbitals of earlier SCF computations on the
+        same system, after projecting them into the current basis and geometry. GRASSMANN extrapolates
+        the occupied subspaces along the Grassmann manifold; ASPC combines their densities with the
+        always stable predictor-corrector coefficients of Kolafa. !expert -*/
+        options.add_str("GUESS_EXTRAPOLATION", "GRASSMANN", "GRASSMANN ASPC");
+        /*- Number of converged SCF solutions kept for the EXTRAPOLATE guess. !expert -*/
+        options.add_int("GUESS_HISTORY_SIZE", 3);
         /*- Mix the HOMO/LUMO in UHF or UKS to break alpha/beta spatial symmetry.
         Useful to produce broken-symmetry unrestricted solutions.
         Notice that this procedure is defined only for calculations in C1 symmetry. -*/
@@ -1645,9 +1675,20 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_int("INCFOCK_FULL_FOCK_EVERY", 5);
         /*- The density threshold at which to stop building the Fock matrix incrementally -*/
         options.add_double("INCFOCK_CONVERGENCE", 1.0e-5);
+        /*- Screening threshold for the density difference in incremental Fock builds with |scf__scf_type| ``MEM_DF``
+        or ``DISK_DF``. Shell pairs whose elements fall below this magnitude are dropped, as are the smallest
+        eigenpairs of the difference while their summed magnitude stays below it. J is always built from the
+        difference; K only when the remaining eigenvectors are fewer than the occupied orbitals. -*/
+        options.add_double("INCFOCK_DF_CUTOFF", 1.0e-10);
 
         /*- The screening tolerance used for ERI/Density sparsity in the LinK algorithm -*/
         options.add_double("LINK_INTS_TOLERANCE", 1.0e-12);
+        /*- How threads in the integral-direct DirectJK and LinK builds add their contributions
+        to the J/K matrices. ``ATOMIC`` updates the shared matrices with atomic operations.
+        ``THREAD`` gives each thread a private copy of every J/K matrix and sums the copies in a
+        tree reduction after the integral loop, which avoids contention on many-core nodes at the
+        cost of one extra set of matrices per thread. !expert -*/
+        options.add_str("JK_ACCUMULATION", "ATOMIC", "ATOMIC THREAD");
         /*- For |globals__orbital_optimizer_package| = `OOO`, verbosity of printing to screen.
         0 prints nothing. 1 prints one line per iter (note that RHF rms(density) printed
         differs by half from convergence criterion. 5 is common and adds occupancy printing. 12 is max. -*/
@@ -1732,6 +1773,14 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_str("DF_INTS_IO", "NONE", "NONE SAVE LOAD");
         /*- Fitting Condition, i.e. eigenvalue threshold for RI basis. Analogous to S_TOLERANCE !expert -*/
         options.add_double("DF_FITTING_CONDITION", 1.0E-10);
+        /*- Do build the exchange matrix from localized orbitals with |scf__scf_type| ``MEM_DF``?
+        Each density is factored into pivoted Cholesky orbitals, and each orbital is half-transformed
+        and contracted only over the basis functions it can reach. Lowers the scaling of K for large
+        insulators; for small or metallic systems the dense contraction is faster. -*/
+        options.add_bool("DF_LOCAL_K", false);
+        /*- Cholesky truncation of the density and orbital coefficient cutoff of the AO domains for
+        |scf__df_local_k|. !expert -*/
+        options.add_double("DF_LOCAL_K_CUTOFF", 1.0E-10);
         /*- FastDF Fitting Metric -*/
         options.add_str("DF_METRIC", "COULOMB", "COULOMB EWALD OVERLAP");
         /*- FastDF SR Ewald metric range separation parameter -*/
@@ -1772,6 +1821,9 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
 
         /*- SUBSECTION snLinK Algorithm -*/
 
+        /*- Implementation of snLinK. AUTO uses GauXC if Psi4 was built with it and the
+        native implementation (Psi4 grids and one-electron integrals, CPU only) otherwise. -*/
+        options.add_str("SNLINK_BACKEND", "AUTO", "AUTO GAUXC NATIVE");
         /*- Number of spherical points in snLinK grid. -*/
         options.add_int("SNLINK_SPHERICAL_POINTS", 302);
         /*- Number of radial points in snLinK grid. -*/
@@ -1878,8 +1930,29 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_double("DFT_BS_RADIUS_ALPHA", 1.0);
         /*- DFT basis cutoff. -*/
         options.add_double("DFT_BASIS_TOLERANCE", 1.0E-12);
+        /*- Precision in which the basis function values of the DFT grid blocks are cached between SCF iterations.
+        ``FLOAT`` halves the memory per block, so more of the grid fits in the cache, at a relative error of about
+        1e-7 in the collocation values. !expert -*/
+        options.add_str("DFT_COLLOCATION_CACHE_PRECISION", "DOUBLE", "DOUBLE FLOAT");
+        /*- Screening threshold for the DFT collocation cache, relative to the largest basis function value of each
+        block. Smaller values are dropped, and blocks that become sparse enough are stored as index/value pairs.
+        Zero disables the screening. !expert -*/
+        options.add_double("DFT_COLLOCATION_CACHE_CUTOFF", 0.0);
+        /*- Do form the densities and the XC potential matrix on the grid with single-precision GEMMs,
+        accumulated into double precision, in the early SCF iterations? The quadrature switches back to double
+        precision once the DIIS error drops below |scf__dft_mixed_precision_switch|, so the converged energy is
+        unaffected. !expert -*/
+        options.add_bool("DFT_MIXED_PRECISION", false);
+        /*- DIIS error below which a |scf__dft_mixed_precision| SCF switches to the double-precision quadrature.
+        !expert -*/
+        options.add_double("DFT_MIXED_PRECISION_SWITCH", 1.0E-4);
         /*- grid weight cutoff. Disable with -1.0. !expert -*/
         options.add_double("DFT_WEIGHTS_TOLERANCE", 1.0E-15);
+        /*- Skip the grid blocks on which the density and its gradient are bounded below this value in the
+        XC potential of each SCF iteration. The bounds come from the shell pairs of the current density
+        matrix and the decay of each basis function over the block, so blocks come back into play when the
+        density changes. Disable with 0.0. !expert -*/
+        options.add_double("DFT_BLOCK_DENSITY_TOLERANCE", 0.0);
         /*- density cutoff for LibXC. A negative value turns the feature off and LibXC defaults are used. !expert -*/
         options.add_double("DFT_DENSITY_TOLERANCE", -1.0);
         /*- The DFT grid specification, such as SG1.!expert -*/
@@ -1901,6 +1974,12 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_bool("DFT_REMOVE_DISTANT_POINTS",true);
         /*- The blocking scheme for DFT. !expert -*/
         options.add_str("DFT_BLOCK_SCHEME", "OCTREE", "NAIVE OCTREE ATOMIC");
+        /*- Keep DFT grid data between grids built on the same atoms with the same grid options, as in
+        geometry optimizations, finite differences and SCF restarts. Atomic grids and basis extents are
+        reused, as are the nuclear weights of an unchanged geometry. The block partition is reused while
+        no point has moved by more than a tenth of |scf__dft_block_max_radius|. The quadrature itself is
+        unchanged. Not used with BrianQC. !expert -*/
+        options.add_bool("DFT_GRID_CACHE", false);
         /*- Parameters defining the dispersion correction. See Table
         :ref:`-D Functionals <table:dft_disp>` for default values and Table
         :ref:`Dispersion Corrections <table:dashd>` for the order in which
@@ -2211,8 +2290,9 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         which means that all four-index quantities with up to two virtual-orbital
         indices (e.g., $\left\langle ij | ab \right\rangle$ integrals) may be held in the cache. -*/
         options.add_int("CACHELEVEL", 2);
-        /*- The criterion used to retain/release cached data -*/
-        options.add_str("CACHETYPE", "LRU", "LOW LRU");
+        /*- The criterion used to retain/release cached data. ``LOW`` is treated as ``LRU``
+        here; ``COST`` weighs size, re-read cost and recent use, as in |ccenergy__cachetype|. -*/
+        options.add_str("CACHETYPE", "LRU", "COST LOW LRU");
         /*- Number of threads -*/
         options.add_int("CC_NUM_THREADS", 1);
         /*- Type of ABCD algorithm will be used -*/
@@ -2518,8 +2598,11 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         cache used by the libdpd codes. A value of ``LOW`` selects a "low priority"
         scheme in which the deletion of items from the cache is based on
         pre-programmed priorities. A value of LRU selects a "least recently used"
-        scheme in which the oldest item in the cache will be the first one deleted. -*/
-        options.add_str("CACHETYPE", "LOW", "LOW LRU");
+        scheme in which the oldest item in the cache will be the first one deleted.
+        A value of ``COST`` deletes the item that saves the least disk time per byte
+        of memory, weighing its size and re-read (and write-back) cost against how
+        often it has been used recently. ``LOW`` is only available for RHF references. -*/
+        options.add_str("CACHETYPE", "LOW", "COST LOW LRU");
         /*- Number of threads -*/
         options.add_int("CC_NUM_THREADS", 1);
         /*- Do use DIIS extrapolation to accelerate convergence? -*/
@@ -2755,6 +2838,10 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_bool("WRITE_QIA_PNO", false);
         /*- Write (Q_{ij} | a_{ij} b_{ij}) integrals to disk? !expert -*/
         options.add_bool("WRITE_QAB_PNO", false);
+        /*- Maximum memory [GB] for the (Q_{ij} | m_{ij} a_{ij}) and (Q_{ij} | a_{ij} b_{ij}) integrals
+        kept in core. The largest pair blocks beyond it are written to disk and streamed back in
+        batches. Zero leaves the total memory as the only limit. !expert -*/
+        options.add_double("DF_PNO_CORE_MEMORY", 0.0);
         /*- Write triples (W and V intermediates) to disk? !expert -*/
         options.add_bool("WRITE_TRIPLES_INTERMEDIATES", false);
         /*- Write triples amplitudes to disk? !expert -*/
@@ -45,6 +45,7 @@ units au
         pytest.param("LINK"),
         pytest.param("COSX"),
         pytest.param("SNLINK", marks=using('gauxc')),
+        pytest.param("SNLINK", id="SNLINK (native)"),
     ]
 ) #to be extended in the future
 def test_composite_call(j_algo, k_algo, mols, request):
@@ -58,6 +59,8 @@ def test_composite_call(j_algo, k_algo, mols, request):
     
     scf_type = f'{j_algo}+{k_algo}'
     psi4.set_options({ "scf_type" : f'{j_algo}+{k_algo}', "incfock": True, "save_jk": True })
+    if "native" in test_id:
+        psi4.set_options({ "snlink_backend" : "native" })
   
     if any([ _ in scf_type for _ in ["COSX", "SNLINK"] ]): 
         psi4.set_options({ "screening" : "schwarz" })
@@ -150,6 +153,10 @@ def test_composite_call(j_algo, k_algo, mols, request):
                       },
                       },
                       id="snlink (cartesian)", marks=using("gauxc")),
+        pytest.param({"scf_type" : "dfdirj+snlink",
+                      "snlink_backend": "native",
+                      },
+                      id="snlink (native)"),
  
     ]
 )
@@ -161,6 +168,8 @@ def test_seminum(inp, scf, mols, request):
     molecule = mols[inp["molecule"]]
     psi4.set_options({"scf_type" : scf["scf_type"], "basis": "cc-pvdz"})
     psi4.set_options(inp["options"])
+    if "snlink_backend" in scf.keys():
+        psi4.set_options({"snlink_backend": scf["snlink_backend"]})
     if "snlink_force_cartesian" in scf.keys():
         psi4.set_options({"snlink_force_cartesian": scf["snlink_force_cartesian"]})
 
@@ -173,8 +182,10 @@ def test_seminum(inp, scf, mols, request):
         tol = 7e-6
 
     # does the SCF energy match a pre-computed reference?
+    # the native sn-LinK grid differs from GauXC's, so it is only held to the PK comparison below
     energy_seminum = psi4.energy(inp["method"], molecule=molecule, bsse_type=inp["bsse_type"])
-    assert compare_values(scf["ref"][test_id.split("-")[1]], energy_seminum, tol, f'{test_id} accurate to reference (1e-6 threshold)')
+    if "ref" in scf.keys():
+        assert compare_values(scf["ref"][test_id.split("-")[1]], energy_seminum, tol, f'{test_id} accurate to reference (1e-6 threshold)')
 
     # is the SCF energy reasonably close to a conventional SCF?
     psi4.set_options({"scf_type" : "pk"})
@@ -224,6 +235,8 @@ def test_seminum(inp, scf, mols, request):
                       id="cosx"),
         pytest.param({"scf_type" : "dfdirj+snlink"},
                       id="snlink", marks=using("gauxc")),
+        pytest.param({"scf_type" : "dfdirj+snlink", "snlink_backend": "native"},
+                      id="snlink (native)"),
     ]
 )
 def test_seminum_incfock(inp, scf, mols, request):
@@ -234,6 +247,8 @@ def test_seminum_incfock(inp, scf, mols, request):
     molecule = mols[inp["molecule"]]
     psi4.set_options({"scf_type" : scf["scf_type"], "basis": "cc-pvdz", "incfock": False})
     psi4.set_options(inp["options"])
+    if "snlink_backend" in scf.keys():
+        psi4.set_options({"snlink_backend": scf["snlink_backend"]})
 
     # compute energy+wfn without IncFock 
     energy_seminum_noinc, wfn_seminum_noinc = psi4.energy(inp["method"], molecule=molecule, bsse_type=inp["bsse_type"], return_wfn=True)
@@ -263,9 +278,11 @@ def test_seminum_incfock(inp, scf, mols, request):
         pytest.param("DFDIRJ+LINK"),
         pytest.param("DFDIRJ+COSX"),
         pytest.param("DFDIRJ+SNLINK", marks=using('gauxc')),
+        pytest.param("SNLINK", id="SNLINK (native)"),
+        pytest.param("DFDIRJ+SNLINK", id="DFDIRJ+SNLINK (native)"),
     ]
 )
-def test_dfdirj(functional, scf_type, mols):
+def test_dfdirj(functional, scf_type, mols, request):
     """Test the functionality of the SCF_TYPE keyword for CompositeJK methods under varying situations:
       - Using hybrid DFT functionals without specifying a K algorithm should cause a RuntimeError to be thrown.
       - Not specifying a J algorithm should cause a ValidationError to be thrown."""
@@ -279,6 +296,8 @@ def test_dfdirj(functional, scf_type, mols):
 
     molecule = mols["h2o"]
     screening = "CSAM" if any([ _ in scf_type for _ in [ "COSX", "SNLINK" ] ]) else "DENSITY"
+    if "native" in request.node.callspec.id:
+        psi4.set_options({"snlink_backend": "native"})
     
     # if J algorithm isn't specified, code should throw here...
     if not any([ algo in scf_type for algo, matrix in composite_algo_to_matrix.items() if matrix == "J" ]):
@@ -317,10 +336,11 @@ def test_dfdirj(functional, scf_type, mols):
         pytest.param("LINK"),
         pytest.param("COSX"),
         pytest.param("SNLINK", marks=using('gauxc')),
+        pytest.param("SNLINK", id="SNLINK (native)"),
     ]
 ) 
 @pytest.mark.parametrize("df_basis_scf", [ "CC-PVDZ-JKFIT", "DEF2-UNIVERSAL-JFIT" ]) #to be extended in the future
-def test_j_algo_bp86(j_algo, k_algo, df_basis_scf, mols):
+def test_j_algo_bp86(j_algo, k_algo, df_basis_scf, mols, request):
     """Test SCF_TYPE={J} and all SCF_TYPE={J}+{K} combinations for a BP86 calculation.
     They should all give the exact same answer (within tolerance).""" 
 
@@ -335,7 +355,33 @@ def test_j_algo_bp86(j_algo, k_algo, df_basis_scf, mols):
     screening = "CSAM" if any([ _ in scf_type for _ in [ "COSX", "SNLINK" ] ]) else "DENSITY"
 
     psi4.set_options({"scf_type" : scf_type, "reference": "rhf", "basis": "cc-pvdz", "df_basis_scf": df_basis_scf, "screening": screening})
+    if "native" in request.node.callspec.id:
+        psi4.set_options({"snlink_backend": "native"})
 
     energy_composite = psi4.energy("bp86", molecule=molecule) 
  
     assert compare_values(energy_dfdirj, energy_composite, 6, f'BP86/{df_basis_scf} {scf_type} accurate to {j_algo} (1e-6 threshold)')
+
+@pytest.mark.parametrize("scf_type", [ "DIRECT", "DFDIRJ+LINK" ])
+@pytest.mark.parametrize(
+    "inp",
+    [
+        pytest.param({"molecule" : "h2o", "reference" : "rhf"}, id="h2o (rhf)"),
+        pytest.param({"molecule" : "nh2", "reference" : "uhf"}, id="nh2 (uhf)"),
+    ]
+)
+def test_jk_accumulation(scf_type, inp, mols):
+    """Test that JK_ACCUMULATION=THREAD (thread-private J/K with tree reduction)
+    reproduces the default atomic accumulation in DirectJK and LinK."""
+
+    molecule = mols[inp["molecule"]]
+    psi4.set_options({"scf_type" : scf_type, "reference": inp["reference"], "basis": "cc-pvdz",
+                      "screening": "density", "incfock": True, "d_convergence": 1e-8})
+
+    psi4.set_options({"jk_accumulation": "atomic"})
+    energy_atomic = psi4.energy("hf", molecule=molecule)
+
+    psi4.set_options({"jk_accumulation": "thread"})
+    energy_thread = psi4.energy("hf", molecule=molecule)
+
+    assert compare_values(energy_atomic, energy_thread, 8, f'{scf_type} JK_ACCUMULATION=THREAD matches ATOMIC (1e-8 threshold)')
@@ -0,0 +1,117 @@
+"""
+Tests for the memory-mapped (DF_IO_BACKEND MMAP) disk backend and the persistent AO cache (DF_INTS_CACHE_DIR)
+of DFHelper
+"""
+
+import numpy as np
+import pytest
+from utils import compare, compare_values, compare_arrays
+
+import psi4
+
+pytestmark = [pytest.mark.psi, pytest.mark.api]
+
+
+@pytest.fixture
+def h2o():
+    return psi4.geometry("""
+    O
+    H 1 1.00
+    H 1 1.00 2 103.1
+    """)
+
+
+@pytest.mark.parametrize("order", ["Qpq", "pQq", "pqQ"])
+def test_dfhelper_mmap_transform(h2o, order):
+    """Out-of-core transformed tensors are identical through stdio and mmap storage."""
+
+    primary = psi4.core.BasisSet.build(h2o, "ORBITAL", "cc-pVDZ")
+    aux = psi4.core.BasisSet.build(h2o, "ORBITAL", "cc-pVDZ-jkfit")
+    nbf = primary.nbf()
+
+    np.random.seed(0)
+    C1 = psi4.core.Matrix.from_array(np.random.rand(nbf, 5))
+    C2 = psi4.core.Matrix.from_array(np.random.rand(nbf, 12))
+
+    tensors = {}
+    for mmap in [False, True]:
+        dfh = psi4.core.DFHelper(primary, aux)
+        # small memory to force several blocks through the disk backend
+        dfh.set_memory(20000)
+        dfh.set_method("STORE")
+        dfh.set_AO_core(False)
+        dfh.set_MO_core(False)
+        dfh.set_mmap_io(mmap)
+        dfh.initialize()
+
+        dfh.add_space("i", C1)
+        dfh.add_space("a", C2)
+        dfh.add_transformation("ia", "i", "a", order)
+        dfh.add_transformation("aa", "a", "a", order)
+        dfh.transform()
+
+        tensors[mmap] = [dfh.get_tensor("ia").np.copy(), dfh.get_tensor("aa").np.copy()]
+        dfh.clear_all()
+
+    for stdio, mapped in zip(tensors[False], tensors[True]):
+        assert compare_arrays(stdio, mapped, 12, f"DFHelper {order} MMAP tensor")
+
+
+@pytest.mark.parametrize("reference", ["rhf", "uhf"])
+def test_dfhelper_mmap_scf(h2o, reference):
+    """Out-of-core MemDFJK gives the same energy with either disk backend."""
+
+    psi4.set_options({"scf_type": "mem_df", "scf_subtype": "out_of_core", "reference": reference,
+                      "basis": "cc-pvdz", "d_convergence": 1e-8})
+
+    psi4.set_options({"df_io_backend": "stdio"})
+    energy_stdio = psi4.energy("hf", molecule=h2o)
+
+    psi4.set_options({"df_io_backend": "mmap"})
+    energy_mmap = psi4.energy("hf", molecule=h2o)
+
+    assert compare_values(energy_stdio, energy_mmap, 10, f"MemDFJK ({reference}) DF_IO_BACKEND=MMAP matches STDIO")
+
+
+def test_dfhelper_ints_cache_memdf(tmp_path):
+    """MemDF SCF energies are unchanged when the AOs come from the cache, and new geometries get new entries."""
+
+    def run_scf(roh, cache_dir):
+        psi4.core.clean()
+        psi4.core.clean_options()
+        psi4.set_output_file("dfhelper_ints_cache.out", False)
+        psi4.geometry(f"""
+        O
+        H 1 {roh}
+        H 1 {roh} 2 104.5
+        """)
+        psi4.set_options({
+            "basis": "cc-pvdz",
+            "scf_type": "mem_df",
+            "df_ints_cache_dir": cache_dir,
+        })
+        energy = psi4.energy("scf")
+        with open("dfhelper_ints_cache.out") as f:
+            output = f.read()
+        return energy, "read metric-contracted AOs from the cache" in output
+
+    ref, _ = run_scf(0.96, "")
+    assert list(tmp_path.iterdir()) == []
+
+    # first run fills the cache, second run reads from it
+    first, first_hit = run_scf(0.96, str(tmp_path))
+    assert len(list(tmp_path.glob("dfh.AO.*.dat"))) == 1
+    second, second_hit = run_scf(0.96, str(tmp_path))
+    assert len(list(tmp_path.glob("dfh.AO.*.dat"))) == 1
+
+    assert compare_values(ref, first, 10, "MemDF SCF energy, cache miss")
+    assert compare_values(ref, second, 10, "MemDF SCF energy, cache hit")
+    assert compare(False, first_hit, "AOs computed on a cache miss")
+    assert compare(True, second_hit, "AOs read on a cache hit")
+
+    # a different geometry must not pick up the stored entry
+    stretched_ref, _ = run_scf(1.00, "")
+    stretched, stretched_hit = run_scf(1.00, str(tmp_path))
+    assert len(list(tmp_path.glob("dfh.AO.*.dat"))) == 2
+    assert compare_values(stretched_ref, stretched, 10, "MemDF SCF energy, new geometry")
+    assert compare(False, stretched_hit, "AOs computed for a new geometry")
@@ -1,4 +1,6 @@
-#! compare MemJK and DiskJK
+#! compare MemJK and DiskJK, and their incremental and local exchange options
+
+import re
 
 import psi4
 import pytest
@@ -72,3 +74,112 @@ def test_dfjk_compare(build_system):
     for j, t in enumerate(['J', 'K']):
         for i in range(len(disk[0])):
             assert compare_arrays(np.asarray(disk[j][i]), np.asarray(mem[j][i]), 9, t + str(i))
+
+
+@pytest.mark.parametrize("scf_type", ["mem_df", "disk_df"])
+@pytest.mark.parametrize("reference", ["rhf", "uhf", "rohf"])
+def test_dfjk_incfock(scf_type, reference):
+    """SCF energies and iteration counts with IncFock match the full builds of the DF JK objects."""
+
+    molecule = psi4.geometry("""
+    0 2
+    N
+    H 1 1.01
+    H 1 1.01 2 105.0
+    symmetry c1
+    """)
+    if reference == "rhf":
+        molecule.set_molecular_charge(-1)
+        molecule.set_multiplicity(1)
+
+    psi4.set_options({
+        "scf_type": scf_type,
+        "basis": "cc-pvdz",
+        "reference": reference,
+        "e_convergence": 1.0e-10,
+        "d_convergence": 1.0e-8,
+        "incfock": False,
+    })
+    energy_noinc, wfn_noinc = psi4.energy("hf", molecule=molecule, return_wfn=True)
+
+    psi4.set_options({"incfock": True, "save_jk": True})
+    energy_inc, wfn_inc = psi4.energy("hf", molecule=molecule, return_wfn=True)
+
+    assert compare_values(energy_noinc, energy_inc, 8, f"{scf_type} {reference} IncFock accurate")
+    assert compare(True, wfn_inc.jk().num_incfock_J_builds() > 0, f"{scf_type} {reference} IncFock J built")
+
+    niter_noinc = int(wfn_noinc.variable("SCF ITERATIONS"))
+    niter_inc = int(wfn_inc.variable("SCF ITERATIONS"))
+    assert compare(True, abs(niter_inc - niter_noinc) <= 3, f"{scf_type} {reference} IncFock efficient")
+
+
+@pytest.mark.parametrize("scf_type", ["mem_df", "disk_df"])
+def test_dfjk_incfock_K(scf_type):
+    """A loose difference cutoff leaves few enough eigenvectors that K is built incrementally too."""
+
+    molecule = psi4.geometry("""
+    0 1
+    O
+    H 1 0.96
+    H 1 0.96 2 104.5
+    symmetry c1
+    """)
+
+    psi4.set_options({
+        "scf_type": scf_type,
+        "basis": "cc-pvdz",
+        "e_convergence": 1.0e-10,
+        "d_convergence": 1.0e-8,
+        "incfock": False,
+    })
+    energy_noinc = psi4.energy("hf", molecule=molecule)
+
+    psi4.set_options({"incfock": True, "incfock_df_cutoff": 1.0e-3, "save_jk": True})
+    energy_inc, wfn_inc = psi4.energy("hf", molecule=molecule, return_wfn=True)
+
+    # the iterations below INCFOCK_CONVERGENCE are full builds, so the truncation does not reach the energy
+    assert compare_values(energy_noinc, energy_inc, 8, f"{scf_type} IncFock K accurate")
+    jk = wfn_inc.jk()
+    assert compare(True, jk.num_incfock_K_builds() > 0, f"{scf_type} IncFock K built")
+    assert compare(True, jk.num_incfock_K_builds() <= jk.num_incfock_J_builds(), f"{scf_type} IncFock K with J")
+
+
+@pytest.mark.parametrize("method,reference", [
+    pytest.param("hf", "rhf", id="rhf"),
+    pytest.param("hf", "uhf", id="uhf"),
+    pytest.param("wb97x", "rks", id="wb97x"),
+])
+def test_memdf_local_k(method, reference):
+    """MemDF energies with local exchange match the dense exchange."""
+
+    molecule = psi4.geometry("""
+    0 1
+    O  -1.551007  -0.114520   0.000000
+    H  -1.934259   0.762503   0.000000
+    H  -0.599677   0.040712   0.000000
+    --
+    0 1
+    O   1.350625   0.111469   0.000000
+    H   1.680398  -0.373741  -0.758561
+    H   1.680398  -0.373741   0.758561
+    symmetry c1
+    """)
+
+    psi4.set_options({
+        "basis": "cc-pvdz",
+        "scf_type": "mem_df",
+        "reference": reference,
+        "e_convergence": 1.0e-10,
+        "d_convergence": 1.0e-8,
+        "df_local_k": False,
+    })
+    ref = psi4.energy(method, molecule=molecule)
+
+    psi4.set_output_file(f"memdf_local_k_{reference}.out", False)
+    psi4.set_options({"df_local_k": True})
+    energy = psi4.energy(method, molecule=molecule)
+    with open(f"memdf_local_k_{reference}.out") as f:
+        local_k = re.findall(r"Local K:\s+(\S+)", f.read())
+
+    assert compare_values(ref, energy, 8, f"{method} {reference} energy with local K")
+    assert compare(True, len(local_k) > 0 and local_k[-1] == "Yes", f"{method} {reference} local K used")
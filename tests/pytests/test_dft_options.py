@@ -0,0 +1,203 @@
+"""
+Tests for the options of the DFT quadrature: the density-driven block screening (DFT_BLOCK_DENSITY_TOLERANCE), the
+float and screened-sparse collocation cache (DFT_COLLOCATION_CACHE_PRECISION), the mixed-precision quadrature
+(DFT_MIXED_PRECISION), the grid cache (DFT_GRID_CACHE), the batched Vx of many trial densities, and the threaded
+analytic Hessians
+"""
+
+import re
+
+import numpy as np
+import pytest
+from utils import compare, compare_matrices, compare_values
+
+import psi4
+
+pytestmark = [pytest.mark.psi, pytest.mark.api]
+
+_xc_option_molecules = {
+    "water": """
+    0 1
+    O
+    H 1 0.96
+    H 1 0.96 2 104.5
+    symmetry c1
+    """,
+    "water_neon": """
+    O  0.000  0.000  0.000
+    H  0.000  0.757  0.587
+    H  0.000 -0.757  0.587
+    --
+    Ne 0.000  0.000  7.000
+    symmetry c1
+    """,
+    "hydroxide": """
+    -1 1
+    O
+    H 1 0.97
+    symmetry c1
+    """,
+    "hydroxyl": """
+    0 2
+    O
+    H 1 0.97
+    symmetry c1
+    """,
+}
+
+
+@pytest.mark.parametrize("functional,reference,mol,options,digits", [
+    pytest.param("svwn", "rks", "water_neon", {"dft_block_density_tolerance": 1.0e-14}, 8, id="screening-svwn-rks"),
+    pytest.param("svwn", "uks", "water_neon", {"dft_block_density_tolerance": 1.0e-14}, 8, id="screening-svwn-uks"),
+    pytest.param("pbe", "rks", "water_neon", {"dft_block_density_tolerance": 1.0e-14}, 8, id="screening-pbe-rks"),
+    pytest.param("pbe", "uks", "water_neon", {"dft_block_density_tolerance": 1.0e-14}, 8, id="screening-pbe-uks"),
+    pytest.param("pbe0", "rks", "water", {"dft_collocation_cache_precision": "DOUBLE",
+                                          "dft_collocation_cache_cutoff": 1.0e-12}, 8, id="collocation-double-sparse"),
+    pytest.param("pbe0", "rks", "water", {"dft_collocation_cache_precision": "FLOAT",
+                                          "dft_collocation_cache_cutoff": 0.0}, 6, id="collocation-float"),
+    pytest.param("pbe0", "rks", "water", {"dft_collocation_cache_precision": "FLOAT",
+                                          "dft_collocation_cache_cutoff": 1.0e-8}, 6, id="collocation-float-sparse"),
+    pytest.param("svwn", "rks", "hydroxide", {"dft_mixed_precision": True}, 8, id="mixed-svwn-rks"),
+    pytest.param("svwn", "uks", "hydroxyl", {"dft_mixed_precision": True}, 8, id="mixed-svwn-uks"),
+    pytest.param("pbe", "rks", "hydroxide", {"dft_mixed_precision": True}, 8, id="mixed-pbe-rks"),
+    pytest.param("pbe", "uks", "hydroxyl", {"dft_mixed_precision": True}, 8, id="mixed-pbe-uks"),
+    pytest.param("tpss", "rks", "hydroxide", {"dft_mixed_precision": True}, 8, id="mixed-tpss-rks"),
+    pytest.param("tpss", "uks", "hydroxyl", {"dft_mixed_precision": True}, 8, id="mixed-tpss-uks"),
+])  # yapf: disable
+def test_dft_xc_options(request, functional, reference, mol, options, digits):
+    """DFT energies with each XC quadrature option on match the default quadrature, and the option was used."""
+
+    molecule = psi4.geometry(_xc_option_molecules[mol])
+    psi4.set_options({
+        "basis": "cc-pvdz",
+        "scf_type": "df",
+        "reference": reference,
+        "e_convergence": 1.0e-10,
+        "d_convergence": 1.0e-8,
+    })
+    ref, wfn_ref = psi4.energy(functional, molecule=molecule, return_wfn=True)
+
+    label = request.node.callspec.id
+    psi4.set_output_file(f"dft_xc_options_{label}.out", False)
+    psi4.set_options(options)
+    energy, wfn = psi4.energy(functional, molecule=molecule, return_wfn=True)
+    with open(f"dft_xc_options_{label}.out") as f:
+        output = f.read()
+
+    assert compare_values(ref, energy, digits, f"{functional} {reference} energy, {label}")
+
+    if label.startswith("screening"):
+        assert compare(True, wfn.V_potential().nblocks_skipped() > 0, "some blocks screened out")
+    elif label.startswith("collocation"):
+        cached = [float(fraction) for fraction in re.findall(r"Cached (\S+)% of DFT collocation blocks", output)]
+        assert compare(True, len(cached) > 0 and cached[-1] > 0.0, "collocation blocks cached")
+    elif label.startswith("mixed"):
+        assert compare(True, "==> Mixed Precision <==" in output, "mixed-precision XC requested")
+        assert compare(False, wfn.V_potential().mixed_precision(), "XC quadrature back in double precision")
+        niter_ref = int(wfn_ref.variable("SCF ITERATIONS"))
+        niter = int(wfn.variable("SCF ITERATIONS"))
+        assert compare(True, abs(niter - niter_ref) <= 3, f"{functional} {reference} mixed-precision iterations")
+
+
+@pytest.mark.parametrize("scheme", ["OCTREE", "NAIVE"])
+def test_dft_grid_cache(scheme):
+    """DFT energies with cached grids, extents and blocks match the ones on freshly built grids."""
+
+    def run_dft(roh, cache, output=None):
+        molecule = psi4.geometry(f"""
+        O
+        H 1 {roh}
+        H 1 {roh} 2 104.5
+        symmetry c1
+        """)
+        psi4.set_options({
+            "basis": "cc-pvdz",
+            "scf_type": "df",
+            "e_convergence": 1.0e-10,
+            "d_convergence": 1.0e-8,
+            "dft_block_scheme": scheme,
+            "dft_grid_cache": cache,
+        })
+        if output is None:
+            return psi4.energy("b3lyp", molecule=molecule), None
+        psi4.set_output_file(output, False)
+        energy = psi4.energy("b3lyp", molecule=molecule)
+        with open(output) as f:
+            return energy, re.findall(r"Grid Cache\s+=\s+(\S+)", f.read())[-1]
+
+    ref, _ = run_dft(0.96, False)
+    ref_displaced, _ = run_dft(0.9601, False)
+
+    psi4.core.DFTGrid.clear_cache()
+    # new grid, the same grid again, then a small step that keeps the block partition
+    first, first_status = run_dft(0.96, True, f"dft_grid_cache_{scheme}_1.out")
+    second, second_status = run_dft(0.96, True, f"dft_grid_cache_{scheme}_2.out")
+    displaced, displaced_status = run_dft(0.9601, True, f"dft_grid_cache_{scheme}_3.out")
+    psi4.core.DFTGrid.clear_cache()
+
+    assert compare_values(ref, first, 8, f"B3LYP energy, {scheme} grid cache miss")
+    assert compare_values(ref, second, 8, f"B3LYP energy, {scheme} grid cache hit")
+    assert compare_values(ref_displaced, displaced, 8, f"B3LYP energy, {scheme} reused block partition")
+
+    assert compare("MISS", first_status, f"{scheme} grid cache status of the first grid")
+    assert compare(True, second_status != "MISS", f"{scheme} grid cache status of the same grid")
+    assert compare(True, displaced_status in ("FULL", "BLOCKS"), f"{scheme} grid cache status of the displaced grid")
+
+
+@pytest.mark.parametrize("functional", ["svwn", "pbe"])
+@pytest.mark.parametrize("reference", ["rks", "uks"])
+def test_dft_vx_batch(functional, reference):
+    """Vx of many trial densities built together match the ones built one density at a time."""
+
+    molecule = psi4.geometry("""
+    O
+    H 1 0.96
+    H 1 0.96 2 104.5
+    symmetry c1
+    """)
+    psi4.set_options({"basis": "cc-pvdz", "scf_type": "df", "reference": reference})
+    _, wfn = psi4.energy(functional, molecule=molecule, return_wfn=True)
+
+    nbf = wfn.nso()
+    ndens = 12 if reference == "rks" else 24
+    rng = np.random.default_rng(7)
+    Dx = [psi4.core.Matrix.from_array(rng.uniform(-0.05, 0.05, (nbf, nbf))) for _ in range(ndens)]
+
+    Vpot = wfn.V_potential()
+    Vx = [psi4.core.Matrix(nbf, nbf) for _ in range(ndens)]
+    Vpot.compute_Vx(Dx, Vx)
+
+    step = 1 if reference == "rks" else 2
+    for i in range(0, ndens, step):
+        Vx_ref = [psi4.core.Matrix(nbf, nbf) for _ in range(step)]
+        Vpot.compute_Vx(Dx[i:i + step], Vx_ref)
+        for j in range(step):
+            assert compare_matrices(Vx_ref[j], Vx[i + j], 10, f"{functional} {reference} Vx of trial density {i + j}")
+
+
+@pytest.mark.parametrize("reference", ["rks", "uks"])
+def test_dft_hessian_threads(reference):
+    """Analytic SVWN Hessians built on several threads match the single-threaded ones."""
+
+    molecule = psi4.geometry("""
+    O
+    H 1 0.96
+    H 1 0.96 2 104.5
+    symmetry c1
+    """)
+    psi4.set_options({
+        "basis": "cc-pvdz",
+        "scf_type": "df",
+        "reference": reference,
+        "e_convergence": 1.0e-10,
+        "d_convergence": 1.0e-10,
+    })
+
+    psi4.set_num_threads(1)
+    ref = psi4.hessian("svwn", molecule=molecule)
+
+    psi4.set_num_threads(4)
+    hess = psi4.hessian("svwn", molecule=molecule)
+    psi4.set_num_threads(1)
+
+    assert compare_matrices(ref, hess, 7, f"SVWN {reference} Hessian on four threads")
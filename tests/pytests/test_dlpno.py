@@ -0,0 +1,107 @@
+"""
+Tests for the DLPNO pair machinery: the CSR pair domains, the arena-backed pair products of the DLPNO-MP2 and
+DLPNO-CCSD residuals, and the partial spilling of the DF PNO integrals to disk (DF_PNO_CORE_MEMORY)
+"""
+
+import re
+
+import pytest
+from utils import compare, compare_values
+
+import psi4
+
+pytestmark = [pytest.mark.psi, pytest.mark.api]
+
+
+def test_dlpno_sparse_maps():
+    """CSRMap, SparseRow::find and the buffer-reusing list and submatrix helpers agree with hand-made references."""
+
+    assert compare(True, psi4.core.test_dlpno_sparse_maps(), "DLPNO sparse maps")
+
+
+def test_dlpno_pair_gemm_ops():
+    """triplet_add and doublet_add agree with linalg::triplet and linalg::doublet for every transpose."""
+
+    assert compare(True, psi4.core.test_dlpno_pair_gemm(), "DLPNO pair products")
+
+
+@pytest.mark.parametrize("method", ["dlpno-mp2", "dlpno-ccsd"])
+def test_dlpno_pair_gemm(method):
+    """DLPNO energies do not depend on how the size-ordered pairs are spread over threads."""
+
+    psi4.geometry("""
+    O  -1.551007  -0.114520   0.000000
+    H  -1.934259   0.762503   0.000000
+    H  -0.599677   0.040712   0.000000
+    O   1.350625   0.111469   0.000000
+    H   1.680398  -0.373741  -0.758561
+    H   1.680398  -0.373741   0.758561
+    symmetry c1
+    """)
+
+    psi4.set_options({
+        "basis": "cc-pvdz",
+        "scf_type": "df",
+        "freeze_core": True,
+        "e_convergence": 1.0e-10,
+        "r_convergence": 1.0e-8,
+    })
+
+    psi4.set_num_threads(1)
+    ref = psi4.energy(method)
+
+    psi4.set_num_threads(4)
+    energy = psi4.energy(method)
+    psi4.set_num_threads(1)
+
+    assert compare_values(ref, energy, 9, f"{method} energy on four threads")
+
+
+@pytest.mark.parametrize("spill", ["partial", "all"])
+def test_dlpno_pair_store(spill):
+    """DLPNO-CCSD energies with pair blocks on disk match the ones with every block in core."""
+
+    psi4.geometry("""
+    O  -1.551007  -0.114520   0.000000
+    H  -1.934259   0.762503   0.000000
+    H  -0.599677   0.040712   0.000000
+    O   1.350625   0.111469   0.000000
+    H   1.680398  -0.373741  -0.758561
+    H   1.680398  -0.373741   0.758561
+    symmetry c1
+    """)
+
+    psi4.set_options({
+        "basis": "cc-pvdz",
+        "scf_type": "df",
+        "freeze_core": True,
+        "e_convergence": 1.0e-10,
+        "r_convergence": 1.0e-8,
+    })
+    psi4.set_output_file(f"dlpno_pair_store_{spill}_ref.out", False)
+    ref = psi4.energy("dlpno-ccsd")
+
+    if spill == "partial":
+        # Keep about half of the (Q_{ij}|m_{ij} a_{ij}) and (Q_{ij}|a_{ij} b_{ij}) blocks in core
+        with open(f"dlpno_pair_store_{spill}_ref.out") as f:
+            sizes = re.findall(r"\(Q_\{ij\} \| (?:m_\{ij\} a_\{ij\}|a_\{ij\} b_\{ij\})\)\s+:\s+(\S+) \[GB\]", f.read())
+        pno_int_memory = sum(float(size) for size in sizes[-2:])
+        assert compare(True, pno_int_memory > 0.0, "DF PNO integral memory printed")
+        psi4.set_options({"df_pno_core_memory": 0.5 * pno_int_memory})
+    else:
+        psi4.set_options({"write_qia_pno": True, "write_qab_pno": True})
+
+    psi4.set_output_file(f"dlpno_pair_store_{spill}.out", False)
+    energy = psi4.energy("dlpno-ccsd")
+
+    with open(f"dlpno_pair_store_{spill}.out") as f:
+        output = f.read()
+    if spill == "partial":
+        # Some, but not all, of the pair blocks went to disk
+        counts = [(int(ndisk), int(npairs)) for ndisk, npairs in re.findall(r"Writing (\d+) of (\d+) ", output)]
+        assert compare(True, any(0 < ndisk < npairs for ndisk, npairs in counts), "Part of the pair blocks on disk")
+    else:
+        for name in ["(Q_{ij}|m_{ij} a_{ij})", "(Q_{ij}|a_{ij} b_{ij})"]:
+            assert compare(True, f"Writing {name} integrals to disk" in output, f"All {name} pair blocks on disk")
+
+    assert compare_values(ref, energy, 9, "DLPNO-CCSD energy with pair blocks on disk")
@@ -0,0 +1,208 @@
+"""
+Tests for the DPD library options of the coupled-cluster codes
+"""
+
+import re
+
+import pytest
+from utils import compare, compare_values
+
+import psi4
+
+pytestmark = [pytest.mark.psi, pytest.mark.api]
+
+
+def _dpd_io_totals(fname):
+    """The Total rows of the DPD file4 I/O statistics, printed at PRINT > 1."""
+    with open(fname) as f:
+        return [line.split() for line in f if line.strip().startswith("Total") and len(line.split()) == 8]
+
+
+@pytest.mark.parametrize("option,setup,memory,nthreads", [
+    # Little memory and no cache, so that blocks are streamed through the disk
+    pytest.param("dpd_io_pipeline", {"cachelevel": 0}, 50 * 1024 * 1024, 1, id="io_pipeline"),
+    pytest.param("dpd_kernel_threads", {}, None, 4, id="kernel_threads"),
+])  # yapf: disable
+@pytest.mark.parametrize("reference", ["rhf", "uhf"])
+def test_dpd_options_ccsd(reference, option, setup, memory, nthreads):
+    """CCSD energies are the same with and without each DPD option."""
+
+    psi4.geometry("""
+    0 2
+    O
+    H 1 0.97
+    """ if reference == "uhf" else """
+    O
+    H 1 0.96
+    H 1 0.96 2 104.5
+    """)
+
+    psi4.set_num_threads(nthreads)
+    energies = {}
+    for on in [False, True]:
+        psi4.core.clean()
+        psi4.core.clean_options()
+        if memory is not None:
+            psi4.core.set_memory_bytes(memory)
+        psi4.set_output_file(f"dpd_{option}_{reference}_{on}.out", False)
+        psi4.set_options({
+            "basis": "cc-pvdz",
+            "reference": reference,
+            "freeze_core": True,
+            "print": 2,
+            option: on,
+        })
+        psi4.set_options(setup)
+        energies[on] = psi4.energy("ccsd")
+    psi4.set_num_threads(1)
+
+    assert compare_values(energies[False], energies[True], 9, f"{reference.upper()}-CCSD energy with {option.upper()}")
+
+    if option == "dpd_io_pipeline":
+        # some reads were served from the prefetched blocks, and none without the pipeline
+        prefetched = {on: sum(int(total[2]) for total in _dpd_io_totals(f"dpd_{option}_{reference}_{on}.out"))
+                      for on in [False, True]}
+        assert compare(True, prefetched[True] > 0, "DPD blocks read from prefetch buffers")
+        assert compare(0, prefetched[False], "DPD blocks read from prefetch buffers without the pipeline")
+
+    if option == "dpd_kernel_threads":
+        # some sorts or contractions, counted at PRINT > 1, ran on several threads
+        with open(f"dpd_{option}_{reference}_True.out") as f:
+            kernels = re.findall(r"DPD kernels with concurrent irrep blocks:\s+(\d+), threaded sorts:\s+(\d+)", f.read())
+        assert compare(True, len(kernels) > 0, "DPD kernel counts printed")
+        assert compare(True, sum(int(n) + int(m) for n, m in kernels) > 0, "DPD kernels run on several threads")
+
+
+@pytest.mark.long
+def test_dpd_io_pipeline_memory_limit():
+    """CCSD runs with the DPD I/O pipeline at every memory size that it runs at without it.
+
+    The staging buffers of the blocks prefetched for the next irrep must not count against the memory in which
+    contract444 fits the current one, or NN contractions that fit in core are sent to the (missing) out-of-core path.
+    The sizes are far below the 250 MiB floor of psi4.set_memory, hence psi4.core.set_memory_bytes.
+    """
+
+    psi4.geometry("""
+    O
+    H 1 0.96
+    H 1 0.96 2 104.5
+    """)
+
+    def run_ccsd(memory, pipeline):
+        psi4.core.clean()
+        psi4.core.clean_options()
+        psi4.core.set_memory_bytes(memory)
+        psi4.set_options({
+            "basis": "cc-pvdz",
+            "freeze_core": True,
+            "cachelevel": 0,
+            "dpd_io_pipeline": pipeline,
+        })
+        return psi4.energy("ccsd")
+
+    # Shrink the memory until contract444 no longer fits without the pipeline, at most eight sizes, and check
+    # that every size that worked gives the same energy with the pipeline
+    tested = 0
+    for step in range(8):
+        memory = int(16 * 1024 * 1024 * 0.8**step)
+        try:
+            ref = run_ccsd(memory, False)
+        except RuntimeError as e:
+            if "contract444" not in str(e):
+                raise
+            break
+        energy = run_ccsd(memory, True)
+        assert compare_values(ref, energy, 9, f"CCSD energy with DPD_IO_PIPELINE in {memory} bytes")
+        tested += 1
+
+    psi4.core.clean()
+    assert tested > 0, "CCSD did not run in the largest memory size tried"
+
+
+def test_dpd_cache_cost_ccsd():
+    """RHF-CCSD energies agree between the COST, LOW and LRU caches under memory pressure."""
+
+    psi4.geometry("""
+    O
+    H 1 0.96
+    H 1 0.96 2 104.5
+    """)
+
+    energies = {}
+    evictions = {}
+    for cachetype in ["COST", "LOW", "LRU"]:
+        psi4.core.clean()
+        psi4.core.clean_options()
+        psi4.set_output_file(f"dpd_cache_{cachetype.lower()}.out", False)
+        # Cache everything in too little memory, so that entries have to be evicted
+        psi4.core.set_memory_bytes(30 * 1024 * 1024)
+        psi4.set_options({
+            "basis": "cc-pvdz",
+            "freeze_core": True,
+            "cachelevel": 6,
+            "cachetype": cachetype,
+            "print": 2,
+        })
+        energies[cachetype] = psi4.energy("ccsd")
+
+        # the I/O statistics of the DPD file4 cache are printed at PRINT > 1
+        totals = _dpd_io_totals(f"dpd_cache_{cachetype.lower()}.out")
+        assert compare(True, len(totals) > 0, f"DPD I/O statistics printed with CACHETYPE {cachetype}")
+        evictions[cachetype] = sum(int(total[-1]) for total in totals)
+
+    assert compare_values(energies["LOW"], energies["COST"], 9, "RHF-CCSD energy with CACHETYPE COST")
+    assert compare_values(energies["LRU"], energies["COST"], 9, "RHF-CCSD energy with CACHETYPE LRU")
+    assert compare(True, evictions["COST"] > 0, "CACHETYPE COST evicted cache entries")
+
+
+def test_dpd_cache_stats_print_level():
+    """The DPD I/O statistics stay out of the output at the default print level."""
+
+    psi4.geometry("""
+    O
+    H 1 0.96
+    H 1 0.96 2 104.5
+    """)
+    psi4.set_output_file("dpd_cache_print1.out", False)
+    psi4.set_options({"basis": "cc-pvdz", "freeze_core": True})
+    psi4.energy("ccsd")
+
+    with open("dpd_cache_print1.out") as f:
+        assert compare(False, "DPD File4 I/O Statistics" in f.read(), "DPD I/O statistics at PRINT 1")
+
+
+@pytest.mark.parametrize("pipeline", [False, True])
+def test_cctriples_uhf_threads(pipeline):
+    """UHF-CCSD(T) spin components are the same on one and on several explicit ijk threads."""
+
+    psi4.geometry("""
+    0 2
+    O
+    H 1 0.97
+    """)
+
+    components = ["AAA", "AAB", "ABB", "BBB"]
+    energies = {}
+    for nthreads in [1, 4]:
+        psi4.core.clean()
+        psi4.core.clean_options()
+        psi4.set_output_file(f"cctriples_uhf_{pipeline}_{nthreads}.out", False)
+        psi4.set_options({
+            "basis": "cc-pvdz",
+            "reference": "uhf",
+            "freeze_core": True,
+            "cachelevel": 0,
+            "dpd_io_pipeline": pipeline,
+            "cc_num_threads": nthreads,
+        })
+        psi4.energy("ccsd(t)")
+        energies[nthreads] = [psi4.variable(f"{spin} (T) CORRECTION ENERGY") for spin in components]
+
+        # every spin case ran its ijk loop on the requested number of threads
+        with open(f"cctriples_uhf_{pipeline}_{nthreads}.out") as f:
+            threads = re.findall(r"Number of threads for explicit ijk threading:\s+(\d+)", f.read())
+        assert compare(len(components), len(threads), "UHF (T) spin cases threaded")
+        assert compare(True, all(int(n) == nthreads for n in threads), f"UHF (T) ijk loops on {nthreads} threads")
+
+    for spin, ref, energy in zip(components, energies[1], energies[4]):
+        assert compare_values(ref, energy, 10, f"{spin} (T) energy on 4 threads")
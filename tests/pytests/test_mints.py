@@ -3,7 +3,7 @@ import pytest
 import numpy as np
 import psi4
 
-from utils import compare_arrays
+from utils import compare_arrays, compare_values
 
 pytestmark = [pytest.mark.psi, pytest.mark.api]
 
@@ -127,3 +127,42 @@ def test_export_ao_overlap_half_deriv():
 
             # Test (S_ij)^x = < i^x | j > + < i | j^x >
             assert compare_arrays(deriv1_np[map_key1] + deriv1_np[map_key2], deriv1_np[map_key3])
+
+
+@pytest.mark.quick
+def test_eri_batch_ao_eri():
+    """The batched AO ERI tensor matches shell quartets computed one at a time."""
+
+    mol = psi4.geometry("""
+    O
+    H 1 0.96
+    H 1 0.96 2 104.5
+    """)
+    basis = psi4.core.BasisSet.build(mol, target="cc-pvdz")
+    mints = psi4.core.MintsHelper(basis)
+
+    eri = mints.ao_eri().np
+
+    for M, N, P, Q in [(0, 0, 0, 0), (3, 1, 5, 2), (1, 3, 2, 5), (7, 7, 4, 0), (9, 2, 9, 2)]:
+        shells = [basis.shell(S) for S in (M, N, P, Q)]
+        blocks = tuple(slice(sh.function_index, sh.function_index + sh.nfunction) for sh in shells)
+        ref = mints.ao_eri_shell(M, N, P, Q).np
+        assert compare_arrays(ref, eri[blocks], 12, f"AO ERI quartet ({M} {N}|{P} {Q})")
+
+
+@pytest.mark.quick
+def test_eri_batch_direct_scf():
+    """Integral-direct SCF with batched quartets reproduces the PK energy."""
+
+    psi4.geometry("""
+    O
+    H 1 0.96
+    H 1 0.96 2 104.5
+    """)
+    psi4.set_options({"basis": "cc-pvdz", "scf_type": "pk", "d_convergence": 1e-10})
+    e_ref = psi4.energy("scf")
+
+    psi4.set_options({"scf_type": "direct"})
+    e_batch = psi4.energy("scf")
+
+    assert compare_values(e_ref, e_batch, 9, "SCF energy with batched quartets")
@@ -1,9 +1,11 @@
+import re
+
 import numpy as np
 import pytest
 
 import psi4
 
-from utils import compare_values
+from utils import compare, compare_values
 
 pytestmark = [pytest.mark.psi, pytest.mark.api]
 
@@ -288,3 +290,75 @@ def test_sad_frac_occ_atomic_natural_occupations(atom, geom, expected_spin_elect
 # 0  O:   4.00000000   4.00000000   8.00000000
 # 1  H:   0.50000000   0.50000000   1.00000000
 # 2  H:   0.50000000   0.50000000   1.00000000
+
+
+@pytest.mark.parametrize("scheme", ["GRASSMANN", "ASPC"])
+@pytest.mark.parametrize("reference", ["rhf", "uhf"])
+def test_scf_guess_extrapolate(reference, scheme):
+    """SCF energies along a scan started from extrapolated orbitals match SAD-started ones in fewer iterations."""
+
+    def run_scf(roh, guess):
+        molecule = psi4.geometry(f"""
+        0 {1 if reference == "rhf" else 3}
+        O
+        H 1 {roh}
+        H 1 {roh} 2 104.5
+        """)
+        psi4.set_options({
+            "basis": "cc-pvdz",
+            "scf_type": "pk",
+            "reference": reference,
+            "e_convergence": 1.0e-10,
+            "d_convergence": 1.0e-8,
+            "guess": guess,
+            "guess_extrapolation": scheme,
+        })
+        psi4.set_output_file(f"scf_guess_{guess}.out", False)
+        energy, wfn = psi4.energy("scf", molecule=molecule, return_wfn=True)
+        with open(f"scf_guess_{guess}.out") as f:
+            used = re.findall(rf"SCF Guess: {scheme} extrapolation of (\d+) previous SCF solution", f.read())
+        return energy, int(wfn.variable("SCF ITERATIONS")), used
+
+    scan = [0.94, 0.95, 0.96, 0.97]
+
+    psi4.core.GuessHistory.clear()
+    for i, roh in enumerate(scan):
+        ref, niter_ref, _ = run_scf(roh, "sad")
+        energy, niter, used = run_scf(roh, "extrapolate")
+        assert compare_values(ref, energy, 8, f"{reference} energy at R(OH) = {roh} with a {scheme} guess")
+        # the first point has nothing to extrapolate from and falls back to SAD
+        assert compare(i > 0, len(used) > 0 and int(used[0]) > 0, f"{reference} {scheme} guess at R(OH) = {roh}")
+        if i > 0:
+            assert compare(True, niter <= niter_ref, f"{reference} iterations at R(OH) = {roh} with a {scheme} guess")
+    assert compare(3, psi4.core.GuessHistory.size(), "number of saved SCF solutions")
+    psi4.core.GuessHistory.clear()
+
+
+def test_scf_guess_extrapolate_basis_guess():
+    """The small-basis step of a BASIS_GUESS neither adds to nor clears the history of the target basis."""
+
+    scan = [0.94, 0.95, 0.96]
+
+    psi4.core.GuessHistory.clear()
+    for roh in scan:
+        molecule = psi4.geometry(f"""
+        0 1
+        O
+        H 1 {roh}
+        H 1 {roh} 2 104.5
+        """)
+        psi4.set_options({
+            "basis": "cc-pvdz",
+            "basis_guess": True,
+            "scf_type": "pk",
+            "e_convergence": 1.0e-10,
+            "d_convergence": 1.0e-8,
+            "guess": "sad",
+        })
+        ref = psi4.energy("scf", molecule=molecule)
+
+        psi4.set_options({"guess": "extrapolate"})
+        energy = psi4.energy("scf", molecule=molecule)
+        assert compare_values(ref, energy, 8, f"energy at R(OH) = {roh} with BASIS_GUESS and an extrapolated guess")
+    assert compare(len(scan), psi4.core.GuessHistory.size(), "number of saved target-basis SCF solutions")
+    psi4.core.GuessHistory.clear()